@@ -0,0 +1,387 @@
+#pragma once
+#include "counters.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Small benchmark framework for Zork (the TEST framework's counterpart)
+//
+// A BENCHMARK body prepares whatever it needs and hands the operation to
+// Bench::run(), which times it:
+//
+//     BENCHMARK(ParseSimple) {
+//         setupGame();
+//         Parser& parser = getGlobalParser();
+//         Bench::run([&]() { Bench::keep(parser.parse("look")); });
+//     }
+//
+// run() first finds a batch size that takes at least BATCH_NANOSECONDS,
+// then times batches until minSeconds have passed (and at least
+// MIN_SAMPLES batches). Each batch gives one sample of the time per
+// operation; the reported statistics are over those samples.
+//
+// Where the hardware counters can be read (counters.h), the timed batches
+// are also counted, and the table and JSON show instructions per cycle and
+// cache and branch misses per operation next to the times.
+//
+// Results can be written as JSON and compared with an earlier JSON file:
+// a benchmark whose median is more than the threshold slower than the
+// baseline's is a regression.
+
+namespace Bench {
+
+struct Result {
+    std::string name;
+    uint64_t iterations = 0; // operations timed
+    size_t samples = 0;
+    // Nanoseconds per operation
+    double mean = 0;
+    double stddev = 0;
+    double min = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+    CounterSample counters; // over all timed operations
+
+    // Mean count of event per operation
+    double perOperation(Event event) const {
+        return iterations ? static_cast<double>(counters[event]) / static_cast<double>(iterations) : 0;
+    }
+};
+
+// Keep a value (and the work that produced it) from being optimized away
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Stream buffer that accepts and drops everything (game output in
+// benchmarks is produced in full, then thrown away)
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Value at fraction q of sorted values (nearest rank)
+inline double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+inline Result summarize(const std::string& name, std::vector<double> samples, uint64_t iterations) {
+    Result r;
+    r.name = name;
+    r.iterations = iterations;
+    r.samples = samples.size();
+    if (samples.empty()) {
+        return r;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double s : samples) {
+        sum += s;
+    }
+    r.mean = sum / static_cast<double>(samples.size());
+    double squares = 0;
+    for (double s : samples) {
+        squares += (s - r.mean) * (s - r.mean);
+    }
+    r.stddev = samples.size() > 1 ? std::sqrt(squares / static_cast<double>(samples.size() - 1)) : 0;
+    r.min = samples.front();
+    r.max = samples.back();
+    r.p50 = percentile(samples, 0.50);
+    r.p90 = percentile(samples, 0.90);
+    r.p99 = percentile(samples, 0.99);
+    r.p999 = percentile(samples, 0.999);
+    return r;
+}
+
+class Framework {
+public:
+    static constexpr double BATCH_NANOSECONDS = 20000;
+    static constexpr size_t MIN_SAMPLES = 10;
+    static constexpr size_t MAX_SAMPLES = 100000;
+
+    static Framework& instance() {
+        static Framework inst;
+        return inst;
+    }
+
+    void add(const std::string& name, std::function<void()> body) {
+        benchmarks_.push_back({name, std::move(body)});
+    }
+
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        for (const auto& b : benchmarks_) {
+            result.push_back(b.name);
+        }
+        return result;
+    }
+
+    // Time operations for at least this long per benchmark
+    double minSeconds = 0.5;
+
+    // Run every benchmark whose name contains filter
+    std::vector<Result> runAll(const std::string& filter = "") {
+        std::vector<Result> results;
+        for (const auto& b : benchmarks_) {
+            if (b.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            current_ = b.name;
+            measured_ = false;
+            b.body();
+            if (!measured_) {
+                std::cerr << b.name << " never called Bench::run()\n";
+                continue;
+            }
+            results.push_back(last_);
+        }
+        return results;
+    }
+
+    void measure(const std::function<void()>& op) {
+        using Clock = std::chrono::steady_clock;
+        auto time = [&](uint64_t batch) {
+            auto start = Clock::now();
+            for (uint64_t i = 0; i < batch; ++i) {
+                op();
+            }
+            return static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        };
+
+        // Calibrate (this also warms up caches and lazy initialization)
+        uint64_t batch = 1;
+        while (batch < (1u << 24) && time(batch) < BATCH_NANOSECONDS) {
+            batch *= 2;
+        }
+
+        std::vector<double> samples;
+        uint64_t iterations = 0;
+        double spent = 0;
+        CounterSample counted;
+        while (samples.size() < MAX_SAMPLES &&
+               (spent < minSeconds * 1e9 || samples.size() < MIN_SAMPLES)) {
+            CounterSample before = counters_.read();
+            double ns = time(batch);
+            counted += counters_.read() - before;
+            samples.push_back(ns / static_cast<double>(batch));
+            iterations += batch;
+            spent += ns;
+        }
+        last_ = summarize(current_, std::move(samples), iterations);
+        last_.counters = counted;
+        measured_ = true;
+    }
+
+private:
+    struct Benchmark {
+        std::string name;
+        std::function<void()> body;
+    };
+
+    std::vector<Benchmark> benchmarks_;
+    Counters counters_;
+    std::string current_;
+    Result last_;
+    bool measured_ = false;
+};
+
+// Time op (called from a BENCHMARK body)
+inline void run(const std::function<void()>& op) {
+    Framework::instance().measure(op);
+}
+
+// -- Reporting ---------------------------------------------------------------
+
+// Counter columns: instructions per cycle, then misses per operation
+// ("-" for events that were not counted)
+inline std::string counterColumns(const CounterSample& counters, double operations) {
+    char column[32];
+    std::string text;
+    if (counters.has(Event::CYCLES) && counters.has(Event::INSTRUCTIONS)) {
+        std::snprintf(column, sizeof(column), " %6.2f", counters.ipc());
+    } else {
+        std::snprintf(column, sizeof(column), " %6s", "-");
+    }
+    text += column;
+    for (Event event : {Event::L1D_MISSES, Event::LLC_MISSES, Event::BRANCH_MISSES}) {
+        if (counters.has(event) && operations > 0) {
+            std::snprintf(column, sizeof(column), " %10.2f",
+                          static_cast<double>(counters[event]) / operations);
+        } else {
+            std::snprintf(column, sizeof(column), " %10s", "-");
+        }
+        text += column;
+    }
+    return text;
+}
+
+inline std::string counterHeadings() {
+    char line[64];
+    std::snprintf(line, sizeof(line), " %6s %10s %10s %10s", "IPC", "L1d miss", "LLC miss",
+                  "br miss");
+    return line;
+}
+
+inline void printTable(const std::vector<Result>& results, std::ostream& out = std::cout) {
+    bool counted = std::any_of(results.begin(), results.end(),
+                               [](const Result& r) { return r.counters.has(Event::CYCLES); });
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-28s %10s %10s %10s %10s %10s %9s", "benchmark",
+                  "p50 ns", "p90 ns", "p99 ns", "mean ns", "stddev", "samples");
+    out << line << (counted ? counterHeadings() : "") << "\n";
+    for (const auto& r : results) {
+        std::snprintf(line, sizeof(line), "%-28s %10.1f %10.1f %10.1f %10.1f %10.1f %9zu",
+                      r.name.c_str(), r.p50, r.p90, r.p99, r.mean, r.stddev, r.samples);
+        out << line
+            << (counted ? counterColumns(r.counters, static_cast<double>(r.iterations)) : "")
+            << "\n";
+    }
+    if (!counted) {
+        out << "(hardware counters unavailable: wall time only)\n";
+    }
+}
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+// One benchmark object per line, so the file diffs well
+inline void writeJson(const std::vector<Result>& results,
+                      const std::map<std::string, std::string>& context, std::ostream& out) {
+    out << "{\n  \"context\": {";
+    bool first = true;
+    for (const auto& [key, value] : context) {
+        out << (first ? "" : ",") << "\n    \"" << jsonEscape(key) << "\": \"" << jsonEscape(value) << "\"";
+        first = false;
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+    char number[64];
+    auto field = [&](const char* key, double value) {
+        std::snprintf(number, sizeof(number), "%.1f", value);
+        out << ", \"" << key << "\": " << number;
+    };
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i ? "," : "") << "\n    {\"name\": \"" << jsonEscape(r.name) << "\""
+            << ", \"iterations\": " << r.iterations << ", \"samples\": " << r.samples;
+        field("mean_ns", r.mean);
+        field("stddev_ns", r.stddev);
+        field("min_ns", r.min);
+        field("p50_ns", r.p50);
+        field("p90_ns", r.p90);
+        field("p99_ns", r.p99);
+        field("p999_ns", r.p999);
+        field("max_ns", r.max);
+        if (r.counters.has(Event::CYCLES) && r.counters.has(Event::INSTRUCTIONS)) {
+            std::snprintf(number, sizeof(number), "%.3f", r.counters.ipc());
+            out << ", \"ipc\": " << number;
+        }
+        for (size_t e = 0; e < EVENTS; ++e) {
+            Event event = static_cast<Event>(e);
+            if (r.counters.has(event)) {
+                field(std::string(eventName(event)).c_str(), r.perOperation(event));
+            }
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Median (p50_ns) of every benchmark in a file written by writeJson()
+inline std::map<std::string, double> readBaseline(std::istream& in) {
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    std::map<std::string, double> medians;
+    const std::string nameKey = "\"name\": \"";
+    const std::string p50Key = "\"p50_ns\": ";
+    for (size_t pos = text.find(nameKey); pos != std::string::npos; pos = text.find(nameKey, pos)) {
+        pos += nameKey.size();
+        std::string name;
+        for (; pos < text.size() && text[pos] != '"'; ++pos) {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                ++pos;
+            }
+            name += text[pos];
+        }
+        size_t end = text.find('}', pos);
+        size_t p50 = text.find(p50Key, pos);
+        if (p50 != std::string::npos && p50 < end) {
+            medians[name] = std::strtod(text.c_str() + p50 + p50Key.size(), nullptr);
+        }
+    }
+    return medians;
+}
+
+// Print each benchmark's change from the baseline; returns the names of
+// those more than thresholdPercent slower
+inline std::vector<std::string> compare(const std::vector<Result>& results,
+                                        const std::map<std::string, double>& baseline,
+                                        double thresholdPercent, std::ostream& out = std::cout) {
+    std::vector<std::string> regressions;
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-28s %12s %12s %9s\n", "benchmark", "baseline ns",
+                  "p50 ns", "change");
+    out << line;
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0) {
+            std::snprintf(line, sizeof(line), "%-28s %12s %12.1f %9s\n", r.name.c_str(), "-",
+                          r.p50, "new");
+            out << line;
+            continue;
+        }
+        double change = 100.0 * (r.p50 - it->second) / it->second;
+        bool regressed = change > thresholdPercent;
+        if (regressed) {
+            regressions.push_back(r.name);
+        }
+        std::snprintf(line, sizeof(line), "%-28s %12.1f %12.1f %+8.1f%%%s\n", r.name.c_str(),
+                      it->second, r.p50, change, regressed ? "  REGRESSION" : "");
+        out << line;
+    }
+    return regressions;
+}
+
+} // namespace Bench
+
+// Register a benchmark (same shape as TEST)
+#define BENCHMARK(name) \
+    void bench_##name(); \
+    struct BenchRegistrar_##name { \
+        BenchRegistrar_##name() { Bench::Framework::instance().add(#name, bench_##name); } \
+    } bench_registrar_##name; \
+    void bench_##name()
@@ -0,0 +1,198 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware performance counters of the calling thread (Linux perf events)
+//
+// Counters opens one perf event group (cycles, instructions, L1 data
+// cache read misses, last-level cache misses, branch misses) counting user
+// mode only, and read() returns the running totals; the difference of two
+// reads is what ran in between:
+//
+//     Bench::Counters counters;
+//     Bench::CounterSample before = counters.read();
+//     op();
+//     Bench::CounterSample spent = counters.read() - before;
+//
+// Where perf events cannot be opened (not Linux, no PMU in a virtual
+// machine, perf_event_paranoid or a container's seccomp profile)
+// available() is false, read() returns an empty sample and the benchmarks
+// report wall time only. Events the CPU lacks are left out individually
+// (CounterSample::has()).
+
+namespace Bench {
+
+enum class Event : uint8_t {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    COUNT
+};
+
+constexpr size_t EVENTS = static_cast<size_t>(Event::COUNT);
+
+inline std::string_view eventName(Event event) {
+    switch (event) {
+        case Event::CYCLES: return "cycles";
+        case Event::INSTRUCTIONS: return "instructions";
+        case Event::L1D_MISSES: return "l1d_misses";
+        case Event::LLC_MISSES: return "llc_misses";
+        case Event::BRANCH_MISSES: return "branch_misses";
+        default: return "?";
+    }
+}
+
+// Event counts; valid marks the events that were counted
+struct CounterSample {
+    std::array<uint64_t, EVENTS> counts{};
+    std::array<bool, EVENTS> valid{};
+
+    uint64_t operator[](Event event) const { return counts[static_cast<size_t>(event)]; }
+    bool has(Event event) const { return valid[static_cast<size_t>(event)]; }
+
+    CounterSample& operator+=(const CounterSample& other) {
+        for (size_t i = 0; i < EVENTS; ++i) {
+            counts[i] += other.counts[i];
+            valid[i] = valid[i] || other.valid[i];
+        }
+        return *this;
+    }
+
+    CounterSample operator-(const CounterSample& earlier) const {
+        CounterSample difference;
+        for (size_t i = 0; i < EVENTS; ++i) {
+            difference.counts[i] = counts[i] - earlier.counts[i];
+            difference.valid[i] = valid[i] && earlier.valid[i];
+        }
+        return difference;
+    }
+
+    // Instructions per cycle (0 unless both were counted)
+    double ipc() const {
+        uint64_t cycles = (*this)[Event::CYCLES];
+        return cycles && has(Event::INSTRUCTIONS)
+                   ? static_cast<double>((*this)[Event::INSTRUCTIONS]) / static_cast<double>(cycles)
+                   : 0;
+    }
+};
+
+class Counters {
+public:
+    Counters() {
+#ifdef __linux__
+        for (size_t i = 0; i < EVENTS; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            configure(static_cast<Event>(i), attr);
+            attr.disabled = leader_ < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0));
+            if (fd < 0) {
+                if (leader_ < 0) {
+                    return; // no cycles, no counters
+                }
+                continue;
+            }
+            if (leader_ < 0) {
+                leader_ = fd;
+            }
+            fds_[i] = fd;
+            ioctl(fd, PERF_EVENT_IOC_ID, &ids_[i]);
+        }
+        // Cycles without instructions give no IPC; count neither
+        if (fds_[static_cast<size_t>(Event::INSTRUCTIONS)] < 0) {
+            close();
+            return;
+        }
+        ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    ~Counters() { close(); }
+
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+
+    // True if cycles and instructions are counted
+    bool available() const { return leader_ >= 0; }
+
+    // Totals since construction (nothing valid if unavailable)
+    CounterSample read() const {
+        CounterSample sample;
+#ifdef __linux__
+        if (leader_ < 0) {
+            return sample;
+        }
+        // nr, then {value, id} per event in the group
+        uint64_t buffer[1 + 2 * EVENTS];
+        if (::read(leader_, buffer, sizeof(buffer)) <= 0) {
+            return sample;
+        }
+        for (uint64_t n = 0; n < buffer[0] && n < EVENTS; ++n) {
+            for (size_t i = 0; i < EVENTS; ++i) {
+                if (fds_[i] >= 0 && ids_[i] == buffer[2 + 2 * n]) {
+                    sample.counts[i] = buffer[1 + 2 * n];
+                    sample.valid[i] = true;
+                }
+            }
+        }
+#endif
+        return sample;
+    }
+
+private:
+#ifdef __linux__
+    static void configure(Event event, perf_event_attr& attr) {
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (event) {
+            case Event::CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+            case Event::INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+            case Event::L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case Event::LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+            case Event::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+            default: break;
+        }
+    }
+#endif
+
+    void close() {
+#ifdef __linux__
+        for (int& fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+        leader_ = -1;
+    }
+
+    int leader_ = -1;
+    std::array<int, EVENTS> fds_ = [] {
+        std::array<int, EVENTS> fds{};
+        fds.fill(-1);
+        return fds;
+    }();
+    std::array<uint64_t, EVENTS> ids_{};
+};
+
+} // namespace Bench
@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+
+// Walkthrough played by zork_walkthrough
+//
+// The longest route through the port that plays without detours: every
+// treasure that can currently be reached is carried to the trophy case.
+// It covers the opening, the troll fight, light sources and their timers,
+// the rope and dome, the temple and the way back through the Mirror Room.
+//
+// The commands assume a new game with SEED (the troll fight is random)
+// and finish with SCORE points. The original's 350 points are not within
+// reach: the port scores treasures only, and several puzzles (the mirror,
+// the dam, Hades, the thief's lair) cannot be solved yet. Extend the
+// route as they are.
+
+namespace Walkthrough {
+
+constexpr uint32_t SEED = 1;
+constexpr int SCORE = 76;
+
+inline const char* const COMMANDS[] = {
+    // Opening and the egg
+    "open mailbox",
+    "take leaflet",
+    "read leaflet",
+    "drop leaflet",
+    "north",
+    "north",
+    "up",
+    "take egg",
+    "down",
+    "south",
+    "east",
+    "open window",
+    "west",
+    "west",
+    "open case",
+    "put egg in case",
+
+    // Into the cellar, past the troll
+    "take lamp",
+    "take sword",
+    "light lamp",
+    "move rug",
+    "open trap door",
+    "down",
+    "north",
+    "kill troll with sword",
+    "kill troll with sword",
+    "kill troll with sword",
+
+    // Platinum bar
+    "east",
+    "east",
+    "east",
+    "take bar",
+    "west",
+    "west",
+    "west",
+    "south",
+    "up",
+    "put bar in case",
+
+    // Painting and diamond
+    "down",
+    "south",
+    "east",
+    "take painting",
+    "west",
+    "take diamond",
+    "north",
+    "up",
+    "put painting in case",
+    "put diamond in case",
+
+    // Rope, dome and temple
+    "east",
+    "up",
+    "take rope",
+    "down",
+    "west",
+    "down",
+    "north",
+    "east",
+    "east",
+    "southeast",
+    "east",
+    "tie rope to railing",
+    "down",
+    "down",
+    "take torch",
+    "south",
+    "take all",
+    "north",
+    "east",
+    "take scarab",
+    "take sceptre",
+    "drop sword",
+    "take coffin",
+
+    // Back through the Mirror Room
+    "west",
+    "south",
+    "down",
+    "north",
+    "north",
+    "north",
+    "west",
+    "west",
+    "south",
+    "up",
+    "put torch in case",
+    "put sapphire bracelet in case",
+    "put emerald bracelet in case",
+    "put scarab in case",
+    "put sceptre in case",
+    "put coffin in case",
+
+    // Wrap up
+    "score",
+    "inventory",
+    "examine case",
+    "diagnose",
+    "wait",
+};
+
+} // namespace Walkthrough
@@ -0,0 +1,271 @@
+// Zork Bench - microbenchmarks of the engine's hot paths
+//
+// Usage:
+//   zork_bench [options]
+//
+// Options:
+//   --filter TEXT       run only benchmarks whose name contains TEXT
+//   --min-time S        time each benchmark for at least S seconds (default 0.5)
+//   --json FILE         write the results as JSON
+//   --baseline FILE     compare medians with a JSON file from an earlier run
+//   --threshold PCT     with --baseline, fail if a median is more than PCT
+//                       percent slower (default 10)
+//   --list              print the benchmark names
+//
+// Exit status: 0, or 1 if a benchmark regressed against the baseline.
+//
+// Build with -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release.
+
+#include "bench.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "parser/parser.h"
+#include "systems/save.h"
+#include "systems/timer.h"
+#include "verbs/verbs.h"
+#include "world/objects.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#ifndef ZORK_BENCH_BUILD_TYPE
+#define ZORK_BENCH_BUILD_TYPE ""
+#endif
+
+namespace {
+
+Bench::NullBuffer nullBuffer;
+std::ostream nullStream(&nullBuffer);
+
+const char* const SAVE_FILE = "zork_bench.sav";
+
+// New game with output discarded, then walk to the Living Room (lamp,
+// sword, trophy case, rug and trap door in scope)
+void livingRoom() {
+    setOutputStream(&nullStream);
+    Engine::newGame(1);
+    for (const char* command : {"north", "east", "open window", "west", "west"}) {
+        Engine::step(command);
+    }
+}
+
+// End of a turn for the parser's temporaries (Engine::step does this)
+void endTurn() {
+    Globals::instance().releaseScratch();
+}
+
+} // namespace
+
+// -- Parser ------------------------------------------------------------------
+
+BENCHMARK(ParseSimple) {
+    livingRoom();
+    Parser& parser = getGlobalParser();
+    Bench::run([&]() {
+        Bench::keep(parser.parse("take lamp"));
+        endTurn();
+    });
+}
+
+BENCHMARK(ParseAdjective) {
+    livingRoom();
+    Parser& parser = getGlobalParser();
+    Bench::run([&]() {
+        Bench::keep(parser.parse("take brass lantern"));
+        endTurn();
+    });
+}
+
+BENCHMARK(ParsePreposition) {
+    livingRoom();
+    Parser& parser = getGlobalParser();
+    Bench::run([&]() {
+        Bench::keep(parser.parse("put sword in trophy case"));
+        endTurn();
+    });
+}
+
+BENCHMARK(ParseAll) {
+    livingRoom();
+    Parser& parser = getGlobalParser();
+    Bench::run([&]() {
+        Bench::keep(parser.parse("take all"));
+        endTurn();
+    });
+}
+
+BENCHMARK(FindObjects) {
+    livingRoom();
+    Parser& parser = getGlobalParser();
+    const std::vector<std::string> words = {"brass", "lantern"};
+    Bench::run([&]() {
+        Bench::keep(parser.findObjects(words));
+        endTurn();
+    });
+}
+
+// -- Systems -----------------------------------------------------------------
+
+BENCHMARK(TimerTick) {
+    livingRoom();
+    Bench::run([]() { TimerSystem::tick(); });
+}
+
+BENCHMARK(Look) {
+    livingRoom();
+    Bench::run([]() { Verbs::vLook(); });
+}
+
+BENCHMARK(WalkDir) {
+    // Kitchen and Living Room, back and forth
+    livingRoom();
+    bool east = true;
+    Bench::run([&]() {
+        Verbs::vWalkDir(east ? Direction::EAST : Direction::WEST);
+        east = !east;
+    });
+}
+
+// The lamp from the room to the inventory and back
+BENCHMARK(MoveObject) {
+    livingRoom();
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+    bool held = false;
+    Bench::run([&]() {
+        lamp->moveTo(held ? g.here : g.winner);
+        held = !held;
+    });
+}
+
+// SIZE and VALUE of every object, as the load and score checks read them
+BENCHMARK(PropertyReads) {
+    livingRoom();
+    const auto& objects = Globals::instance().getAllObjects();
+    Bench::run([&]() {
+        int sum = 0;
+        for (const auto& [id, obj] : objects) {
+            sum += obj->getProperty(P_SIZE) + obj->getProperty(P_VALUE);
+        }
+        Bench::keep(sum);
+    });
+}
+
+BENCHMARK(Save) {
+    livingRoom();
+    Bench::run([]() { Bench::keep(SaveSystem::save(SAVE_FILE)); });
+    std::remove(SAVE_FILE);
+}
+
+BENCHMARK(Restore) {
+    livingRoom();
+    SaveSystem::save(SAVE_FILE);
+    Bench::run([]() { Bench::keep(SaveSystem::restore(SAVE_FILE)); });
+    std::remove(SAVE_FILE);
+}
+
+BENCHMARK(WorldInit) {
+    setOutputStream(&nullStream);
+    Bench::run([]() { Engine::newGame(1); });
+}
+
+// The same with the world on the global heap instead of its arena
+BENCHMARK(WorldInitHeap) {
+    setOutputStream(&nullStream);
+    Globals::instance().setWorldArena(false);
+    Bench::run([]() { Engine::newGame(1); });
+    Globals::instance().setWorldArena(true);
+}
+
+// ------------------------------------------------------------------------------
+
+namespace {
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_bench [--filter TEXT] [--min-time S] [--json FILE]\n"
+                 "                  [--baseline FILE [--threshold PCT]] [--list]\n");
+    return 2;
+}
+
+std::map<std::string, std::string> context() {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    std::map<std::string, std::string> c = {
+        {"date", date},
+        {"build_type", ZORK_BENCH_BUILD_TYPE},
+#ifdef __VERSION__
+        {"compiler", __VERSION__},
+#endif
+    };
+    return c;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 10;
+    auto& framework = Bench::Framework::instance();
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            filter = argv[++i];
+        } else if (std::strcmp(arg, "--min-time") == 0 && hasValue) {
+            framework.minSeconds = std::stod(argv[++i]);
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--threshold") == 0 && hasValue) {
+            threshold = std::stod(argv[++i]);
+        } else if (std::strcmp(arg, "--list") == 0) {
+            for (const auto& name : framework.names()) {
+                std::printf("%s\n", name.c_str());
+            }
+            return 0;
+        } else {
+            return usage();
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty()) {
+        std::ifstream in(baselinePath);
+        if (!in) {
+            std::fprintf(stderr, "Cannot open %s\n", baselinePath.c_str());
+            return 2;
+        }
+        baseline = Bench::readBaseline(in);
+    }
+
+    auto results = framework.runAll(filter);
+    setOutputStream(nullptr);
+    Bench::printTable(results);
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        Bench::writeJson(results, context(), out);
+        if (!out) {
+            std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+            return 2;
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        std::printf("\n");
+        auto regressions = Bench::compare(results, baseline, threshold);
+        if (!regressions.empty()) {
+            std::printf("\n%zu benchmark(s) more than %.1f%% slower than %s\n",
+                        regressions.size(), threshold, baselinePath.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+// Zork Footprint - memory per live game session
+//
+// Usage:
+//   zork_footprint [options]
+//
+//   Starts N sessions at once, each a new game on a thread of its own
+//   (game state is per thread) that then plays the first C commands of
+//   bench/walkthrough.h and waits. With all N alive it reads the
+//   process's resident set size and reports, per session:
+//
+//     RSS           growth of the process's RSS divided by N; what a host
+//                   pays per session, thread stack and allocator slack
+//                   included
+//     heap          growth of the bytes malloc has handed out (main arena
+//                   and thread arenas), divided by N
+//     footprint     Footprint::current() of each session (mean), by part
+//                   (systems/footprint.h)
+//
+//   and the time to start the N sessions and to tear them down, and the
+//   RSS left once they are gone (what the allocator could not give back).
+//   Each world lives in its session's arena (core/globals.h); --heap
+//   builds them on the global heap instead, for comparison.
+//
+// Options:
+//   --sessions N        live sessions (default 10000)
+//   --commands C        walkthrough commands each session plays first
+//                       (default 0: a new game)
+//   --stack KIB         stack per session thread (default 256)
+//   --heap              build the worlds on the global heap, not in arenas
+//
+// Exit status: 0, or 2 on usage errors or if threads cannot be created.
+//
+// Build with -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release.
+
+#include "bench.h"
+#include "walkthrough.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "systems/footprint.h"
+#include <cstring>
+#include <latch>
+#include <malloc.h>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace {
+
+// Current resident set size of this process in KiB
+long rssKb() {
+    long pages = 0, resident = 0;
+    if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Bytes malloc has handed out and not had back
+size_t heapInUse() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+struct Shared {
+    size_t commands = 0;
+    bool heap = false;
+    std::latch* started = nullptr;
+    std::latch* release = nullptr;
+};
+
+struct Session {
+    const Shared* shared = nullptr;
+    uint32_t seed = 0;
+    Footprint::Report footprint;
+};
+
+void* runSession(void* argument) {
+    auto& session = *static_cast<Session*>(argument);
+    Bench::NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    std::istringstream noInput;
+    setOutputStream(&nullStream);
+    setInputStream(&noInput);
+
+    Globals::instance().setWorldArena(!session.shared->heap);
+    Engine::newGame(session.seed);
+    for (size_t i = 0; i < session.shared->commands; ++i) {
+        Engine::step(Walkthrough::COMMANDS[i]);
+    }
+    setOutputStream(nullptr);
+    session.footprint = Footprint::current();
+
+    session.shared->started->count_down();
+    session.shared->release->wait();
+    setInputStream(nullptr);
+    return nullptr;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printFootprint(const std::vector<Session>& sessions) {
+    Footprint::Report mean;
+    for (const auto& session : sessions) {
+        for (size_t i = 0; i < Footprint::PARTS; ++i) {
+            mean.bytes[i] += session.footprint.bytes[i];
+        }
+    }
+    for (auto& bytes : mean.bytes) {
+        bytes /= sessions.size();
+    }
+    double total = static_cast<double>(mean.total());
+    std::printf("\n%-16s %12s %7s\n", "part", "bytes", "share");
+    for (size_t i = 0; i < Footprint::PARTS; ++i) {
+        std::printf("%-16s %12zu %6.1f%%\n",
+                    std::string(Footprint::partName(static_cast<Footprint::Part>(i))).c_str(),
+                    mean.bytes[i], total > 0 ? 100.0 * static_cast<double>(mean.bytes[i]) / total : 0);
+    }
+    std::printf("%-16s %12zu\n", "footprint", mean.total());
+}
+
+int usage() {
+    std::fprintf(stderr, "usage: zork_footprint [--sessions N] [--commands C] [--stack KIB] [--heap]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t count = 10000;
+    size_t commands = 0;
+    size_t stackKb = 256;
+    bool heap = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--sessions") == 0 && hasValue) {
+            count = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--commands") == 0 && hasValue) {
+            commands = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--stack") == 0 && hasValue) {
+            stackKb = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--heap") == 0) {
+            heap = true;
+        } else {
+            return usage();
+        }
+    }
+    if (count == 0 || commands > std::size(Walkthrough::COMMANDS) || stackKb < 64) {
+        return usage();
+    }
+
+    // Warm up the process-wide statics (verb registry, iostreams) on a
+    // thread of their own so that they are not charged to the sessions
+    {
+        std::latch started(1), release(0);
+        Shared shared{commands, heap, &started, &release};
+        Session session{&shared, 1, {}};
+        pthread_t thread;
+        if (pthread_create(&thread, nullptr, runSession, &session) != 0) {
+            std::perror("pthread_create");
+            return 2;
+        }
+        pthread_join(thread, nullptr);
+    }
+
+    std::latch started(static_cast<std::ptrdiff_t>(count));
+    std::latch release(1);
+    Shared shared{commands, heap, &started, &release};
+    std::vector<Session> sessions(count);
+    std::vector<pthread_t> threads(count);
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, stackKb * 1024);
+
+    long rssBefore = rssKb();
+    size_t heapBefore = heapInUse();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        sessions[i] = Session{&shared, static_cast<uint32_t>(i + 1), {}};
+        if (pthread_create(&threads[i], &attributes, runSession, &sessions[i]) != 0) {
+            std::fprintf(stderr, "cannot create session thread %zu (see ulimit -u)\n", i);
+            _exit(2); // the live threads wait on release forever
+        }
+    }
+    started.wait();
+    double startSeconds = secondsSince(start);
+    long rssAfter = rssKb();
+    size_t heapAfter = heapInUse();
+
+    start = std::chrono::steady_clock::now();
+    release.count_down();
+    for (pthread_t thread : threads) {
+        pthread_join(thread, nullptr);
+    }
+    double teardownSeconds = secondsSince(start);
+    pthread_attr_destroy(&attributes);
+    long rssLeft = rssKb();
+
+    double n = static_cast<double>(count);
+    std::printf("%zu live sessions, %zu command%s each, %zu KiB stacks, worlds %s\n\n", count,
+                commands, commands == 1 ? "" : "s", stackKb, heap ? "on the heap" : "in arenas");
+    std::printf("RSS before          %10ld KiB\n", rssBefore);
+    std::printf("RSS with sessions   %10ld KiB\n", rssAfter);
+    std::printf("RSS per session     %10.1f KiB\n", static_cast<double>(rssAfter - rssBefore) / n);
+    std::printf("RSS after teardown  %10ld KiB (%+ld)\n", rssLeft, rssLeft - rssBefore);
+    std::printf("heap per session    %10.1f KiB\n",
+                (static_cast<double>(heapAfter) - static_cast<double>(heapBefore)) / n / 1024);
+    std::printf("start               %10.3f s (%.1f us per session)\n", startSeconds,
+                startSeconds / n * 1e6);
+    std::printf("teardown            %10.3f s (%.1f us per session)\n", teardownSeconds,
+                teardownSeconds / n * 1e6);
+    printFootprint(sessions);
+    return 0;
+}
@@ -0,0 +1,283 @@
+// Zork Sessions - throughput of many games in one process
+//
+// Usage:
+//   zork_sessions [options]
+//
+//   Plays M sessions (a new game, then bench/walkthrough.h) on T threads
+//   for T = 1, 2, 4, ... up to the number of cores. Game state is per
+//   thread, so a thread plays its sessions one after another; threads
+//   take the next session from a shared counter until all M are done.
+//
+//   For every T it reports aggregate commands per second, the speedup
+//   over one thread and the per-thread efficiency (speedup / T), and
+//   measures what usually hides behind poor scaling:
+//
+//     allocs/cmd    heap allocations per command, new games included
+//                   (malloc arenas and their locks are shared by the
+//                   whole process)
+//     vcsw/1k       voluntary context switches per 1000 commands; a
+//                   thread only gives up the CPU voluntarily to wait, so
+//                   these count sleeps on locks (futexes) and I/O
+//     proc eff      efficiency of the same T sessions-at-a-time in T
+//                   forked processes, which share nothing in user space.
+//                   The hardware (memory bandwidth, caches, SMT) limits
+//                   both; a gap between "eff" and "proc eff" is
+//                   contention inside the process: shared statics
+//                   written by several threads, false sharing, the
+//                   allocator.
+//
+// Options:
+//   --sessions M        sessions per round (default 64)
+//   --threads N         highest thread count (default: one per core)
+//   --no-processes      skip the forked-process rounds
+//
+// Exit status: 0, or 2 on usage errors or if a session did not end with
+// the walkthrough's score.
+//
+// Build with -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release.
+
+#include "bench.h"
+#include "walkthrough.h"
+#include "core/engine.h"
+#include "core/io.h"
+#include "systems/allocation_hook.h"
+#include "systems/score.h"
+#include <atomic>
+#include <cstring>
+#include <latch>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// What one thread (or process) did in a round
+struct Work {
+    uint64_t sessions = 0;
+    uint64_t commands = 0;
+    uint64_t allocations = 0;
+    uint64_t voluntarySwitches = 0;
+    uint64_t involuntarySwitches = 0;
+    uint64_t offRoute = 0; // sessions that did not reach the score
+
+    void add(const Work& other) {
+        sessions += other.sessions;
+        commands += other.commands;
+        allocations += other.allocations;
+        voluntarySwitches += other.voluntarySwitches;
+        involuntarySwitches += other.involuntarySwitches;
+        offRoute += other.offRoute;
+    }
+};
+
+struct Round {
+    unsigned threads = 0;
+    double seconds = 0;
+    Work work;
+    double processSeconds = 0; // 0 if not measured
+
+    double commandsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(work.commands) / seconds : 0;
+    }
+    double perCommand(uint64_t total, double scale = 1) const {
+        return work.commands ? scale * static_cast<double>(total) / static_cast<double>(work.commands) : 0;
+    }
+};
+
+void playSession(Work& work) {
+    Engine::newGame(Walkthrough::SEED);
+    for (const char* command : Walkthrough::COMMANDS) {
+        Bench::keep(Engine::step(command));
+    }
+    ++work.sessions;
+    work.commands += std::size(Walkthrough::COMMANDS);
+    if (ScoreSystem::instance().getScore() != Walkthrough::SCORE) {
+        ++work.offRoute;
+    }
+}
+
+// Play sessions taken from next until there are none left; counts what
+// the calling thread did (RUSAGE_THREAD) or, in a child process, the
+// whole process
+Work playShare(std::atomic<size_t>& next, size_t sessions, int who) {
+    Bench::NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    std::istringstream noInput;
+    setOutputStream(&nullStream);
+    setInputStream(&noInput);
+
+    rusage before{}, after{};
+    getrusage(who, &before);
+    Allocations::Counter counter;
+
+    Work work;
+    while (next.fetch_add(1, std::memory_order_relaxed) < sessions) {
+        playSession(work);
+    }
+
+    getrusage(who, &after);
+    work.allocations = counter.elapsed().total().allocations;
+    work.voluntarySwitches = static_cast<uint64_t>(after.ru_nvcsw - before.ru_nvcsw);
+    work.involuntarySwitches = static_cast<uint64_t>(after.ru_nivcsw - before.ru_nivcsw);
+    setOutputStream(nullptr);
+    setInputStream(nullptr);
+    return work;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// M sessions on T threads of this process
+void runThreads(Round& round, size_t sessions) {
+    std::atomic<size_t> next{0};
+    std::vector<Work> work(round.threads);
+    std::latch ready(round.threads);
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < round.threads; ++t) {
+        threads.emplace_back([&, t]() {
+            ready.count_down();
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            work[t] = playShare(next, sessions, RUSAGE_THREAD);
+        });
+    }
+    ready.wait();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    round.seconds = secondsSince(start);
+    for (const auto& w : work) {
+        round.work.add(w);
+    }
+}
+
+// The same M sessions in T forked processes, M / T each.
+// Returns false if a child failed.
+bool runProcesses(Round& round, size_t sessions) {
+    std::fflush(stdout);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<pid_t> children;
+    for (unsigned p = 0; p < round.threads; ++p) {
+        size_t share = sessions / round.threads + (p < sessions % round.threads ? 1 : 0);
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::perror("fork");
+            return false;
+        }
+        if (pid == 0) {
+            std::atomic<size_t> next{0};
+            Work work = playShare(next, share, RUSAGE_SELF);
+            _exit(work.offRoute == 0 && work.sessions == share ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+    bool ok = true;
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    round.processSeconds = secondsSince(start);
+    return ok;
+}
+
+std::vector<unsigned> threadCounts(unsigned highest) {
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < highest; t *= 2) {
+        counts.push_back(t);
+    }
+    counts.push_back(highest);
+    return counts;
+}
+
+void printRounds(const std::vector<Round>& rounds, bool processes) {
+    double single = rounds.front().commandsPerSecond();
+    double singleProcess = rounds.front().processSeconds;
+    std::printf("%7s %12s %8s %6s %12s %10s %8s %9s", "threads", "cmds/s", "speedup", "eff",
+                "cmds/s/thr", "allocs/cmd", "vcsw/1k", "ivcsw/1k");
+    std::printf(processes ? " %9s\n" : "\n", "proc eff");
+    for (const auto& r : rounds) {
+        double speedup = single > 0 ? r.commandsPerSecond() / single : 0;
+        std::printf("%7u %12.0f %7.2fx %5.0f%% %12.0f %10.1f %8.2f %9.2f", r.threads,
+                    r.commandsPerSecond(), speedup, 100.0 * speedup / r.threads,
+                    r.commandsPerSecond() / r.threads, r.perCommand(r.work.allocations),
+                    r.perCommand(r.work.voluntarySwitches, 1000),
+                    r.perCommand(r.work.involuntarySwitches, 1000));
+        if (processes) {
+            double processSpeedup = r.processSeconds > 0 ? singleProcess / r.processSeconds : 0;
+            std::printf(" %8.0f%%", 100.0 * processSpeedup / r.threads);
+        }
+        std::printf("\n");
+    }
+}
+
+int usage() {
+    std::fprintf(stderr, "usage: zork_sessions [--sessions M] [--threads N] [--no-processes]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t sessions = 64;
+    unsigned highest = std::max(1u, std::thread::hardware_concurrency());
+    bool processes = true;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--sessions") == 0 && hasValue) {
+            sessions = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            highest = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--no-processes") == 0) {
+            processes = false;
+        } else {
+            return usage();
+        }
+    }
+    if (sessions == 0 || highest == 0) {
+        return usage();
+    }
+
+    // Warm up (and check the route) on the main thread
+    {
+        std::atomic<size_t> next{0};
+        if (playShare(next, 1, RUSAGE_THREAD).offRoute) {
+            std::fprintf(stderr, "the walkthrough did not end with %d points\n", Walkthrough::SCORE);
+            return 2;
+        }
+    }
+
+    std::printf("%zu sessions of %zu commands per round, %u core%s\n\n", sessions,
+                std::size(Walkthrough::COMMANDS), std::thread::hardware_concurrency(),
+                std::thread::hardware_concurrency() == 1 ? "" : "s");
+
+    std::vector<Round> rounds;
+    for (unsigned threads : threadCounts(highest)) {
+        Round round;
+        round.threads = threads;
+        runThreads(round, sessions);
+        if (round.work.offRoute || round.work.sessions != sessions) {
+            std::fprintf(stderr, "%u threads: %llu of %llu sessions did not end with %d points\n",
+                         threads, static_cast<unsigned long long>(round.work.offRoute),
+                         static_cast<unsigned long long>(round.work.sessions), Walkthrough::SCORE);
+            return 2;
+        }
+        if (processes && !runProcesses(round, sessions)) {
+            std::fprintf(stderr, "%u processes: a session did not end with %d points\n", threads,
+                         Walkthrough::SCORE);
+            return 2;
+        }
+        rounds.push_back(round);
+    }
+    printRounds(rounds, processes);
+    return 0;
+}
@@ -0,0 +1,330 @@
+// Zork Walkthrough - whole-game benchmark of the turn loop
+//
+// Usage:
+//   zork_walkthrough [options]
+//
+//   Plays bench/walkthrough.h from a new game, command by command through
+//   Engine::step() (parse, dispatch, timers, NPCs, combat and output), and
+//   repeats it. Every turn is timed and its heap allocations counted. The
+//   whole run is done twice: with output discarded ("null") and with
+//   output captured in a string ("capture"), so the cost of producing the
+//   text can be told apart from the cost of printing it.
+//
+//   Allocations per turn are also broken down by command class (the
+//   command's first word; directions count as "walk") and by the
+//   subsystem that made them (systems/allocations.h), for the null sink.
+//   Where the hardware counters can be read (counters.h), each turn is
+//   also counted, for instructions per cycle and cache and branch misses
+//   per turn.
+//
+// Options:
+//   --repeat N          playthroughs per output sink (default 100)
+//   --json FILE         write the per-turn latencies as JSON
+//   --baseline FILE     compare median turn latency with a JSON file from
+//                       an earlier run
+//   --threshold PCT     with --baseline, fail if a median is more than PCT
+//                       percent slower (default 10)
+//   --metrics           record Metrics while playing (to measure their
+//                       overhead) and print the slowest verbs
+//
+// Exit status: 0, 1 if a sink regressed against the baseline, 2 on usage
+// errors or if the walkthrough did not reach its score.
+//
+// Build with -DBUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release.
+
+#include "bench.h"
+#include "walkthrough.h"
+#include "core/engine.h"
+#include "core/io.h"
+#include "systems/allocation_hook.h"
+#include "systems/metrics.h"
+#include "systems/score.h"
+#include <cstring>
+#include <ctime>
+#include <set>
+#include <sys/resource.h>
+
+#ifndef ZORK_BENCH_BUILD_TYPE
+#define ZORK_BENCH_BUILD_TYPE ""
+#endif
+
+namespace {
+
+// Allocations of the turns of one command class
+struct ClassAllocations {
+    uint64_t turns = 0;
+    Allocations::Tally tally;
+};
+
+using ClassTable = std::map<std::string, ClassAllocations>;
+
+// A command's class: its first word, with directions counted as "walk"
+std::string commandClass(std::string_view command) {
+    static const std::set<std::string, std::less<>> directions = {
+        "north", "south", "east", "west", "northeast", "northwest", "southeast",
+        "southwest", "up", "down", "n", "s", "e", "w", "ne", "nw", "se", "sw", "u", "d"};
+    std::string_view word = command.substr(0, command.find(' '));
+    return directions.contains(word) ? "walk" : std::string(word);
+}
+
+// One output sink's playthroughs
+struct SinkResult {
+    Bench::Result turns;    // nanoseconds per turn
+    double seconds = 0;     // total time inside Engine::step()
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    ClassTable classes;     // allocations by command class
+    size_t outputBytes = 0; // text printed by one playthrough
+
+    double turnsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(turns.samples) / seconds : 0;
+    }
+    double perTurn(uint64_t total) const {
+        return turns.samples ? static_cast<double>(total) / static_cast<double>(turns.samples) : 0;
+    }
+};
+
+// Play the walkthrough once; appends each turn's latency to samples, its
+// hardware counts to counted and its allocations to classes. Returns false
+// if it did not end with the expected score.
+bool playthrough(const Bench::Counters& counters, std::vector<double>& samples,
+                 Bench::CounterSample& counted, ClassTable& classes) {
+    using Clock = std::chrono::steady_clock;
+    Engine::newGame(Walkthrough::SEED);
+    for (const char* command : Walkthrough::COMMANDS) {
+        Allocations::Counter counter;
+        Bench::CounterSample before = counters.read();
+        auto start = Clock::now();
+        StepResult result = Engine::step(command);
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        counted += counters.read() - before;
+        ClassAllocations& c = classes[commandClass(command)];
+        c.turns++;
+        c.tally += counter.elapsed();
+        samples.push_back(static_cast<double>(ns));
+        Bench::keep(result);
+    }
+    return ScoreSystem::instance().getScore() == Walkthrough::SCORE;
+}
+
+// Play the walkthrough repeat times with output going to out (after one
+// untimed playthrough to warm up)
+bool runSink(const std::string& name, std::ostream& out, std::ostringstream* capture,
+             unsigned repeat, const Bench::Counters& counters, SinkResult& result) {
+    setOutputStream(&out);
+    std::vector<double> samples;
+    Bench::CounterSample counted;
+    bool onRoute = playthrough(counters, samples, counted, result.classes);
+
+    samples.clear();
+    counted = Bench::CounterSample();
+    result.classes.clear();
+    for (unsigned i = 0; i < repeat && onRoute; ++i) {
+        if (capture) {
+            capture->str("");
+        }
+        onRoute = playthrough(counters, samples, counted, result.classes);
+    }
+    setOutputStream(nullptr);
+    if (!onRoute) {
+        std::fprintf(stderr, "%s: the walkthrough ended with %d points instead of %d\n",
+                     name.c_str(), ScoreSystem::instance().getScore(), Walkthrough::SCORE);
+        return false;
+    }
+
+    for (double ns : samples) {
+        result.seconds += ns / 1e9;
+    }
+    result.turns = Bench::summarize("Walkthrough/" + name, std::move(samples), 0);
+    result.turns.iterations = result.turns.samples;
+    result.turns.counters = counted;
+    for (const auto& [name, c] : result.classes) {
+        Allocations::Counts total = c.tally.total();
+        result.allocations += total.allocations;
+        result.allocatedBytes += total.bytes;
+    }
+    result.outputBytes = capture ? capture->str().size() : 0;
+    return true;
+}
+
+// Peak resident set size of this process in KiB
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void printResults(const std::vector<SinkResult>& sinks) {
+    std::printf("%-24s %10s %9s %9s %9s %12s %12s\n", "sink", "turns/s", "p50 us", "p99 us",
+                "p999 us", "allocs/turn", "bytes/turn");
+    for (const auto& s : sinks) {
+        std::printf("%-24s %10.0f %9.2f %9.2f %9.2f %12.1f %12.1f\n", s.turns.name.c_str(),
+                    s.turnsPerSecond(), s.turns.p50 / 1e3, s.turns.p99 / 1e3, s.turns.p999 / 1e3,
+                    s.perTurn(s.allocations), s.perTurn(s.allocatedBytes));
+    }
+
+    if (!sinks.empty() && sinks[0].turns.counters.has(Bench::Event::CYCLES)) {
+        std::printf("\n%-24s%s  (per turn)\n", "sink", Bench::counterHeadings().c_str());
+        for (const auto& s : sinks) {
+            std::printf("%-24s%s\n", s.turns.name.c_str(),
+                        Bench::counterColumns(s.turns.counters, static_cast<double>(s.turns.samples))
+                            .c_str());
+        }
+    } else {
+        std::printf("\n(hardware counters unavailable: wall time only)\n");
+    }
+}
+
+// Allocations per turn of each command class, by subsystem
+void printClassAllocations(const ClassTable& classes) {
+    std::printf("\n%-12s %6s %12s %12s", "class", "turns", "allocs/turn", "bytes/turn");
+    for (size_t i = 0; i < Allocations::SUBSYSTEMS; ++i) {
+        std::printf(" %8s", std::string(Allocations::subsystemName(
+                                 static_cast<Allocations::Subsystem>(i))).c_str());
+    }
+    std::printf("\n");
+    for (const auto& [name, c] : classes) {
+        double turns = static_cast<double>(c.turns);
+        Allocations::Counts total = c.tally.total();
+        std::printf("%-12s %6llu %12.1f %12.1f", name.c_str(),
+                    static_cast<unsigned long long>(c.turns),
+                    static_cast<double>(total.allocations) / turns,
+                    static_cast<double>(total.bytes) / turns);
+        for (const auto& counts : c.tally.bySubsystem) {
+            std::printf(" %8.1f", static_cast<double>(counts.allocations) / turns);
+        }
+        std::printf("\n");
+    }
+}
+
+// Verbs by estimated total time spent in their handlers (calls times the
+// mean of the sampled ones)
+void printSlowestVerbs(const Metrics::Snapshot& metrics) {
+    std::vector<std::pair<std::string, const Metrics::Timing*>> verbs;
+    for (const auto& [name, timing] : metrics.verbs) {
+        verbs.emplace_back(name, &timing);
+    }
+    auto total = [](const Metrics::Timing* t) { return t->latency.mean() * static_cast<double>(t->calls); };
+    std::sort(verbs.begin(), verbs.end(), [&](const auto& a, const auto& b) {
+        return total(a.second) > total(b.second);
+    });
+    std::printf("\n%-16s %10s %10s %10s %10s\n", "verb", "calls", "total ms", "p50 us", "p99 us");
+    for (size_t i = 0; i < verbs.size() && i < 10; ++i) {
+        const Metrics::Timing& t = *verbs[i].second;
+        std::printf("%-16s %10llu %10.2f %10.2f %10.2f\n", verbs[i].first.c_str(),
+                    static_cast<unsigned long long>(t.calls), total(&t) / 1e6,
+                    static_cast<double>(t.latency.percentile(0.50)) / 1e3,
+                    static_cast<double>(t.latency.percentile(0.99)) / 1e3);
+    }
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_walkthrough [--repeat N] [--json FILE]\n"
+                 "                        [--baseline FILE [--threshold PCT]] [--metrics]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned repeat = 100;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--repeat") == 0 && hasValue) {
+            repeat = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--threshold") == 0 && hasValue) {
+            threshold = std::stod(argv[++i]);
+        } else if (std::strcmp(arg, "--metrics") == 0) {
+            Metrics::setEnabled(true);
+        } else {
+            return usage();
+        }
+    }
+    if (repeat == 0) {
+        return usage();
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty()) {
+        std::ifstream in(baselinePath);
+        if (!in) {
+            std::fprintf(stderr, "Cannot open %s\n", baselinePath.c_str());
+            return 2;
+        }
+        baseline = Bench::readBaseline(in);
+    }
+
+    Bench::NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    std::ostringstream capture;
+
+    Bench::Counters counters;
+    std::vector<SinkResult> sinks(2);
+    if (!runSink("null", nullStream, nullptr, repeat, counters, sinks[0]) ||
+        !runSink("capture", capture, &capture, repeat, counters, sinks[1])) {
+        return 2;
+    }
+    long rss = peakRssKb();
+
+    constexpr size_t commands = std::size(Walkthrough::COMMANDS);
+    std::printf("Walkthrough: %zu commands, %d points, %u playthroughs per sink\n\n", commands,
+                Walkthrough::SCORE, repeat);
+    printResults(sinks);
+    std::printf("\noutput per playthrough: %zu bytes\n", sinks[1].outputBytes);
+    std::printf("peak RSS: %ld KiB\n", rss);
+    printClassAllocations(sinks[0].classes);
+    if (Metrics::enabled()) {
+        printSlowestVerbs(Metrics::snapshot());
+    }
+
+    if (!jsonPath.empty()) {
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        std::map<std::string, std::string> context = {
+            {"date", date},
+            {"build_type", ZORK_BENCH_BUILD_TYPE},
+            {"commands", std::to_string(commands)},
+            {"playthroughs", std::to_string(repeat)},
+            {"peak_rss_kb", std::to_string(rss)},
+#ifdef __VERSION__
+            {"compiler", __VERSION__},
+#endif
+        };
+        std::vector<Bench::Result> results;
+        for (const auto& s : sinks) {
+            char value[32];
+            std::snprintf(value, sizeof(value), "%.1f", s.perTurn(s.allocations));
+            context[s.turns.name + " allocs_per_turn"] = value;
+            results.push_back(s.turns);
+        }
+        std::ofstream out(jsonPath);
+        Bench::writeJson(results, context, out);
+        if (!out) {
+            std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+            return 2;
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        std::printf("\n");
+        std::vector<Bench::Result> results = {sinks[0].turns, sinks[1].turns};
+        auto regressions = Bench::compare(results, baseline, threshold);
+        if (!regressions.empty()) {
+            std::printf("\n%zu sink(s) more than %.1f%% slower than %s\n", regressions.size(),
+                        threshold, baselinePath.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
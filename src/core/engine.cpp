@@ -0,0 +1,360 @@
+#include "engine.h"
+#include "globals.h"
+#include "io.h"
+#include "object.h"
+#include "random.h"
+#include "parser/parser.h"
+#include "systems/allocations.h"
+#include "systems/candle.h"
+#include "systems/death.h"
+#include "systems/lamp.h"
+#include "systems/metrics.h"
+#include "systems/npc.h"
+#include "systems/score.h"
+#include "systems/slow_turns.h"
+#include "systems/state_hash.h"
+#include "systems/sword.h"
+#include "systems/timer.h"
+#include "systems/trace.h"
+#include "systems/undo.h"
+#include "verbs/verbs.h"
+#include "world/world.h"
+#include <functional>
+#include <map>
+#include <sstream>
+
+namespace {
+
+// Verb dispatch table
+const std::map<VerbId, std::function<bool()>> verbHandlers = {
+    {V_LOOK, Verbs::vLook},
+    {V_INVENTORY, Verbs::vInventory},
+    {V_QUIT, Verbs::vQuit},
+    {V_RAISE, Verbs::vRaise},
+    {V_MAKE, Verbs::vMake},
+    {V_WIND, Verbs::vWind},
+    {V_TAKE, Verbs::vTake},
+    {V_DROP, Verbs::vDrop},
+    {V_EXAMINE, Verbs::vExamine},
+    {V_READ, Verbs::vRead},
+    {V_OPEN, Verbs::vOpen},
+    {V_CLOSE, Verbs::vClose},
+    {V_WALK, Verbs::vWalk},
+    {V_PUT, Verbs::vPut},
+    {V_LOCK, Verbs::vLock},
+    {V_UNLOCK, Verbs::vUnlock},
+    {V_LOOK_INSIDE, Verbs::vLookInside},
+    {V_SEARCH, Verbs::vSearch},
+    {V_ENTER, Verbs::vEnter},
+    {V_EXIT, Verbs::vExit},
+    {V_CLIMB_UP, Verbs::vClimbUp},
+    {V_CLIMB_DOWN, Verbs::vClimbDown},
+    {V_BOARD, Verbs::vBoard},
+    {V_DISEMBARK, Verbs::vDisembark},
+    {V_TURN, Verbs::vTurn},
+    {V_PUSH, Verbs::vPush},
+    {V_PULL, Verbs::vPull},
+    {V_MOVE, Verbs::vMove},
+    {V_TIE, Verbs::vTie},
+    {V_UNTIE, Verbs::vUntie},
+    {V_LISTEN, Verbs::vListen},
+    {V_SMELL, Verbs::vSmell},
+    {V_TOUCH, Verbs::vTouch},
+    {V_YELL, Verbs::vYell},
+    {V_EAT, Verbs::vEat},
+    {V_DRINK, Verbs::vDrink},
+    {V_LAMP_ON, Verbs::vLampOn},
+    {V_LAMP_OFF, Verbs::vLampOff},
+    {V_INFLATE, Verbs::vInflate},
+    {V_DEFLATE, Verbs::vDeflate},
+    {V_PRAY, Verbs::vPray},
+    {V_EXORCISE, Verbs::vExorcise},
+    {V_WAVE, Verbs::vWave},
+    {V_RUB, Verbs::vRub},
+    {V_RING, Verbs::vRing},
+    {V_ATTACK, Verbs::vAttack},
+    {V_KILL, Verbs::vKill},
+    {V_THROW, Verbs::vThrow},
+    {V_SWING, Verbs::vSwing},
+    {V_SCORE, Verbs::vScore},
+    {V_DIAGNOSE, Verbs::vDiagnose},
+    {V_VERBOSE, Verbs::vVerbose},
+    {V_BRIEF, Verbs::vBrief},
+    {V_SUPERBRIEF, Verbs::vSuperbrief},
+    {V_SAVE, Verbs::vSave},
+    {V_RESTORE, Verbs::vRestore},
+    {V_RESTART, Verbs::vRestart},
+    {V_VERSION, Verbs::vVersion},
+    {V_TALK, Verbs::vTalk},
+    {V_ASK, Verbs::vAsk},
+    {V_TELL, Verbs::vTell},
+    {V_ODYSSEUS, Verbs::vOdysseus},
+    // Easter eggs / special words
+    {V_HELLO, Verbs::vHello},
+    {V_ZORK, Verbs::vZork},
+    {V_PLUGH, Verbs::vPlugh},
+    {V_FROBOZZ, Verbs::vFrobozz},
+    // Additional common verbs
+    {V_WAIT, Verbs::vWait},
+    {V_SWIM, Verbs::vSwim},
+    {V_BACK, Verbs::vBack},
+    {V_JUMP, Verbs::vJump},
+    {V_CURSE, Verbs::vCurse}};
+
+// Nesting depth of tryStep()/trySequence()
+thread_local int dryRunDepth = 0;
+
+// Redirects game output/input for a dry run and restores them on exit
+class DryRunScope {
+public:
+    DryRunScope()
+        : column_(getOutputColumn()),
+          oldOut_(&outputStream()),
+          oldIn_(&inputStream()),
+          parserMemory_(getGlobalParser().saveMemory()) {
+        setOutputStream(&output_);
+        setInputStream(&input_);
+        UndoSystem::UndoJournal::instance().pushCheckpoint();
+        dryRunDepth++;
+    }
+
+    ~DryRunScope() {
+        UndoSystem::UndoJournal::instance().rollbackToCheckpoint();
+        dryRunDepth--;
+        setOutputStream(oldOut_);
+        setInputStream(oldIn_);
+        setOutputColumn(column_);
+        getGlobalParser().restoreMemory(parserMemory_);
+    }
+
+    DryRunScope(const DryRunScope&) = delete;
+    DryRunScope& operator=(const DryRunScope&) = delete;
+
+    // Return the text printed since the last call
+    std::string takeOutput() {
+        std::string text = output_.str();
+        output_.str("");
+        return text;
+    }
+
+private:
+    std::ostringstream output_;
+    std::istringstream input_;
+    int column_;
+    std::ostream* oldOut_;
+    std::istream* oldIn_;
+    Parser::Memory parserMemory_;
+};
+
+ObjectId currentRoomId() {
+    ZObject* here = Globals::instance().here;
+    return here ? here->getId() : 0;
+}
+
+} // namespace
+
+void Engine::initialize() {
+    initializeWorld();
+    NPCSystem::initializeThief();
+    NPCSystem::initializeTroll();
+    NPCSystem::initializeCyclops();
+    LampSystem::initialize();   // Initialize lamp timer (Requirement 47)
+    CandleSystem::initialize(); // Initialize candle timer (Requirement 48)
+    SwordSystem::initialize();  // Initialize sword glow timer (Requirement 49)
+}
+
+void Engine::newGame(uint32_t seed) {
+    Globals::instance().reset();
+    ScoreSystem::instance().reset();
+    getGlobalParser().restoreMemory(Parser::Memory{}); // forget "it" and half-typed commands
+    Random::seed(seed);
+    initialize();
+    SlowTurns::newGame(seed);
+}
+
+StepResult Engine::step(std::string_view input) {
+    return run(input);
+}
+
+StepResult Engine::tryStep(std::string_view input) {
+    DryRunScope scope;
+    StepResult result = run(input);
+    result.output = scope.takeOutput();
+    return result;
+}
+
+std::vector<StepResult> Engine::trySequence(const std::vector<std::string>& commands) {
+    std::vector<StepResult> results;
+    results.reserve(commands.size());
+
+    DryRunScope scope;
+    for (const auto& command : commands) {
+        StepResult result = run(command);
+        result.output = scope.takeOutput();
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+bool Engine::isDryRun() {
+    return dryRunDepth > 0;
+}
+
+std::vector<Action> Engine::validActions(bool dropNoOps) {
+    std::vector<Action> actions = ActionEnumerator::enumerate();
+
+    // Verbs without a handler only print "not implemented"
+    std::erase_if(actions, [](const Action& action) {
+        return !action.isDirection && !verbHandlers.contains(action.verb);
+    });
+    if (!dropNoOps) {
+        return actions;
+    }
+
+    uint64_t idle = tryStep("wait").stateHash;
+    std::erase_if(actions, [idle](const Action& action) {
+        StepResult result = tryStep(action.command);
+        return !result.tookTurn || result.stateHash == idle;
+    });
+    return actions;
+}
+
+StepResult Engine::run(std::string_view input) {
+    ZORK_TRACE_SCOPE("turn", input);
+    auto& score = ScoreSystem::instance();
+    int scoreBefore = score.getScore();
+    int deathsBefore = DeathSystem::getDeathCount();
+    bool deadBefore = DeathSystem::isDead();
+
+    StepResult result;
+    SlowTurns::beginTurn();
+    result.roomBefore = currentRoomId();
+    result.tookTurn = dispatch(input);
+    result.roomAfter = currentRoomId();
+    result.scoreDelta = score.getScore() - scoreBefore;
+    result.died = DeathSystem::getDeathCount() > deathsBefore ||
+                  (!deadBefore && DeathSystem::isDead());
+    result.stateHash = StateHash::current();
+    SlowTurns::endTurn(input);
+    Globals::instance().releaseScratch(); // the turn's temporaries
+    return result;
+}
+
+bool Engine::dispatch(std::string_view input) {
+    auto& g = Globals::instance();
+
+    // Trim whitespace (Requirement 72.5)
+    size_t start = input.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return false; // Empty or all whitespace (Requirement 72.1)
+    }
+    size_t end = input.find_last_not_of(" \t\r\n");
+    input = input.substr(start, end - start + 1);
+
+    // Handle very long input gracefully (Requirement 72.2)
+    if (input.length() > 1000) {
+        printLine("That command is too long.");
+        return false;
+    }
+
+    // Parse the command
+    uint64_t parseStart = Metrics::start();
+    ParsedCommand cmd = [input] {
+        Allocations::Scope scope(Allocations::Subsystem::PARSER);
+        return getGlobalParser().parse(input);
+    }();
+    uint64_t dispatchStart = Metrics::parsed(parseStart);
+    SlowTurns::mark(SlowTurns::Phase::PARSE);
+
+    // Handle parse errors (Requirement 73)
+    if (cmd.verb == 0) {
+        // Error message already printed by parser
+        return false;
+    }
+
+    // UNDO rolls back journaled turns rather than playing a new one
+    if (cmd.verb == V_UNDO) {
+        Verbs::vUndo();
+        return false;
+    }
+
+    // Journal every mutation made by this turn so it can be undone
+    UndoSystem::beginTurn();
+
+    // Set global state for verb handlers
+    g.prsa = cmd.verb;
+    g.prso = cmd.directObj;
+    g.prsi = cmd.indirectObj;
+
+    // Handle "all" commands
+    if (cmd.isAll) {
+        if (cmd.allObjects.empty()) {
+            printLine("There's nothing here to " + std::string(cmd.words[0]) + ".");
+            UndoSystem::endTurn();
+            return true;
+        }
+
+        // Execute verb for each object
+        for (auto* obj : cmd.allObjects) {
+            g.prso = obj;
+
+            // Display what we're doing (into a reused buffer: no allocation
+            // per object once warm)
+            static thread_local std::string label;
+            label.assign(obj->getDesc()).append(": ");
+            print(label);
+
+            ZORK_TRACE_SCOPE("verb handler", cmd.words[0]);
+            Allocations::Scope scope(Allocations::Subsystem::HANDLER);
+            if (auto it = verbHandlers.find(cmd.verb); it != verbHandlers.end()) {
+                it->second();
+            } else {
+                printLine("That verb is not implemented yet.");
+            }
+        }
+        Metrics::dispatched(cmd.verb, dispatchStart);
+        SlowTurns::mark(SlowTurns::Phase::HANDLER);
+
+        g.moves++;
+        UndoSystem::endTurn();
+        return true;
+    }
+
+    // Handle direction commands
+    {
+        ZORK_TRACE_SCOPE("verb handler", cmd.words[0]);
+        Allocations::Scope scope(Allocations::Subsystem::HANDLER);
+        if (cmd.isDirection) {
+            Verbs::vWalkDir(cmd.direction);
+        } else if (auto it = verbHandlers.find(cmd.verb); it != verbHandlers.end()) {
+            it->second();
+        } else {
+            printLine("That verb is not implemented yet.");
+        }
+    }
+    Metrics::dispatched(cmd.verb, dispatchStart);
+    SlowTurns::mark(SlowTurns::Phase::HANDLER);
+
+    g.moves++;
+
+    // Process all timers (includes thief, troll, cyclops, lamp, etc.)
+    TimerSystem::tick();
+    SlowTurns::mark(SlowTurns::Phase::TIMERS);
+
+    // Process NPC actions that aren't timer-based
+    {
+        Allocations::Scope scope(Allocations::Subsystem::NPCS);
+        {
+            ZORK_TRACE_SCOPE("troll turn");
+            NPCSystem::processTrollTurn();
+        }
+        {
+            ZORK_TRACE_SCOPE("cyclops turn");
+            NPCSystem::processCyclopsTurn();
+        }
+    }
+    SlowTurns::mark(SlowTurns::Phase::NPCS);
+
+    UndoSystem::endTurn();
+    return true;
+}
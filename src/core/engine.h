@@ -0,0 +1,67 @@
+#pragma once
+#include "types.h"
+#include "parser/action_enumerator.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Game engine - the turn loop behind the interactive game
+//
+// step() plays one command exactly as typed at the "> " prompt: parse,
+// dispatch to the verb handler, advance the move counter, tick timers and
+// let the NPCs act. main() only reads input and hands it to step().
+//
+// tryStep() plays a command hypothetically. The turn is journaled by the
+// undo system and rolled back before returning, so the world (including
+// the random engine and the undo history) is exactly as it was. Output is
+// captured instead of printed and input is replaced by an empty stream, so
+// confirmation prompts inside the command are answered with "no".
+//
+// All game state is per thread: each thread plays its own game.
+
+// Outcome of one command
+struct StepResult {
+    std::string output;     // Text printed by the command (dry runs only)
+    int scoreDelta = 0;     // Change in ScoreSystem score
+    ObjectId roomBefore = 0;
+    ObjectId roomAfter = 0;
+    bool died = false;      // The player was killed during the command
+    bool tookTurn = false;  // False for empty input, parse errors and UNDO
+    uint64_t stateHash = 0; // StateHash::current() after the command
+
+    bool roomChanged() const { return roomBefore != roomAfter; }
+};
+
+class Engine {
+public:
+    // Build the world and start the NPC and light-source timers
+    static void initialize();
+
+    // Discard the current game and start a new one with the given seed
+    // (same seed + same commands = same game)
+    static void newGame(uint32_t seed);
+
+    // Play one command; output goes to outputStream() (std::cout by default)
+    static StepResult step(std::string_view input);
+
+    // Play one command and roll back everything it changed
+    static StepResult tryStep(std::string_view input);
+
+    // Play several commands in a row from the current state, then roll
+    // all of them back. Result i describes command i.
+    static std::vector<StepResult> trySequence(const std::vector<std::string>& commands);
+
+    // True while a tryStep()/trySequence() is running
+    static bool isDryRun();
+
+    // Commands worth trying in the current state: ActionEnumerator's
+    // candidates minus verbs the engine has no handler for. With
+    // dropNoOps, each candidate is also dry-run and dropped if it does
+    // not take a turn or leaves the same state as WAIT would.
+    static std::vector<Action> validActions(bool dropNoOps = false);
+
+private:
+    static StepResult run(std::string_view input);
+    static bool dispatch(std::string_view input);
+};
@@ -2,16 +2,33 @@
 #include "systems/combat.h"
 #include "systems/timer.h"
 #include "systems/death.h"
+#include "systems/light.h"
+#include "systems/undo.h"
 
 Globals& Globals::instance() {
-    static Globals inst;
+    static thread_local Globals inst;
     return inst;
 }
 
-void Globals::registerObject(ObjectId id, std::unique_ptr<ZObject> obj) {
+void Globals::registerObject(ObjectId id, ObjectPtr obj) {
     objects_[id] = std::move(obj);
 }
 
+void* Globals::ArenaUpstream::do_allocate(size_t bytes, size_t alignment) {
+    bytes_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void Globals::ArenaUpstream::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    bytes_ -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+void Globals::setHere(ZObject* room) {
+    here = room;
+    LightSystem::refresh();
+}
+
 ZObject* Globals::getObject(ObjectId id) {
     auto it = objects_.find(id);
     return it != objects_.end() ? it->second.get() : nullptr;
@@ -29,16 +46,25 @@ void Globals::reset() {
     // Reset death system
     DeathSystem::reset();
     
+    // Drop undo history (it points at the objects about to be destroyed)
+    UndoSystem::clear();
+    
+    // Destroy the world, then hand its arena back in one go
     objects_.clear();
+    arena_.release();
+    worldArenaBytes_ = 0;
     here = nullptr;
     winner = nullptr;
     player = nullptr;
     prso = nullptr;
     prsi = nullptr;
     prsa = 0;
+    it = nullptr;
     lit = false;
     score = 0;
     moves = 0;
+    loadMax = 100;
+    loadAllowed = 100;
     pCont = false;
     quoteFlag = false;
     lampBattery = 330;
@@ -52,6 +78,8 @@ void Globals::reset() {
     grunlock = false;       // Grate Unlocked
     waterLevel = 0;         // Maintenance Room water
     grateRevealed = false;  // Clearing Grating
+    matchCount = 5;
+    rainbowFlag = false;
     
     // Reset display modes to defaults (Requirement 65.5)
     verboseMode = true;
@@ -1,9 +1,29 @@
 #pragma once
 #include "object.h"
 #include "types.h"
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 
+/**
+ * @brief Owning pointer to a registered object
+ *
+ * Objects built in the world arena (Globals::makeObject) are destroyed
+ * but not freed; their memory goes back when the arena is released.
+ */
+struct ObjectDeleter {
+  bool inArena = false;
+  void operator()(ZObject *obj) const {
+    if (inArena) {
+      obj->~ZObject();
+    } else {
+      delete obj;
+    }
+  }
+};
+using ObjectPtr = std::unique_ptr<ZObject, ObjectDeleter>;
+
 /**
  * @brief Global game state singleton (mirrors ZIL global variables)
  *
@@ -14,7 +34,25 @@
  * - Display mode settings
  * - Object registry for all game entities
  *
- * Access via Globals::instance() singleton pattern.
+ * Access via Globals::instance() singleton pattern. The instance is
+ * per thread, as are the other game singletons and file-level state, so
+ * a thread that calls Engine::newGame() gets a world of its own.
+ *
+ * The world is built in a monotonic arena the session owns: makeObject()
+ * places an object there, and the object's strings, containers and exits
+ * follow it (ZObject). reset() destroys the objects and then releases the
+ * arena, so tearing a world down frees a chunk or two instead of every
+ * string and node, and a world's objects sit together in memory. What the
+ * arena holds is only reclaimed at reset(), so memory an object gives
+ * back during play (a grown contents vector, a removed property) stays
+ * allocated until then.
+ *
+ * Temporaries of a turn (the parser's word and candidate lists, a verb's
+ * or an NPC's candidates) come from a second, smaller arena: scratch()
+ * bumps through a buffer the session owns and Engine::step() releases it
+ * when the turn ends, so a warm turn's temporaries cost no heap
+ * allocations. Only a turn that overflows the buffer takes more from the
+ * heap, given back at the same time.
  *
  * @see ZIL equivalent: GGLOBALS.ZIL global variables
  */
@@ -33,8 +71,11 @@ public:
   VerbId prsa = 0; ///< Parser Result Subject Action - current verb (ZIL: ,PRSA)
   ZObject *it = nullptr; ///< Last referenced object (ZIL: ,P-IT-OBJECT)
 
+  // Move HERE, keeping lit in step (ZIL's GOTO sets both)
+  void setHere(ZObject *room);
+
   // Game state
-  bool lit = false; // Is current room lit?
+  bool lit = false; // Is current room lit? (kept by LightSystem::refresh)
   int score = 0;
   int moves = 0;
   int loadMax = 100;
@@ -69,17 +110,70 @@ public:
   bool quoteFlag = false;
 
   // Object registry - using unordered_map for O(1) lookup
-  void registerObject(ObjectId id, std::unique_ptr<ZObject> obj);
+  void registerObject(ObjectId id, ObjectPtr obj);
+  void registerObject(ObjectId id, std::unique_ptr<ZObject> obj) {
+    registerObject(id, ObjectPtr(obj.release()));
+  }
   ZObject *getObject(ObjectId id);
-  const std::unordered_map<ObjectId, std::unique_ptr<ZObject>> &
-  getAllObjects() const {
+  const std::unordered_map<ObjectId, ObjectPtr> &getAllObjects() const {
     return objects_;
   }
 
+  // World memory: construct a T in the world arena (or on the heap with
+  // the arena off), passing it the memory resource as its last argument
+  template <typename T, typename... Args>
+  std::unique_ptr<T, ObjectDeleter> makeObject(Args &&...args);
+  // Off builds worlds on the global heap (for comparison); affects the
+  // objects made from then on
+  void setWorldArena(bool enabled) { worldArena_ = enabled; }
+  // Bytes the arena has taken from the heap for this world
+  size_t worldArenaBytes() const { return worldArenaBytes_; }
+  // The arena's first chunk: a new game's world fits in it
+  static constexpr size_t WORLD_ARENA_BYTES = 320 * 1024;
+
+  // Turn memory: for temporaries that do not outlive the turn
+  std::pmr::memory_resource *scratch() { return &scratch_; }
+  // Forget all turn memory (end of turn); what used it must be gone
+  void releaseScratch() { scratch_.release(); }
+  // The scratch buffer: a turn's temporaries fit in it
+  static constexpr size_t SCRATCH_BYTES = 16 * 1024;
+
   // Reset for testing
   void reset();
 
 private:
+  // Upstream of the arena: counts what it takes
+  class ArenaUpstream : public std::pmr::memory_resource {
+  public:
+    explicit ArenaUpstream(size_t &bytes) : bytes_(bytes) {}
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+    size_t &bytes_;
+  };
+
   Globals() = default;
-  std::unordered_map<ObjectId, std::unique_ptr<ZObject>> objects_;
+  bool worldArena_ = true;
+  size_t worldArenaBytes_ = 0;
+  ArenaUpstream arenaUpstream_{worldArenaBytes_};
+  // Declared before the registry, so it outlives the objects in it
+  std::pmr::monotonic_buffer_resource arena_{WORLD_ARENA_BYTES, &arenaUpstream_};
+  std::unordered_map<ObjectId, ObjectPtr> objects_;
+  alignas(std::max_align_t) std::byte scratchBuffer_[SCRATCH_BYTES];
+  std::pmr::monotonic_buffer_resource scratch_{scratchBuffer_, SCRATCH_BYTES};
 };
+
+template <typename T, typename... Args>
+std::unique_ptr<T, ObjectDeleter> Globals::makeObject(Args &&...args) {
+  if (!worldArena_) {
+    return std::unique_ptr<T, ObjectDeleter>(
+        new T(std::forward<Args>(args)..., std::pmr::new_delete_resource()));
+  }
+  void *memory = arena_.allocate(sizeof(T), alignof(T));
+  return std::unique_ptr<T, ObjectDeleter>(
+      new (memory) T(std::forward<Args>(args)..., &arena_), ObjectDeleter{true});
+}
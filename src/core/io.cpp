@@ -1,11 +1,24 @@
 #include "io.h"
 #include "object.h"
+#include "systems/allocations.h"
 #include <iostream>
 #include <sstream>
 #include <string>
 
 // Track current column position for word wrapping
-static int currentColumn = 0;
+static thread_local int currentColumn = 0;
+
+// Redirected streams for this thread (nullptr = std::cout/std::cin)
+static thread_local std::ostream* currentOutput = nullptr;
+static thread_local std::istream* currentInput = nullptr;
+
+std::ostream& outputStream() { return currentOutput ? *currentOutput : std::cout; }
+
+std::istream& inputStream() { return currentInput ? *currentInput : std::cin; }
+
+void setOutputStream(std::ostream* out) { currentOutput = out; }
+
+void setInputStream(std::istream* in) { currentInput = in; }
 
 void printDesc(const ZObject *obj) {
   if (obj) {
@@ -13,7 +26,14 @@ void printDesc(const ZObject *obj) {
   }
 }
 
+int getOutputColumn() { return currentColumn; }
+
+void setOutputColumn(int column) { currentColumn = column; }
+
 void print(std::string_view str) {
+  Allocations::Scope scope(Allocations::Subsystem::OUTPUT);
+  std::ostream& out = outputStream();
+
   // Process string character by character, preserving explicit newlines
   // while still doing word wrapping for long lines
   std::string word;
@@ -26,33 +46,33 @@ void print(std::string_view str) {
       if (!word.empty()) {
         if (currentColumn > 0 &&
             currentColumn + word.length() + 1 > WRAP_WIDTH) {
-          std::cout << '\n';
+          out << '\n';
           currentColumn = 0;
         }
         if (currentColumn > 0) {
-          std::cout << ' ';
+          out << ' ';
           currentColumn++;
         }
-        std::cout << word;
+        out << word;
         currentColumn += word.length();
         word.clear();
       }
       // Output the newline
-      std::cout << '\n';
+      out << '\n';
       currentColumn = 0;
     } else if (c == ' ' || c == '\t') {
       // End of word - output it
       if (!word.empty()) {
         if (currentColumn > 0 &&
             currentColumn + word.length() + 1 > WRAP_WIDTH) {
-          std::cout << '\n';
+          out << '\n';
           currentColumn = 0;
         }
         if (currentColumn > 0) {
-          std::cout << ' ';
+          out << ' ';
           currentColumn++;
         }
-        std::cout << word;
+        out << word;
         currentColumn += word.length();
         word.clear();
       }
@@ -65,7 +85,7 @@ void print(std::string_view str) {
   // Output any remaining word
   if (!word.empty()) {
     if (currentColumn > 0 && currentColumn + word.length() + 1 > WRAP_WIDTH) {
-      std::cout << '\n';
+      out << '\n';
       currentColumn = 0;
     }
     // Don't add space before punctuation
@@ -74,17 +94,18 @@ void print(std::string_view str) {
                            word[0] == '?' || word[0] == ':' || word[0] == ';' ||
                            word[0] == ')' || word[0] == ']'));
     if (currentColumn > 0 && !isPunctuation) {
-      std::cout << ' ';
+      out << ' ';
       currentColumn++;
     }
-    std::cout << word;
+    out << word;
     currentColumn += word.length();
   }
 }
 
 void printLine(std::string_view str) {
+  Allocations::Scope scope(Allocations::Subsystem::OUTPUT);
   print(str);
-  std::cout << std::endl;
+  outputStream() << std::endl;
   currentColumn = 0;
 }
 
@@ -92,14 +113,15 @@ std::string readLine() {
   std::string line;
 
   // Handle EOF gracefully (Requirement 72.4)
-  if (!std::getline(std::cin, line)) {
-    if (std::cin.eof()) {
+  std::istream& in = inputStream();
+  if (!std::getline(in, line)) {
+    if (in.eof()) {
       // EOF encountered (Ctrl+D on Unix, Ctrl+Z on Windows)
       // Return empty string to signal end
       return "";
     }
     // Other input error
-    std::cin.clear();
+    in.clear();
     return "";
   }
 
@@ -10,11 +10,22 @@ constexpr int WRAP_WIDTH = 80;
 void print(std::string_view str);
 void printLine(std::string_view str);
 
+// Streams used by print()/readLine() on the calling thread (std::cout and
+// std::cin unless redirected); pass nullptr to restore the default
+std::ostream& outputStream();
+std::istream& inputStream();
+void setOutputStream(std::ostream* out);
+void setInputStream(std::istream* in);
+
 inline void crlf() {
-    std::cout << std::endl;
+    outputStream() << std::endl;
 }
 
 void printDesc(const class ZObject* obj);
 
+// Current output column used for word wrapping
+int getOutputColumn();
+void setOutputColumn(int column);
+
 // Input functions
 std::string readLine();
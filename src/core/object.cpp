@@ -1,24 +1,138 @@
 #include "object.h"
+#include "systems/footprint.h"
+#include "systems/light.h"
+#include "systems/metrics.h"
+#include "systems/state_hash.h"
+#include "systems/undo.h"
+#include "world/objects.h"
 #include <algorithm>
 
-ZObject::ZObject(ObjectId id, std::string_view desc)
-    : id_(id), desc_(desc) {}
+namespace {
+
+constexpr uint64_t bit(ObjectFlag flag) {
+    return static_cast<uint64_t>(flag);
+}
+
+// A container's contents can be seen when it is open or transparent, and
+// reached when it is open (ZIL's SEE-INSIDE? and ACCESSIBLE?)
+bool contentsShown(uint64_t flags) {
+    return (flags & bit(ObjectFlag::CONTBIT)) &&
+           (flags & (bit(ObjectFlag::OPENBIT) | bit(ObjectFlag::TRANSBIT)));
+}
+
+bool contentsOpen(uint64_t flags) {
+    return (flags & bit(ObjectFlag::CONTBIT)) && (flags & bit(ObjectFlag::OPENBIT));
+}
+
+bool givesLight(uint64_t flags) {
+    constexpr uint64_t LIT = bit(ObjectFlag::LIGHTBIT) | bit(ObjectFlag::ONBIT);
+    return (flags & LIT) == LIT;
+}
+
+} // namespace
+
+ZObject::ZObject(ObjectId id, std::string_view desc, std::pmr::memory_resource* memory)
+    : id_(id), desc_(desc, memory), synonyms_(memory), adjectives_(memory),
+      synonymSet_(memory), adjectiveSet_(memory), text_(memory),
+      longDesc_(memory) {}
+
+ZObject::~ZObject() {
+    // Detach from the containment tree so no container keeps a dangling
+    // pointer (registering a second object under an id destroys the first)
+    addWeightToLocations(-getWeight());
+    if (givesLight(flags_) && seenFrom_) {
+        seenFrom_->lightSources_--;
+    }
+    unlink();
+    for (ZObject* child : getContents()) {
+        child->location_ = nullptr;
+        child->nextSibling_ = nullptr;
+        child->prevSibling_ = nullptr;
+        child->updateLocationKey();
+        child->updateScope();
+    }
+
+    // Take this object's keys out of the state hash (the location may
+    // already be destroyed, hence the cached key)
+    StateHash::toggle(locationKey_);
+    StateHash::toggle(StateHash::flagsKey(id_, flags_));
+    for (const auto& [prop, value] : properties_) {
+        StateHash::toggle(StateHash::propertyKey(id_, prop, value));
+    }
+}
 
 void ZObject::setProperty(PropertyId prop, int value) {
-    properties_[prop] = value;
+    if (!PropertyTable::valid(prop)) {
+        return; // no slot for it
+    }
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordProperty(this, prop);
+    }
+    if (prop == P_SIZE) {
+        addWeightToLocations(value - properties_.get(prop));
+    }
+    if (properties_.contains(prop)) {
+        StateHash::toggle(StateHash::propertyKey(id_, prop, properties_.get(prop)));
+    }
+    properties_.set(prop, value);
+    StateHash::toggle(StateHash::propertyKey(id_, prop, value));
 }
 
 int ZObject::getProperty(PropertyId prop) const {
-    auto it = properties_.find(prop);
-    return it != properties_.end() ? it->second : 0;
+    return properties_.get(prop);
+}
+
+void ZObject::removeProperty(PropertyId prop) {
+    if (!properties_.contains(prop)) {
+        return;
+    }
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordProperty(this, prop);
+    }
+    if (prop == P_SIZE) {
+        addWeightToLocations(-properties_.get(prop));
+    }
+    StateHash::toggle(StateHash::propertyKey(id_, prop, properties_.get(prop)));
+    properties_.erase(prop);
 }
 
 void ZObject::setFlag(ObjectFlag flag) {
-    flags_ |= static_cast<uint32_t>(flag);
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordFlags(this);
+    }
+    setFlagWord(flags_ | static_cast<uint32_t>(flag));
 }
 
 void ZObject::clearFlag(ObjectFlag flag) {
-    flags_ &= ~static_cast<uint32_t>(flag);
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordFlags(this);
+    }
+    setFlagWord(flags_ & ~static_cast<uint32_t>(flag));
+}
+
+void ZObject::setAllFlags(uint32_t flags) {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordFlags(this);
+    }
+    setFlagWord(flags);
+}
+
+void ZObject::setFlagWord(uint64_t flags) {
+    StateHash::toggle(StateHash::flagsKey(id_, flags_) ^ StateHash::flagsKey(id_, flags));
+    bool scopeChanges = contentsShown(flags_) != contentsShown(flags) ||
+                        contentsOpen(flags_) != contentsOpen(flags);
+    bool lightChanges = givesLight(flags_) != givesLight(flags);
+    bool onChanges = ((flags_ ^ flags) & bit(ObjectFlag::ONBIT)) != 0; // a room's own light
+    flags_ = flags;
+    if (lightChanges && seenFrom_) {
+        seenFrom_->lightSources_ += givesLight(flags_) ? 1 : -1;
+    }
+    if (scopeChanges) {
+        updateContentsScope();
+    }
+    if (scopeChanges || lightChanges || onChanges) {
+        LightSystem::refresh();
+    }
 }
 
 bool ZObject::hasFlag(ObjectFlag flag) const {
@@ -31,17 +145,149 @@ void ZObject::moveTo(ZObject* location) {
         return;
     }
     
-    // Remove from current location
-    if (location_) {
-        auto& contents = location_->contents_;
-        contents.erase(std::remove(contents.begin(), contents.end(), this), contents.end());
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordLocation(this);
     }
     
-    // Add to new location
+    // Remove from current location, add last to the new one
+    int weight = getWeight();
+    addWeightToLocations(-weight);
+    unlink();
     location_ = location;
     if (location_) {
-        location_->contents_.push_back(this);
+        linkAfter(location_->lastChild_);
     }
+    addWeightToLocations(weight);
+    updateLocationKey();
+    updateScope();
+    LightSystem::refresh();
+}
+
+void ZObject::restoreLocation(ZObject* location, size_t position) {
+    int weight = getWeight();
+    addWeightToLocations(-weight);
+    unlink();
+    location_ = location;
+    if (location_) {
+        ZObject* previous = nullptr;
+        for (ZObject* child = location_->firstChild_; child && position > 0; --position) {
+            previous = child;
+            child = child->nextSibling_;
+        }
+        linkAfter(previous);
+    }
+    addWeightToLocations(weight);
+    updateLocationKey();
+    updateScope();
+    LightSystem::refresh();
+}
+
+void ZObject::unlink() {
+    if (!location_) {
+        return;
+    }
+    (prevSibling_ ? prevSibling_->nextSibling_ : location_->firstChild_) = nextSibling_;
+    (nextSibling_ ? nextSibling_->prevSibling_ : location_->lastChild_) = prevSibling_;
+    prevSibling_ = nullptr;
+    nextSibling_ = nullptr;
+}
+
+void ZObject::linkAfter(ZObject* previous) {
+    prevSibling_ = previous;
+    nextSibling_ = previous ? previous->nextSibling_ : location_->firstChild_;
+    (prevSibling_ ? prevSibling_->nextSibling_ : location_->firstChild_) = this;
+    (nextSibling_ ? nextSibling_->prevSibling_ : location_->lastChild_) = this;
+}
+
+bool ZObject::showsContents() const {
+    return contentsShown(flags_);
+}
+
+bool ZObject::opensContents() const {
+    return contentsOpen(flags_);
+}
+
+void ZObject::updateScope() {
+    if (updateScopeFrom(this)) {
+        // Moved inside itself (a containment cycle, which Explorer flags):
+        // scope it from its location so the walks up still end
+        setSeenFrom(location_);
+        reachedFrom_ = location_;
+        updateContentsScope();
+    }
+}
+
+void ZObject::updateContentsScope() {
+    for (ZObject* child : getContents()) {
+        child->updateScopeFrom(this);
+    }
+}
+
+bool ZObject::updateScopeFrom(const ZObject* origin) {
+    // Through the location if it is see-through and somewhere itself
+    setSeenFrom(location_ && location_->seenFrom_ && location_->showsContents()
+                    ? location_->seenFrom_
+                    : location_);
+    reachedFrom_ = location_ && location_->reachedFrom_ && location_->opensContents()
+                       ? location_->reachedFrom_
+                       : location_;
+    bool cycle = false;
+    for (ZObject* child : getContents()) {
+        cycle |= child == origin || child->updateScopeFrom(origin);
+    }
+    return cycle;
+}
+
+void ZObject::setSeenFrom(ZObject* seenFrom) {
+    // A lit light source counts where it is seen from
+    if (seenFrom != seenFrom_ && givesLight(flags_)) {
+        if (seenFrom_) {
+            seenFrom_->lightSources_--;
+        }
+        if (seenFrom) {
+            seenFrom->lightSources_++;
+        }
+    }
+    seenFrom_ = seenFrom;
+}
+
+bool ZObject::isInsideBefore(const ZObject* container, const ZObject* top) const {
+    // A see-through container on the way up is scoped from the same top,
+    // which the walk always reaches
+    for (const ZObject* up = location_; up != top; up = up->location_) {
+        if (up == container) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int ZObject::getWeight() const {
+    return properties_.get(P_SIZE) + contentsWeight_;
+}
+
+void ZObject::addWeightToLocations(int delta) {
+    // The trailing pointer, at half speed, stops the walk if it goes round
+    // in circles (something moved inside itself, which Explorer reports)
+    const ZObject* trailing = this;
+    bool step = false;
+    for (ZObject* up = location_; up && up != trailing; up = up->location_) {
+        up->contentsWeight_ += delta;
+        if (step) {
+            trailing = trailing->location_;
+        }
+        step = !step;
+    }
+}
+
+size_t ZObject::Contents::size() const {
+    return static_cast<size_t>(std::distance(begin(), end()));
+}
+
+void ZObject::updateLocationKey() {
+    uint64_t key = location_ ? StateHash::locationKey(id_, location_->getId()) : 0;
+    StateHash::toggle(locationKey_ ^ key);
+    locationKey_ = key;
 }
 
 void ZObject::addSynonym(std::string_view syn) {
@@ -56,26 +302,49 @@ void ZObject::addAdjective(std::string_view adj) {
 
 bool ZObject::hasSynonym(std::string_view word) const {
     // O(1) lookup using hash set, case-insensitive
-    std::string lowerWord(word);
+    std::pmr::string lowerWord(word);
     std::transform(lowerWord.begin(), lowerWord.end(), lowerWord.begin(), ::tolower);
     return synonymSet_.find(lowerWord) != synonymSet_.end();
 }
 
 bool ZObject::hasAdjective(std::string_view word) const {
     // O(1) lookup using hash set, case-insensitive
-    std::string lowerWord(word);
+    std::pmr::string lowerWord(word);
     std::transform(lowerWord.begin(), lowerWord.end(), lowerWord.begin(), ::tolower);
     return adjectiveSet_.find(lowerWord) != adjectiveSet_.end();
 }
 
+bool ZObject::performAction() {
+    if (!action_) {
+        return false;
+    }
+    Metrics::objectAction(*this);
+    return action_();
+}
+
 void ZObject::setText(std::string_view text) {
     text_ = text;
 }
 
-const std::string& ZObject::getText() const {
+const std::pmr::string& ZObject::getText() const {
     return text_;
 }
 
 bool ZObject::hasText() const {
     return !text_.empty();
 }
+
+void ZObject::addFootprint(Footprint::Report &report) const {
+  using Footprint::Part;
+  using Footprint::heap;
+  size_t vocabulary = sizeof(synonyms_) + sizeof(adjectives_) +
+                      sizeof(synonymSet_) + sizeof(adjectiveSet_);
+  size_t text = sizeof(desc_) + sizeof(text_) + sizeof(longDesc_);
+  report[Part::OBJECTS] += Footprint::block(sizeof(ZObject)) - vocabulary -
+                           text - sizeof(action_);
+  report[Part::VOCABULARY] += vocabulary + heap(synonyms_) +
+                              heap(adjectives_) + heap(synonymSet_) +
+                              heap(adjectiveSet_);
+  report[Part::TEXT] += text + heap(desc_) + heap(text_) + heap(longDesc_);
+  report[Part::CLOSURES] += sizeof(action_);
+}
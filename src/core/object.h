@@ -1,13 +1,88 @@
 #pragma once
 #include "flags.h"
 #include "types.h"
+#include <array>
+#include <bit>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <unordered_set>
 #include <vector>
 
+namespace Footprint {
+struct Report;
+}
+
+/**
+ * @brief Numeric properties of an object (SIZE, CAPACITY, VALUE, ...)
+ *
+ * Property ids are small and fixed (world/objects.h), so the table is an
+ * array indexed by id with a mask of the ids that are set. An unset slot
+ * holds 0, so a read is a bounds check and one load. Iteration visits the
+ * set properties in id order. Ids outside [0, SLOTS) cannot be set and
+ * read as 0.
+ */
+class PropertyTable {
+public:
+  static constexpr PropertyId SLOTS = 8;
+
+  static constexpr bool valid(PropertyId prop) {
+    return prop >= 0 && prop < SLOTS;
+  }
+  bool contains(PropertyId prop) const {
+    return valid(prop) && (mask_ & bit(prop)) != 0;
+  }
+  int get(PropertyId prop) const { return valid(prop) ? values_[prop] : 0; }
+  // Both expect valid(prop)
+  void set(PropertyId prop, int value) {
+    mask_ |= bit(prop);
+    values_[prop] = value;
+  }
+  void erase(PropertyId prop) {
+    mask_ &= static_cast<uint8_t>(~bit(prop));
+    values_[prop] = 0;
+  }
+
+  // Bit n set if property n is
+  uint8_t mask() const { return mask_; }
+  size_t size() const { return static_cast<size_t>(std::popcount(mask_)); }
+  bool empty() const { return mask_ == 0; }
+
+  // Yields (id, value) pairs of the set properties
+  class const_iterator {
+  public:
+    const_iterator(const PropertyTable *table, uint8_t rest)
+        : table_(table), rest_(rest) {}
+    std::pair<PropertyId, int> operator*() const {
+      auto prop = static_cast<PropertyId>(std::countr_zero(rest_));
+      return {prop, table_->values_[prop]};
+    }
+    const_iterator &operator++() {
+      rest_ &= static_cast<uint8_t>(rest_ - 1);
+      return *this;
+    }
+    bool operator==(const const_iterator &other) const {
+      return rest_ == other.rest_;
+    }
+
+  private:
+    const PropertyTable *table_;
+    uint8_t rest_;
+  };
+  const_iterator begin() const { return {this, mask_}; }
+  const_iterator end() const { return {this, 0}; }
+
+private:
+  static constexpr uint8_t bit(PropertyId prop) {
+    return static_cast<uint8_t>(1u << prop);
+  }
+
+  uint8_t mask_ = 0;
+  std::array<int, SLOTS> values_{};
+};
+
 /**
  * @brief Core game object class (mirrors ZIL <OBJECT> definition)
  *
@@ -17,30 +92,39 @@
  * - Synonyms and adjectives for parser matching
  * - Flags (TAKEBIT, OPENBIT, etc.) for state and capabilities
  * - Properties (SIZE, CAPACITY, VALUE, etc.) for numeric attributes
- * - Location tracking for containment hierarchy
+ * - Location tracking for containment hierarchy (linked through the
+ *   objects themselves, as ZIL's LOC/FIRST/NEXT: a move is O(1)), with
+ *   each object's scope (the room or holder it is seen and reached from)
+ *   cached so visibility and accessibility are a comparison
  * - Optional action handler for object-specific behavior
  *
  * ZRoom extends this class for room-specific functionality.
  *
+ * The object's strings and containers allocate from the memory resource
+ * it is constructed with: the session's world arena for the objects the
+ * world builds (Globals::makeObject), the heap otherwise.
+ *
  * @see ZIL equivalent: <OBJECT> definitions in 1DUNGEON.ZIL
  */
 class ZObject {
 public:
-  ZObject(ObjectId id, std::string_view desc);
-  virtual ~ZObject() = default;
+  ZObject(ObjectId id, std::string_view desc,
+          std::pmr::memory_resource *memory = std::pmr::get_default_resource());
+  virtual ~ZObject();
 
   // Property accessors
   void setProperty(PropertyId prop, int value);
   int getProperty(PropertyId prop) const;
+  void removeProperty(PropertyId prop);
 
   // Text property accessors
   void setText(std::string_view text);
-  const std::string &getText() const;
+  const std::pmr::string &getText() const;
   bool hasText() const;
 
   // Long description (for room display)
   void setLongDesc(std::string_view ldesc) { longDesc_ = ldesc; }
-  const std::string &getLongDesc() const { return longDesc_; }
+  const std::pmr::string &getLongDesc() const { return longDesc_; }
   bool hasLongDesc() const { return !longDesc_.empty(); }
 
   // Flag operations
@@ -48,45 +132,161 @@ public:
   void clearFlag(ObjectFlag flag);
   bool hasFlag(ObjectFlag flag) const;
 
+  // A container's children, in the order they were moved in. A loop over
+  // them may move the child it is on elsewhere, but not the others.
+  class Contents {
+  public:
+    class iterator {
+    public:
+      using iterator_concept = std::forward_iterator_tag;
+      using iterator_category = std::input_iterator_tag;
+      using value_type = ZObject *;
+      using difference_type = std::ptrdiff_t;
+      using reference = ZObject *;
+
+      iterator() = default;
+      explicit iterator(ZObject *child)
+          : child_(child), next_(child ? child->nextSibling_ : nullptr) {}
+      ZObject *operator*() const { return child_; }
+      iterator &operator++() {
+        *this = iterator(next_);
+        return *this;
+      }
+      iterator operator++(int) {
+        iterator old = *this;
+        ++*this;
+        return old;
+      }
+      bool operator==(const iterator &other) const {
+        return child_ == other.child_;
+      }
+
+    private:
+      ZObject *child_ = nullptr;
+      ZObject *next_ = nullptr; // read ahead, so child_ may move away
+    };
+
+    explicit Contents(ZObject *first) : first_(first) {}
+    iterator begin() const { return iterator(first_); }
+    iterator end() const { return iterator(); }
+    bool empty() const { return first_ == nullptr; }
+    ZObject *front() const { return first_; }
+    size_t size() const; // counts them
+
+  private:
+    ZObject *first_;
+  };
+
   // Location/containment
   void moveTo(ZObject *location);
   ZObject *getLocation() const { return location_; }
-  const std::vector<ZObject *> &getContents() const { return contents_; }
+  // Reinsert at an exact position in location's contents (used by UNDO)
+  void restoreLocation(ZObject *location, size_t position);
+  Contents getContents() const { return Contents(firstChild_); }
+
+  // Scope, cached and kept current by moves and CONTBIT/OPENBIT/TRANSBIT
+  // changes. Seen from: the outermost object this one is inside through
+  // open or transparent containers (ZIL's SEE-INSIDE?); reached from: the
+  // same through open containers only (ACCESSIBLE?). Null if nowhere.
+  ZObject *getSeenFrom() const { return seenFrom_; }
+  ZObject *getReachedFrom() const { return reachedFrom_; }
+  // Whether this is transitively inside container with nothing closed (or,
+  // for visibility, closed and opaque) in between. O(1) when container is
+  // where this is seen/reached from; otherwise bounded by the nesting.
+  bool isVisibleIn(const ZObject *container) const {
+    return container && (seenFrom_ == container ||
+                         (seenFrom_ && container->seenFrom_ == seenFrom_ &&
+                          isInsideBefore(container, seenFrom_)));
+  }
+  bool isReachableIn(const ZObject *container) const {
+    return container && (reachedFrom_ == container ||
+                         (reachedFrom_ && container->reachedFrom_ == reachedFrom_ &&
+                          isInsideBefore(container, reachedFrom_)));
+  }
+  // Whether this object's contents can be seen / reached from outside it
+  bool showsContents() const;
+  bool opensContents() const;
+
+  // ZIL's WEIGHT: this object's P_SIZE plus everything inside it, at any
+  // depth. The contents part is kept per container and updated by moves
+  // and P_SIZE changes, so neither walks the contents.
+  int getWeight() const;
+  int getContentsWeight() const { return contentsWeight_; }
+
+  // Lit light sources (LIGHTBIT and ONBIT) seen from this object, kept by
+  // the moves and flag changes that affect them. A room is lit by its own
+  // and, with the player in it, the player's (LightSystem::isRoomLit).
+  int getLightSources() const { return lightSources_; }
 
   // Identification
   ObjectId getId() const { return id_; }
-  const std::string &getDesc() const { return desc_; }
+  const std::pmr::string &getDesc() const { return desc_; }
   void addSynonym(std::string_view syn);
   void addAdjective(std::string_view adj);
-  const std::vector<std::string> &getSynonyms() const { return synonyms_; }
-  const std::vector<std::string> &getAdjectives() const { return adjectives_; }
+  const std::pmr::vector<std::pmr::string> &getSynonyms() const {
+    return synonyms_;
+  }
+  const std::pmr::vector<std::pmr::string> &getAdjectives() const {
+    return adjectives_;
+  }
   bool hasSynonym(std::string_view word) const;
   bool hasAdjective(std::string_view word) const;
 
   // Action handler
   using ActionFunc = std::function<bool()>;
   void setAction(ActionFunc func) { action_ = func; }
-  bool performAction() { return action_ ? action_() : false; }
+  bool performAction();
 
   // Serialization support (for save/restore system)
   uint32_t getAllFlags() const { return flags_; }
-  void setAllFlags(uint32_t flags) { flags_ = flags; }
-  const std::map<PropertyId, int> &getAllProperties() const {
-    return properties_;
-  }
+  void setAllFlags(uint32_t flags);
+  const PropertyTable &getAllProperties() const { return properties_; }
+
+  // Add this object's memory to report (see Footprint)
+  virtual void addFootprint(Footprint::Report &report) const;
 
 private:
+  // Replace the flag word, keeping the state hash in step
+  void setFlagWord(uint64_t flags);
+  // Take this object out of its location's children (location_ unchanged)
+  void unlink();
+  // Make this object a child of location_, after the given child (first
+  // if null)
+  void linkAfter(ZObject *previous);
+  // Recompute this object's location key in the state hash
+  void updateLocationKey();
+  // Recompute seenFrom_/reachedFrom_ for this object and everything in it
+  void updateScope();
+  // Refresh the scope of this object's contents
+  void updateContentsScope();
+  // updateScope() below origin; returns whether it came back to origin
+  bool updateScopeFrom(const ZObject *origin);
+  // Set seenFrom_, moving this object's light to it if it gives any
+  void setSeenFrom(ZObject *seenFrom);
+  // Whether container is on the way up from this object to top
+  bool isInsideBefore(const ZObject *container, const ZObject *top) const;
+  // Add delta to the contents weight of everything this object is inside
+  void addWeightToLocations(int delta);
+
   ObjectId id_;
-  std::string desc_;
-  std::vector<std::string> synonyms_;
-  std::vector<std::string> adjectives_;
-  std::unordered_set<std::string> synonymSet_;   // O(1) lookup cache
-  std::unordered_set<std::string> adjectiveSet_; // O(1) lookup cache
+  int contentsWeight_ = 0; // P_SIZE of everything inside, at any depth
+  std::pmr::string desc_;
+  std::pmr::vector<std::pmr::string> synonyms_;
+  std::pmr::vector<std::pmr::string> adjectives_;
+  std::pmr::unordered_set<std::pmr::string> synonymSet_;   // O(1) lookup cache
+  std::pmr::unordered_set<std::pmr::string> adjectiveSet_; // O(1) lookup cache
   uint64_t flags_ = 0;
-  std::map<PropertyId, int> properties_;
-  std::string text_;     // For readable objects
-  std::string longDesc_; // Long description for room display
+  PropertyTable properties_;
+  int lightSources_ = 0;
+  std::pmr::string text_;     // For readable objects
+  std::pmr::string longDesc_; // Long description for room display
   ZObject *location_ = nullptr;
-  std::vector<ZObject *> contents_;
+  uint64_t locationKey_ = 0; // State hash key for location_
+  ZObject *firstChild_ = nullptr;
+  ZObject *lastChild_ = nullptr;
+  ZObject *nextSibling_ = nullptr; // in location_'s children
+  ZObject *prevSibling_ = nullptr;
+  ZObject *seenFrom_ = nullptr;
+  ZObject *reachedFrom_ = nullptr;
   ActionFunc action_;
 };
@@ -0,0 +1,20 @@
+#include "random.h"
+
+namespace Random {
+
+static thread_local Engine gameEngine;
+
+Engine& engine() {
+    return gameEngine;
+}
+
+void seed(uint32_t value) {
+    gameEngine.seed(value);
+}
+
+int range(int min, int max) {
+    std::uniform_int_distribution<int> dist(min, max);
+    return dist(gameEngine);
+}
+
+} // namespace Random
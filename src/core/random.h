@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <random>
+
+// Game random number generator
+// Every random decision in the game (thief movement, combat rolls, bat
+// drops, scattering items on death) draws from this one engine, so a game
+// can be replayed from its seed and the undo journal can rewind it.
+//
+// The engine defaults to a fixed seed; the interactive game reseeds it
+// from std::random_device at startup.
+
+namespace Random {
+
+// Small, cheaply copyable engine (the journal copies it every turn)
+using Engine = std::minstd_rand;
+
+// The game engine
+Engine& engine();
+
+// Reseed the game engine
+void seed(uint32_t value);
+
+// Random number in range [min, max]
+int range(int min, int max);
+
+} // namespace Random
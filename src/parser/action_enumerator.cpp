@@ -0,0 +1,187 @@
+#include "action_enumerator.h"
+#include "parser.h"
+#include "verb_registry.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "verbs/verbs.h"
+#include "world/rooms.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace ActionEnumerator {
+
+namespace {
+
+// Word the parser accepts for each direction
+const char* directionWord(Direction dir) {
+    switch (dir) {
+        case Direction::NORTH: return "north";
+        case Direction::SOUTH: return "south";
+        case Direction::EAST: return "east";
+        case Direction::WEST: return "west";
+        case Direction::NE: return "ne";
+        case Direction::NW: return "nw";
+        case Direction::SE: return "se";
+        case Direction::SW: return "sw";
+        case Direction::UP: return "up";
+        case Direction::DOWN: return "down";
+        case Direction::IN: return "in";
+        case Direction::OUT: return "out";
+    }
+    return "";
+}
+
+// An object in scope and the words that pick it out unambiguously
+struct Candidate {
+    ZObject* obj;
+    std::string name;
+};
+
+// Shortest name that matches this object and nothing else in scope:
+// a noun alone, or an adjective and a noun (empty if neither works)
+std::string uniqueName(const ZObject* obj, const std::vector<ZObject*>& scope) {
+    for (const auto& noun : obj->getSynonyms()) {
+        auto sharesNoun = [&](const ZObject* other) {
+            return other != obj && other->hasSynonym(noun);
+        };
+        if (std::none_of(scope.begin(), scope.end(), sharesNoun)) {
+            return std::string(noun);
+        }
+        for (const auto& adjective : obj->getAdjectives()) {
+            auto sharesBoth = [&](const ZObject* other) {
+                return sharesNoun(other) && other->hasAdjective(adjective);
+            };
+            if (std::none_of(scope.begin(), scope.end(), sharesBoth)) {
+                return std::string(adjective).append(" ").append(noun);
+            }
+        }
+    }
+    return "";
+}
+
+// Fill the pattern's slots from `element` on, appending finished commands
+void expandPattern(const SyntaxPattern& pattern, size_t element, std::string text,
+                   ObjectId first, ObjectId second,
+                   const std::vector<Candidate>& candidates, bool useFlags,
+                   std::vector<Action>& out) {
+    const auto& elements = pattern.getPattern();
+    if (element == elements.size()) {
+        Action action;
+        action.command = std::move(text);
+        action.verb = pattern.getVerbId();
+        action.directObj = first;
+        action.indirectObj = second;
+        out.push_back(std::move(action));
+        return;
+    }
+
+    const auto& e = elements[element];
+    switch (e.type) {
+        case SyntaxPattern::ElementType::PREPOSITION:
+            if (!e.values.empty()) {
+                expandPattern(pattern, element + 1, text + " " + e.values.front(),
+                              first, second, candidates, useFlags, out);
+            }
+            break;
+
+        case SyntaxPattern::ElementType::OBJECT:
+            for (const auto& c : candidates) {
+                if (useFlags && e.requiredFlag && !c.obj->hasFlag(*e.requiredFlag)) {
+                    continue;
+                }
+                if (c.obj->getId() == first) {
+                    continue; // "put sack in sack"
+                }
+                bool isFirst = first == 0;
+                expandPattern(pattern, element + 1, text + " " + c.name,
+                              isFirst ? c.obj->getId() : first,
+                              isFirst ? 0 : c.obj->getId(),
+                              candidates, useFlags, out);
+            }
+            break;
+
+        case SyntaxPattern::ElementType::VERB:
+            // The verb word is already in `text`
+            expandPattern(pattern, element + 1, std::move(text), first, second,
+                          candidates, useFlags, out);
+            break;
+
+        case SyntaxPattern::ElementType::DIRECTION:
+            // Directions come from the room's exits instead
+            break;
+    }
+}
+
+} // namespace
+
+bool isMetaVerb(VerbId verb) {
+    return (verb >= V_VERBOSE && verb <= V_UNDO) || verb == V_BUG ||
+           verb == V_RECORD || verb == V_UNRECORD || verb == V_VERIFY;
+}
+
+std::vector<Action> enumerate(bool useFlags) {
+    auto& g = Globals::instance();
+    std::vector<Action> actions;
+
+    // Exits of the current room
+    if (auto* room = dynamic_cast<ZRoom*>(g.here)) {
+        for (int d = 0; d <= static_cast<int>(Direction::OUT); ++d) {
+            auto dir = static_cast<Direction>(d);
+            const RoomExit* exit = room->getExit(dir);
+            if (exit && (exit->targetRoom || exit->condition)) {
+                Action action;
+                action.command = directionWord(dir);
+                action.verb = V_WALK;
+                action.isDirection = true;
+                actions.push_back(std::move(action));
+            }
+        }
+    }
+
+    Parser& parser = getGlobalParser();
+    const VerbRegistry* registry = parser.getVerbRegistry();
+    if (!registry) {
+        return actions;
+    }
+
+    // Objects in scope, in id order so the output is stable
+    std::vector<ZObject*> scope = parser.getObjectsInScope();
+    scope.erase(std::remove(scope.begin(), scope.end(), g.winner), scope.end());
+    std::sort(scope.begin(), scope.end(),
+              [](const ZObject* a, const ZObject* b) { return a->getId() < b->getId(); });
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(scope.size());
+    for (ZObject* obj : scope) {
+        std::string name = uniqueName(obj, scope);
+        if (!name.empty()) {
+            candidates.push_back({obj, std::move(name)});
+        }
+    }
+
+    for (VerbId verb : registry->getAllVerbs()) {
+        std::string_view word = parser.getVerbWord(verb);
+        if (word.empty()) {
+            continue;
+        }
+        for (const auto& pattern : registry->getSyntaxPatterns(verb)) {
+            if (isMetaVerb(pattern.getVerbId())) {
+                continue;
+            }
+            expandPattern(pattern, 0, std::string(word), 0, 0, candidates, useFlags, actions);
+        }
+    }
+
+    // Patterns that differ only in the resolved verb give the same text
+    std::vector<Action> unique;
+    unique.reserve(actions.size());
+    std::unordered_set<std::string> seen;
+    for (auto& action : actions) {
+        if (seen.insert(action.command).second) {
+            unique.push_back(std::move(action));
+        }
+    }
+    return unique;
+}
+
+} // namespace ActionEnumerator
@@ -0,0 +1,39 @@
+#pragma once
+#include "core/types.h"
+#include <string>
+#include <vector>
+
+// Action Enumerator - the commands that make sense in the current state
+//
+// Candidates are built from the parser's vocabulary:
+// - one bare direction for every exit of the current room
+// - every VerbRegistry syntax pattern, with each OBJECT slot filled by
+//   the objects in scope (the same scope the parser uses)
+//
+// An OBJECT slot with a requiredFlag only takes objects that have the
+// flag. Objects are named by a noun, plus an adjective when another
+// object in scope shares the noun, so every command parses without a
+// disambiguation question. Out-of-game verbs (SAVE, QUIT, UNDO, SCORE,
+// ...) are never generated.
+//
+// See Engine::validActions() for the version that also drops verbs
+// without a handler and (optionally) commands that change nothing.
+
+struct Action {
+    std::string command;       // Text to pass to Engine::step()
+    VerbId verb = 0;           // Verb after syntax resolution (V_WALK for exits)
+    ObjectId directObj = 0;    // First object slot (0 if none)
+    ObjectId indirectObj = 0;  // Second object slot (0 if none)
+    bool isDirection = false;
+};
+
+namespace ActionEnumerator {
+
+// Enumerate candidate commands for the current state (in a stable
+// order). With useFlags false, requiredFlag is ignored.
+std::vector<Action> enumerate(bool useFlags = true);
+
+// True for verbs that act on the session rather than the game world
+bool isMetaVerb(VerbId verb);
+
+} // namespace ActionEnumerator
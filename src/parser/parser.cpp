@@ -2,12 +2,13 @@
 #include "core/globals.h"
 #include "core/io.h"
 #include "verb_registry.h"
+#include "systems/footprint.h"
+#include "systems/trace.h"
 #include "verbs/verbs.h"
 #include "world/objects.h"
 #include "world/rooms.h"
 #include <algorithm>
 #include <cctype>
-#include <sstream>
 #include <stdexcept>
 
 Parser::Parser() {
@@ -49,6 +50,7 @@ void Parser::initializeVerbsAndDirections() {
   verbSynonyms_["restore"] = V_RESTORE;
   verbSynonyms_["restart"] = V_RESTART;
   verbSynonyms_["version"] = V_VERSION;
+  verbSynonyms_["undo"] = V_UNDO;
 
   // Easter eggs / special words
   verbSynonyms_["hello"] = V_HELLO;
@@ -216,23 +218,69 @@ void Parser::initializeVerbsAndDirections() {
   prepositions_.insert("around");
   prepositions_.insert("down");
   prepositions_.insert("up");
+
+  // Preferred word for each verb: the registry's canonical word if the
+  // parser knows it, otherwise the shortest single word
+  for (const auto &[word, verb] : verbSynonyms_) {
+    if (word.find(' ') != std::string::npos) {
+      continue;
+    }
+    std::string_view primary =
+        verbRegistry_ ? verbRegistry_->getPrimaryWord(verb) : std::string_view();
+    std::string &best = verbWords_[verb];
+    if (!best.empty() && best == primary) {
+      continue;
+    }
+    if (best.empty() || word == primary || word.size() < best.size() ||
+        (word.size() == best.size() && word < best)) {
+      best = word;
+    }
+  }
 }
 
 Parser::Parser(VerbRegistry *registry) : verbRegistry_(registry) {
   initializeVerbsAndDirections();
 }
 
-void Parser::tokenize(const std::string &input,
-                      std::vector<std::string> &tokens) {
-  std::istringstream iss(input);
-  std::string word;
-  while (iss >> word) {
-    std::transform(word.begin(), word.end(), word.begin(), ::tolower);
-    tokens.push_back(word);
+void Parser::addFootprint(Footprint::Report &report) const {
+  using Footprint::Part;
+  using Footprint::heap;
+  size_t history = sizeof(lastCommand_) + sizeof(lastObject_) +
+                   sizeof(lastObjects_) + sizeof(lastUnknownWord_) +
+                   sizeof(orphanPreposition_);
+  report[Part::PARSER_HISTORY] += history + heap(lastCommand_) +
+                                  heap(lastObjects_) + heap(lastUnknownWord_) +
+                                  heap(orphanPreposition_);
+  report[Part::VOCABULARY] += sizeof(Parser) - history + heap(verbSynonyms_) +
+                              heap(prepositions_) + heap(directions_) +
+                              heap(verbWords_);
+  for (const auto &[verb, word] : verbWords_) {
+    report[Part::VOCABULARY] += heap(word);
+  }
+}
+
+void Parser::tokenize(std::string_view input,
+                      std::pmr::vector<std::string> &tokens) {
+  ZORK_TRACE_SCOPE("tokenize");
+  auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+  size_t i = 0;
+  while (i < input.size()) {
+    while (i < input.size() && isSpace(input[i])) {
+      ++i;
+    }
+    size_t start = i;
+    while (i < input.size() && !isSpace(input[i])) {
+      ++i;
+    }
+    if (i > start) {
+      std::string &word = tokens.emplace_back(input.substr(start, i - start));
+      std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+    }
   }
 }
 
 VerbId Parser::findVerb(const std::string &word) const {
+  ZORK_TRACE_SCOPE("verb lookup");
   auto it = verbSynonyms_.find(word);
   return it != verbSynonyms_.end() ? it->second : 0;
 }
@@ -243,17 +291,18 @@ ZObject *Parser::findObject(const std::string &word) {
 }
 
 Direction *Parser::findDirection(const std::string &word) {
+  ZORK_TRACE_SCOPE("verb lookup");
   auto it = directions_.find(word);
   return it != directions_.end() ? &it->second : nullptr;
 }
 
-bool Parser::matchesSynonym(ZObject *obj, const std::string &word) const {
+bool Parser::matchesSynonym(ZObject *obj, std::string_view word) const {
   // Check if the word matches any of the object's synonyms
   return obj->hasSynonym(word);
 }
 
 bool Parser::matchesAdjectives(
-    ZObject *obj, const std::vector<std::string> &adjectives) const {
+    ZObject *obj, std::span<const std::string_view> adjectives) const {
   // Check if all provided adjectives match the object
   for (const auto &adj : adjectives) {
     if (!obj->hasAdjective(adj)) {
@@ -276,13 +325,10 @@ int Parser::getLocationPriority(ZObject *obj) const {
     return 2;
   }
 
-  // Priority 3: Objects in open containers in room or inventory
-  ZObject *loc = obj->getLocation();
-  if (loc && loc->hasFlag(ObjectFlag::CONTBIT) &&
-      loc->hasFlag(ObjectFlag::OPENBIT)) {
-    if (loc->getLocation() == g.here || loc->getLocation() == g.winner) {
-      return 1;
-    }
+  // Priority 3: Objects in open or transparent containers, at any depth, in
+  // room or inventory
+  if (obj->isVisibleIn(g.here) || obj->isVisibleIn(g.winner)) {
+    return 1;
   }
 
   // Priority 0: Objects elsewhere (not visible)
@@ -310,19 +356,17 @@ bool Parser::isObjectVisible(ZObject *obj) const {
   return getLocationPriority(obj) > 0;
 }
 
-std::vector<ZObject *>
-Parser::findObjects(const std::vector<std::string> &words, size_t startIdx) {
-  std::vector<ZObject *> matches;
+std::pmr::vector<ZObject *>
+Parser::findObjects(std::span<const std::string> words, size_t startIdx) {
+  ZORK_TRACE_SCOPE("resolve objects");
+  auto &g = Globals::instance();
+  std::pmr::vector<ZObject *> matches(g.scratch());
 
   if (startIdx >= words.size()) {
     return matches;
   }
 
-  auto &g = Globals::instance();
-
-  // Separate adjectives from nouns
-  std::vector<std::string> adjectives;
-  std::vector<std::string> nouns;
+  std::pmr::vector<std::string_view> nouns(g.scratch());
 
   for (size_t i = startIdx; i < words.size(); ++i) {
     const auto &word = words[i];
@@ -343,6 +387,7 @@ Parser::findObjects(const std::vector<std::string> &words, size_t startIdx) {
   }
 
   // Search through all objects
+  std::pmr::vector<std::string_view> otherWords(g.scratch());
   for (const auto &[id, objPtr] : g.getAllObjects()) {
     ZObject *obj = objPtr.get();
 
@@ -357,9 +402,8 @@ Parser::findObjects(const std::vector<std::string> &words, size_t startIdx) {
     // Strategy 1: Try matching last word as noun with earlier words as
     // adjectives
     if (nouns.size() > 1) {
-      const std::string &noun = nouns.back();
-      std::vector<std::string> potentialAdjectives(nouns.begin(),
-                                                   nouns.end() - 1);
+      std::string_view noun = nouns.back();
+      auto potentialAdjectives = std::span(nouns).first(nouns.size() - 1);
 
       if (matchesSynonym(obj, noun) &&
           matchesAdjectives(obj, potentialAdjectives)) {
@@ -369,12 +413,12 @@ Parser::findObjects(const std::vector<std::string> &words, size_t startIdx) {
 
     // Strategy 2: Try matching any single word as a synonym
     if (!matched) {
-      for (const auto &word : nouns) {
+      for (std::string_view word : nouns) {
         if (matchesSynonym(obj, word)) {
           // If we have multiple words, check if the others are adjectives
           if (nouns.size() > 1) {
-            std::vector<std::string> otherWords;
-            for (const auto &w : nouns) {
+            otherWords.clear();
+            for (std::string_view w : nouns) {
               if (w != word) {
                 otherWords.push_back(w);
               }
@@ -408,7 +452,7 @@ Parser::findObjects(const std::vector<std::string> &words, size_t startIdx) {
 std::string Parser::formatObjectDescription(ZObject *obj) const {
   // Format object for disambiguation list
   // Show description and location for clarity
-  std::string result = obj->getDesc();
+  std::string result(obj->getDesc());
 
   // Add location context if helpful
   auto &g = Globals::instance();
@@ -427,13 +471,14 @@ std::string Parser::formatObjectDescription(ZObject *obj) const {
 
 ZObject *
 Parser::parseDisambiguationResponse(const std::string &response,
-                                    const std::vector<ZObject *> &candidates) {
+                                    std::span<ZObject *const> candidates) {
   if (candidates.empty()) {
     return nullptr;
   }
 
   // Tokenize the response
-  std::vector<std::string> tokens;
+  auto &g = Globals::instance();
+  std::pmr::vector<std::string> tokens(g.scratch());
   tokenize(response, tokens);
 
   if (tokens.empty()) {
@@ -462,7 +507,8 @@ Parser::parseDisambiguationResponse(const std::string &response,
 
     // Check if response matches adjectives + synonym
     if (tokens.size() > 1) {
-      std::vector<std::string> adjectives(tokens.begin(), tokens.end() - 1);
+      std::pmr::vector<std::string_view> adjectives(
+          tokens.begin(), tokens.end() - 1, g.scratch());
       const std::string &noun = tokens.back();
 
       if (matchesSynonym(candidate, noun) &&
@@ -475,8 +521,9 @@ Parser::parseDisambiguationResponse(const std::string &response,
   return nullptr;
 }
 
-ZObject *Parser::disambiguate(const std::vector<ZObject *> &candidates,
+ZObject *Parser::disambiguate(std::span<ZObject *const> candidates,
                               const std::string &noun) {
+  ZORK_TRACE_SCOPE("disambiguate");
   if (candidates.empty()) {
     return nullptr;
   }
@@ -527,7 +574,7 @@ bool Parser::isPreposition(const std::string &word) const {
 }
 
 std::optional<size_t>
-Parser::findPrepositionIndex(const std::vector<std::string> &tokens) const {
+Parser::findPrepositionIndex(std::span<const std::string> tokens) const {
   for (size_t i = 1; i < tokens.size(); ++i) { // Start at 1 to skip verb
     if (isPreposition(tokens[i])) {
       return i;
@@ -556,8 +603,8 @@ void Parser::setLastObject(ZObject *obj) { lastObject_ = obj; }
 
 ZObject *Parser::getLastObject() const { return lastObject_; }
 
-void Parser::setLastObjects(const std::vector<ZObject *> &objs) {
-  lastObjects_ = objs;
+void Parser::setLastObjects(std::span<ZObject *const> objs) {
+  lastObjects_.assign(objs.begin(), objs.end());
 }
 
 const std::vector<ZObject *> &Parser::getLastObjects() const {
@@ -584,11 +631,11 @@ bool Parser::isExceptKeyword(const std::string &word) const {
   return word == "except" || word == "but";
 }
 
-bool Parser::isAgainCommand(const std::vector<std::string> &tokens) const {
+bool Parser::isAgainCommand(std::span<const std::string> tokens) const {
   return !tokens.empty() && (tokens[0] == "again" || tokens[0] == "g");
 }
 
-bool Parser::isOopsCommand(const std::vector<std::string> &tokens) const {
+bool Parser::isOopsCommand(std::span<const std::string> tokens) const {
   return !tokens.empty() && tokens[0] == "oops";
 }
 
@@ -596,9 +643,10 @@ bool Parser::isPronoun(const std::string &word) const {
   return word == "it" || word == "them";
 }
 
-std::vector<ZObject *> Parser::findAllApplicableObjects(VerbId verb) const {
-  std::vector<ZObject *> applicable;
+std::pmr::vector<ZObject *> Parser::findAllApplicableObjects(VerbId verb) const {
   auto &g = Globals::instance();
+  std::pmr::vector<ZObject *> applicable(g.scratch());
+  applicable.reserve(g.getAllObjects().size());
 
   // Determine which objects are applicable based on the verb
   for (const auto &[id, objPtr] : g.getAllObjects()) {
@@ -670,6 +718,52 @@ void Parser::setOrphanIndirect(VerbId verb, ZObject *directObj,
   orphanPreposition_ = prep;
 }
 
+Parser::Memory Parser::saveMemory() const {
+  Memory memory;
+  memory.lastCommand = lastCommand_;
+  memory.lastObject = lastObject_;
+  memory.lastObjects = lastObjects_;
+  memory.lastUnknownWord = lastUnknownWord_;
+  memory.hadUnknownWordLastTurn = hadUnknownWordLastTurn_;
+  memory.orphanFlag = orphanFlag_;
+  memory.orphanVerb = orphanVerb_;
+  memory.orphanPreposition = orphanPreposition_;
+  memory.orphanNeedsDirect = orphanNeedsDirect_;
+  memory.orphanNeedsIndirect = orphanNeedsIndirect_;
+  memory.orphanDirectObj = orphanDirectObj_;
+  return memory;
+}
+
+void Parser::restoreMemory(const Memory &memory) {
+  lastCommand_ = memory.lastCommand;
+  lastObject_ = memory.lastObject;
+  lastObjects_ = memory.lastObjects;
+  lastUnknownWord_ = memory.lastUnknownWord;
+  hadUnknownWordLastTurn_ = memory.hadUnknownWordLastTurn;
+  orphanFlag_ = memory.orphanFlag;
+  orphanVerb_ = memory.orphanVerb;
+  orphanPreposition_ = memory.orphanPreposition;
+  orphanNeedsDirect_ = memory.orphanNeedsDirect;
+  orphanNeedsIndirect_ = memory.orphanNeedsIndirect;
+  orphanDirectObj_ = memory.orphanDirectObj;
+}
+
+std::string_view Parser::getVerbWord(VerbId verb) const {
+  auto it = verbWords_.find(verb);
+  return it != verbWords_.end() ? std::string_view(it->second)
+                                : std::string_view();
+}
+
+std::vector<ZObject *> Parser::getObjectsInScope() const {
+  std::vector<ZObject *> scope;
+  for (const auto &[id, objPtr] : Globals::instance().getAllObjects()) {
+    if (isObjectVisible(objPtr.get())) {
+      scope.push_back(objPtr.get());
+    }
+  }
+  return scope;
+}
+
 void Parser::clearOrphan() {
   orphanFlag_ = false;
   orphanVerb_ = 0;
@@ -815,8 +909,8 @@ bool Parser::isKnownObjectWord(const std::string &word) const {
   return false;
 }
 
-ParsedCommand Parser::parse(const std::string &input) {
-  ParsedCommand cmd;
+ParsedCommand Parser::parse(std::string_view input) {
+  ParsedCommand cmd(Globals::instance().scratch());
 
   // Handle AGAIN command
   tokenize(input, cmd.words);
@@ -973,8 +1067,7 @@ ParsedCommand Parser::parse(const std::string &input) {
     if (cmd.words.size() > 2 && isExceptKeyword(cmd.words[2])) {
       // Find the exception object
       if (cmd.words.size() > 3) {
-        std::vector<std::string> exceptWords(cmd.words.begin() + 3,
-                                             cmd.words.end());
+        auto exceptWords = std::span(cmd.words).subspan(3);
         auto exceptMatches = findObjects(exceptWords, 0);
         if (!exceptMatches.empty()) {
           cmd.exceptObject =
@@ -1020,7 +1113,7 @@ ParsedCommand Parser::parse(const std::string &input) {
         if (!lastObjects_.empty()) {
           // For "them", treat as "all" with the last objects
           cmd.isAll = true;
-          cmd.allObjects = lastObjects_;
+          cmd.allObjects.assign(lastObjects_.begin(), lastObjects_.end());
         } else {
           printLine("I don't know what \"them\" refers to.");
           return cmd;
@@ -1058,12 +1151,11 @@ ParsedCommand Parser::parse(const std::string &input) {
       }
 
       // Extract direct object (words between verb and preposition)
-      std::vector<std::string> directObjWords(
-          cmd.words.begin() + 1, cmd.words.begin() + prepIdx.value());
+      auto directObjWords =
+          std::span(cmd.words).subspan(1, prepIdx.value() - 1);
 
       // Extract indirect object (words after preposition)
-      std::vector<std::string> indirectObjWords(
-          cmd.words.begin() + prepIdx.value() + 1, cmd.words.end());
+      auto indirectObjWords = std::span(cmd.words).subspan(prepIdx.value() + 1);
 
       // Find objects
       if (!directObjWords.empty()) {
@@ -1093,8 +1185,7 @@ ParsedCommand Parser::parse(const std::string &input) {
     } else if (cmd.verb != 0) {
       // No preposition, just try to find direct object
       if (cmd.words.size() > 1) {
-        std::vector<std::string> objWords(cmd.words.begin() + 1,
-                                          cmd.words.end());
+        auto objWords = std::span(cmd.words).subspan(1);
         auto matches = findObjects(objWords, 0);
         if (!matches.empty()) {
           cmd.directObj = matches.size() == 1
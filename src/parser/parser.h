@@ -1,6 +1,8 @@
 #pragma once
 #include "core/types.h"
 #include "world/rooms.h"
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -14,15 +16,23 @@ class Parser;
 // Global parser accessor (defined in main.cpp)
 Parser& getGlobalParser();
 
+// A parsed command. Parser::parse() puts its lists in the turn's scratch
+// memory (Globals::scratch()), so a command is good until the turn it was
+// parsed in ends; move it rather than assign it (assigning copies the lists
+// to the target's memory).
 struct ParsedCommand {
+    ParsedCommand() = default;
+    explicit ParsedCommand(std::pmr::memory_resource* memory)
+        : words(memory), allObjects(memory) {}
+
     VerbId verb = 0;
     ZObject* directObj = nullptr;
     ZObject* indirectObj = nullptr;
-    std::vector<std::string> words;
+    std::pmr::vector<std::string> words;
     Direction direction = Direction::NORTH;
     bool isDirection = false;
     bool isAll = false;  // "all" keyword used
-    std::vector<ZObject*> allObjects;  // Objects for "all" command
+    std::pmr::vector<ZObject*> allObjects;  // Objects for "all" command
     ZObject* exceptObject = nullptr;  // Object to exclude in "all except"
 };
 
@@ -34,14 +44,14 @@ public:
     Parser();
     Parser(VerbRegistry* registry);  // Constructor with registry
     
-    ParsedCommand parse(const std::string& input);
+    ParsedCommand parse(std::string_view input);
     
     // Special command support
     void setLastCommand(const std::string& cmd);
     std::string_view getLastCommand() const;
     void setLastObject(ZObject* obj);
     ZObject* getLastObject() const;
-    void setLastObjects(const std::vector<ZObject*>& objs);
+    void setLastObjects(std::span<ZObject* const> objs);
     const std::vector<ZObject*>& getLastObjects() const;
     void setLastUnknownWord(const std::string& word);
     std::string_view getLastUnknownWord() const;
@@ -53,29 +63,57 @@ public:
     void clearOrphan();
     bool isOrphaned() const { return orphanFlag_; }
     
-    // Public for testing
-    std::vector<ZObject*> findObjects(const std::vector<std::string>& words, size_t startIdx = 0);
-    ZObject* disambiguate(const std::vector<ZObject*>& candidates, const std::string& noun);
+    // State carried from one command to the next (AGAIN, OOPS, pronouns,
+    // orphans), saved and restored around dry runs
+    struct Memory {
+        std::string lastCommand;
+        ZObject* lastObject = nullptr;
+        std::vector<ZObject*> lastObjects;
+        std::string lastUnknownWord;
+        bool hadUnknownWordLastTurn = false;
+        bool orphanFlag = false;
+        VerbId orphanVerb = 0;
+        std::string orphanPreposition;
+        bool orphanNeedsDirect = true;
+        bool orphanNeedsIndirect = false;
+        ZObject* orphanDirectObj = nullptr;
+    };
+    Memory saveMemory() const;
+    void restoreMemory(const Memory& memory);
+    
+    // Vocabulary and scope (used to enumerate commands)
+    const VerbRegistry* getVerbRegistry() const { return verbRegistry_; }
+    // Word that parses as the given verb (empty if none)
+    std::string_view getVerbWord(VerbId verb) const;
+    // Objects a command can refer to right now
+    std::vector<ZObject*> getObjectsInScope() const;
+    
+    // Add the dictionaries and the command history to report (see Footprint)
+    void addFootprint(Footprint::Report& report) const;
+    
+    // Public for testing (lists returned are in the turn's scratch memory)
+    std::pmr::vector<ZObject*> findObjects(std::span<const std::string> words, size_t startIdx = 0);
+    ZObject* disambiguate(std::span<ZObject* const> candidates, const std::string& noun);
     bool isPreposition(const std::string& word) const;
-    std::optional<size_t> findPrepositionIndex(const std::vector<std::string>& tokens) const;
+    std::optional<size_t> findPrepositionIndex(std::span<const std::string> tokens) const;
     
 private:
     void initializeVerbsAndDirections();
-    void tokenize(const std::string& input, std::vector<std::string>& tokens);
+    void tokenize(std::string_view input, std::pmr::vector<std::string>& tokens);
     VerbId findVerb(const std::string& word) const;
     ZObject* findObject(const std::string& word);
     Direction* findDirection(const std::string& word);
     
     // Helper methods for object matching
-    bool matchesSynonym(ZObject* obj, const std::string& word) const;
-    bool matchesAdjectives(ZObject* obj, const std::vector<std::string>& adjectives) const;
+    bool matchesSynonym(ZObject* obj, std::string_view word) const;
+    bool matchesAdjectives(ZObject* obj, std::span<const std::string_view> adjectives) const;
     int getLocationPriority(ZObject* obj) const;
     bool isObjectVisible(ZObject* obj) const;
     
     // Disambiguation helpers
     std::string formatObjectDescription(ZObject* obj) const;
     ZObject* parseDisambiguationResponse(const std::string& response, 
-                                         const std::vector<ZObject*>& candidates);
+                                         std::span<ZObject* const> candidates);
     
     // Preposition handling
     bool validatePreposition(VerbId verb, const std::string& preposition) const;
@@ -83,17 +121,18 @@ private:
     // Special command helpers
     bool isAllKeyword(const std::string& word) const;
     bool isExceptKeyword(const std::string& word) const;
-    bool isAgainCommand(const std::vector<std::string>& tokens) const;
-    bool isOopsCommand(const std::vector<std::string>& tokens) const;
+    bool isAgainCommand(std::span<const std::string> tokens) const;
+    bool isOopsCommand(std::span<const std::string> tokens) const;
     bool isPronoun(const std::string& word) const;
     bool isKnownObjectWord(const std::string& word) const;
-    std::vector<ZObject*> findAllApplicableObjects(VerbId verb) const;
+    std::pmr::vector<ZObject*> findAllApplicableObjects(VerbId verb) const;
     std::string replaceOopsWord(const std::string& original, const std::string& replacement);
     
     // Using unordered containers for O(1) lookup
     std::unordered_map<std::string, VerbId> verbSynonyms_;
     std::unordered_set<std::string> prepositions_;
     std::unordered_map<std::string, Direction> directions_;
+    std::unordered_map<VerbId, std::string> verbWords_;  // Preferred word per verb
     VerbRegistry* verbRegistry_;  // Optional registry for advanced validation
     
     // Special command state
@@ -1,8 +1,7 @@
 #include "parser.h"
 
-// Global parser instance
-static Parser globalParserInstance;
-
+// Global parser instance (one per thread, like the rest of the game state)
 Parser& getGlobalParser() {
+    static thread_local Parser globalParserInstance;
     return globalParserInstance;
 }
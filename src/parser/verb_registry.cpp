@@ -26,6 +26,7 @@ void VerbRegistry::initializeVerbSynonyms() {
     registerVerb(V_SAVE, {"save"});
     registerVerb(V_SCORE, {"score"});
     registerVerb(V_VERSION, {"version"});
+    registerVerb(V_UNDO, {"undo"});
     
     // Manipulation verbs
     registerVerb(V_TAKE, {"take", "get", "hold", "carry", "remove", "grab", "catch"});
@@ -220,6 +221,7 @@ void VerbRegistry::registerVerb(VerbId verbId, std::vector<std::string> synonyms
                       lowerSynonym.begin(), ::tolower);
         
         verbMap_[lowerSynonym] = verbId;
+        primaryWords_.try_emplace(verbId, lowerSynonym);
     }
 }
 
@@ -241,6 +243,11 @@ std::optional<VerbId> VerbRegistry::lookupVerb(std::string_view word) const {
     return std::nullopt;
 }
 
+std::string_view VerbRegistry::getPrimaryWord(VerbId verbId) const {
+    auto it = primaryWords_.find(verbId);
+    return it != primaryWords_.end() ? std::string_view(it->second) : std::string_view();
+}
+
 const std::vector<SyntaxPattern>& VerbRegistry::getSyntaxPatterns(VerbId verbId) const {
     // C++17 if with initializer
     if (auto it = syntaxMap_.find(verbId); it != syntaxMap_.end()) {
@@ -346,6 +353,7 @@ void VerbRegistry::initializeSyntaxPatterns() {
     registerSyntax(V_SAVE, SyntaxPattern(V_SAVE, {Elem(ET::VERB)}));
     registerSyntax(V_SCORE, SyntaxPattern(V_SCORE, {Elem(ET::VERB)}));
     registerSyntax(V_VERSION, SyntaxPattern(V_VERSION, {Elem(ET::VERB)}));
+    registerSyntax(V_UNDO, SyntaxPattern(V_UNDO, {Elem(ET::VERB)}));
     
     // TAKE verb patterns
     // TAKE OBJECT (FIND TAKEBIT) (ON-GROUND IN-ROOM MANY)
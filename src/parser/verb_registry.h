@@ -55,6 +55,14 @@ public:
      */
     std::optional<VerbId> lookupVerb(std::string_view word) const;
     
+    /**
+     * Get the first synonym registered for a verb (its canonical word).
+     * 
+     * @param verbId The verb identifier
+     * @return The word, or an empty view if the verb has no synonyms
+     */
+    std::string_view getPrimaryWord(VerbId verbId) const;
+    
     /**
      * Get all syntax patterns for a verb.
      * 
@@ -115,6 +123,9 @@ private:
     // Map from verb ID to its syntax patterns
     std::unordered_map<VerbId, std::vector<SyntaxPattern>> syntaxMap_;
     
+    // First synonym registered for each verb
+    std::unordered_map<VerbId, std::string> primaryWords_;
+    
     // Empty pattern vector for verbs with no patterns
     static const std::vector<SyntaxPattern> emptyPatterns_;
     
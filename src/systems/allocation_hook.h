@@ -0,0 +1,31 @@
+#pragma once
+#include "allocations.h"
+#include <cstdlib>
+#include <new>
+
+// Counting replacement of the global operator new (see allocations.h)
+//
+// Include in exactly one source file of a program to count its heap
+// allocations: the definitions below replace the standard library's for
+// the whole program. The array and nothrow forms call these; the
+// over-aligned forms are left alone (nothing in the game uses them).
+
+namespace {
+[[maybe_unused]] const bool allocationHookInstalled = (Allocations::detail::hooked = true);
+} // namespace
+
+void* operator new(std::size_t size) {
+    Allocations::detail::count(size);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
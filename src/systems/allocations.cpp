@@ -0,0 +1,51 @@
+#include "allocations.h"
+
+namespace Allocations {
+
+namespace detail {
+
+thread_local Subsystem current = Subsystem::OTHER;
+thread_local Tally tally;
+bool hooked = false;
+
+} // namespace detail
+
+std::string_view subsystemName(Subsystem subsystem) {
+    switch (subsystem) {
+        case Subsystem::OTHER: return "other";
+        case Subsystem::PARSER: return "parser";
+        case Subsystem::HANDLER: return "handler";
+        case Subsystem::TIMERS: return "timers";
+        case Subsystem::NPCS: return "npcs";
+        case Subsystem::OUTPUT: return "output";
+        case Subsystem::UNDO: return "undo";
+        default: return "?";
+    }
+}
+
+Counts Tally::total() const {
+    Counts sum;
+    for (const auto& counts : bySubsystem) {
+        sum += counts;
+    }
+    return sum;
+}
+
+Tally& Tally::operator+=(const Tally& other) {
+    for (size_t i = 0; i < SUBSYSTEMS; ++i) {
+        bySubsystem[i] += other.bySubsystem[i];
+    }
+    return *this;
+}
+
+Tally Tally::operator-(const Tally& earlier) const {
+    Tally difference;
+    for (size_t i = 0; i < SUBSYSTEMS; ++i) {
+        difference.bySubsystem[i].allocations =
+            bySubsystem[i].allocations - earlier.bySubsystem[i].allocations;
+        difference.bySubsystem[i].bytes = bySubsystem[i].bytes - earlier.bySubsystem[i].bytes;
+    }
+    return difference;
+}
+
+} // namespace Allocations
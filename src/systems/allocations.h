@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Allocations - heap allocations per thread, attributed to the subsystem
+// that made them
+//
+// Counting is opt-in per program: a program that includes
+// "systems/allocation_hook.h" in exactly one source file replaces the
+// global operator new with one that counts into the calling thread's
+// tally (benchmarks, tests, zork_ab). Everywhere else nothing is counted
+// and thisThread() stays zero; the Scope markers in the turn loop cost a
+// thread-local store either way.
+//
+// A Scope names the subsystem running on the calling thread until it is
+// destroyed; scopes nest and the innermost one is charged. Engine marks
+// the parser, the verb handler, the timer tick and the NPC turns,
+// print()/printLine() mark output, and the undo journal marks what it
+// records (it keeps every turn's changes, so a turn that changes the world
+// always allocates there). Allocations outside every scope (the turn's own
+// bookkeeping, new games) are charged to OTHER.
+//
+// Usage (a test asserting an allocation budget):
+//   Allocations::Counter counter;
+//   Engine::step("north");
+//   ASSERT_EQ(counter.elapsed()[Allocations::Subsystem::OUTPUT].allocations, 0u);
+
+namespace Allocations {
+
+enum class Subsystem : uint8_t {
+    OTHER,
+    PARSER,
+    HANDLER,
+    TIMERS,
+    NPCS,
+    OUTPUT,
+    UNDO,
+    COUNT
+};
+
+constexpr size_t SUBSYSTEMS = static_cast<size_t>(Subsystem::COUNT);
+
+std::string_view subsystemName(Subsystem subsystem);
+
+struct Counts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+
+    Counts& operator+=(const Counts& other) {
+        allocations += other.allocations;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+// Allocations of one thread by subsystem
+struct Tally {
+    std::array<Counts, SUBSYSTEMS> bySubsystem{};
+
+    const Counts& operator[](Subsystem subsystem) const {
+        return bySubsystem[static_cast<size_t>(subsystem)];
+    }
+
+    Counts total() const;
+    Tally& operator+=(const Tally& other);
+    Tally operator-(const Tally& earlier) const;
+};
+
+namespace detail {
+extern thread_local Subsystem current;
+extern thread_local Tally tally;
+extern bool hooked;
+
+// Called by the hook for every operator new
+inline void count(size_t bytes) {
+    Counts& counts = tally.bySubsystem[static_cast<size_t>(current)];
+    counts.allocations++;
+    counts.bytes += bytes;
+}
+} // namespace detail
+
+// True if this program counts allocations (includes allocation_hook.h)
+inline bool hooked() {
+    return detail::hooked;
+}
+
+// Everything the calling thread has allocated so far
+inline const Tally& thisThread() {
+    return detail::tally;
+}
+
+// Charge the calling thread's allocations to subsystem while alive
+class Scope {
+public:
+    explicit Scope(Subsystem subsystem) : previous_(detail::current) {
+        detail::current = subsystem;
+    }
+    ~Scope() { detail::current = previous_; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Subsystem previous_;
+};
+
+// The calling thread's allocations since construction
+class Counter {
+public:
+    Counter() : start_(thisThread()) {}
+
+    Tally elapsed() const { return thisThread() - start_; }
+
+private:
+    Tally start_;
+};
+
+} // namespace Allocations
@@ -3,13 +3,12 @@
 #include "death.h"
 #include "core/globals.h"
 #include "core/io.h"
-#include <cstdlib>
-#include <ctime>
+#include "core/random.h"
 
 namespace CombatSystem {
 
 CombatManager& CombatManager::instance() {
-    static CombatManager instance;
+    static thread_local CombatManager instance;
     return instance;
 }
 
@@ -117,8 +116,8 @@ void CombatManager::processCombatRound() {
         int damage = calculateDamage(*player_, *enemy_);
         applyDamage(*enemy_, damage);
         
-        std::string weaponName = player_->weapon ? player_->weapon->getDesc() : "fists";
-        printLine("You strike the " + enemy_->object->getDesc() + " with your " + weaponName + "!");
+        std::string weaponName(player_->weapon ? std::string_view(player_->weapon->getDesc()) : "fists");
+        printLine("You strike the " + std::string(enemy_->object->getDesc()) + " with your " + weaponName + "!");
         
         if (damage > 0) {
             printLine("You deal " + std::to_string(damage) + " damage!");
@@ -187,7 +186,7 @@ int CombatManager::calculateDamage(const Combatant& attacker, const Combatant& d
     if (variance < 1) {
         variance = 1;
     }
-    int randomFactor = (rand() % (variance * 2 + 1)) - variance;
+    int randomFactor = Random::range(-variance, variance);
     int damage = baseDamage + randomFactor;
     
     // Ensure minimum damage of 1
@@ -231,7 +230,7 @@ bool CombatManager::attackSucceeds(const Combatant& attacker, const Combatant& d
     }
     
     // Roll for hit
-    int roll = rand() % 100;
+    int roll = Random::range(0, 99);
     return roll < hitChance;
 }
 
@@ -248,7 +247,7 @@ bool CombatManager::shouldEnemyFlee(const Combatant& enemy) {
     if (enemy.health < enemy.maxHealth * 3 / 10) {
         // Higher chance to flee when more wounded
         int fleeChance = 40 + ((enemy.maxHealth - enemy.health) * 20 / enemy.maxHealth);
-        return (rand() % 100) < fleeChance;
+        return Random::range(0, 99) < fleeChance;
     }
     return false;
 }
@@ -290,8 +289,7 @@ void CombatManager::handleDeath(Combatant& combatant) {
         location = g.here;
     }
     
-    auto contents = combatant.object->getContents();
-    for (auto* item : contents) {
+    for (auto* item : combatant.object->getContents()) {
         if (location) {
             item->moveTo(location);
             // Make items visible and accessible
@@ -1,8 +1,10 @@
 #include "death.h"
 #include "score.h"
 #include "timer.h"
+#include "undo.h"
 #include "../core/globals.h"
 #include "../core/io.h"
+#include "../core/random.h"
 #include "../world/rooms.h"
 #include "../world/objects.h"
 #include <cstdlib>
@@ -13,10 +15,10 @@ extern bool deadFunction();
 namespace DeathSystem {
 
 // State variables
-static int deathCount_ = 0;
-static bool dead_ = false;
-static bool alwaysLit_ = false;
-static bool testMode_ = false;
+static thread_local int deathCount_ = 0;
+static thread_local bool dead_ = false;
+static thread_local bool alwaysLit_ = false;
+static thread_local bool testMode_ = false;
 
 // Initialize death system
 
@@ -35,6 +37,9 @@ void setTestMode(bool enabled) {
 
 
 void setDead(bool dead) {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(dead_);
+    }
     dead_ = dead;
 }
 
@@ -97,21 +102,20 @@ static void randomizeObjects() {
         return;
     }
     
-    // Scatter player's inventory
-    auto contents = g.winner->getContents();
-    for (auto* item : contents) {
+    // Scatter player's inventory (each item moves as the loop reaches it)
+    for (auto* item : g.winner->getContents()) {
         if (!item) continue;
         
         // Treasures go to random dark land rooms
         int tvalue = item->getProperty(P_TVALUE);
         if (tvalue > 0) {
             // Pick random dark room
-            int idx = rand() % validRooms.size();
+            int idx = Random::range(0, static_cast<int>(validRooms.size()) - 1);
             item->moveTo(validRooms[idx]);
         } else {
             // Non-treasures go to random above-ground rooms
             // For simplicity, use any valid room
-            int idx = rand() % validRooms.size();
+            int idx = Random::range(0, static_cast<int>(validRooms.size()) - 1);
             item->moveTo(validRooms[idx]);
         }
     }
@@ -164,7 +168,7 @@ bool offerResurrection() {
         print("Do you wish to be resurrected? (Y/N) ");
         
         std::string response;
-        std::getline(std::cin, response);
+        std::getline(inputStream(), response);
         
         // Convert to lowercase for comparison
         for (auto& c : response) {
@@ -181,7 +185,7 @@ bool offerResurrection() {
         print("Do you wish to continue? (Y/N) ");
         
         std::string response;
-        std::getline(std::cin, response);
+        std::getline(inputStream(), response);
         
         // Convert to lowercase for comparison
         for (auto& c : response) {
@@ -206,6 +210,10 @@ void performResurrection() {
     if (visitedTemple) {
         // Full resurrection at Entrance to Hades (Requirement 59.3)
         // Mark as dead (ghost mode)
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(dead_);
+            UndoSystem::UndoJournal::instance().recordValue(alwaysLit_);
+        }
         dead_ = true;
         alwaysLit_ = true;  // Can see in darkness as a ghost
         
@@ -222,7 +230,7 @@ void performResurrection() {
         auto* hades = g.getObject(RoomIds::ENTRANCE_TO_HADES);
         if (hades && g.winner) {
             g.winner->moveTo(hades);
-            g.here = hades;
+            g.setHere(hades);
         }
     } else {
         // Simple resurrection in forest
@@ -233,7 +241,7 @@ void performResurrection() {
         auto* forest = g.getObject(RoomIds::FOREST_1);
         if (forest && g.winner) {
             g.winner->moveTo(forest);
-            g.here = forest;
+            g.setHere(forest);
         }
     }
     
@@ -294,6 +302,9 @@ void jigsUp(std::string_view deathMessage, DeathCause cause) {
     }
     
     // Increment death counter (Requirement 58.5)
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(deathCount_);
+    }
     deathCount_++;
     
     // Check if resurrection is available (Requirement 59.2, 59.5)
@@ -0,0 +1,654 @@
+/**
+ * @file explorer.cpp
+ * @brief Coverage-guided random exploration
+ *
+ * Coverage is a shared bitmap of hashed features, set with atomic
+ * fetch_or so workers never wait on each other for it. The corpus and the
+ * failure list are behind mutexes; both change rarely compared to the
+ * number of commands played.
+ */
+
+#include "explorer.h"
+#include "score.h"
+#include "state_hash.h"
+#include "timer.h"
+#include "undo.h"
+#include "../core/engine.h"
+#include "../core/globals.h"
+#include "../core/io.h"
+#include "../core/object.h"
+#include "../parser/parser.h"
+#include "../world/rooms.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace Explorer {
+
+namespace {
+
+using Log = std::vector<std::string>;
+using Clock = std::chrono::steady_clock;
+
+// Commands played by this thread since its last new game, one per line,
+// for the fatal-signal handler
+thread_local std::string crashLog;
+
+extern "C" void onFatalSignal(int sig) {
+    static const char header[] = "\n*** Explorer: fatal signal; commands since a new game:\n";
+    ssize_t ignored = write(STDERR_FILENO, header, sizeof(header) - 1);
+    ignored = write(STDERR_FILENO, crashLog.data(), crashLog.size());
+    (void)ignored;
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+constexpr int FATAL_SIGNALS[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+std::string describe(const ZObject* obj) {
+    if (!obj) {
+        return "nothing";
+    }
+    return std::string(obj->getDesc()) + " (" + std::to_string(obj->getId()) + ")";
+}
+
+ObjectId idOf(const ZObject* obj) {
+    return obj ? obj->getId() : 0;
+}
+
+// Globals puzzle flags as one word (bit order is only used for coverage)
+uint32_t globalFlags() {
+    auto& g = Globals::instance();
+    const bool flags[] = {g.lit,      g.lampWarned, g.rugMoved,      g.lldFlag,
+                          g.gateFlag, g.gatesOpen,  g.lowTide,       g.domeFlag,
+                          g.grunlock, g.grateRevealed, g.rainbowFlag};
+    uint32_t word = 0;
+    for (size_t i = 0; i < std::size(flags); ++i) {
+        word |= static_cast<uint32_t>(flags[i]) << i;
+    }
+    return word;
+}
+
+enum class Feature : uint64_t {
+    ROOM = 1,
+    VERB,
+    MESSAGE,
+    FLAG,
+    GLOBAL_FLAG,
+    MOVE,
+    TIMER
+};
+
+uint64_t feature(Feature kind, uint64_t a, uint64_t b = 0, uint64_t c = 0) {
+    uint64_t h = StateHash::mix(static_cast<uint64_t>(kind) ^ (a << 8));
+    h = StateHash::mix(h ^ b);
+    return StateHash::mix(h ^ c);
+}
+
+// FNV-1a of the output with digits skipped, so "score is 10" and
+// "score is 15" are the same message
+uint64_t messageHash(const std::string& text) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+        }
+    }
+    return h;
+}
+
+// Set of features seen by any worker
+class CoverageMap {
+public:
+    CoverageMap() : words_(std::make_unique<std::atomic<uint64_t>[]>(BITS / 64)) {}
+
+    // Returns true if the feature was new
+    bool insert(uint64_t f) {
+        uint64_t bit = f & (BITS - 1);
+        uint64_t mask = 1ULL << (bit % 64);
+        auto& word = words_[bit / 64];
+        if (word.load(std::memory_order_relaxed) & mask) {
+            return false;
+        }
+        if (word.fetch_or(mask, std::memory_order_relaxed) & mask) {
+            return false;
+        }
+        count_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t size() const { return count_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t BITS = 1ULL << 22;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+    std::atomic<size_t> count_{0};
+};
+
+// What the watchdog needs to know about a worker
+struct Progress {
+    std::mutex mutex;
+    Log log;                               // guarded by mutex
+    std::atomic<int64_t> commandStart{0};  // ms since epoch; 0 when idle
+};
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               Clock::now().time_since_epoch()).count();
+}
+
+class Exploration {
+public:
+    Exploration(const Options& options, unsigned threads)
+        : options_(options), progress_(threads) {
+        corpus_.push_back(std::make_shared<const Log>());
+        for (auto& p : progress_) {
+            p = std::make_unique<Progress>();
+        }
+    }
+
+    void work(unsigned index);
+    Stats coordinate(unsigned threads);
+
+    // Fill in the counters (failures only once the workers are done)
+    void finish(Stats& stats, bool withFailures = true);
+
+private:
+    std::shared_ptr<const Log> pick(std::mt19937_64& rng);
+    std::string randomCommand(std::mt19937_64& rng);
+    bool cover(const StepResult& result, uint32_t flagsBefore, const std::string& output);
+    void report(Failure failure);
+    bool limitReached() const {
+        return stop_ || (options_.maxCommands && commands_ >= options_.maxCommands);
+    }
+
+    Options options_;
+    CoverageMap coverage_;
+    std::vector<std::unique_ptr<Progress>> progress_;
+
+    std::mutex corpusMutex_;
+    std::vector<std::shared_ptr<const Log>> corpus_;
+
+    std::mutex failureMutex_;
+    std::vector<Failure> failures_;
+    std::set<std::string> failureKeys_;
+
+    std::atomic<bool> stop_{false};
+    std::atomic<uint64_t> commands_{0};
+    std::atomic<uint64_t> runs_{0};
+};
+
+std::shared_ptr<const Log> Exploration::pick(std::mt19937_64& rng) {
+    std::lock_guard<std::mutex> lock(corpusMutex_);
+    return corpus_[rng() % corpus_.size()];
+}
+
+std::string Exploration::randomCommand(std::mt19937_64& rng) {
+    // Now and then ignore the syntax flags, to exercise refusals
+    std::vector<Action> actions =
+        rng() % 8 ? Engine::validActions() : ActionEnumerator::enumerate(false);
+    if (actions.empty()) {
+        return "";
+    }
+
+    // Directions get a third of the picks so the explorer keeps moving
+    auto firstVerb = std::partition(actions.begin(), actions.end(),
+                                    [](const Action& a) { return a.isDirection; });
+    size_t directions = static_cast<size_t>(firstVerb - actions.begin());
+    if (directions > 0 && (directions == actions.size() || rng() % 3 == 0)) {
+        return actions[rng() % directions].command;
+    }
+    return actions[directions + rng() % (actions.size() - directions)].command;
+}
+
+bool Exploration::cover(const StepResult& result, uint32_t flagsBefore,
+                        const std::string& output) {
+    auto& g = Globals::instance();
+    bool novel = false;
+    auto add = [&](uint64_t f) { novel = coverage_.insert(f) || novel; };
+
+    add(feature(Feature::ROOM, idOf(g.here)));
+    add(feature(Feature::MESSAGE, g.prsa, messageHash(output)));
+
+    uint32_t flagsAfter = globalFlags();
+    for (uint32_t changed = flagsBefore ^ flagsAfter; changed; changed &= changed - 1) {
+        int bit = __builtin_ctz(changed);
+        add(feature(Feature::GLOBAL_FLAG, bit, (flagsAfter >> bit) & 1));
+    }
+
+    if (!result.tookTurn) {
+        return novel;
+    }
+    add(feature(Feature::VERB, g.prsa, idOf(g.prso), idOf(g.prsi)));
+
+    if (const auto* turn = UndoSystem::UndoJournal::instance().getLastTurn()) {
+        for (const auto& change : turn->changes) {
+            auto* obj = static_cast<const ZObject*>(change.target);
+            if (change.kind == UndoSystem::Change::Kind::FLAGS) {
+                uint64_t now = obj->getAllFlags();
+                for (uint64_t flipped = now ^ static_cast<uint64_t>(change.value); flipped;
+                     flipped &= flipped - 1) {
+                    int bit = __builtin_ctzll(flipped);
+                    add(feature(Feature::FLAG, obj->getId(), bit, (now >> bit) & 1));
+                }
+            } else if (change.kind == UndoSystem::Change::Kind::LOCATION) {
+                add(feature(Feature::MOVE, obj->getId(), idOf(obj->getLocation())));
+            }
+        }
+    }
+
+    for (const auto& name : TimerSystem::TimerManager::instance().getFiredLastTick()) {
+        add(feature(Feature::TIMER, StateHash::nameKey(name)));
+    }
+    return novel;
+}
+
+void Exploration::report(Failure failure) {
+    std::string key = std::string(kindName(failure.kind)) + ": " + failure.message;
+    {
+        std::lock_guard<std::mutex> lock(failureMutex_);
+        if (failureKeys_.count(key)) {
+            return;
+        }
+    }
+
+    if (options_.minimize) {
+        auto reproduces = [&](const Log& log) {
+            auto f = replay(log, options_.seed);
+            return f && f->kind == failure.kind && f->message == failure.message;
+        };
+        if (auto f = replay(failure.commands, options_.seed);
+            f && f->kind == failure.kind && f->message == failure.message) {
+            failure.commands = minimize(f->commands, reproduces);
+        } else {
+            failure.message += " (does not reproduce from a new game)";
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(failureMutex_);
+    if (!failureKeys_.insert(key).second) {
+        return;
+    }
+    failures_.push_back(failure);
+    if (options_.onFailure) {
+        options_.onFailure(failure);
+    }
+    if (options_.stopOnFailure) {
+        stop_ = true;
+    }
+}
+
+void Exploration::work(unsigned index) {
+    std::ostringstream output;
+    std::istringstream noInput;
+    setOutputStream(&output);
+    setInputStream(&noInput);
+
+    std::mt19937_64 rng(StateHash::mix(options_.seed) + index);
+    auto& journal = UndoSystem::UndoJournal::instance();
+    Progress& progress = *progress_[index];
+    Parser::Memory startMemory;
+
+    auto newGame = [&]() {
+        Engine::newGame(options_.seed);
+        journal.clear();
+        journal.pushCheckpoint(); // undo never goes below the start state
+        startMemory = getGlobalParser().saveMemory();
+    };
+    newGame();
+
+    Log log;
+    while (!limitReached()) {
+        std::shared_ptr<const Log> base = pick(rng);
+        size_t keep = base->size();
+        if (keep > 0 && rng() % 4 == 0) {
+            keep = rng() % keep;
+        }
+
+        // Back to the start state (cheaper than a new game)
+        if (journal.rollbackToCheckpoint()) {
+            journal.pushCheckpoint();
+            getGlobalParser().restoreMemory(startMemory);
+            setOutputColumn(0);
+        } else {
+            newGame();
+        }
+
+        log.assign(base->begin(), base->begin() + static_cast<std::ptrdiff_t>(keep));
+        {
+            std::lock_guard<std::mutex> lock(progress.mutex);
+            progress.log = log;
+        }
+        crashLog.clear();
+        for (const auto& command : log) {
+            crashLog += command;
+            crashLog += '\n';
+        }
+
+        bool broken = false;
+        try {
+            for (const auto& command : log) {
+                Engine::step(command);
+            }
+        } catch (...) {
+            broken = true; // reported when the log was first played
+        }
+        commands_ += keep;
+
+        int count = 1 + static_cast<int>(rng() % static_cast<uint64_t>(options_.mutationLength));
+        for (int i = 0; i < count && !broken && log.size() < options_.maxLogLength; ++i) {
+            if (limitReached()) {
+                break;
+            }
+            std::string command = randomCommand(rng);
+            if (command.empty()) {
+                break;
+            }
+            log.push_back(command);
+            crashLog += command;
+            crashLog += '\n';
+            {
+                std::lock_guard<std::mutex> lock(progress.mutex);
+                progress.log.push_back(command);
+            }
+
+            output.str("");
+            uint32_t flagsBefore = globalFlags();
+            std::optional<Failure> failure;
+            StepResult result;
+            progress.commandStart = nowMs();
+            try {
+                result = Engine::step(command);
+            } catch (const std::exception& e) {
+                failure = Failure{Failure::Kind::EXCEPTION, e.what(), log};
+            } catch (...) {
+                failure = Failure{Failure::Kind::EXCEPTION, "unknown exception", log};
+            }
+            progress.commandStart = 0;
+            commands_++;
+
+            if (!failure) {
+                if (auto violation = checkInvariants()) {
+                    failure = Failure{Failure::Kind::INVARIANT, *violation, log};
+                }
+            }
+            if (failure) {
+                report(std::move(*failure));
+                broken = true;
+                break;
+            }
+
+            if (cover(result, flagsBefore, output.str()) && !limitReached()) {
+                std::lock_guard<std::mutex> lock(corpusMutex_);
+                corpus_.push_back(std::make_shared<const Log>(log));
+            }
+            if (result.died) {
+                break;
+            }
+        }
+        runs_++;
+
+        // The world may be inconsistent (or replaced by minimization)
+        if (broken) {
+            newGame();
+        }
+    }
+
+    journal.clear();
+    setOutputStream(nullptr);
+    setInputStream(nullptr);
+}
+
+Stats Exploration::coordinate(unsigned threads) {
+    auto start = Clock::now();
+    auto elapsed = [&start]() {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    double nextProgress = options_.progressSeconds;
+
+    while (!limitReached()) {
+        if (options_.seconds > 0 && elapsed() >= options_.seconds) {
+            stop_ = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        if (options_.onProgress && options_.progressSeconds > 0 && elapsed() >= nextProgress) {
+            Stats stats;
+            stats.seconds = elapsed();
+            stats.threads = threads;
+            finish(stats, false);
+            options_.onProgress(stats);
+            nextProgress += options_.progressSeconds;
+        }
+
+        // A command that never returns cannot be interrupted: report the
+        // log and end the process
+        int64_t now = nowMs();
+        for (auto& p : progress_) {
+            int64_t began = p->commandStart.load();
+            if (began && options_.hangSeconds > 0 &&
+                static_cast<double>(now - began) > options_.hangSeconds * 1000) {
+                Failure failure;
+                failure.kind = Failure::Kind::HANG;
+                failure.message = "command still running after " +
+                                  std::to_string(options_.hangSeconds) + " s";
+                {
+                    std::lock_guard<std::mutex> lock(p->mutex);
+                    failure.commands = p->log;
+                }
+                std::lock_guard<std::mutex> lock(failureMutex_);
+                if (options_.onFailure) {
+                    options_.onFailure(failure);
+                }
+                std::_Exit(3);
+            }
+        }
+    }
+
+    Stats stats;
+    stats.seconds = elapsed();
+    stats.threads = threads;
+    return stats;
+}
+
+void Exploration::finish(Stats& stats, bool withFailures) {
+    stats.commands = commands_;
+    stats.runs = runs_;
+    stats.features = coverage_.size();
+    {
+        std::lock_guard<std::mutex> lock(corpusMutex_);
+        stats.corpus = corpus_.size();
+    }
+    if (withFailures) {
+        stats.failures = failures_;
+    }
+}
+
+} // namespace
+
+const char* kindName(Failure::Kind kind) {
+    switch (kind) {
+        case Failure::Kind::EXCEPTION: return "exception";
+        case Failure::Kind::INVARIANT: return "invariant";
+        case Failure::Kind::HANG: return "hang";
+        case Failure::Kind::CRASH: return "crash";
+    }
+    return "";
+}
+
+std::optional<std::string> checkInvariants() {
+    auto& g = Globals::instance();
+    const auto& objects = g.getAllObjects();
+
+    // Which container lists each object
+    static thread_local std::unordered_map<const ZObject*, const ZObject*> listedIn;
+    listedIn.clear();
+    for (const auto& [_, obj] : objects) {
+        for (const ZObject* child : obj->getContents()) {
+            auto [it, inserted] = listedIn.emplace(child, obj.get());
+            if (!inserted) {
+                return describe(child) + " is in both " + describe(it->second) + " and " +
+                       describe(obj.get());
+            }
+            if (child->getLocation() != obj.get()) {
+                return describe(child) + " is listed in " + describe(obj.get()) +
+                       " but located in " + describe(child->getLocation());
+            }
+        }
+    }
+
+    for (const auto& [_, obj] : objects) {
+        const ZObject* location = obj->getLocation();
+        if (location && !listedIn.count(obj.get())) {
+            return describe(obj.get()) + " is located in " + describe(location) +
+                   " but missing from its contents";
+        }
+        size_t depth = 0;
+        for (const ZObject* p = location; p; p = p->getLocation()) {
+            if (p == obj.get() || ++depth > objects.size()) {
+                return "containment cycle through " + describe(obj.get());
+            }
+        }
+    }
+
+    if (!dynamic_cast<const ZRoom*>(g.here)) {
+        return "HERE is " + describe(g.here) + ", not a room";
+    }
+    if (g.winner) {
+        const ZObject* p = g.winner->getLocation();
+        while (p && p != g.here) {
+            p = p->getLocation();
+        }
+        if (!p) {
+            return "the player is in " + describe(g.winner->getLocation()) + " but HERE is " +
+                   describe(g.here);
+        }
+    }
+    if (ScoreSystem::instance().getScore() > ScoreSystem::MAX_SCORE) {
+        return "score " + std::to_string(ScoreSystem::instance().getScore()) + " exceeds " +
+               std::to_string(ScoreSystem::MAX_SCORE);
+    }
+    if (StateHash::incremental() != StateHash::scanIncremental()) {
+        return "incremental state hash differs from a full scan";
+    }
+    return std::nullopt;
+}
+
+std::optional<Failure> replay(const std::vector<std::string>& commands, uint32_t seed) {
+    std::ostream discard(nullptr); // an ostream without a buffer drops output
+    std::istringstream noInput;
+    std::ostream* oldOut = &outputStream();
+    std::istream* oldIn = &inputStream();
+    setOutputStream(&discard);
+    setInputStream(&noInput);
+
+    Engine::newGame(seed);
+    crashLog.clear();
+    std::optional<Failure> failure;
+    for (size_t i = 0; i < commands.size() && !failure; ++i) {
+        crashLog += commands[i];
+        crashLog += '\n';
+        try {
+            Engine::step(commands[i]);
+        } catch (const std::exception& e) {
+            failure = Failure{Failure::Kind::EXCEPTION, e.what(), {}};
+        } catch (...) {
+            failure = Failure{Failure::Kind::EXCEPTION, "unknown exception", {}};
+        }
+        if (!failure) {
+            if (auto violation = checkInvariants()) {
+                failure = Failure{Failure::Kind::INVARIANT, *violation, {}};
+            }
+        }
+        if (failure) {
+            failure->commands.assign(commands.begin(),
+                                     commands.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        }
+    }
+
+    setOutputStream(oldOut);
+    setInputStream(oldIn);
+    return failure;
+}
+
+std::vector<std::string> minimize(std::vector<std::string> commands,
+                                  const std::function<bool(const std::vector<std::string>&)>& fails) {
+    // Remove ever smaller chunks while the failure persists
+    size_t chunks = 2;
+    while (commands.size() >= 2) {
+        size_t chunk = (commands.size() + chunks - 1) / chunks;
+        bool reduced = false;
+        for (size_t begin = 0; begin < commands.size(); begin += chunk) {
+            std::vector<std::string> candidate(commands.begin(),
+                                               commands.begin() + static_cast<std::ptrdiff_t>(begin));
+            size_t end = std::min(begin + chunk, commands.size());
+            candidate.insert(candidate.end(), commands.begin() + static_cast<std::ptrdiff_t>(end),
+                             commands.end());
+            if (fails(candidate)) {
+                commands = std::move(candidate);
+                chunks = std::max<size_t>(chunks - 1, 2);
+                reduced = true;
+                break;
+            }
+        }
+        if (!reduced) {
+            if (chunk == 1) {
+                break;
+            }
+            chunks = std::min(chunks * 2, commands.size());
+        }
+    }
+    if (commands.size() == 1 && fails({})) {
+        commands.clear();
+    }
+    return commands;
+}
+
+Stats explore(const Options& options) {
+    unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    using Handler = void (*)(int);
+    std::vector<Handler> oldHandlers;
+    if (options.handleCrashes) {
+        for (int sig : FATAL_SIGNALS) {
+            oldHandlers.push_back(std::signal(sig, onFatalSignal));
+        }
+    }
+
+    Exploration exploration(options, threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([&exploration, i]() { exploration.work(i); });
+    }
+
+    Stats stats = exploration.coordinate(threads);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    exploration.finish(stats);
+
+    if (options.handleCrashes) {
+        for (size_t i = 0; i < oldHandlers.size(); ++i) {
+            std::signal(FATAL_SIGNALS[i], oldHandlers[i]);
+        }
+    }
+    return stats;
+}
+
+} // namespace Explorer
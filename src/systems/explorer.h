@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Explorer - coverage-guided random play for bug hunting
+//
+// Worker threads (each with its own game, see Solver) repeatedly take a
+// command log from the corpus, replay it from the start state and append
+// random commands drawn from Engine::validActions(). A log joins the
+// corpus when its last command reached something no earlier command did:
+// - a room
+// - a verb applied to a particular pair of objects
+// - a message (the command's output, digits ignored)
+// - an object flag being set or cleared, or a Globals puzzle flag changing
+// - an object moving into a particular container
+// - a timer firing
+// Flag changes and moves are read from the undo journal's record of the
+// turn, so only journaled state counts.
+//
+// After every command the world is checked (checkInvariants()) and C++
+// exceptions are caught. A failure is shrunk to a minimal command log by
+// replaying subsets of it from a new game. Crashes and hangs cannot be
+// contained in-process: with handleCrashes, a fatal signal prints the
+// crashing worker's command log before the process dies, and a command
+// running longer than hangSeconds is reported and ends the process.
+
+namespace Explorer {
+
+struct Failure {
+    enum class Kind { EXCEPTION, INVARIANT, HANG, CRASH };
+
+    Kind kind = Kind::INVARIANT;
+    std::string message;
+    std::vector<std::string> commands; // from a new game with Options::seed
+};
+
+// Name of a failure kind ("invariant", ...)
+const char* kindName(Failure::Kind kind);
+
+struct Stats {
+    uint64_t commands = 0;  // commands played, replays included
+    uint64_t runs = 0;      // corpus logs replayed and mutated
+    size_t corpus = 0;      // logs in the corpus
+    size_t features = 0;    // distinct coverage features reached
+    unsigned threads = 0;
+    double seconds = 0;
+    std::vector<Failure> failures;
+
+    double commandsPerSecond() const {
+        return seconds > 0 ? static_cast<double>(commands) / seconds : 0;
+    }
+};
+
+struct Options {
+    uint32_t seed = 1;
+
+    // Worker threads (0 = one per hardware thread)
+    unsigned threads = 0;
+
+    // Stop after this long or this many commands (0 = no limit)
+    double seconds = 60;
+    uint64_t maxCommands = 0;
+
+    // Random commands appended to a corpus log per run (1..mutationLength)
+    int mutationLength = 16;
+    // Longest command log kept in the corpus
+    size_t maxLogLength = 400;
+
+    // Shrink failing logs before reporting them
+    bool minimize = true;
+    bool stopOnFailure = false;
+
+    // Watchdog and fatal-signal reporting (see above)
+    double hangSeconds = 10;
+    bool handleCrashes = false;
+
+    // Called once per distinct failure (any thread, serialized)
+    std::function<void(const Failure&)> onFailure;
+    // Called on the calling thread every progressSeconds (failures empty)
+    std::function<void(const Stats&)> onProgress;
+    double progressSeconds = 10;
+};
+
+// Check the current world; returns a description of the first violation:
+// containment cycles, an object listed in two places or in a container
+// other than its location, the player outside the current room, a score
+// above the maximum, or a stale incremental state hash
+std::optional<std::string> checkInvariants();
+
+// Play commands from a new game, checking after each one. Returns the
+// failure (its log ending at the failing command), or nullopt.
+// Output is discarded.
+std::optional<Failure> replay(const std::vector<std::string>& commands, uint32_t seed);
+
+// Smallest log found (by removing chunks, ddmin style) for which
+// fails(log) still holds. fails(commands) must be true.
+std::vector<std::string> minimize(std::vector<std::string> commands,
+                                  const std::function<bool(const std::vector<std::string>&)>& fails);
+
+// Run the explorer. The calling thread's game is not touched.
+Stats explore(const Options& options);
+
+} // namespace Explorer
@@ -0,0 +1,286 @@
+/**
+ * @file fidelity.cpp
+ * @brief Differential testing against the original story file
+ *
+ * Workers take runs from a shared counter. Between runs the port goes
+ * back to the new game through the undo journal (as Explorer does) and
+ * the interpreter restarts, which only copies its dynamic memory back.
+ */
+
+#include "fidelity.h"
+#include "state_hash.h"
+#include "undo.h"
+#include "../core/engine.h"
+#include "../core/io.h"
+#include "../parser/parser.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace Fidelity {
+
+namespace {
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// The port and the interpreter playing the same game
+class Lockstep {
+public:
+    Lockstep(ZMachine& original, uint32_t seed) : original_(original), seed_(seed) {
+        setOutputStream(&output_);
+        setInputStream(&noInput_);
+    }
+
+    ~Lockstep() {
+        setOutputStream(nullptr);
+        setInputStream(nullptr);
+    }
+
+    // New game in both; with reuse, the port rolls back to the last start
+    // instead of rebuilding the world
+    void start(bool reuse) {
+        auto& journal = UndoSystem::UndoJournal::instance();
+        if (reuse && started_ && journal.rollbackToCheckpoint()) {
+            getGlobalParser().restoreMemory(startMemory_);
+        } else {
+            Engine::newGame(seed_);
+            journal.clear();
+            startMemory_ = getGlobalParser().saveMemory();
+            started_ = true;
+        }
+        journal.pushCheckpoint(); // undo never goes below the start state
+        setOutputColumn(0);
+        output_.str("");
+
+        original_.restart();
+        original_.seed(seed_);
+        original_.run(); // banner and opening room
+    }
+
+    bool finished() const { return original_.status() == ZMachine::Status::QUIT; }
+
+    // Play one command in both games and compare the output
+    std::optional<Divergence> play(const std::string& command) {
+        original_.input(command);
+        std::string expected = original_.run();
+        // Drop the original's prompt; the port's caller prints its own
+        while (!expected.empty() && (expected.back() == '>' || isSpace(expected.back()))) {
+            expected.pop_back();
+        }
+
+        Engine::step(command);
+        std::string actual = output_.str();
+        output_.str("");
+
+        auto want = paragraphs(expected);
+        auto got = paragraphs(actual);
+        size_t n = std::max(want.size(), got.size());
+        for (size_t i = 0; i < n; ++i) {
+            const std::string& w = i < want.size() ? want[i] : empty_;
+            const std::string& g = i < got.size() ? got[i] : empty_;
+            if (w != g) {
+                Divergence d;
+                d.paragraph = i;
+                d.expected = w;
+                d.actual = g;
+                d.random = original_.randomDraws() > 0;
+                return d;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    ZMachine& original_;
+    uint32_t seed_;
+    std::ostringstream output_;
+    std::istringstream noInput_;
+    Parser::Memory startMemory_;
+    bool started_ = false;
+    const std::string empty_;
+};
+
+// Play one run; fills commands with what was played up to a divergence
+std::optional<Divergence> play(Lockstep& game, bool reuse, std::vector<std::string>& commands,
+                               const std::vector<std::string>* script, std::mt19937_64* walk,
+                               size_t walkLength) {
+    game.start(reuse);
+    size_t length = script ? script->size() : walkLength;
+    for (size_t i = 0; i < length && !game.finished(); ++i) {
+        std::string command;
+        if (script) {
+            command = (*script)[i];
+        } else {
+            auto actions = Engine::validActions();
+            if (actions.empty()) {
+                break;
+            }
+            command = actions[(*walk)() % actions.size()].command;
+        }
+        commands.push_back(command);
+        if (auto divergence = game.play(command)) {
+            divergence->commands = commands;
+            return divergence;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+std::vector<std::string> paragraphs(std::string_view text) {
+    std::vector<std::string> result;
+    std::string current;
+    bool inParagraph = false;
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        bool blank = std::all_of(line.begin(), line.end(), isSpace);
+        if (blank) {
+            if (inParagraph) {
+                result.push_back(std::move(current));
+                current.clear();
+                inParagraph = false;
+            }
+            continue;
+        }
+
+        // Words of the line, single-spaced, appended to the paragraph
+        bool space = inParagraph;
+        for (char c : line) {
+            if (isSpace(c)) {
+                space = !current.empty();
+            } else {
+                if (space) {
+                    current += ' ';
+                    space = false;
+                }
+                current += c;
+            }
+        }
+        inParagraph = true;
+    }
+    if (inParagraph) {
+        result.push_back(std::move(current));
+    }
+    return result;
+}
+
+std::optional<Divergence> compare(ZMachine& original, const std::vector<std::string>& commands,
+                                  uint32_t seed) {
+    std::ostream* oldOut = &outputStream();
+    std::istream* oldIn = &inputStream();
+    std::optional<Divergence> result;
+    {
+        Lockstep game(original, seed);
+        std::vector<std::string> played;
+        result = play(game, false, played, &commands, nullptr, 0);
+        UndoSystem::UndoJournal::instance().clear();
+    }
+    setOutputStream(oldOut == &std::cout ? nullptr : oldOut);
+    setInputStream(oldIn == &std::cin ? nullptr : oldIn);
+    return result;
+}
+
+Report run(const Options& options) {
+    auto startTime = std::chrono::steady_clock::now();
+    ZMachine::Story story = ZMachine::load(options.storyPath);
+
+    unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    Report report;
+    size_t runs = options.scripts.size() + options.walks;
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::map<std::pair<std::string, std::string>, Divergence> found;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        size_t matched = 0;
+        size_t commands = 0;
+        try {
+            ZMachine original(story);
+            Lockstep game(original, options.seed);
+            std::vector<std::string> played;
+            for (size_t i; (i = next.fetch_add(1)) < runs;) {
+                played.clear();
+                std::optional<Divergence> divergence;
+                if (i < options.scripts.size()) {
+                    divergence = play(game, true, played, &options.scripts[i], nullptr, 0);
+                } else {
+                    // Each walk's choices depend only on the seed and its number
+                    std::mt19937_64 walk(StateHash::mix(options.seed) + i);
+                    divergence = play(game, true, played, nullptr, &walk, options.walkLength);
+                }
+                commands += played.size();
+                if (!divergence) {
+                    ++matched;
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                auto [it, inserted] = found.try_emplace({divergence->expected, divergence->actual},
+                                                        *divergence);
+                if (!inserted) {
+                    ++it->second.count;
+                    if (divergence->commands.size() < it->second.commands.size()) {
+                        it->second.commands = std::move(divergence->commands);
+                        it->second.random = divergence->random;
+                    }
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = runs; // stop the other workers
+        }
+        UndoSystem::UndoJournal::instance().clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        report.matched += matched;
+        report.commands += commands;
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    report.runs = runs;
+    for (auto& [key, divergence] : found) {
+        report.divergences.push_back(std::move(divergence));
+    }
+    std::stable_sort(report.divergences.begin(), report.divergences.end(),
+                     [](const Divergence& a, const Divergence& b) { return a.count > b.count; });
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return report;
+}
+
+} // namespace Fidelity
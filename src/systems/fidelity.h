@@ -0,0 +1,84 @@
+#pragma once
+#include "zmachine.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Fidelity - differential testing against the original story file
+//
+// The port and the original game (zil/COMPILED/zork1.z3 on ZMachine) play
+// the same commands in lockstep from a new game, and each command's output
+// is compared. The first difference is reported with the commands that
+// lead to it, so docs/TEXT_FIDELITY_AUDIT.md can be checked mechanically.
+//
+// Output is compared as paragraphs: runs of non-blank lines joined into
+// one line, with whitespace collapsed. The port wraps at WRAP_WIDTH and the
+// interpreter does not wrap at all, so line breaks inside a paragraph and
+// the number of blank lines between paragraphs are not compared. The
+// opening banner is not compared either.
+//
+// Both games are seeded from Options::seed, but their random number
+// generators cannot produce the same sequence: the original's choices
+// (combat, the thief, PICK-ONE messages) come from different draws than
+// the port's. A divergence in a command during which the original used
+// RANDOM is marked, since it may be chance rather than a bug.
+//
+// run() spreads many command sequences over worker threads; every worker
+// plays its own game (game state is per thread) and its own interpreter.
+
+namespace Fidelity {
+
+// Output of one command split into normalized paragraphs
+std::vector<std::string> paragraphs(std::string_view text);
+
+struct Divergence {
+    std::vector<std::string> commands; // from a new game; the last one diverged
+    size_t paragraph = 0;   // index in that command's output
+    std::string expected;   // the original's paragraph ("" if it printed less)
+    std::string actual;     // the port's paragraph ("" if it printed less)
+    bool random = false;    // the original used RANDOM during the command
+    size_t count = 1;       // runs that reached this divergence (run() only)
+};
+
+// Play commands from a new game in both the port (the calling thread's
+// game, which is replaced) and a fresh interpreter session. Returns the
+// first divergence, or nullopt if every command matched. The sequence
+// stops early if the original game quits.
+std::optional<Divergence> compare(ZMachine& original, const std::vector<std::string>& commands,
+                                  uint32_t seed);
+
+struct Options {
+    // Story file of the original game
+    std::string storyPath = "zil/COMPILED/zork1.z3";
+    uint32_t seed = 1;
+
+    // Worker threads (0 = one per hardware thread)
+    unsigned threads = 0;
+
+    // Fixed command sequences, each played from a new game
+    std::vector<std::vector<std::string>> scripts;
+
+    // Random walks: each command is drawn from Engine::validActions() in
+    // the port's current state, until a divergence or walkLength commands
+    size_t walks = 0;
+    size_t walkLength = 40;
+};
+
+struct Report {
+    size_t runs = 0;       // scripts and walks played
+    size_t matched = 0;    // runs without a divergence
+    size_t commands = 0;   // commands compared
+    double seconds = 0;
+    // Distinct divergences (by expected and actual text), most frequent
+    // first; each keeps the shortest command sequence that reached it
+    std::vector<Divergence> divergences;
+};
+
+// Play every script and walk. The calling thread's game is not touched.
+// Throws std::runtime_error if the story file cannot be loaded.
+Report run(const Options& options);
+
+} // namespace Fidelity
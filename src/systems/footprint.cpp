@@ -0,0 +1,86 @@
+#include "footprint.h"
+#include "timer.h"
+#include "undo.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "parser/parser.h"
+#include <sstream>
+
+namespace Footprint {
+
+namespace {
+
+// Bytes reserved by a string stream's buffer (its put area)
+struct StringBufferAccess : std::stringbuf {
+    static size_t capacity(std::stringbuf& buffer) {
+        auto begin = &StringBufferAccess::pbase;
+        auto end = &StringBufferAccess::epptr;
+        return static_cast<size_t>((buffer.*end)() - (buffer.*begin)());
+    }
+};
+
+void addObjects(Report& report) {
+    const auto& objects = Globals::instance().getAllObjects();
+    report[Part::OBJECTS] += heap(objects);
+    for (const auto& [id, object] : objects) {
+        object->addFootprint(report);
+    }
+}
+
+void addTimers(Report& report) {
+    const auto& timers = TimerSystem::TimerManager::instance();
+    const auto& table = timers.getAllTimers();
+    report[Part::TIMERS] += sizeof(timers) + heap(table) + heap(timers.getFiredLastTick());
+    size_t callbacks = table.size() * sizeof(TimerSystem::TimerCallback);
+    report[Part::TIMERS] -= callbacks;
+    report[Part::CLOSURES] += callbacks;
+}
+
+void addUndo(Report& report) {
+    const auto& journal = UndoSystem::UndoJournal::instance();
+    report[Part::UNDO] += sizeof(journal) + journal.getMemoryUsage();
+}
+
+void addOutput(Report& report) {
+    if (auto* buffer = dynamic_cast<std::stringbuf*>(outputStream().rdbuf())) {
+        size_t capacity = StringBufferAccess::capacity(*buffer);
+        report[Part::OUTPUT] += capacity > std::string().capacity() ? block(capacity + 1) : 0;
+    }
+}
+
+} // namespace
+
+std::string_view partName(Part part) {
+    switch (part) {
+        case Part::OBJECTS: return "objects";
+        case Part::VOCABULARY: return "vocabulary";
+        case Part::TEXT: return "text";
+        case Part::EXITS: return "exits";
+        case Part::CLOSURES: return "closures";
+        case Part::TIMERS: return "timers";
+        case Part::PARSER_HISTORY: return "parser history";
+        case Part::UNDO: return "undo";
+        case Part::OUTPUT: return "output";
+        default: return "?";
+    }
+}
+
+size_t Report::total() const {
+    size_t sum = 0;
+    for (size_t part : bytes) {
+        sum += part;
+    }
+    return sum;
+}
+
+Report current() {
+    Report report;
+    addObjects(report);
+    getGlobalParser().addFootprint(report);
+    addTimers(report);
+    addUndo(report);
+    addOutput(report);
+    return report;
+}
+
+} // namespace Footprint
@@ -0,0 +1,142 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Footprint - the memory a game session owns, by kind
+//
+// current() walks the calling thread's session (objects, rooms, the
+// parser, the timer manager, the undo journal, the output buffer). Each
+// member of an owner counts to its Part, both its bytes inside the owner
+// and the heap blocks behind it; the rest of the owner's body counts to
+// the owner's Part. So a ZObject's synonym vector and set are VOCABULARY
+// and its action is CLOSURES, while its id, flags and contents are
+// OBJECTS. A heap block counts as the chunk malloc carves for it (size
+// header and rounding included), so the total approximates what malloc
+// hands out to the session; zork_footprint compares it with the RSS of
+// many live sessions. A world built in its arena (Globals::makeObject)
+// has no per-block headers, so for it the total is an upper bound.
+//
+// It is an estimate from the containers' sizes and capacities (node sizes
+// follow libstdc++), not a census of the heap: std::function captures too
+// big for the function's own buffer live on the heap unseen (the world's
+// closures capture at most a few ids), and the fixed-size thread-local
+// state (Globals fields, NPC state, the random engine) is left out.
+//
+// Owners with private containers report themselves through an
+// addFootprint(Report&) member, using the helpers below.
+
+namespace Footprint {
+
+enum class Part : uint8_t {
+    OBJECTS,        // ZObject/ZRoom bodies, contents, properties, registry
+    VOCABULARY,     // object synonyms and adjectives, parser dictionaries
+    TEXT,           // descriptions, readable text, exit messages
+    EXITS,          // room exit tables
+    CLOSURES,       // object, room, exit and timer actions (std::function)
+    TIMERS,         // timer table and names
+    PARSER_HISTORY, // last command, last objects, orphan state
+    UNDO,           // undo journal
+    OUTPUT,         // the output stream's buffer, if the session captures
+    COUNT
+};
+
+constexpr size_t PARTS = static_cast<size_t>(Part::COUNT);
+
+std::string_view partName(Part part);
+
+struct Report {
+    std::array<size_t, PARTS> bytes{};
+
+    size_t& operator[](Part part) { return bytes[static_cast<size_t>(part)]; }
+    size_t operator[](Part part) const { return bytes[static_cast<size_t>(part)]; }
+
+    size_t total() const;
+};
+
+// The calling thread's session
+Report current();
+
+// -- Heap estimates ----------------------------------------------------------
+
+// The chunk glibc malloc (64-bit) uses for a request: an 8-byte size
+// header, rounded up to 16 bytes, 32 at least
+constexpr size_t BLOCK_HEADER = 8;
+constexpr size_t BLOCK_ALIGNMENT = 16;
+constexpr size_t MIN_BLOCK = 32;
+
+inline size_t block(size_t bytes) {
+    if (bytes == 0) {
+        return 0;
+    }
+    size_t chunk = (bytes + BLOCK_HEADER + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    return chunk < MIN_BLOCK ? MIN_BLOCK : chunk;
+}
+
+template <typename T>
+constexpr bool IS_STRING = false;
+template <typename Alloc>
+constexpr bool IS_STRING<std::basic_string<char, std::char_traits<char>, Alloc>> = true;
+
+// Strings up to the small-string capacity live inside the string
+template <typename Alloc>
+size_t heap(const std::basic_string<char, std::char_traits<char>, Alloc>& s) {
+    return s.capacity() > std::string().capacity() ? block(s.capacity() + 1) : 0;
+}
+
+template <typename T, typename Alloc>
+size_t heap(const std::vector<T, Alloc>& v) {
+    size_t bytes = block(v.capacity() * sizeof(T));
+    if constexpr (IS_STRING<T>) {
+        for (const auto& s : v) {
+            bytes += heap(s);
+        }
+    }
+    return bytes;
+}
+
+// Hash tables: a node per element (next pointer, value, and the cached
+// hash for string keys) plus the bucket array
+template <typename Key, typename Value>
+size_t hashNodes(size_t elements, size_t buckets) {
+    size_t node = sizeof(void*) + sizeof(Value) + (IS_STRING<Key> ? sizeof(size_t) : 0);
+    return elements * block(node) + (buckets > 1 ? block(buckets * sizeof(void*)) : 0);
+}
+
+template <typename Key, typename T, typename Hash, typename Equal, typename Alloc>
+size_t heap(const std::unordered_map<Key, T, Hash, Equal, Alloc>& m) {
+    size_t bytes = hashNodes<Key, std::pair<const Key, T>>(m.size(), m.bucket_count());
+    if constexpr (IS_STRING<Key>) {
+        for (const auto& [key, value] : m) {
+            bytes += heap(key);
+        }
+    }
+    return bytes;
+}
+
+template <typename Key, typename Hash, typename Equal, typename Alloc>
+size_t heap(const std::unordered_set<Key, Hash, Equal, Alloc>& s) {
+    size_t bytes = hashNodes<Key, Key>(s.size(), s.bucket_count());
+    if constexpr (IS_STRING<Key>) {
+        for (const auto& key : s) {
+            bytes += heap(key);
+        }
+    }
+    return bytes;
+}
+
+// Red-black tree: colour, parent, left and right, then the value
+template <typename Key, typename T, typename Compare, typename Alloc>
+size_t heap(const std::map<Key, T, Compare, Alloc>& m) {
+    return m.size() * block(4 * sizeof(void*) + sizeof(std::pair<const Key, T>));
+}
+
+} // namespace Footprint
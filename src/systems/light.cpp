@@ -5,11 +5,13 @@
 #include "../core/io.h"
 
 // Static member initialization
-int LightSystem::darknessTurns_ = 0;
-bool LightSystem::warnedAboutGrue_ = false;
+thread_local int LightSystem::darknessTurns_ = 0;
+thread_local bool LightSystem::warnedAboutGrue_ = false;
 
 // Check if a room is lit (Requirement 50)
-// Based on ZIL LIT? routine in gparser.zil
+// Based on ZIL LIT? routine in gparser.zil: the room's own light, lit
+// sources seen from the room, and the player's when the player is in it.
+// The counts are kept by ZObject (getLightSources), so nothing is searched.
 bool LightSystem::isRoomLit(ZObject* room) {
     if (!room) {
         return false;
@@ -22,44 +24,15 @@ bool LightSystem::isRoomLit(ZObject* room) {
         return true;
     }
     
-    // Check for light sources in the room
-    // Look through objects in the room
-    for (auto* obj : room->getContents()) {
-        if (obj && obj->hasFlag(ObjectFlag::LIGHTBIT) && obj->hasFlag(ObjectFlag::ONBIT)) {
-            return true;
-        }
-        
-        // Check inside open containers in the room
-        if (obj && obj->hasFlag(ObjectFlag::CONTBIT) && obj->hasFlag(ObjectFlag::OPENBIT)) {
-            for (auto* contained : obj->getContents()) {
-                if (contained && contained->hasFlag(ObjectFlag::LIGHTBIT) && 
-                    contained->hasFlag(ObjectFlag::ONBIT)) {
-                    return true;
-                }
-            }
-        }
-    }
-    
-    // Check player's inventory if player is in this room
-    if (g.winner && g.winner->getLocation() == room) {
-        for (auto* obj : g.winner->getContents()) {
-            if (obj && obj->hasFlag(ObjectFlag::LIGHTBIT) && obj->hasFlag(ObjectFlag::ONBIT)) {
-                return true;
-            }
-            
-            // Check inside open containers in inventory
-            if (obj && obj->hasFlag(ObjectFlag::CONTBIT) && obj->hasFlag(ObjectFlag::OPENBIT)) {
-                for (auto* contained : obj->getContents()) {
-                    if (contained && contained->hasFlag(ObjectFlag::LIGHTBIT) && 
-                        contained->hasFlag(ObjectFlag::ONBIT)) {
-                        return true;
-                    }
-                }
-            }
-        }
+    // Light sources in the room, at any depth of open or transparent
+    // containers
+    if (room->getLightSources() > 0) {
+        return true;
     }
     
-    return false;
+    // Player's inventory if player is in this room (or in an open vehicle
+    // in it)
+    return g.winner && g.winner->getLightSources() > 0 && g.winner->isVisibleIn(room);
 }
 
 // Check if player has a light source (Requirement 50)
@@ -70,43 +43,14 @@ bool LightSystem::hasLightSource() {
         return false;
     }
     
-    // Check player's inventory
-    for (auto* obj : g.winner->getContents()) {
-        if (obj && obj->hasFlag(ObjectFlag::LIGHTBIT) && obj->hasFlag(ObjectFlag::ONBIT)) {
-            return true;
-        }
-        
-        // Check inside open containers in inventory
-        if (obj && obj->hasFlag(ObjectFlag::CONTBIT) && obj->hasFlag(ObjectFlag::OPENBIT)) {
-            for (auto* contained : obj->getContents()) {
-                if (contained && contained->hasFlag(ObjectFlag::LIGHTBIT) && 
-                    contained->hasFlag(ObjectFlag::ONBIT)) {
-                    return true;
-                }
-            }
-        }
-    }
-    
-    // Check current room
-    if (g.here) {
-        for (auto* obj : g.here->getContents()) {
-            if (obj && obj->hasFlag(ObjectFlag::LIGHTBIT) && obj->hasFlag(ObjectFlag::ONBIT)) {
-                return true;
-            }
-            
-            // Check inside open containers in the room
-            if (obj && obj->hasFlag(ObjectFlag::CONTBIT) && obj->hasFlag(ObjectFlag::OPENBIT)) {
-                for (auto* contained : obj->getContents()) {
-                    if (contained && contained->hasFlag(ObjectFlag::LIGHTBIT) && 
-                        contained->hasFlag(ObjectFlag::ONBIT)) {
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    
-    return false;
+    // Player's inventory, then the current room
+    return g.winner->getLightSources() > 0 ||
+           (g.here && g.here->getLightSources() > 0);
+}
+
+void LightSystem::refresh() {
+    auto& g = Globals::instance();
+    g.lit = isRoomLit(g.here);
 }
 
 // Update lighting state (Requirement 50)
@@ -119,7 +63,7 @@ void LightSystem::updateLighting() {
     }
     
     bool wasLit = g.lit;
-    g.lit = isRoomLit(g.here);
+    refresh();
     
     // If we just went dark, warn the player
     if (wasLit && !g.lit) {
@@ -12,8 +12,13 @@ public:
     // Returns true if player inventory or current room has lit light sources
     static bool hasLightSource();
     
-    // Update lighting state after light source changes (Requirement 50)
-    // Should be called when lights are turned on/off or moved
+    // Recompute Globals::lit for the current room from the light source
+    // counts (O(1)). Object moves and light/container flag changes call it,
+    // and so does Globals::setHere, so lit is always current
+    static void refresh();
+    
+    // Update lighting state and report a change (Requirement 50)
+    // Prints "It is now pitch black." if lit was true before the update
     static void updateLighting();
     
     // Check for grue attack in darkness (Requirement 51)
@@ -24,6 +29,6 @@ public:
     static void reset();
     
 private:
-    static int darknessTurns_;      // Turns spent in darkness
-    static bool warnedAboutGrue_;   // Has player been warned?
+    static thread_local int darknessTurns_;      // Turns spent in darkness
+    static thread_local bool warnedAboutGrue_;   // Has player been warned?
 };
@@ -0,0 +1,499 @@
+#include "metrics.h"
+#include "core/object.h"
+#include "parser/parser.h"
+#include "parser/verb_registry.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+namespace Metrics {
+
+// -- Histogram ---------------------------------------------------------------
+
+int Histogram::bucketOf(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return static_cast<int>(ns);
+    }
+    int magnitude = std::bit_width(ns) - 1; // >= SUB_BITS
+    if (magnitude >= MAX_BITS) {
+        return BUCKETS - 1;
+    }
+    int sub = static_cast<int>((ns >> (magnitude - SUB_BITS)) & (SUB_BUCKETS - 1));
+    return (magnitude - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::bucketLow(int bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int magnitude = bucket / SUB_BUCKETS + SUB_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % SUB_BUCKETS);
+    return (uint64_t{SUB_BUCKETS} + sub) << (magnitude - SUB_BITS);
+}
+
+uint64_t Histogram::bucketHigh(int bucket) {
+    return bucket + 1 < BUCKETS ? bucketLow(bucket + 1) - 1 : std::numeric_limits<uint64_t>::max();
+}
+
+void Histogram::record(uint64_t ns) {
+    counts[bucketOf(ns)]++;
+    min = count ? std::min(min, ns) : ns;
+    max = std::max(max, ns);
+    count++;
+    sum += ns;
+}
+
+void Histogram::merge(const Histogram& other) {
+    if (!other.count) {
+        return;
+    }
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i] += other.counts[i];
+    }
+    min = count ? std::min(min, other.min) : other.min;
+    max = std::max(max, other.max);
+    count += other.count;
+    sum += other.sum;
+}
+
+uint64_t Histogram::percentile(double q) const {
+    if (!count) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(count));
+    rank = std::clamp<uint64_t>(rank, 1, count);
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketHigh(i), max);
+        }
+    }
+    return max;
+}
+
+// -- JSON --------------------------------------------------------------------
+
+namespace {
+
+std::string jsonString(std::string_view text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+void writeTiming(std::ostream& out, const Timing& timing) {
+    const Histogram& h = timing.latency;
+    char line[300];
+    std::snprintf(line, sizeof(line),
+                  "{\"calls\": %llu, \"timed\": %llu, \"mean_ns\": %.1f, \"p50_ns\": %llu, "
+                  "\"p90_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+                  static_cast<unsigned long long>(timing.calls),
+                  static_cast<unsigned long long>(h.count), h.mean(),
+                  static_cast<unsigned long long>(h.percentile(0.50)),
+                  static_cast<unsigned long long>(h.percentile(0.90)),
+                  static_cast<unsigned long long>(h.percentile(0.99)),
+                  static_cast<unsigned long long>(h.percentile(0.999)),
+                  static_cast<unsigned long long>(h.max));
+    out << line;
+}
+
+void writeTimings(std::ostream& out, const char* key, const std::map<std::string, Timing>& all) {
+    out << "  \"" << key << "\": {";
+    bool first = true;
+    for (const auto& [name, timing] : all) {
+        out << (first ? "" : ",") << "\n    " << jsonString(name) << ": ";
+        writeTiming(out, timing);
+        first = false;
+    }
+    out << (first ? "" : "\n  ") << "}";
+}
+
+void writeCounts(std::ostream& out, const char* key, const std::map<std::string, uint64_t>& all) {
+    out << "  \"" << key << "\": {";
+    bool first = true;
+    for (const auto& [name, count] : all) {
+        out << (first ? "" : ",") << "\n    " << jsonString(name) << ": " << count;
+        first = false;
+    }
+    out << (first ? "" : "\n  ") << "}";
+}
+
+} // namespace
+
+void Snapshot::writeJson(std::ostream& out) const {
+    out << "{\n  \"sample_every\": " << sampleEvery() << ",\n  \"parse\": ";
+    writeTiming(out, parse);
+    out << ",\n";
+    writeTimings(out, "verbs", verbs);
+    out << ",\n";
+    writeTimings(out, "timers", timers);
+    out << ",\n";
+    writeCounts(out, "object_actions", objectActions);
+    out << ",\n";
+    writeCounts(out, "room_actions", roomActions);
+    out << "\n}\n";
+}
+
+// -- Per-thread recorders ----------------------------------------------------
+
+namespace {
+
+constexpr size_t VERB_SLOTS = 512;   // indexed by VerbId
+constexpr size_t TIMER_SLOTS = 64;   // in order of first firing
+constexpr size_t OBJECT_SLOTS = 2048; // indexed by ObjectId; larger ids share slot 0
+
+// Written only by the owning thread (relaxed load + store, no locked
+// instructions), read by snapshot() from any thread
+using Cell = std::atomic<uint64_t>;
+
+inline void add(Cell& cell, uint64_t n) {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct LiveTiming {
+    explicit LiveTiming(std::string name_) : name(std::move(name_)) {}
+
+    const std::string name;
+    Cell calls{0};
+    Cell counts[Histogram::BUCKETS] = {};
+    Cell count{0};
+    Cell sum{0};
+    Cell min{0};
+    Cell max{0};
+
+    // One call that began at start (detail::UNTIMED if not sampled)
+    void record(uint64_t start, uint64_t end) {
+        add(calls, 1);
+        if (start != detail::UNTIMED) {
+            recordLatency(end - start);
+        }
+    }
+
+    void recordLatency(uint64_t ns) {
+        uint64_t n = count.load(std::memory_order_relaxed);
+        if (n == 0 || ns < min.load(std::memory_order_relaxed)) {
+            min.store(ns, std::memory_order_relaxed);
+        }
+        if (ns > max.load(std::memory_order_relaxed)) {
+            max.store(ns, std::memory_order_relaxed);
+        }
+        add(counts[Histogram::bucketOf(ns)], 1);
+        add(sum, ns);
+        count.store(n + 1, std::memory_order_relaxed);
+    }
+
+    void readInto(Timing& t) const {
+        t.calls += calls.load(std::memory_order_relaxed);
+        Histogram mine;
+        mine.count = count.load(std::memory_order_relaxed);
+        if (!mine.count) {
+            return;
+        }
+        for (int i = 0; i < Histogram::BUCKETS; ++i) {
+            mine.counts[i] = counts[i].load(std::memory_order_relaxed);
+        }
+        mine.sum = sum.load(std::memory_order_relaxed);
+        mine.min = min.load(std::memory_order_relaxed);
+        mine.max = max.load(std::memory_order_relaxed);
+        t.latency.merge(mine);
+    }
+
+    void clear() {
+        calls.store(0, std::memory_order_relaxed);
+        for (auto& c : counts) {
+            c.store(0, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        min.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+};
+
+// Invocation counts per object id, with the name seen first
+struct CountTable {
+    Cell counts[OBJECT_SLOTS] = {};
+    std::atomic<const std::string*> names[OBJECT_SLOTS] = {};
+
+    ~CountTable() {
+        for (auto& name : names) {
+            delete name.load(std::memory_order_relaxed);
+        }
+    }
+
+    void count(const ZObject& object) {
+        size_t slot = static_cast<size_t>(object.getId());
+        if (slot >= OBJECT_SLOTS) {
+            slot = 0;
+        }
+        if (!names[slot].load(std::memory_order_relaxed)) {
+            std::string name(slot ? std::string_view(object.getDesc()) : "(other)");
+            if (name.empty()) {
+                name = "#" + std::to_string(slot);
+            }
+            names[slot].store(new std::string(std::move(name)), std::memory_order_release);
+        }
+        add(counts[slot], 1);
+    }
+
+    void readInto(std::map<std::string, uint64_t>& out) const {
+        for (size_t i = 0; i < OBJECT_SLOTS; ++i) {
+            const std::string* name = names[i].load(std::memory_order_acquire);
+            uint64_t n = counts[i].load(std::memory_order_relaxed);
+            if (name && n) {
+                out[*name] += n;
+            }
+        }
+    }
+
+    void clear() {
+        for (auto& c : counts) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct Recorder {
+    LiveTiming parse{"parse"};
+    std::atomic<LiveTiming*> verbs[VERB_SLOTS] = {};
+    std::atomic<LiveTiming*> timers[TIMER_SLOTS] = {};
+    size_t timerCount = 0; // owner only; a game has a handful of timers
+    CountTable objects;
+    CountTable rooms;
+
+    ~Recorder() {
+        for (auto& v : verbs) {
+            delete v.load(std::memory_order_relaxed);
+        }
+        for (auto& t : timers) {
+            delete t.load(std::memory_order_relaxed);
+        }
+    }
+
+    void readInto(Snapshot& s) const {
+        parse.readInto(s.parse);
+        for (const auto& slot : verbs) {
+            if (const LiveTiming* h = slot.load(std::memory_order_acquire)) {
+                h->readInto(s.verbs[h->name]);
+            }
+        }
+        for (const auto& slot : timers) {
+            if (const LiveTiming* h = slot.load(std::memory_order_acquire)) {
+                h->readInto(s.timers[h->name]);
+            }
+        }
+        objects.readInto(s.objectActions);
+        rooms.readInto(s.roomActions);
+    }
+
+    void clear() {
+        parse.clear();
+        for (auto& slot : verbs) {
+            if (LiveTiming* h = slot.load(std::memory_order_acquire)) {
+                h->clear();
+            }
+        }
+        for (auto& slot : timers) {
+            if (LiveTiming* h = slot.load(std::memory_order_acquire)) {
+                h->clear();
+            }
+        }
+        objects.clear();
+        rooms.clear();
+    }
+};
+
+// Live recorders, and what exited threads recorded
+struct Registry {
+    std::mutex mutex;
+    std::vector<Recorder*> live;
+    Snapshot retired;
+};
+
+Registry& registry() {
+    // Never destroyed: threads may exit after static destruction begins
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+// The calling thread's recorder (handle.recorder), trivially initialised
+// so that reading it needs no check for dynamic initialisation
+thread_local Recorder* current = nullptr;
+
+// Owns the calling thread's recorder and retires it at thread exit
+struct RecorderHandle {
+    Recorder* recorder = nullptr;
+
+    ~RecorderHandle() {
+        if (!recorder) {
+            return;
+        }
+        Registry& r = registry();
+        std::lock_guard lock(r.mutex);
+        recorder->readInto(r.retired);
+        std::erase(r.live, recorder);
+        delete recorder;
+        current = nullptr;
+    }
+};
+
+thread_local RecorderHandle handle;
+
+Recorder& newRecorder() {
+    current = handle.recorder = new Recorder;
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    r.live.push_back(current);
+    return *current;
+}
+
+inline Recorder& local() {
+    return current ? *current : newRecorder();
+}
+
+std::string verbName(VerbId verb) {
+    const VerbRegistry* verbs = getGlobalParser().getVerbRegistry();
+    std::string_view word = verbs ? verbs->getPrimaryWord(verb) : std::string_view();
+    return word.empty() ? "verb " + std::to_string(verb) : std::string(word);
+}
+
+} // namespace
+
+// -- Recording ---------------------------------------------------------------
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+std::atomic<uint32_t> sampleMask{63};
+thread_local uint32_t sampleState = 0x9e3779b9;
+
+uint64_t recordParse(uint64_t start) {
+    uint64_t end = start == UNTIMED ? UNTIMED : now();
+    local().parse.record(start, end);
+    return end;
+}
+
+void recordVerb(VerbId verb, uint64_t start) {
+    uint64_t end = start == UNTIMED ? UNTIMED : now();
+    if (verb < 0 || static_cast<size_t>(verb) >= VERB_SLOTS) {
+        return;
+    }
+    auto& slot = local().verbs[verb];
+    LiveTiming* h = slot.load(std::memory_order_relaxed);
+    if (!h) {
+        h = new LiveTiming(verbName(verb));
+        slot.store(h, std::memory_order_release);
+    }
+    h->record(start, end);
+}
+
+void recordTimer(std::string_view name, uint64_t start) {
+    uint64_t end = start == UNTIMED ? UNTIMED : now();
+    Recorder& r = local();
+    for (size_t i = 0; i < r.timerCount; ++i) {
+        LiveTiming* h = r.timers[i].load(std::memory_order_relaxed);
+        if (h->name == name) {
+            h->record(start, end);
+            return;
+        }
+    }
+    if (r.timerCount < TIMER_SLOTS) {
+        auto* h = new LiveTiming(std::string(name));
+        r.timers[r.timerCount++].store(h, std::memory_order_release);
+        h->record(start, end);
+    }
+}
+
+void countObjectAction(const ZObject& object) {
+    local().objects.count(object);
+}
+
+void countRoomAction(const ZObject& room) {
+    local().rooms.count(room);
+}
+
+} // namespace detail
+
+void setEnabled(bool on) {
+    detail::enabled.store(on, std::memory_order_relaxed);
+}
+
+void setSampleEvery(uint32_t n) {
+    detail::sampleMask.store(std::bit_ceil(std::max(n, 1u)) - 1, std::memory_order_relaxed);
+}
+
+uint32_t sampleEvery() {
+    return detail::sampleMask.load(std::memory_order_relaxed) + 1;
+}
+
+Snapshot snapshot() {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    Snapshot s = r.retired;
+    for (const Recorder* recorder : r.live) {
+        recorder->readInto(s);
+    }
+    return s;
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    r.retired = Snapshot{};
+    for (Recorder* recorder : r.live) {
+        recorder->clear();
+    }
+}
+
+// -- Periodic dump -----------------------------------------------------------
+
+PeriodicDump::PeriodicDump(std::string path, std::chrono::milliseconds interval)
+    : path_(std::move(path)), interval_(interval) {
+    thread_ = std::thread([this]() {
+        std::unique_lock lock(mutex_);
+        while (!wake_.wait_for(lock, interval_, [this]() { return stop_; })) {
+            dump();
+        }
+    });
+}
+
+PeriodicDump::~PeriodicDump() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+    dump();
+}
+
+bool PeriodicDump::dump() const {
+    std::string temporary = path_ + ".tmp";
+    {
+        std::ofstream out(temporary);
+        snapshot().writeJson(out);
+        if (!out) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path_.c_str()) == 0;
+}
+
+} // namespace Metrics
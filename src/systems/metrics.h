@@ -0,0 +1,189 @@
+#pragma once
+#include "core/types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Metrics - counters and latency histograms of the turn loop
+//
+// Recorded while enabled (off by default):
+// - parse latency (Parser::parse from Engine)
+// - dispatch latency per verb (the verb handler, from the end of parsing
+//   to the end of the handler)
+// - cost of each timer callback, per timer name
+// - invocations of each object's action handler (ZObject::performAction)
+// - invocations of each room's action handler (ZRoom::performRoomAction)
+//
+// Every thread records into its own Recorder, so the hot path never
+// writes a cache line another thread writes. snapshot() merges the
+// recorders of all live threads plus whatever exited threads left
+// behind; it may be called from any thread at any time.
+//
+// Invocations are all counted, but only a random sample of them is timed
+// (one in sampleEvery(), 64 by default): a clock read costs about as much
+// as a timer callback, and timing every one would slow the turn loop
+// down by several percent; sampled, recording stays near 1%. Latencies go into log-linear histograms in
+// the style of HdrHistogram: each power of two is split into 8 buckets,
+// so any recorded value is within 12.5% of the bucket it is reported as.
+
+class ZObject;
+
+namespace Metrics {
+
+// Log-linear histogram of nanosecond values
+class Histogram {
+public:
+    static constexpr int SUB_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int MAX_BITS = 36; // values from 2^36 ns (about 69 s) share the last bucket
+    static constexpr int BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketOf(uint64_t ns);
+    static uint64_t bucketLow(int bucket);  // smallest value in bucket
+    static uint64_t bucketHigh(int bucket); // largest value in bucket
+
+    std::vector<uint64_t> counts = std::vector<uint64_t>(BUCKETS);
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+
+    void record(uint64_t ns);
+    void merge(const Histogram& other);
+
+    double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0; }
+
+    // Upper bound of the bucket holding the value at fraction q (0..1),
+    // capped at the largest value recorded
+    uint64_t percentile(double q) const;
+};
+
+// Invocation count and the latencies of the sampled invocations
+struct Timing {
+    uint64_t calls = 0;
+    Histogram latency;
+};
+
+// Merged view of everything recorded
+struct Snapshot {
+    Timing parse;                          // one call per command
+    std::map<std::string, Timing> verbs;   // by verb word ("take", "walk")
+    std::map<std::string, Timing> timers;  // by timer name ("I-LANTERN")
+    std::map<std::string, uint64_t> objectActions; // by object description
+    std::map<std::string, uint64_t> roomActions;   // by room name (rooms
+                                                    // sharing a name add up)
+
+    // JSON object with calls, timed calls and mean/p50/p90/p99/p999/max
+    // (ns) per timing
+    void writeJson(std::ostream& out) const;
+};
+
+namespace detail {
+extern std::atomic<bool> enabled;
+extern std::atomic<uint32_t> sampleMask;
+extern thread_local uint32_t sampleState;
+
+constexpr uint64_t UNTIMED = 1; // enabled, but this call is not sampled
+
+uint64_t now();
+uint64_t recordParse(uint64_t start);
+void recordVerb(VerbId verb, uint64_t start);
+void recordTimer(std::string_view name, uint64_t start);
+void countObjectAction(const ZObject& object);
+void countRoomAction(const ZObject& room);
+} // namespace detail
+
+inline bool enabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool on);
+
+// Time one call in every n (rounded up to a power of two; 1 times all)
+void setSampleEvery(uint32_t n);
+uint32_t sampleEvery();
+
+// Start of a measurement: 0 while disabled, otherwise a timestamp if this
+// call is sampled, detail::UNTIMED if not
+inline uint64_t start() {
+    if (!enabled()) {
+        return 0;
+    }
+    uint32_t& x = detail::sampleState; // xorshift32
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return (x & detail::sampleMask.load(std::memory_order_relaxed)) ? detail::UNTIMED : detail::now();
+}
+
+// Record a parse that began at start; returns the start of dispatch to
+// pass on to dispatched() (the time the parse ended if it was timed)
+inline uint64_t parsed(uint64_t start) {
+    return start ? detail::recordParse(start) : 0;
+}
+
+// Record a verb handler that began at start
+inline void dispatched(VerbId verb, uint64_t start) {
+    if (start) {
+        detail::recordVerb(verb, start);
+    }
+}
+
+// Record a timer callback that began at start
+inline void timerFired(std::string_view name, uint64_t start) {
+    if (start) {
+        detail::recordTimer(name, start);
+    }
+}
+
+inline void objectAction(const ZObject& object) {
+    if (enabled()) {
+        detail::countObjectAction(object);
+    }
+}
+
+inline void roomAction(const ZObject& room) {
+    if (enabled()) {
+        detail::countRoomAction(room);
+    }
+}
+
+// Everything recorded so far, merged across threads
+Snapshot snapshot();
+
+// Forget everything recorded so far (every thread's recorder)
+void reset();
+
+// Write snapshot() to a file every interval, and once more when
+// destroyed. The file is replaced atomically (written beside it, then
+// renamed), so a reader never sees half a dump.
+class PeriodicDump {
+public:
+    PeriodicDump(std::string path, std::chrono::milliseconds interval);
+    ~PeriodicDump();
+
+    PeriodicDump(const PeriodicDump&) = delete;
+    PeriodicDump& operator=(const PeriodicDump&) = delete;
+
+    // Write the file now; false if it could not be written
+    bool dump() const;
+
+private:
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace Metrics
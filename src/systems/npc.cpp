@@ -5,24 +5,20 @@
 #include "world/rooms.h"
 #include "world/objects.h"
 #include "systems/timer.h"
+#include "core/random.h"
 #include <algorithm>
-#include <random>
 
 namespace NPCSystem {
 
 // Global thief state
-static ThiefState thiefState;
-
-// Random number generator
-static std::mt19937 rng(std::random_device{}());
+static thread_local ThiefState thiefState;
 
 ThiefState& getThiefState() {
     return thiefState;
 }
 
 int randomRange(int min, int max) {
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(rng);
+    return Random::range(min, max);
 }
 
 ZObject* getThief() {
@@ -262,10 +258,10 @@ bool thiefSteal() {
     
     // Thief prefers to steal treasures
     // First, look for treasures in the room
-    std::vector<ZObject*> roomTreasures;
-    std::vector<ZObject*> playerTreasures;
-    std::vector<ZObject*> roomItems;
-    std::vector<ZObject*> playerItems;
+    std::pmr::vector<ZObject*> roomTreasures(g.scratch());
+    std::pmr::vector<ZObject*> playerTreasures(g.scratch());
+    std::pmr::vector<ZObject*> roomItems(g.scratch());
+    std::pmr::vector<ZObject*> playerItems(g.scratch());
     
     // Check room contents
     for (auto* obj : g.here->getContents()) {
@@ -450,7 +446,7 @@ void thiefTreasureRoom() {
     
     // When in treasure room, thief empties bag
     // Move all items from bag to treasure room
-    std::vector<ZObject*> bagContents;
+    std::pmr::vector<ZObject*> bagContents(g.scratch());
     for (auto* obj : bag->getContents()) {
         bagContents.push_back(obj);
     }
@@ -590,7 +586,7 @@ bool processThiefTurn() {
 // ============================================================================
 
 // Global troll state
-static TrollState trollState;
+static thread_local TrollState trollState;
 
 TrollState& getTrollState() {
     return trollState;
@@ -851,7 +847,7 @@ bool trollAction() {
 // ============================================================================
 
 // Global cyclops state
-static CyclopsState cyclopsState;
+static thread_local CyclopsState cyclopsState;
 
 // Cyclops anger messages (from CYCLOMAD table in ZIL)
 static const std::vector<std::string> cyclopsAngerMessages = {
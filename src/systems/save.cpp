@@ -3,6 +3,7 @@
 #include "../core/object.h"
 #include "timer.h"
 #include "score.h"
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -11,7 +12,7 @@
 namespace SaveSystem {
 
 // File format version
-constexpr const char* SAVE_VERSION = "ZORK_SAVE_V1";
+constexpr const char* SAVE_VERSION = "ZORK_SAVE_V2";
 
 std::string_view errorToString(SaveError error) {
     switch (error) {
@@ -202,7 +203,7 @@ bool deserializeState(std::ifstream& in) {
     
     // Set player location
     if (playerLocation != 0) {
-        g.here = g.getObject(playerLocation);
+        g.setHere(g.getObject(playerLocation));
     }
     
     return true;
@@ -215,7 +216,7 @@ void serializeObject(std::ofstream& out, ObjectId id) {
     
     if (!obj) return;
     
-    // Format: OBJECT=<id>,<location_id>,<flags>,<properties>
+    // Format: OBJECT=<id>,<location_id>,<flags>,<property_mask>,<properties>
     out << "OBJECT=" << id << ",";
     
     // Save location
@@ -229,17 +230,19 @@ void serializeObject(std::ofstream& out, ObjectId id) {
     // Save flags as hex value
     out << std::hex << obj->getAllFlags() << std::dec << ",";
     
-    // Save properties
-    // Format: prop1:val1;prop2:val2;...
+    // Save properties: the mask of those set (hex), then their values in
+    // property id order
+    // Format: <mask>,val1;val2;...
     const auto& props = obj->getAllProperties();
+    out << std::hex << unsigned{props.mask()} << std::dec << ",";
     bool first = true;
     for (const auto& [propId, value] : props) {
         if (!first) out << ";";
-        out << propId << ":" << value;
+        out << value;
         first = false;
     }
     
-    // Save text property if present
+    // Save text property if present (last: the text may hold separators)
     if (obj->hasText()) {
         if (!first) out << ";";
         out << "TEXT:" << obj->getText();
@@ -250,7 +253,7 @@ void serializeObject(std::ofstream& out, ObjectId id) {
 
 // Deserialize a single object
 bool deserializeObject(std::ifstream& in, const std::string& line) {
-    // Parse: OBJECT=<id>,<location_id>,<flags>,<properties>
+    // Parse: OBJECT=<id>,<location_id>,<flags>,<property_mask>,<properties>
     size_t eqPos = line.find('=');
     if (eqPos == std::string::npos) return false;
     
@@ -283,30 +286,28 @@ bool deserializeObject(std::ifstream& in, const std::string& line) {
     uint32_t flags = std::stoul(token, nullptr, 16);
     obj->setAllFlags(flags);
     
-    // Parse and restore properties
-    if (std::getline(ss, token)) {
-        // Parse properties: prop1:val1;prop2:val2;...
-        if (!token.empty()) {
-            std::istringstream propStream(token);
-            std::string propPair;
-            
-            while (std::getline(propStream, propPair, ';')) {
-                size_t colonPos = propPair.find(':');
-                if (colonPos != std::string::npos) {
-                    std::string propKey = propPair.substr(0, colonPos);
-                    std::string propValue = propPair.substr(colonPos + 1);
-                    
-                    // Handle TEXT property specially
-                    if (propKey == "TEXT") {
-                        obj->setText(propValue);
-                    } else {
-                        PropertyId propId = std::stoi(propKey);
-                        int value = std::stoi(propValue);
-                        obj->setProperty(propId, value);
-                    }
-                }
-            }
+    // Parse and restore properties: the mask says which are set, and the
+    // values follow in property id order
+    if (!std::getline(ss, token, ',')) return false;
+    unsigned long mask = std::stoul(token, nullptr, 16);
+    if (mask >> PropertyTable::SLOTS) return false;
+    std::string values;
+    std::getline(ss, values);
+    size_t pos = 0;
+    for (PropertyId propId = 0; propId < PropertyTable::SLOTS; ++propId) {
+        if (!(mask & (1ul << propId))) {
+            obj->removeProperty(propId);
+            continue;
         }
+        if (pos >= values.size()) return false;
+        size_t end = std::min(values.find(';', pos), values.size());
+        obj->setProperty(propId, std::stoi(values.substr(pos, end - pos)));
+        pos = end + 1;
+    }
+    
+    // Text property, if saved, comes last
+    if (pos < values.size() && values.compare(pos, 5, "TEXT:") == 0) {
+        obj->setText(std::string_view(values).substr(pos + 5));
     }
     
     return true;
@@ -1,19 +1,26 @@
 #include "score.h"
+#include "state_hash.h"
+#include "undo.h"
 
 // External flag from actions.cpp for end game access
-extern bool wonFlag;
+extern thread_local bool wonFlag;
 
 ScoreSystem& ScoreSystem::instance() {
-    static ScoreSystem instance;
+    static thread_local ScoreSystem instance;
     return instance;
 }
 
 // Requirement 52, 85: Add points to score
 void ScoreSystem::addScore(int points) {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(score_);
+    }
+    StateHash::toggle(StateHash::scoreKey(score_));
     score_ += points;
     if (score_ > MAX_SCORE) {
         score_ = MAX_SCORE;
     }
+    StateHash::toggle(StateHash::scoreKey(score_));
     
     // Trigger end game when max score reached (Requirement 70: Winnability)
     if (score_ >= MAX_SCORE && !wonFlag) {
@@ -23,9 +30,27 @@ void ScoreSystem::addScore(int points) {
 
 // Requirement 53: Increment move counter
 void ScoreSystem::incrementMoves() {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(moves_);
+    }
     moves_++;
 }
 
+void ScoreSystem::setScore(int score) {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(score_);
+    }
+    StateHash::toggle(StateHash::scoreKey(score_) ^ StateHash::scoreKey(score));
+    score_ = score;
+}
+
+void ScoreSystem::setMoves(int moves) {
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(moves_);
+    }
+    moves_ = moves;
+}
+
 // Requirement 54: Get player's rank based on score
 std::string_view ScoreSystem::getRank() const {
     return calculateRank();
@@ -46,7 +71,19 @@ std::string_view ScoreSystem::calculateRank() const {
 
 // Requirement 85: Mark treasure as scored to prevent double-scoring
 void ScoreSystem::markTreasureScored(ObjectId treasureId) {
-    scoredTreasures_.insert(treasureId);
+    if (!scoredTreasures_.insert(treasureId).second) {
+        return;
+    }
+    StateHash::toggle(StateHash::treasureKey(treasureId));
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordTreasureScored(treasureId);
+    }
+}
+
+void ScoreSystem::unmarkTreasureScored(ObjectId treasureId) {
+    if (scoredTreasures_.erase(treasureId)) {
+        StateHash::toggle(StateHash::treasureKey(treasureId));
+    }
 }
 
 // Requirement 85: Check if treasure has already been scored
@@ -56,6 +93,10 @@ bool ScoreSystem::isTreasureScored(ObjectId treasureId) const {
 
 // Reset score system for new game
 void ScoreSystem::reset() {
+    StateHash::toggle(StateHash::scoreKey(score_));
+    for (ObjectId treasureId : scoredTreasures_) {
+        StateHash::toggle(StateHash::treasureKey(treasureId));
+    }
     score_ = 0;
     moves_ = 0;
     scoredTreasures_.clear();
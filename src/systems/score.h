@@ -24,6 +24,12 @@ public:
     // Treasure scoring (Requirement 85)
     void markTreasureScored(ObjectId treasureId);
     bool isTreasureScored(ObjectId treasureId) const;
+    const std::unordered_set<ObjectId>& getScoredTreasures() const { return scoredTreasures_; }
+    
+    // Direct setters (for restore and undo)
+    void setScore(int score);
+    void setMoves(int moves);
+    void unmarkTreasureScored(ObjectId treasureId);
     
     // Reset for new game
     void reset();
@@ -0,0 +1,311 @@
+#include "slow_turns.h"
+#include "state_hash.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "core/random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace SlowTurns {
+
+namespace {
+
+constexpr const char* HEADER = "ZORK_SLOW_TURN_V1";
+constexpr const char* PREFIX = "slow-turn-";
+constexpr const char* SUFFIX = ".txt";
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+// Commands are one line each in the file
+std::string oneLine(std::string_view text) {
+    std::string line(text);
+    std::replace(line.begin(), line.end(), '\n', ' ');
+    std::replace(line.begin(), line.end(), '\r', ' ');
+    return line;
+}
+
+// The ring (shared by all threads)
+struct Ring {
+    std::mutex mutex;
+    Options options;
+    std::atomic<uint64_t> thresholdNs{0};
+    std::atomic<uint64_t> nextSequence{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> epoch{0}; // bumped by enable()
+};
+
+Ring& ring() {
+    // Never destroyed: threads may exit after static destruction begins
+    static Ring* instance = new Ring;
+    return *instance;
+}
+
+// The calling thread's game
+struct Session {
+    uint64_t epoch = 0; // ring epoch when the game began; history is
+                        // complete only if it is still the current one
+    uint32_t seed = 0;
+    bool openingLook = false;
+    std::vector<std::string> history;
+
+    // The turn being played
+    bool inTurn = false;
+    uint64_t start = 0;
+    uint64_t lastMark = 0;
+    std::array<uint64_t, static_cast<size_t>(Phase::COUNT)> phaseNs{};
+    Random::Engine random; // formatted only if the turn turns out slow
+    uint64_t hashBefore = 0;
+    int moves = 0;
+    ObjectId room = 0;
+};
+
+thread_local Session session;
+
+void writeIncident(const Incident& incident) {
+    Ring& r = ring();
+    std::string path, temporary;
+    {
+        std::lock_guard lock(r.mutex);
+        if (r.options.directory.empty()) {
+            return;
+        }
+        path = slotPath(r.options.directory,
+                        static_cast<size_t>(incident.sequence % r.options.capacity));
+    }
+    temporary = path + "." + std::to_string(incident.sequence) + ".tmp";
+    {
+        std::ofstream out(temporary);
+        incident.write(out);
+        if (!out) {
+            std::remove(temporary.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) == 0) {
+        r.written.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+std::string_view phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::PARSE: return "parse";
+        case Phase::HANDLER: return "handler";
+        case Phase::TIMERS: return "timers";
+        case Phase::NPCS: return "npcs";
+        default: return "?";
+    }
+}
+
+// -- Incident files ------------------------------------------------------------
+
+void Incident::write(std::ostream& out) const {
+    out << HEADER << "\n";
+    out << "SEQUENCE=" << sequence << "\n";
+    out << "COMMAND=" << oneLine(command) << "\n";
+    out << "TURN_NS=" << turnNs << "\n";
+    for (size_t i = 0; i < phaseNs.size(); ++i) {
+        out << "PHASE=" << phaseName(static_cast<Phase>(i)) << "," << phaseNs[i] << "\n";
+    }
+    out << "SEED=" << seed << "\n";
+    out << "OPENING_LOOK=" << openingLook << "\n";
+    out << "RANDOM=" << random << "\n";
+    out << "HASH_BEFORE=" << std::hex << hashBefore << "\n";
+    out << "HASH_AFTER=" << hashAfter << std::dec << "\n";
+    out << "MOVES=" << moves << "\n";
+    out << "ROOM=" << room << "\n";
+    for (const auto& command : history) {
+        out << "HISTORY=" << oneLine(command) << "\n";
+    }
+}
+
+std::optional<Incident> Incident::read(std::istream& in) {
+    std::string line;
+    if (!std::getline(in, line) || line != HEADER) {
+        return std::nullopt;
+    }
+    Incident incident;
+    try {
+        while (std::getline(in, line)) {
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) {
+                continue;
+            }
+            std::string key = line.substr(0, eq);
+            std::string value = line.substr(eq + 1);
+            if (key == "SEQUENCE") {
+                incident.sequence = std::stoull(value);
+            } else if (key == "COMMAND") {
+                incident.command = value;
+            } else if (key == "TURN_NS") {
+                incident.turnNs = std::stoull(value);
+            } else if (key == "PHASE") {
+                size_t comma = value.find(',');
+                for (size_t i = 0; i < incident.phaseNs.size(); ++i) {
+                    if (value.compare(0, comma, phaseName(static_cast<Phase>(i))) == 0) {
+                        incident.phaseNs[i] = std::stoull(value.substr(comma + 1));
+                    }
+                }
+            } else if (key == "SEED") {
+                incident.seed = static_cast<uint32_t>(std::stoul(value));
+            } else if (key == "OPENING_LOOK") {
+                incident.openingLook = value == "1";
+            } else if (key == "RANDOM") {
+                incident.random = value;
+            } else if (key == "HASH_BEFORE") {
+                incident.hashBefore = std::stoull(value, nullptr, 16);
+            } else if (key == "HASH_AFTER") {
+                incident.hashAfter = std::stoull(value, nullptr, 16);
+            } else if (key == "MOVES") {
+                incident.moves = std::stoi(value);
+            } else if (key == "ROOM") {
+                incident.room = static_cast<ObjectId>(std::stoi(value));
+            } else if (key == "HISTORY") {
+                incident.history.push_back(value);
+            }
+        }
+    } catch (const std::exception&) {
+        return std::nullopt; // malformed number
+    }
+    return incident;
+}
+
+std::string slotPath(const std::string& directory, size_t slot) {
+    return (std::filesystem::path(directory) / (PREFIX + std::to_string(slot) + SUFFIX)).string();
+}
+
+std::vector<Incident> list(const std::string& directory) {
+    std::vector<Incident> incidents;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string name = entry.path().filename().string();
+        if (!name.starts_with(PREFIX) || !name.ends_with(SUFFIX)) {
+            continue;
+        }
+        std::ifstream in(entry.path());
+        if (auto incident = Incident::read(in)) {
+            incidents.push_back(std::move(*incident));
+        }
+    }
+    std::sort(incidents.begin(), incidents.end(),
+              [](const Incident& a, const Incident& b) { return a.sequence < b.sequence; });
+    return incidents;
+}
+
+// -- Recording -------------------------------------------------------------------
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+void beginTurn() {
+    Session& s = session;
+    if (s.epoch != ring().epoch.load(std::memory_order_relaxed) || Engine::isDryRun()) {
+        return;
+    }
+    auto& g = Globals::instance();
+    s.random = Random::engine();
+    s.hashBefore = StateHash::current();
+    s.moves = g.moves;
+    s.room = g.here ? g.here->getId() : 0;
+    s.phaseNs.fill(0);
+    s.inTurn = true;
+    s.start = s.lastMark = now();
+}
+
+void mark(Phase phase) {
+    Session& s = session;
+    if (!s.inTurn || Engine::isDryRun()) {
+        return;
+    }
+    uint64_t t = now();
+    s.phaseNs[static_cast<size_t>(phase)] += t - s.lastMark;
+    s.lastMark = t;
+}
+
+void endTurn(std::string_view command) {
+    Session& s = session;
+    if (!s.inTurn || Engine::isDryRun()) {
+        return;
+    }
+    s.inTurn = false;
+    uint64_t turnNs = now() - s.start;
+
+    Ring& r = ring();
+    if (turnNs >= r.thresholdNs.load(std::memory_order_relaxed)) {
+        Incident incident;
+        incident.sequence = r.nextSequence.fetch_add(1, std::memory_order_relaxed);
+        incident.command = command;
+        incident.turnNs = turnNs;
+        incident.phaseNs = s.phaseNs;
+        incident.seed = s.seed;
+        incident.openingLook = s.openingLook;
+        incident.history = s.history;
+        std::ostringstream random;
+        random << s.random;
+        incident.random = random.str();
+        incident.hashBefore = s.hashBefore;
+        incident.hashAfter = StateHash::current();
+        incident.moves = s.moves;
+        incident.room = s.room;
+        writeIncident(incident);
+    }
+    s.history.emplace_back(command);
+}
+
+} // namespace detail
+
+void enable(const Options& options) {
+    Ring& r = ring();
+    uint64_t next = 0;
+    for (const auto& incident : list(options.directory)) {
+        next = std::max(next, incident.sequence + 1);
+    }
+    {
+        std::lock_guard lock(r.mutex);
+        r.options = options;
+        r.options.capacity = std::max<size_t>(options.capacity, 1);
+    }
+    r.thresholdNs.store(options.thresholdNs, std::memory_order_relaxed);
+    r.nextSequence.store(next, std::memory_order_relaxed);
+    r.written.store(0, std::memory_order_relaxed);
+    r.epoch.fetch_add(1, std::memory_order_relaxed);
+    detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable() {
+    detail::enabled.store(false, std::memory_order_relaxed);
+    Ring& r = ring();
+    std::lock_guard lock(r.mutex);
+    r.options = Options{};
+}
+
+void newGame(uint32_t seed) {
+    Session& s = session;
+    s.epoch = enabled() ? ring().epoch.load(std::memory_order_relaxed) : 0;
+    s.seed = seed;
+    s.openingLook = false;
+    s.history.clear();
+    s.inTurn = false;
+}
+
+void openingLook() {
+    session.openingLook = session.history.empty();
+}
+
+uint64_t written() {
+    return ring().written.load(std::memory_order_relaxed);
+}
+
+} // namespace SlowTurns
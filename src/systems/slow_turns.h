@@ -0,0 +1,128 @@
+#pragma once
+#include "core/types.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Slow Turns - on-disk ring of turns that took longer than a threshold
+//
+// While enabled, Engine::step() times every turn and its phases. A turn
+// slower than the threshold is written to the ring directory as an
+// incident: the command, how long each phase took, and what it takes to
+// get back to the state it started from. That state is not saved
+// directly. Same seed + same commands = same game, so the incident holds
+// the seed of the game and every command played since it began, plus the
+// random engine and the state hash before the turn to check a replay
+// against. tools/zork_replay.cpp plays an incident back and repeats the
+// slow turn as often as a profiler needs.
+//
+// Incident files are named slow-turn-<slot>.txt, with slot = sequence
+// number modulo the ring capacity, so the newest incidents replace the
+// oldest. Numbering carries on from the incidents already in the
+// directory. Each file is written beside its slot and renamed into
+// place.
+//
+// Answers to prompts inside a command (RESTART, QUIT) are not recorded;
+// a replay answers them with empty input. A game that has been through
+// RESTORE cannot be replayed either. zork_replay reports such histories
+// as not reproducible (the state hash before the turn does not match).
+
+namespace SlowTurns {
+
+// Phases of a turn, in the order Engine::dispatch runs them
+enum class Phase : uint8_t {
+    PARSE,   // parser, including object resolution and disambiguation
+    HANDLER, // verb handler
+    TIMERS,  // TimerSystem::tick
+    NPCS,    // troll and cyclops turns
+    COUNT
+};
+
+std::string_view phaseName(Phase phase);
+
+struct Incident {
+    uint64_t sequence = 0;    // numbering across the whole ring
+    std::string command;      // the slow command
+    uint64_t turnNs = 0;      // Engine::step() from start to end
+    std::array<uint64_t, static_cast<size_t>(Phase::COUNT)> phaseNs{}; // 0 = not reached
+    uint32_t seed = 0;        // Engine::newGame() seed
+    bool openingLook = false; // the room was described before the first
+                              // command (Verbs::vLook(), as zork1 does)
+    std::vector<std::string> history; // commands since newGame, before this one
+    std::string random;       // Random::engine() before the turn
+    uint64_t hashBefore = 0;  // StateHash::current() before the turn
+    uint64_t hashAfter = 0;   // and after it
+    int moves = 0;            // Globals::moves before the turn
+    ObjectId room = 0;        // the player's room before the turn
+
+    void write(std::ostream& out) const;
+    static std::optional<Incident> read(std::istream& in);
+};
+
+struct Options {
+    std::string directory;      // where the ring lives (must exist)
+    uint64_t thresholdNs = 50'000'000; // 50 ms
+    size_t capacity = 32;       // incident files kept
+};
+
+namespace detail {
+extern std::atomic<bool> enabled;
+
+void beginTurn();
+void mark(Phase phase);
+void endTurn(std::string_view command);
+} // namespace detail
+
+// Start recording into options.directory. Commands played before this
+// are unknown, so incidents are only written once the calling thread
+// starts a new game (Engine::newGame).
+void enable(const Options& options);
+void disable();
+
+inline bool enabled() {
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+
+// Forget the calling thread's history and start a new one (from
+// Engine::newGame)
+void newGame(uint32_t seed);
+
+// The game described the opening room with Verbs::vLook() outside a turn
+void openingLook();
+
+// Turn hooks (from Engine::run and Engine::dispatch); dry runs are ignored
+inline void beginTurn() {
+    if (enabled()) {
+        detail::beginTurn();
+    }
+}
+
+// The phase that just ended
+inline void mark(Phase phase) {
+    if (enabled()) {
+        detail::mark(phase);
+    }
+}
+
+inline void endTurn(std::string_view command) {
+    if (enabled()) {
+        detail::endTurn(command);
+    }
+}
+
+// Incidents written since enable() (all threads)
+uint64_t written();
+
+// Path of the file for slot i of a ring in directory
+std::string slotPath(const std::string& directory, size_t slot);
+
+// Every incident in directory, oldest first
+std::vector<Incident> list(const std::string& directory);
+
+} // namespace SlowTurns
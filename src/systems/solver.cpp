@@ -0,0 +1,461 @@
+/**
+ * @file solver.cpp
+ * @brief Parallel breadth-first search over game states
+ *
+ * The calling thread only coordinates: it hands each level's states to
+ * the workers and decides when to stop. Workers meet at a barrier at the
+ * start and end of every level, which also publishes the nodes created
+ * during a level to every other worker.
+ */
+
+#include "solver.h"
+#include "score.h"
+#include "state_hash.h"
+#include "undo.h"
+#include "../core/engine.h"
+#include "../core/globals.h"
+#include "../core/io.h"
+#include "../core/object.h"
+#include "../world/rooms.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+namespace Solver {
+
+namespace {
+
+// One discovered state: the command that reached it from its parent
+struct Node {
+    const Node* parent;
+    std::string command;
+    int depth;
+};
+
+// Concurrent set of state hashes, sharded to keep lock contention low
+class SeenSet {
+public:
+    // Returns true if the hash was not present yet
+    bool insert(uint64_t hash) {
+        Shard& shard = shards_[hash % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.hashes.insert(hash).second) {
+            return false;
+        }
+        count_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t size() const { return count_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t SHARDS = 64;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<uint64_t> hashes;
+    };
+
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<size_t> count_{0};
+};
+
+// A worker's states for the current level
+// The owner takes the newest state, thieves take the oldest
+class WorkQueue {
+public:
+    void push(const Node* node) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nodes_.push_back(node);
+    }
+
+    const Node* pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nodes_.empty()) {
+            return nullptr;
+        }
+        const Node* node = nodes_.back();
+        nodes_.pop_back();
+        return node;
+    }
+
+    const Node* steal() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nodes_.empty()) {
+            return nullptr;
+        }
+        const Node* node = nodes_.front();
+        nodes_.pop_front();
+        return node;
+    }
+
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return nodes_.empty();
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<const Node*> nodes_;
+};
+
+class Search {
+public:
+    Search(const Options& options, unsigned threads)
+        : options_(options),
+          threads_(threads),
+          queues_(threads),
+          next_(threads),
+          nodes_(threads),
+          barrier_(static_cast<std::ptrdiff_t>(threads) + 1) {
+        for (auto& queue : queues_) {
+            queue = std::make_unique<WorkQueue>();
+        }
+        if (!options_.goal) {
+            int target = options_.targetScore;
+            options_.goal = [target]() {
+                return ScoreSystem::instance().getScore() >= target;
+            };
+        }
+        if (!options_.actions) {
+            options_.actions = basicActions;
+        }
+    }
+
+    // Body of worker thread `index`
+    void work(unsigned index);
+
+    // Body of the calling thread
+    Result coordinate();
+
+private:
+    // Move this worker's world to the given state
+    void goTo(const Node* node, std::vector<const Node*>& path);
+
+    // Try every action in the state and queue the new children
+    void expand(const Node* node, unsigned index, std::vector<const Node*>& path);
+
+    const Node* nextNode(unsigned index);
+    void reportGoal(const Node* node);
+
+    Options options_;
+    unsigned threads_;
+    SeenSet seen_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::vector<const Node*>> next_;  // children found this level
+    std::vector<std::deque<Node>> nodes_;         // node storage per worker
+    std::barrier<> barrier_;
+
+    std::atomic<bool> found_{false};
+    std::atomic<bool> full_{false};
+    std::atomic<size_t> expanded_{0};
+    bool done_ = false; // written by the coordinator between barriers
+    std::mutex goalMutex_;
+    const Node* goal_ = nullptr;
+};
+
+void Search::work(unsigned index) {
+    // Nothing a worker prints is wanted; an ostream without a buffer drops it
+    std::ostream discard(nullptr);
+    std::istringstream noInput;
+    setOutputStream(&discard);
+    setInputStream(&noInput);
+
+    Engine::newGame(options_.seed);
+    if (options_.start) {
+        options_.start();
+    }
+    auto& journal = UndoSystem::UndoJournal::instance();
+    journal.clear();
+    journal.pushCheckpoint(); // undo never goes below the start state
+
+    nodes_[index].push_back(Node{nullptr, "", 0});
+    const Node* root = &nodes_[index].back();
+    std::vector<const Node*> path = {root};
+
+    if (index == 0) {
+        seen_.insert(StateHash::currentIgnoringClock());
+        if (options_.goal()) {
+            reportGoal(root);
+        }
+        queues_[0]->push(root);
+    }
+    barrier_.arrive_and_wait(); // setup done
+
+    while (true) {
+        barrier_.arrive_and_wait(); // level start
+        if (done_) {
+            break;
+        }
+        while (const Node* node = nextNode(index)) {
+            // Every worker has its own root; all of them are the start state
+            expand(node->parent ? node : root, index, path);
+        }
+        barrier_.arrive_and_wait(); // level end
+    }
+
+    journal.clear();
+    setOutputStream(nullptr);
+    setInputStream(nullptr);
+}
+
+Result Search::coordinate() {
+    Result result;
+    barrier_.arrive_and_wait(); // setup done
+
+    while (true) {
+        bool empty = true;
+        for (auto& queue : queues_) {
+            empty = empty && queue->empty();
+        }
+
+        if (found_ || full_ || empty || result.depth >= options_.maxDepth) {
+            if (found_) {
+                result.outcome = Outcome::FOUND;
+                for (const Node* n = goal_; n->parent; n = n->parent) {
+                    result.route.push_back(n->command);
+                }
+                std::reverse(result.route.begin(), result.route.end());
+            } else if (full_ || !empty) {
+                result.outcome = Outcome::LIMIT;
+            } else {
+                result.outcome = Outcome::UNWINNABLE;
+            }
+            break;
+        }
+
+        barrier_.arrive_and_wait(); // level start
+        barrier_.arrive_and_wait(); // level end
+
+        result.depth++;
+        for (unsigned i = 0; i < threads_; ++i) {
+            for (const Node* node : next_[i]) {
+                queues_[i]->push(node);
+            }
+            next_[i].clear();
+        }
+    }
+
+    done_ = true;
+    barrier_.arrive_and_wait(); // release the workers
+
+    result.statesSeen = seen_.size();
+    result.statesExpanded = expanded_;
+    return result;
+}
+
+const Node* Search::nextNode(unsigned index) {
+    if (found_ || full_) {
+        return nullptr;
+    }
+    if (const Node* node = queues_[index]->pop()) {
+        return node;
+    }
+    for (unsigned i = 1; i < threads_; ++i) {
+        if (const Node* node = queues_[(index + i) % threads_]->steal()) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void Search::goTo(const Node* node, std::vector<const Node*>& path) {
+    std::vector<const Node*> target(static_cast<size_t>(node->depth) + 1);
+    for (const Node* n = node; n; n = n->parent) {
+        target[static_cast<size_t>(n->depth)] = n;
+    }
+    target[0] = path[0]; // own root
+
+    size_t common = 1;
+    while (common < path.size() && common < target.size() &&
+           path[common] == target[common]) {
+        common++;
+    }
+
+    UndoSystem::undo(path.size() - common);
+    for (size_t d = common; d < target.size(); ++d) {
+        Engine::step(target[d]->command);
+    }
+    path = std::move(target);
+}
+
+void Search::expand(const Node* node, unsigned index, std::vector<const Node*>& path) {
+    goTo(node, path);
+    expanded_.fetch_add(1, std::memory_order_relaxed);
+
+    auto& journal = UndoSystem::UndoJournal::instance();
+    for (const auto& command : options_.actions()) {
+        if (found_ || full_) {
+            return;
+        }
+
+        journal.pushCheckpoint();
+        StepResult step = Engine::step(command);
+        bool keep = step.tookTurn && !step.died;
+        uint64_t hash = StateHash::currentIgnoringClock();
+        bool goal = keep && options_.goal();
+        journal.rollbackToCheckpoint();
+
+        if (!keep || !seen_.insert(hash)) {
+            continue;
+        }
+        nodes_[index].push_back(Node{node, command, node->depth + 1});
+        const Node* child = &nodes_[index].back();
+
+        if (goal) {
+            reportGoal(child);
+            return;
+        }
+        next_[index].push_back(child);
+        if (seen_.size() >= options_.maxStates) {
+            full_ = true;
+        }
+    }
+}
+
+void Search::reportGoal(const Node* node) {
+    std::lock_guard<std::mutex> lock(goalMutex_);
+    if (!goal_) {
+        goal_ = node;
+        found_ = true;
+    }
+}
+
+// Word the parser accepts for each direction
+const char* directionWord(Direction dir) {
+    switch (dir) {
+        case Direction::NORTH: return "north";
+        case Direction::SOUTH: return "south";
+        case Direction::EAST: return "east";
+        case Direction::WEST: return "west";
+        case Direction::NE: return "ne";
+        case Direction::NW: return "nw";
+        case Direction::SE: return "se";
+        case Direction::SW: return "sw";
+        case Direction::UP: return "up";
+        case Direction::DOWN: return "down";
+        case Direction::IN: return "in";
+        case Direction::OUT: return "out";
+    }
+    return "";
+}
+
+// Objects inside `container` that can be reached from outside it
+void collectReachable(ZObject* container, ZObject* skip, std::vector<ZObject*>& out) {
+    for (ZObject* obj : container->getContents()) {
+        if (obj == skip || obj->hasFlag(ObjectFlag::INVISIBLE)) {
+            continue;
+        }
+        out.push_back(obj);
+        if (obj->hasFlag(ObjectFlag::OPENBIT) || obj->hasFlag(ObjectFlag::SURFACEBIT)) {
+            collectReachable(obj, skip, out);
+        }
+    }
+}
+
+} // namespace
+
+std::vector<std::string> basicActions() {
+    auto& g = Globals::instance();
+    std::vector<std::string> actions;
+    if (!g.here || !g.winner) {
+        return actions;
+    }
+
+    if (auto* room = dynamic_cast<ZRoom*>(g.here)) {
+        for (int d = 0; d <= static_cast<int>(Direction::OUT); ++d) {
+            auto dir = static_cast<Direction>(d);
+            const RoomExit* exit = room->getExit(dir);
+            if (exit && (exit->targetRoom || exit->condition)) {
+                actions.emplace_back(directionWord(dir));
+            }
+        }
+    }
+
+    std::vector<ZObject*> carried;
+    std::vector<ZObject*> around;
+    collectReachable(g.winner, nullptr, carried);
+    collectReachable(g.here, g.winner, around);
+
+    std::vector<std::string> containers;
+    auto noun = [](const ZObject* obj) -> std::string {
+        const auto& synonyms = obj->getSynonyms();
+        return synonyms.empty() ? std::string() : std::string(synonyms.front());
+    };
+
+    for (ZObject* obj : around) {
+        std::string name = noun(obj);
+        if (name.empty()) {
+            continue;
+        }
+        if (obj->hasFlag(ObjectFlag::TAKEBIT)) {
+            actions.push_back("take " + name);
+        } else if (!obj->hasFlag(ObjectFlag::ACTORBIT)) {
+            actions.push_back("move " + name);
+        }
+        if (obj->hasFlag(ObjectFlag::CONTBIT) || obj->hasFlag(ObjectFlag::DOORBIT)) {
+            actions.push_back((obj->hasFlag(ObjectFlag::OPENBIT) ? "close " : "open ") + name);
+        }
+        if (obj->hasFlag(ObjectFlag::CONTBIT) && obj->hasFlag(ObjectFlag::OPENBIT)) {
+            containers.push_back(name);
+        }
+    }
+
+    for (ZObject* obj : carried) {
+        std::string name = noun(obj);
+        if (name.empty()) {
+            continue;
+        }
+        actions.push_back("drop " + name);
+        if (obj->hasFlag(ObjectFlag::LIGHTBIT)) {
+            actions.push_back((obj->hasFlag(ObjectFlag::ONBIT) ? "turn off " : "turn on ") + name);
+        }
+        if (obj->hasFlag(ObjectFlag::CONTBIT)) {
+            actions.push_back((obj->hasFlag(ObjectFlag::OPENBIT) ? "close " : "open ") + name);
+        }
+        for (const auto& container : containers) {
+            if (container != name) {
+                actions.push_back("put " + name + " in " + container);
+            }
+        }
+    }
+    return actions;
+}
+
+Result solve(const Options& options) {
+    unsigned threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    Search search(options, threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([&search, i]() { search.work(i); });
+    }
+
+    Result result = search.coordinate();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return result;
+}
+
+std::function<void()> startAfter(std::vector<std::string> commands) {
+    return [commands = std::move(commands)]() {
+        for (const auto& command : commands) {
+            Engine::step(command);
+        }
+    };
+}
+
+} // namespace Solver
@@ -0,0 +1,85 @@
+#pragma once
+#include "score.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Solver - parallel breadth-first search over game states
+//
+// Answers "what is the shortest sequence of commands that reaches a goal
+// (by default 350 points)?" and "can this state still reach it at all?".
+//
+// Every worker thread plays its own copy of the game (game state is per
+// thread) starting from the same start state. States are deduplicated by
+// StateHash::currentIgnoringClock(), so the move counters and the random
+// engine position are not part of a state's identity.
+//
+// The search is level-synchronous: all states at depth d are expanded
+// before any at depth d + 1, so the first goal found is a shortest route.
+// A level's states sit in per-worker deques; a worker expands its own
+// states newest-first (consecutive states usually share a parent) and
+// steals the oldest states of other workers when it runs out.
+//
+// Moving a worker's world to a state uses the undo journal: undo back to
+// the common ancestor of the current and target states, then replay the
+// remaining commands. Each child is tried between pushCheckpoint() and
+// rollbackToCheckpoint(), as in Engine::tryStep().
+
+namespace Solver {
+
+// Commands to try in the worker's current state
+using ActionGenerator = std::function<std::vector<std::string>()>;
+
+// Goal test run in the worker's current state
+using Goal = std::function<bool()>;
+
+// Default action generator: exits of the current room plus a fixed set
+// of verbs applied to the objects in reach
+std::vector<std::string> basicActions();
+
+struct Options {
+    // Build the start state on a new game (default: the new game itself)
+    std::function<void()> start;
+    uint32_t seed = 1;
+
+    // Goal test (default: score >= targetScore)
+    Goal goal;
+    int targetScore = ScoreSystem::MAX_SCORE;
+
+    // Commands to try (default: basicActions). Engine::validActions()
+    // gives a wider, pattern-driven set.
+    ActionGenerator actions;
+
+    // Worker threads (0 = one per hardware thread)
+    unsigned threads = 0;
+
+    // Search limits
+    size_t maxStates = 1000000;
+    int maxDepth = 1000;
+};
+
+enum class Outcome {
+    FOUND,      // route reaches the goal
+    UNWINNABLE, // every reachable state was searched without reaching the goal
+    LIMIT       // stopped at maxStates or maxDepth
+};
+
+struct Result {
+    Outcome outcome = Outcome::LIMIT;
+    std::vector<std::string> route; // commands from the start state (FOUND)
+    size_t statesSeen = 0;          // distinct states discovered
+    size_t statesExpanded = 0;      // states whose children were tried
+    int depth = 0;                  // levels expanded (route length when FOUND)
+};
+
+// Run the search. The goal and action generator are called on worker
+// threads and see the worker's world through the usual singletons. The
+// calling thread's game is not touched.
+Result solve(const Options& options);
+
+// Start function that plays the given commands after the new game
+std::function<void()> startAfter(std::vector<std::string> commands);
+
+} // namespace Solver
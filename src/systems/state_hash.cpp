@@ -0,0 +1,159 @@
+/**
+ * @file state_hash.cpp
+ * @brief Zobrist-style state hash
+ *
+ * The incremental part is kept up to date by the mutation hooks in
+ * ZObject, TimerManager and ScoreSystem. Reading the hash folds in the
+ * Globals and NPC scalars, which are written directly all over the code.
+ */
+
+#include "state_hash.h"
+#include "death.h"
+#include "npc.h"
+#include "score.h"
+#include "timer.h"
+#include "../core/globals.h"
+#include "../core/object.h"
+#include "../core/random.h"
+
+// External flag from actions.cpp for end game access
+extern thread_local bool wonFlag;
+
+namespace StateHash {
+
+namespace detail {
+thread_local uint64_t incrementalHash = 0;
+}
+
+namespace {
+
+// Accumulates a sequence of scalars into one key
+class Fold {
+public:
+    explicit Fold(Kind kind) : h_(mix(static_cast<uint64_t>(kind))) {}
+
+    Fold& add(int64_t value) {
+        h_ = mix(h_ ^ static_cast<uint64_t>(value));
+        return *this;
+    }
+
+    Fold& add(const ZObject* obj) {
+        return add(obj ? obj->getId() : 0);
+    }
+
+    uint64_t value() const { return h_; }
+
+private:
+    uint64_t h_;
+};
+
+uint64_t foldGlobals() {
+    auto& g = Globals::instance();
+    const auto& thief = NPCSystem::getThiefState();
+    const auto& troll = NPCSystem::getTrollState();
+    const auto& cyclops = NPCSystem::getCyclopsState();
+
+    Fold f(Kind::GLOBALS);
+    f.add(g.here).add(g.winner).add(g.player).add(g.it);
+    f.add(g.score).add(g.loadMax).add(g.loadAllowed);
+    f.add(g.lampBattery).add(g.waterLevel).add(g.matchCount);
+    f.add(g.lit).add(g.lampWarned).add(g.rugMoved).add(g.lldFlag);
+    f.add(g.gateFlag).add(g.gatesOpen).add(g.lowTide).add(g.domeFlag);
+    f.add(g.grunlock).add(g.grateRevealed).add(g.rainbowFlag);
+    f.add(g.verboseMode).add(g.briefMode).add(g.superbriefMode);
+    f.add(wonFlag);
+
+    f.add(thief.isAlive).add(thief.isEngaged).add(thief.isAwake);
+    f.add(thief.turnsUntilMove).add(thief.turnsInRoom).add(thief.health);
+    f.add(troll.isAlive).add(troll.isUnconscious).add(troll.health);
+    f.add(troll.unconsciousTurns);
+    f.add(cyclops.isAsleep).add(cyclops.hasFled).add(cyclops.hasEatenPeppers);
+    f.add(cyclops.wrathLevel).add(cyclops.turnsInRoom);
+
+    f.add(DeathSystem::getDeathCount()).add(DeathSystem::isDead());
+    return f.value();
+}
+
+uint64_t foldClock() {
+    // The next draw identifies the engine position (the LCG step is a bijection)
+    Random::Engine rng = Random::engine();
+
+    Fold f(Kind::CLOCK);
+    f.add(Globals::instance().moves);
+    f.add(ScoreSystem::instance().getMoves());
+    f.add(static_cast<int64_t>(rng()));
+    return f.value();
+}
+
+} // namespace
+
+uint64_t nameKey(std::string_view name) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+uint64_t current() {
+    return incremental() ^ foldGlobals() ^ foldClock();
+}
+
+uint64_t currentIgnoringClock() {
+    return incremental() ^ foldGlobals();
+}
+
+uint64_t scanIncremental() {
+    uint64_t h = 0;
+
+    for (const auto& [_, obj] : Globals::instance().getAllObjects()) {
+        // Keys use the object's own id, which a few registrations don't match
+        ObjectId id = obj->getId();
+        if (ZObject* loc = obj->getLocation()) {
+            h ^= locationKey(id, loc->getId());
+        }
+        h ^= flagsKey(id, obj->getAllFlags());
+        for (const auto& [prop, value] : obj->getAllProperties()) {
+            h ^= propertyKey(id, prop, value);
+        }
+    }
+
+    for (const auto& [name, timer] : TimerSystem::TimerManager::instance().getAllTimers()) {
+        h ^= timerKey(nameKey(name), timer.interval, timer.counter,
+                      timer.enabled, timer.repeating);
+    }
+
+    auto& score = ScoreSystem::instance();
+    h ^= scoreKey(score.getScore());
+    for (ObjectId treasure : score.getScoredTreasures()) {
+        h ^= treasureKey(treasure);
+    }
+    return h;
+}
+
+size_t bisect(size_t count, const std::function<bool(size_t)>& diverges) {
+    if (count == 0 || !diverges(count - 1)) {
+        return count;
+    }
+
+    // Invariant: diverges(hi) is true; everything below lo agrees
+    size_t lo = 0;
+    size_t hi = count - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (diverges(mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return hi;
+}
+
+size_t firstDivergence(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    size_t common = std::min(a.size(), b.size());
+    return bisect(common, [&](size_t i) { return a[i] != b[i]; });
+}
+
+} // namespace StateHash
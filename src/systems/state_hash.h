@@ -0,0 +1,125 @@
+#pragma once
+#include "core/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// State Hash - 64-bit Zobrist-style hash of the game state
+//
+// Every piece of state contributes a key, and the hash is the XOR of all
+// keys. When something changes, the old key is XORed out and the new one
+// XORed in, so the hash never needs a scan of the world:
+// - Object location, flag word and each property (ZObject setters)
+// - Timer counter/enabled/interval (TimerManager)
+// - Score and scored treasures (ScoreSystem)
+//
+// Keys are derived by mixing (kind, object id, field, value) rather than
+// looked up in random tables, so the same state hashes the same in every
+// build and every process. A value that is "empty" (no location, no flags,
+// score 0) has no key, which keeps a freshly constructed object at zero.
+//
+// Globals fields and the NPC state structs are plain data written directly
+// throughout the code; that fixed handful of scalars is folded in when the
+// hash is read.
+
+namespace StateHash {
+
+enum class Kind : uint64_t {
+    LOCATION = 1,
+    FLAGS,
+    PROPERTY,
+    TIMER,
+    SCORE,
+    TREASURE,
+    GLOBALS,
+    CLOCK
+};
+
+// splitmix64 finalizer
+inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Key for one piece of state
+inline uint64_t key(Kind kind, int64_t a, int64_t b = 0, int64_t c = 0) {
+    uint64_t h = mix(static_cast<uint64_t>(kind) ^ (static_cast<uint64_t>(a) << 8));
+    h = mix(h ^ static_cast<uint64_t>(b));
+    return mix(h ^ static_cast<uint64_t>(c));
+}
+
+// Stable hash of a timer name (FNV-1a)
+uint64_t nameKey(std::string_view name);
+
+// Keys for each kind of state (callers skip the location key when an
+// object has no location)
+inline uint64_t locationKey(ObjectId obj, ObjectId parent) {
+    return key(Kind::LOCATION, obj, parent);
+}
+
+inline uint64_t flagsKey(ObjectId obj, uint64_t flags) {
+    return flags ? key(Kind::FLAGS, obj, static_cast<int64_t>(flags)) : 0;
+}
+
+inline uint64_t propertyKey(ObjectId obj, PropertyId prop, int value) {
+    return key(Kind::PROPERTY, obj, prop, value);
+}
+
+inline uint64_t timerKey(uint64_t name, int interval, int counter, bool enabled, bool repeating) {
+    return key(Kind::TIMER, static_cast<int64_t>(name), interval,
+               (static_cast<int64_t>(counter) << 2) | (enabled ? 2 : 0) | (repeating ? 1 : 0));
+}
+
+inline uint64_t scoreKey(int score) {
+    return score ? key(Kind::SCORE, score) : 0;
+}
+
+inline uint64_t treasureKey(ObjectId treasure) {
+    return key(Kind::TREASURE, treasure);
+}
+
+namespace detail {
+extern thread_local uint64_t incrementalHash;
+}
+
+// XOR a key in or out of the incremental hash
+inline void toggle(uint64_t k) {
+    detail::incrementalHash ^= k;
+}
+
+// Incrementally maintained part (objects, timers, score)
+inline uint64_t incremental() {
+    return detail::incrementalHash;
+}
+
+// Overwrite the incremental part (undo rollback restores the saved value)
+inline void setIncremental(uint64_t value) {
+    detail::incrementalHash = value;
+}
+
+// Hash of the whole game state, including the move counters and the
+// random engine position
+uint64_t current();
+
+// Same, ignoring move counters and the random engine, so a state reached
+// again on a later turn hashes the same (cycle detection, deduplication)
+uint64_t currentIgnoringClock();
+
+// Recompute the incremental part from scratch by scanning every object,
+// timer and score field. Only for verifying the incremental value.
+uint64_t scanIncremental();
+
+// Bisect for the first index in [0, count) where diverges(i) is true.
+// Assumes runs stay diverged once they diverge; returns count if
+// diverges(count - 1) is false.
+size_t bisect(size_t count, const std::function<bool(size_t)>& diverges);
+
+// First turn at which two per-turn hash traces differ (bisected)
+// Returns min(a.size(), b.size()) if one is a prefix of the other
+size_t firstDivergence(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+} // namespace StateHash
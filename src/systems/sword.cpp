@@ -1,5 +1,6 @@
 #include "sword.h"
 #include "timer.h"
+#include "undo.h"
 #include "core/globals.h"
 #include "core/io.h"
 #include "world/objects.h"
@@ -8,7 +9,7 @@
 namespace SwordSystem {
 
 // Track previous glow state to detect changes
-static bool previousGlowState = false;
+static thread_local bool previousGlowState = false;
 
 // Sword timer callback
 // Based on I-SWORD from GCLOCK.ZIL
@@ -31,6 +32,9 @@ void swordTimerCallback() {
         // Sword is not with player, disable glow
         if (sword->hasFlag(ObjectFlag::ONBIT)) {
             sword->clearFlag(ObjectFlag::ONBIT);
+            if (UndoSystem::isRecording()) {
+                UndoSystem::UndoJournal::instance().recordValue(previousGlowState);
+            }
             previousGlowState = false;
         }
         return;
@@ -126,6 +130,9 @@ void updateSwordGlow() {
             printLine("Your sword is glowing with a faint blue light.");
         }
         
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(previousGlowState);
+        }
         previousGlowState = true;
     } else if (!enemiesNearby && currentlyGlowing) {
         // Enemies left - stop glowing
@@ -139,6 +146,9 @@ void updateSwordGlow() {
             printLine("Your sword stops glowing.");
         }
         
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(previousGlowState);
+        }
         previousGlowState = false;
     }
 }
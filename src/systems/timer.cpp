@@ -16,12 +16,31 @@
  */
 
 #include "timer.h"
+#include "allocations.h"
+#include "metrics.h"
+#include "state_hash.h"
+#include "trace.h"
+#include "undo.h"
 #include <algorithm>
 
 namespace TimerSystem {
 
+namespace {
+
+// A timer's key in the state hash
+uint64_t hashKey(uint64_t nameKey, const Timer& timer) {
+    return StateHash::timerKey(nameKey, timer.interval, timer.counter,
+                               timer.enabled, timer.repeating);
+}
+
+uint64_t hashKey(std::string_view name, const Timer& timer) {
+    return hashKey(StateHash::nameKey(name), timer);
+}
+
+} // namespace
+
 TimerManager& TimerManager::instance() {
-    static TimerManager instance;
+    static thread_local TimerManager instance;
     return instance;
 }
 
@@ -33,28 +52,45 @@ void TimerManager::registerTimer(std::string_view name, int interval,
     
     // Check if timer already exists
     auto it = timers_.find(key);
+    if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordTimerRegistration(
+            name, it != timers_.end() ? &it->second : nullptr);
+    }
     if (it != timers_.end()) {
         // Update existing timer
+        StateHash::toggle(hashKey(name, it->second));
         it->second.interval = interval;
         it->second.counter = interval;
         it->second.callback = callback;
         it->second.repeating = repeating;
         it->second.enabled = true;
+        StateHash::toggle(hashKey(name, it->second));
     } else {
         // Create new timer
-        timers_[key] = Timer(interval, callback, repeating);
+        auto& timer = timers_[key] = Timer(interval, callback, repeating);
+        StateHash::toggle(hashKey(name, timer));
     }
 }
 
 void TimerManager::enableTimer(std::string_view name) {
     if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(it->second.enabled);
+        }
+        StateHash::toggle(hashKey(name, it->second));
         it->second.enabled = true;
+        StateHash::toggle(hashKey(name, it->second));
     }
 }
 
 void TimerManager::disableTimer(std::string_view name) {
     if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(it->second.enabled);
+        }
+        StateHash::toggle(hashKey(name, it->second));
         it->second.enabled = false;
+        StateHash::toggle(hashKey(name, it->second));
     }
 }
 
@@ -67,7 +103,12 @@ bool TimerManager::isTimerEnabled(std::string_view name) const {
 
 void TimerManager::resetTimer(std::string_view name) {
     if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(it->second.counter);
+        }
+        StateHash::toggle(hashKey(name, it->second));
         it->second.counter = it->second.interval;
+        StateHash::toggle(hashKey(name, it->second));
     }
 }
 
@@ -75,7 +116,12 @@ void TimerManager::queueTimer(std::string_view name, int ticks) {
     // Based on QUEUE routine in GCLOCK.ZIL
     // Sets the timer's counter to a specific value
     if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(it->second.counter);
+        }
+        StateHash::toggle(hashKey(name, it->second));
         it->second.counter = ticks;
+        StateHash::toggle(hashKey(name, it->second));
     }
 }
 
@@ -86,7 +132,11 @@ bool TimerManager::tick() {
     // 2. If counter reaches 0, fire callback
     // 3. If repeating, reset counter; otherwise disable
     
+    ZORK_TRACE_SCOPE("timers");
+    Allocations::Scope scope(Allocations::Subsystem::TIMERS);
     bool anyFired = false;
+    bool recording = UndoSystem::isRecording();
+    fired_.clear();
     
     for (auto& [name, timer] : timers_) {
         // Skip disabled timers
@@ -100,24 +150,39 @@ bool TimerManager::tick() {
         }
         
         // Decrement counter
+        if (recording) {
+            UndoSystem::UndoJournal::instance().recordValue(timer.counter);
+        }
+        uint64_t nameKey = StateHash::nameKey(name);
+        StateHash::toggle(hashKey(nameKey, timer));
         timer.counter--;
+        StateHash::toggle(hashKey(nameKey, timer));
         
         // Check if timer should fire
         if (timer.counter == 0) {
             // Fire the callback
             if (timer.callback) {
+                fired_.push_back(name);
+                ZORK_TRACE_SCOPE(name);
+                uint64_t callbackStart = Metrics::start();
                 timer.callback();
+                Metrics::timerFired(name, callbackStart);
                 anyFired = true;
             }
             
             // Handle repeating vs one-shot
+            StateHash::toggle(hashKey(nameKey, timer));
             if (timer.repeating) {
                 // Reset counter for next interval
                 timer.counter = timer.interval;
             } else {
                 // One-shot timer - disable after firing
+                if (recording) {
+                    UndoSystem::UndoJournal::instance().recordValue(timer.enabled);
+                }
                 timer.enabled = false;
             }
+            StateHash::toggle(hashKey(nameKey, timer));
         }
     }
     
@@ -125,13 +190,36 @@ bool TimerManager::tick() {
 }
 
 void TimerManager::clear() {
+    for (const auto& [name, timer] : timers_) {
+        StateHash::toggle(hashKey(name, timer));
+    }
     timers_.clear();
 }
 
 void TimerManager::setTimerState(std::string_view name, bool enabled, int counter) {
     if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        if (UndoSystem::isRecording()) {
+            UndoSystem::UndoJournal::instance().recordValue(it->second.enabled);
+            UndoSystem::UndoJournal::instance().recordValue(it->second.counter);
+        }
+        StateHash::toggle(hashKey(name, it->second));
         it->second.enabled = enabled;
         it->second.counter = counter;
+        StateHash::toggle(hashKey(name, it->second));
+    }
+}
+
+Timer* TimerManager::findTimer(std::string_view name) {
+    if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+void TimerManager::removeTimer(std::string_view name) {
+    if (auto it = timers_.find(std::string(name)); it != timers_.end()) {
+        StateHash::toggle(hashKey(name, it->second));
+        timers_.erase(it);
     }
 }
 
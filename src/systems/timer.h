@@ -2,6 +2,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <string_view>
 
 // Timer System - handles scheduled events and interrupts
@@ -78,6 +79,9 @@ public:
     // Returns true if any timer fired
     bool tick();
     
+    // Names of the timers whose callbacks ran in the last tick()
+    const std::vector<std::string>& getFiredLastTick() const { return fired_; }
+    
     // Clear all timers (for game restart)
     void clear();
     
@@ -90,12 +94,19 @@ public:
     // Set timer state (for deserialization)
     void setTimerState(std::string_view name, bool enabled, int counter);
     
+    // Look up a timer by name (nullptr if not registered)
+    Timer* findTimer(std::string_view name);
+    
+    // Remove a timer entirely (used when undoing its registration)
+    void removeTimer(std::string_view name);
+    
 private:
     TimerManager() = default;
     TimerManager(const TimerManager&) = delete;
     TimerManager& operator=(const TimerManager&) = delete;
     
     std::unordered_map<std::string, Timer> timers_;
+    std::vector<std::string> fired_;
 };
 
 // Convenience functions for common operations
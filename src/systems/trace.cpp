@@ -0,0 +1,189 @@
+#include "trace.h"
+
+#ifdef ZORK_TRACE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+namespace Trace {
+
+namespace {
+
+constexpr size_t FLUSH_BYTES = 64 * 1024; // per-thread buffer written out when this full
+
+struct Buffer;
+
+// The open trace file, shared by all threads
+struct Writer {
+    std::mutex mutex;
+    std::FILE* file = nullptr;
+    bool first = true;                    // no event written yet
+    std::atomic<uint64_t> generation{0};  // bumped by start()
+    std::atomic<uint64_t> origin{0};      // ns timestamp of ts 0
+    std::vector<Buffer*> buffers;         // every thread's buffer
+    uint32_t nextThread = 1;
+};
+
+Writer& writer() {
+    // Never destroyed: threads may exit after static destruction begins
+    static Writer* instance = new Writer;
+    return *instance;
+}
+
+// Append text (events separated by ",\n") to the file
+void writeLocked(Writer& w, const std::string& text) {
+    if (!w.file || text.empty()) {
+        return;
+    }
+    if (!w.first) {
+        std::fputs(",\n", w.file);
+    }
+    std::fwrite(text.data(), 1, text.size(), w.file);
+    w.first = false;
+}
+
+// One thread's events not yet in the file
+struct Buffer {
+    std::mutex mutex; // taken by stop() from another thread
+    std::string text;
+    uint64_t generation = 0;
+    uint32_t thread = 0;
+
+    Buffer() {
+        Writer& w = writer();
+        std::lock_guard lock(w.mutex);
+        thread = w.nextThread++;
+        w.buffers.push_back(this);
+    }
+
+    ~Buffer() {
+        Writer& w = writer();
+        std::lock_guard lock(w.mutex);
+        {
+            std::lock_guard own(mutex);
+            if (generation == w.generation.load()) {
+                writeLocked(w, text);
+            }
+        }
+        std::erase(w.buffers, this);
+    }
+
+    // Hand the buffered events to the file (w.mutex held)
+    void flushLocked(Writer& w) {
+        std::lock_guard own(mutex);
+        if (generation == w.generation.load()) {
+            writeLocked(w, text);
+        }
+        text.clear();
+    }
+};
+
+thread_local Buffer buffer;
+
+void appendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            out += c;
+        }
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+std::atomic<bool> active{false};
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void emit(std::string_view name, std::string_view arg, uint64_t start, uint64_t end) {
+    Writer& w = writer();
+    uint64_t origin = w.origin.load(std::memory_order_relaxed);
+    if (start < origin) {
+        return; // began before this trace did
+    }
+
+    Buffer& b = buffer;
+    bool full = false;
+    {
+        std::lock_guard own(b.mutex);
+        uint64_t generation = w.generation.load(std::memory_order_relaxed);
+        if (b.generation != generation) {
+            b.text.clear(); // left over from an earlier trace
+            b.generation = generation;
+        }
+
+        char numbers[96];
+        std::snprintf(numbers, sizeof(numbers), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u",
+                      static_cast<double>(start - origin) / 1e3,
+                      static_cast<double>(end - start) / 1e3, static_cast<int>(getpid()),
+                      b.thread);
+        std::string& out = b.text;
+        if (!out.empty()) {
+            out += ",\n";
+        }
+        out += "{\"name\":\"";
+        appendEscaped(out, name);
+        out += numbers;
+        if (!arg.empty()) {
+            out += ",\"args\":{\"arg\":\"";
+            appendEscaped(out, arg);
+            out += "\"}";
+        }
+        out += '}';
+        full = out.size() >= FLUSH_BYTES;
+    }
+
+    if (full) {
+        std::lock_guard lock(w.mutex);
+        b.flushLocked(w);
+    }
+}
+
+} // namespace detail
+
+bool start(const std::string& path) {
+    stop();
+    Writer& w = writer();
+    std::lock_guard lock(w.mutex);
+    w.file = std::fopen(path.c_str(), "w");
+    if (!w.file) {
+        return false;
+    }
+    std::fputs("[\n", w.file);
+    w.first = true;
+    w.generation.fetch_add(1);
+    w.origin.store(detail::now());
+    detail::active.store(true);
+    return true;
+}
+
+void stop() {
+    Writer& w = writer();
+    detail::active.store(false);
+    std::lock_guard lock(w.mutex);
+    if (!w.file) {
+        return;
+    }
+    for (Buffer* b : w.buffers) {
+        b->flushLocked(w);
+    }
+    std::fputs("\n]\n", w.file);
+    std::fclose(w.file);
+    w.file = nullptr;
+}
+
+} // namespace Trace
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+// Trace - Chrome trace-event export of the phases of a turn
+//
+// With tracing compiled in (cmake -DENABLE_TRACE=ON, which defines
+// ZORK_TRACE) and started, every ZORK_TRACE_SCOPE writes one complete
+// ("X") event when it ends: the turn, tokenizing, verb lookup, object
+// resolution, disambiguation, the verb handler, the timer tick with a
+// slice per fired timer, the troll and cyclops turns, and flushing the
+// output. Open the file in chrome://tracing or ui.perfetto.dev; a slow
+// turn shows up as a wide "turn" slice with its command attached, and
+// the slices nested under it tell where the time went.
+//
+// Without ZORK_TRACE, ZORK_TRACE_SCOPE expands to nothing (its arguments
+// are not evaluated) and this header declares nothing else: the turn
+// loop carries no trace code at all.
+//
+// Usage:
+//   ZORK_TRACE_SCOPE("tokenize");
+//   ZORK_TRACE_SCOPE("turn", input); // with an "arg" shown in the viewer
+//
+// Both strings must outlive the scope. Each thread buffers its events and
+// appends them to the file in blocks; the file is a JSON array of events
+// that viewers accept even if the process dies before stop() closes it.
+
+#ifdef ZORK_TRACE
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Trace {
+
+namespace detail {
+extern std::atomic<bool> active;
+
+uint64_t now(); // nanoseconds
+void emit(std::string_view name, std::string_view arg, uint64_t start, uint64_t end);
+} // namespace detail
+
+// Start writing events to path (replacing it); false if it cannot be
+// opened. A trace already running is stopped first.
+bool start(const std::string& path);
+
+// Write out every thread's buffered events and close the file
+void stop();
+
+inline bool active() {
+    return detail::active.load(std::memory_order_relaxed);
+}
+
+// One slice, from construction to destruction
+class Scope {
+public:
+    explicit Scope(std::string_view name, std::string_view arg = {})
+        : name_(name), arg_(arg), start_(active() ? detail::now() : 0) {}
+
+    ~Scope() {
+        if (start_ && active()) {
+            detail::emit(name_, arg_, start_, detail::now());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    std::string_view name_;
+    std::string_view arg_;
+    uint64_t start_;
+};
+
+} // namespace Trace
+
+#define ZORK_TRACE_CONCAT_(a, b) a##b
+#define ZORK_TRACE_CONCAT(a, b) ZORK_TRACE_CONCAT_(a, b)
+#define ZORK_TRACE_SCOPE(...) ::Trace::Scope ZORK_TRACE_CONCAT(traceScope_, __LINE__)(__VA_ARGS__)
+
+#else
+
+#define ZORK_TRACE_SCOPE(...) static_cast<void>(0)
+
+#endif
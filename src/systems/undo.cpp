@@ -0,0 +1,378 @@
+/**
+ * @file undo.cpp
+ * @brief Per-turn undo journal implementation
+ *
+ * Mutation hooks in ZObject, TimerManager and ScoreSystem append a Change
+ * holding the replaced value while a turn is open. Undoing a turn walks its
+ * changes newest-first and writes the old values back, then restores the
+ * Globals/NPC fields captured when the turn began.
+ */
+
+#include "undo.h"
+#include "allocations.h"
+#include "npc.h"
+#include "score.h"
+#include "state_hash.h"
+#include "../core/globals.h"
+#include "../core/object.h"
+
+// External flag from actions.cpp for end game access
+extern thread_local bool wonFlag;
+
+namespace UndoSystem {
+
+namespace {
+
+TurnStart captureTurnStart() {
+    auto& g = Globals::instance();
+    const auto& thief = NPCSystem::getThiefState();
+    const auto& troll = NPCSystem::getTrollState();
+    const auto& cyclops = NPCSystem::getCyclopsState();
+
+    TurnStart s;
+    s.here = g.here;
+    s.winner = g.winner;
+    s.player = g.player;
+    s.prso = g.prso;
+    s.prsi = g.prsi;
+    s.it = g.it;
+    s.prsa = g.prsa;
+    s.score = g.score;
+    s.moves = g.moves;
+    s.loadMax = g.loadMax;
+    s.loadAllowed = g.loadAllowed;
+    s.lampBattery = g.lampBattery;
+    s.waterLevel = g.waterLevel;
+    s.matchCount = g.matchCount;
+    s.lit = g.lit;
+    s.lampWarned = g.lampWarned;
+    s.rugMoved = g.rugMoved;
+    s.lldFlag = g.lldFlag;
+    s.gateFlag = g.gateFlag;
+    s.gatesOpen = g.gatesOpen;
+    s.lowTide = g.lowTide;
+    s.domeFlag = g.domeFlag;
+    s.grunlock = g.grunlock;
+    s.grateRevealed = g.grateRevealed;
+    s.rainbowFlag = g.rainbowFlag;
+    s.verboseMode = g.verboseMode;
+    s.briefMode = g.briefMode;
+    s.superbriefMode = g.superbriefMode;
+    s.scripting = g.scripting;
+    s.pCont = g.pCont;
+    s.quoteFlag = g.quoteFlag;
+    s.wonFlag = wonFlag;
+    s.rng = Random::engine();
+    s.stateHash = StateHash::incremental();
+
+    s.thiefAlive = thief.isAlive;
+    s.thiefEngaged = thief.isEngaged;
+    s.thiefAwake = thief.isAwake;
+    s.thiefTurnsUntilMove = thief.turnsUntilMove;
+    s.thiefTurnsInRoom = thief.turnsInRoom;
+    s.thiefHealth = thief.health;
+
+    s.trollAlive = troll.isAlive;
+    s.trollUnconscious = troll.isUnconscious;
+    s.trollHealth = troll.health;
+    s.trollUnconsciousTurns = troll.unconsciousTurns;
+
+    s.cyclopsAsleep = cyclops.isAsleep;
+    s.cyclopsFled = cyclops.hasFled;
+    s.cyclopsAtePeppers = cyclops.hasEatenPeppers;
+    s.cyclopsWrath = cyclops.wrathLevel;
+    s.cyclopsTurnsInRoom = cyclops.turnsInRoom;
+    return s;
+}
+
+void restoreTurnStart(const TurnStart& s) {
+    auto& g = Globals::instance();
+    auto& thief = NPCSystem::getThiefState();
+    auto& troll = NPCSystem::getTrollState();
+    auto& cyclops = NPCSystem::getCyclopsState();
+
+    g.here = s.here;
+    g.winner = s.winner;
+    g.player = s.player;
+    g.prso = s.prso;
+    g.prsi = s.prsi;
+    g.it = s.it;
+    g.prsa = s.prsa;
+    g.score = s.score;
+    g.moves = s.moves;
+    g.loadMax = s.loadMax;
+    g.loadAllowed = s.loadAllowed;
+    g.lampBattery = s.lampBattery;
+    g.waterLevel = s.waterLevel;
+    g.matchCount = s.matchCount;
+    g.lit = s.lit;
+    g.lampWarned = s.lampWarned;
+    g.rugMoved = s.rugMoved;
+    g.lldFlag = s.lldFlag;
+    g.gateFlag = s.gateFlag;
+    g.gatesOpen = s.gatesOpen;
+    g.lowTide = s.lowTide;
+    g.domeFlag = s.domeFlag;
+    g.grunlock = s.grunlock;
+    g.grateRevealed = s.grateRevealed;
+    g.rainbowFlag = s.rainbowFlag;
+    g.verboseMode = s.verboseMode;
+    g.briefMode = s.briefMode;
+    g.superbriefMode = s.superbriefMode;
+    g.scripting = s.scripting;
+    g.pCont = s.pCont;
+    g.quoteFlag = s.quoteFlag;
+    wonFlag = s.wonFlag;
+    Random::engine() = s.rng;
+
+    // Raw cell writes during rollback bypass the hash hooks
+    StateHash::setIncremental(s.stateHash);
+
+    thief.isAlive = s.thiefAlive;
+    thief.isEngaged = s.thiefEngaged;
+    thief.isAwake = s.thiefAwake;
+    thief.turnsUntilMove = s.thiefTurnsUntilMove;
+    thief.turnsInRoom = s.thiefTurnsInRoom;
+    thief.health = s.thiefHealth;
+
+    troll.isAlive = s.trollAlive;
+    troll.isUnconscious = s.trollUnconscious;
+    troll.health = s.trollHealth;
+    troll.unconsciousTurns = s.trollUnconsciousTurns;
+
+    cyclops.isAsleep = s.cyclopsAsleep;
+    cyclops.hasFled = s.cyclopsFled;
+    cyclops.hasEatenPeppers = s.cyclopsAtePeppers;
+    cyclops.wrathLevel = s.cyclopsWrath;
+    cyclops.turnsInRoom = s.cyclopsTurnsInRoom;
+}
+
+} // namespace
+
+UndoJournal& UndoJournal::instance() {
+    static thread_local UndoJournal instance;
+    return instance;
+}
+
+void UndoJournal::beginTurn() {
+    if (open_) {
+        endTurn();
+    }
+    current_.start = captureTurnStart();
+    current_.changes.clear();
+    current_.timers.clear();
+    open_ = true;
+}
+
+void UndoJournal::endTurn() {
+    if (!open_) {
+        return;
+    }
+    open_ = false;
+
+    bytes_ += recordSize(current_);
+    Allocations::Scope scope(Allocations::Subsystem::UNDO);
+    turns_.push_back(std::move(current_));
+    current_ = TurnRecord();
+    enforceMemoryLimit();
+}
+
+size_t UndoJournal::undo(size_t turns) {
+    if (open_) {
+        // Abandon whatever the open turn did so far
+        open_ = false;
+        rollback(current_);
+        current_ = TurnRecord();
+    }
+
+    size_t floor = checkpoints_.empty() ? 0 : checkpoints_.back();
+    size_t undone = 0;
+    while (undone < turns && turns_.size() > floor) {
+        TurnRecord& turn = turns_.back();
+        bytes_ -= recordSize(turn);
+        rollback(turn);
+        turns_.pop_back();
+        undone++;
+    }
+    return undone;
+}
+
+void UndoJournal::setMemoryLimit(size_t bytes) {
+    memoryLimit_ = bytes;
+    enforceMemoryLimit();
+}
+
+void UndoJournal::clear() {
+    turns_.clear();
+    checkpoints_.clear();
+    current_ = TurnRecord();
+    open_ = false;
+    replaying_ = false;
+    bytes_ = 0;
+}
+
+void UndoJournal::pushCheckpoint() {
+    endTurn();
+    checkpoints_.push_back(turns_.size());
+}
+
+bool UndoJournal::rollbackToCheckpoint() {
+    if (checkpoints_.empty()) {
+        // History was cleared (restart/restore) while the checkpoint was live
+        undo(0);
+        return false;
+    }
+
+    size_t mark = checkpoints_.back();
+    undo(turns_.size() - mark);
+    checkpoints_.pop_back();
+    enforceMemoryLimit();
+    return true;
+}
+
+void UndoJournal::recordLocation(ZObject* obj) {
+    Change change{Change::Kind::LOCATION};
+    change.target = obj;
+    change.location = obj->getLocation();
+    if (change.location) {
+        for (ZObject* child : change.location->getContents()) {
+            if (child == obj) {
+                break;
+            }
+            change.value++;
+        }
+    }
+    record(change);
+}
+
+void UndoJournal::recordFlags(ZObject* obj) {
+    Change change{Change::Kind::FLAGS};
+    change.target = obj;
+    change.value = obj->getAllFlags();
+    record(change);
+}
+
+void UndoJournal::recordProperty(ZObject* obj, PropertyId prop) {
+    const auto& props = obj->getAllProperties();
+
+    Change change{Change::Kind::PROPERTY};
+    change.target = obj;
+    change.property = prop;
+    change.existed = props.contains(prop);
+    change.value = props.get(prop);
+    record(change);
+}
+
+void UndoJournal::recordValue(int& cell) {
+    Change change{Change::Kind::INT_CELL};
+    change.target = &cell;
+    change.value = cell;
+    record(change);
+}
+
+void UndoJournal::recordValue(bool& cell) {
+    Change change{Change::Kind::BOOL_CELL};
+    change.target = &cell;
+    change.value = cell ? 1 : 0;
+    record(change);
+}
+
+void UndoJournal::recordTimerRegistration(std::string_view name,
+                                          const TimerSystem::Timer* previous) {
+    Allocations::Scope scope(Allocations::Subsystem::UNDO);
+    TimerRegistration reg;
+    reg.name = std::string(name);
+    if (previous) {
+        reg.previous = *previous;
+    }
+
+    Change change{Change::Kind::TIMER_REGISTRATION};
+    change.value = static_cast<int64_t>(current_.timers.size());
+    current_.timers.push_back(std::move(reg));
+    current_.changes.push_back(change);
+}
+
+void UndoJournal::recordTreasureScored(ObjectId treasureId) {
+    Change change{Change::Kind::TREASURE_SCORED};
+    change.value = treasureId;
+    record(change);
+}
+
+void UndoJournal::record(const Change& change) {
+    Allocations::Scope scope(Allocations::Subsystem::UNDO);
+    current_.changes.push_back(change);
+}
+
+void UndoJournal::rollback(TurnRecord& turn) {
+    replaying_ = true;
+    for (auto it = turn.changes.rbegin(); it != turn.changes.rend(); ++it) {
+        apply(*it, turn);
+    }
+    restoreTurnStart(turn.start);
+    replaying_ = false;
+}
+
+void UndoJournal::apply(const Change& change, TurnRecord& turn) {
+    switch (change.kind) {
+        case Change::Kind::LOCATION:
+            static_cast<ZObject*>(change.target)
+                ->restoreLocation(change.location, static_cast<size_t>(change.value));
+            break;
+        case Change::Kind::FLAGS:
+            static_cast<ZObject*>(change.target)
+                ->setAllFlags(static_cast<uint32_t>(change.value));
+            break;
+        case Change::Kind::PROPERTY: {
+            auto* obj = static_cast<ZObject*>(change.target);
+            if (change.existed) {
+                obj->setProperty(change.property, static_cast<int>(change.value));
+            } else {
+                obj->removeProperty(change.property);
+            }
+            break;
+        }
+        case Change::Kind::INT_CELL:
+            *static_cast<int*>(change.target) = static_cast<int>(change.value);
+            break;
+        case Change::Kind::BOOL_CELL:
+            *static_cast<bool*>(change.target) = change.value != 0;
+            break;
+        case Change::Kind::TIMER_REGISTRATION: {
+            auto& timerMgr = TimerSystem::TimerManager::instance();
+            const auto& reg = turn.timers[static_cast<size_t>(change.value)];
+            if (reg.previous) {
+                if (auto* timer = timerMgr.findTimer(reg.name)) {
+                    *timer = *reg.previous;
+                }
+            } else {
+                timerMgr.removeTimer(reg.name);
+            }
+            break;
+        }
+        case Change::Kind::TREASURE_SCORED:
+            ScoreSystem::instance().unmarkTreasureScored(
+                static_cast<ObjectId>(change.value));
+            break;
+    }
+}
+
+size_t UndoJournal::recordSize(const TurnRecord& turn) {
+    size_t bytes = sizeof(TurnRecord) + turn.changes.capacity() * sizeof(Change);
+    for (const auto& reg : turn.timers) {
+        bytes += sizeof(TimerRegistration) + reg.name.capacity();
+    }
+    return bytes;
+}
+
+void UndoJournal::enforceMemoryLimit() {
+    // Dropping turns would shift the checkpoint marks
+    if (!checkpoints_.empty()) {
+        return;
+    }
+    while (bytes_ > memoryLimit_ && !turns_.empty()) {
+        bytes_ -= recordSize(turns_.front());
+        turns_.pop_front();
+    }
+}
+
+} // namespace UndoSystem
@@ -0,0 +1,230 @@
+#pragma once
+#include "core/random.h"
+#include "core/types.h"
+#include "timer.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Undo System - per-turn journal of game state mutations
+//
+// While a turn is open, every mutation is appended to that turn's record
+// together with the value it replaced:
+// - Object location, flags and properties (ZObject::moveTo, setFlag, ...)
+// - Timer counters, enabled state and registrations
+// - ScoreSystem score, moves and scored treasures
+//
+// Globals fields, the NPC state structs and the random engine are written
+// directly throughout the code, so those are captured once when the turn
+// begins.
+//
+// UNDO replays a turn's record backwards, so rolling a turn back costs work
+// proportional to what the turn changed. There is no save-file round trip.
+// Old turns are discarded once the journal exceeds its memory limit.
+
+namespace UndoSystem {
+
+// A single journaled mutation and the value it replaced
+struct Change {
+    enum class Kind : uint8_t {
+        LOCATION,           // target: object, location: old parent, value: index
+        FLAGS,              // target: object, value: old flag word
+        PROPERTY,           // target: object, value: old value (if existed)
+        INT_CELL,           // target: int field, value: old value
+        BOOL_CELL,          // target: bool field, value: old value
+        TIMER_REGISTRATION, // value: index into TurnRecord::timers
+        TREASURE_SCORED     // value: treasure id newly marked as scored
+    };
+
+    Kind kind;
+    bool existed = false;
+    PropertyId property = 0;
+    void* target = nullptr;
+    ZObject* location = nullptr;
+    int64_t value = 0;
+};
+
+// Timer state replaced by a registerTimer() call
+struct TimerRegistration {
+    std::string name;
+    std::optional<TimerSystem::Timer> previous; // nullopt = timer was new
+};
+
+// Globals and NPC fields captured at the start of a turn
+struct TurnStart {
+    ZObject* here;
+    ZObject* winner;
+    ZObject* player;
+    ZObject* prso;
+    ZObject* prsi;
+    ZObject* it;
+    VerbId prsa;
+    int score;
+    int moves;
+    int loadMax;
+    int loadAllowed;
+    int lampBattery;
+    int waterLevel;
+    int matchCount;
+    bool lit;
+    bool lampWarned;
+    bool rugMoved;
+    bool lldFlag;
+    bool gateFlag;
+    bool gatesOpen;
+    bool lowTide;
+    bool domeFlag;
+    bool grunlock;
+    bool grateRevealed;
+    bool rainbowFlag;
+    bool verboseMode;
+    bool briefMode;
+    bool superbriefMode;
+    bool scripting;
+    bool pCont;
+    bool quoteFlag;
+    bool wonFlag;
+    Random::Engine rng;
+    uint64_t stateHash; // Incremental part of StateHash
+
+    // ThiefState (accessibleRooms is fixed after initialization)
+    bool thiefAlive;
+    bool thiefEngaged;
+    bool thiefAwake;
+    int thiefTurnsUntilMove;
+    int thiefTurnsInRoom;
+    int thiefHealth;
+
+    // TrollState
+    bool trollAlive;
+    bool trollUnconscious;
+    int trollHealth;
+    int trollUnconsciousTurns;
+
+    // CyclopsState
+    bool cyclopsAsleep;
+    bool cyclopsFled;
+    bool cyclopsAtePeppers;
+    int cyclopsWrath;
+    int cyclopsTurnsInRoom;
+};
+
+// Everything needed to roll back one turn
+struct TurnRecord {
+    TurnStart start;
+    std::vector<Change> changes;
+    std::vector<TimerRegistration> timers;
+};
+
+// Undo journal
+// Owns the history of completed turns plus the turn currently being played
+class UndoJournal {
+public:
+    // Get singleton instance
+    static UndoJournal& instance();
+
+    // Default cap on journal memory (bytes)
+    static constexpr size_t DEFAULT_MEMORY_LIMIT = 1024 * 1024;
+
+    // Open a new turn: capture Globals/NPC fields and start recording
+    void beginTurn();
+
+    // Close the open turn and push it onto the history
+    void endTurn();
+
+    // Roll back the most recent turns (closing any open turn first)
+    // Returns the number of turns actually undone
+    size_t undo(size_t turns = 1);
+
+    // True while mutations should be journaled
+    bool isRecording() const { return open_ && !replaying_; }
+
+    // Number of completed turns that can be undone
+    size_t getTurnCount() const { return turns_.size(); }
+
+    // The most recently completed turn (nullptr if there is none)
+    const TurnRecord* getLastTurn() const {
+        return turns_.empty() ? nullptr : &turns_.back();
+    }
+
+    // Approximate bytes held by the journal
+    size_t getMemoryUsage() const { return bytes_; }
+
+    // Cap journal memory; oldest turns are dropped first
+    void setMemoryLimit(size_t bytes);
+    size_t getMemoryLimit() const { return memoryLimit_; }
+
+    // Discard all history (new game, restart)
+    void clear();
+
+    // Dry-run checkpoints (see Engine::tryStep)
+    // Turns pushed after the newest checkpoint are never dropped by the
+    // memory limit, and undo() cannot reach below it.
+    void pushCheckpoint();
+
+    // Roll back every turn since the newest checkpoint and remove it
+    // Returns false if the history was cleared in the meantime
+    bool rollbackToCheckpoint();
+
+    // Mutation hooks - call before the state is modified
+    void recordLocation(ZObject* obj);
+    void recordFlags(ZObject* obj);
+    void recordProperty(ZObject* obj, PropertyId prop);
+    void recordValue(int& cell);
+    void recordValue(bool& cell);
+    void recordTimerRegistration(std::string_view name,
+                                 const TimerSystem::Timer* previous);
+    void recordTreasureScored(ObjectId treasureId);
+
+private:
+    UndoJournal() = default;
+    UndoJournal(const UndoJournal&) = delete;
+    UndoJournal& operator=(const UndoJournal&) = delete;
+
+    void record(const Change& change);
+    void rollback(TurnRecord& turn);
+    void apply(const Change& change, TurnRecord& turn);
+    static size_t recordSize(const TurnRecord& turn);
+    void enforceMemoryLimit();
+
+    std::deque<TurnRecord> turns_;
+    std::vector<size_t> checkpoints_; // turn counts at each checkpoint
+    TurnRecord current_;
+    bool open_ = false;
+    bool replaying_ = false;
+    size_t bytes_ = 0;
+    size_t memoryLimit_ = DEFAULT_MEMORY_LIMIT;
+};
+
+// Convenience functions
+
+// Is a turn currently being journaled?
+inline bool isRecording() {
+    return UndoJournal::instance().isRecording();
+}
+
+// Open a turn
+inline void beginTurn() {
+    UndoJournal::instance().beginTurn();
+}
+
+// Close the open turn
+inline void endTurn() {
+    UndoJournal::instance().endTurn();
+}
+
+// Undo the last N turns
+inline size_t undo(size_t turns = 1) {
+    return UndoJournal::instance().undo(turns);
+}
+
+// Discard all undo history
+inline void clear() {
+    UndoJournal::instance().clear();
+}
+
+} // namespace UndoSystem
@@ -0,0 +1,278 @@
+/**
+ * @file vec_env.cpp
+ * @brief Batched game sessions, one thread per session
+ *
+ * The calling thread fills in the operation for every session and meets
+ * the session threads at a barrier to start the round, and again when all
+ * of them are finished. Each session thread only writes its own entries
+ * of the batch.
+ */
+
+#include "vec_env.h"
+#include "death.h"
+#include "score.h"
+#include "undo.h"
+#include "../core/engine.h"
+#include "../core/globals.h"
+#include "../core/io.h"
+#include "../core/object.h"
+#include "../core/random.h"
+#include "../parser/parser.h"
+#include "../world/rooms.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+extern thread_local bool wonFlag;
+
+namespace {
+
+// Seed for episode `episode` of session `session`
+uint32_t episodeSeed(uint32_t seed, size_t session, uint32_t episode) {
+    uint32_t h = seed ^ 0x9E3779B9u;
+    h = (h ^ static_cast<uint32_t>(session)) * 0x85EBCA6Bu;
+    h = (h ^ episode) * 0xC2B2AE35u;
+    return h ^ (h >> 16);
+}
+
+bool heldBy(const ZObject* obj, const ZObject* holder) {
+    for (const ZObject* p = obj ? obj->getLocation() : nullptr; p; p = p->getLocation()) {
+        if (p == holder) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void setBit(int32_t* words, size_t bit) {
+    auto word = static_cast<uint32_t>(words[bit / 32]) | (1u << (bit % 32));
+    words[bit / 32] = static_cast<int32_t>(word);
+}
+
+// Write the current state into one observation row
+void observe(int32_t* row, size_t size, const std::vector<ZObject*>& objects,
+             const std::vector<ZObject*>& rooms) {
+    auto& g = Globals::instance();
+    std::fill(row, row + size, 0);
+
+    row[OBS_ROOM] = g.here ? static_cast<int32_t>(g.here->getId()) : 0;
+    row[OBS_SCORE] = ScoreSystem::instance().getScore();
+    row[OBS_MOVES] = g.moves;
+    row[OBS_LAMP_BATTERY] = g.lampBattery;
+    row[OBS_MATCHES] = g.matchCount;
+    row[OBS_WATER_LEVEL] = g.waterLevel;
+    row[OBS_DEATHS] = DeathSystem::getDeathCount();
+
+    uint32_t flags = 0;
+    auto flag = [&flags](bool set, PuzzleFlag bit) {
+        if (set) {
+            flags |= bit;
+        }
+    };
+    flag(g.lit, PF_LIT);
+    flag(g.lampWarned, PF_LAMP_WARNED);
+    flag(g.rugMoved, PF_RUG_MOVED);
+    flag(g.lldFlag, PF_LLD);
+    flag(g.gateFlag, PF_GATE);
+    flag(g.gatesOpen, PF_GATES_OPEN);
+    flag(g.lowTide, PF_LOW_TIDE);
+    flag(g.domeFlag, PF_DOME);
+    flag(g.grunlock, PF_GRATE_UNLOCKED);
+    flag(g.grateRevealed, PF_GRATE_REVEALED);
+    flag(g.rainbowFlag, PF_RAINBOW);
+    flag(DeathSystem::isDead(), PF_DEAD);
+    flag(wonFlag, PF_WON);
+    row[OBS_FLAGS] = static_cast<int32_t>(flags);
+
+    int32_t* inventory = row + OBS_FIELD_COUNT;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (heldBy(objects[i], g.winner)) {
+            setBit(inventory, i);
+        }
+    }
+    int32_t* visited = inventory + (objects.size() + 31) / 32;
+    for (size_t i = 0; i < rooms.size(); ++i) {
+        if (rooms[i]->hasFlag(ObjectFlag::TOUCHBIT)) {
+            setBit(visited, i);
+        }
+    }
+}
+
+} // namespace
+
+VecEnv::VecEnv(const Options& options)
+    : options_(options),
+      barrier_(static_cast<std::ptrdiff_t>(std::max<size_t>(options.sessions, 1)) + 1) {
+    options_.sessions = std::max<size_t>(options_.sessions, 1);
+    size_t n = options_.sessions;
+    ops_.assign(n, Op::NONE);
+    steps_.assign(n, 0);
+    episodes_.assign(n, 0);
+
+    threads_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        threads_.emplace_back([this, i]() { work(i); });
+    }
+    barrier_.arrive_and_wait(); // templates built, ids known
+
+    batch_.output.resize(n);
+    batch_.reward.resize(n);
+    batch_.done.resize(n);
+    batch_.observations.resize(n * observationSize());
+    reset();
+}
+
+VecEnv::~VecEnv() {
+    done_ = true;
+    barrier_.arrive_and_wait(); // release the session threads
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+const VecEnv::Batch& VecEnv::reset() {
+    std::fill(ops_.begin(), ops_.end(), Op::RESET);
+    run();
+    return batch_;
+}
+
+const VecEnv::Batch& VecEnv::reset(size_t session) {
+    if (session >= sessions()) {
+        throw std::out_of_range("VecEnv::reset: no such session");
+    }
+    std::fill(ops_.begin(), ops_.end(), Op::NONE);
+    ops_[session] = Op::RESET;
+    run();
+    return batch_;
+}
+
+const VecEnv::Batch& VecEnv::step(const std::vector<std::string>& actions) {
+    if (actions.size() != sessions()) {
+        throw std::invalid_argument("VecEnv::step: one action per session expected");
+    }
+    for (size_t i = 0; i < sessions(); ++i) {
+        ops_[i] = batch_.done[i] ? Op::NONE : Op::STEP;
+    }
+    actions_ = &actions;
+    run();
+    actions_ = nullptr;
+    return batch_;
+}
+
+void VecEnv::run() {
+    barrier_.arrive_and_wait(); // round start
+    barrier_.arrive_and_wait(); // round end
+}
+
+void VecEnv::work(size_t index) {
+    std::ostringstream captured;
+    std::ostream discard(nullptr); // an ostream without a buffer drops output
+    std::istringstream noInput;
+    std::ostream& out = options_.captureOutput ? captured : discard;
+    setOutputStream(&out);
+    setInputStream(&noInput);
+
+    auto& g = Globals::instance();
+    auto& journal = UndoSystem::UndoJournal::instance();
+    std::string templateOutput;
+    Parser::Memory templateMemory;
+    int templateColumn = 0;
+    std::vector<ZObject*> objects;
+    std::vector<ZObject*> rooms;
+
+    // Build the template; the world is rebuilt only if an episode clears
+    // the undo history (RESTART, RESTORE)
+    auto buildTemplate = [&]() {
+        Engine::newGame(options_.seed);
+        if (options_.start) {
+            options_.start();
+        }
+        journal.clear();
+        journal.pushCheckpoint(); // undo never goes below the template
+        templateOutput = captured.str();
+        captured.str("");
+        templateMemory = getGlobalParser().saveMemory();
+        templateColumn = getOutputColumn();
+
+        // Every session builds the same world, so the ids agree
+        std::vector<ObjectId> objectIds;
+        std::vector<ObjectId> roomIds;
+        for (const auto& [_, obj] : g.getAllObjects()) {
+            if (dynamic_cast<ZRoom*>(obj.get())) {
+                roomIds.push_back(obj->getId());
+            } else if (obj->hasFlag(ObjectFlag::TAKEBIT)) {
+                objectIds.push_back(obj->getId());
+            }
+        }
+        std::sort(objectIds.begin(), objectIds.end());
+        std::sort(roomIds.begin(), roomIds.end());
+        if (index == 0 && objectIds_.empty()) {
+            objectIds_ = objectIds;
+            roomIds_ = roomIds;
+        }
+        objects.clear();
+        rooms.clear();
+        for (ObjectId id : objectIds) {
+            objects.push_back(g.getObject(id));
+        }
+        for (ObjectId id : roomIds) {
+            rooms.push_back(g.getObject(id));
+        }
+    };
+    buildTemplate();
+    barrier_.arrive_and_wait(); // templates built
+
+    while (true) {
+        barrier_.arrive_and_wait(); // round start
+        if (done_) {
+            break;
+        }
+
+        size_t size = observationSize();
+        int32_t* row = batch_.observations.data() + index * size;
+        switch (ops_[index]) {
+            case Op::NONE:
+                batch_.output[index].clear();
+                batch_.reward[index] = 0;
+                break;
+
+            case Op::RESET:
+                if (!journal.rollbackToCheckpoint()) {
+                    buildTemplate();
+                } else {
+                    journal.pushCheckpoint();
+                    getGlobalParser().restoreMemory(templateMemory);
+                    setOutputColumn(templateColumn);
+                }
+                if (options_.varySeed) {
+                    Random::seed(episodeSeed(options_.seed, index, episodes_[index]));
+                }
+                episodes_[index]++;
+                steps_[index] = 0;
+                batch_.output[index] = templateOutput;
+                batch_.reward[index] = 0;
+                batch_.done[index] = 0;
+                observe(row, size, objects, rooms);
+                break;
+
+            case Op::STEP: {
+                StepResult result = Engine::step((*actions_)[index]);
+                steps_[index]++;
+                batch_.output[index] = captured.str();
+                captured.str("");
+                batch_.reward[index] = result.scoreDelta;
+                batch_.done[index] = result.died || wonFlag ||
+                                     (options_.maxEpisodeSteps > 0 &&
+                                      steps_[index] >= options_.maxEpisodeSteps);
+                observe(row, size, objects, rooms);
+                break;
+            }
+        }
+
+        barrier_.arrive_and_wait(); // round end
+    }
+
+    journal.clear();
+    setOutputStream(nullptr);
+    setInputStream(nullptr);
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include "core/types.h"
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// VecEnv - a batch of independent game sessions for learning agents
+//
+// step() plays one command in every session at once and returns, per
+// session, the text printed, the score change (reward), whether the
+// episode ended, and a fixed-size numeric observation of the state.
+//
+// Game state is per thread, so every session lives on a thread of its own
+// for the lifetime of the VecEnv; a batch is one round of those threads
+// (the same barrier scheme as Solver). The template (new game with the
+// given seed, then the start function) is built once per session. reset()
+// rolls the undo journal back to it instead of rebuilding the world, so a
+// reset costs work proportional to what the episode changed.
+//
+// Sessions read from an empty input stream: prompts such as "Do you wish
+// to be resurrected?" or QUIT's confirmation are answered with "no".
+
+// Bits of the OBS_FLAGS observation field
+enum PuzzleFlag : uint32_t {
+    PF_LIT = 1u << 0,           // current room is lit
+    PF_LAMP_WARNED = 1u << 1,   // low battery warning shown
+    PF_RUG_MOVED = 1u << 2,
+    PF_LLD = 1u << 3,           // exorcism at the Entrance to Hades done
+    PF_GATE = 1u << 4,          // dam control panel activated
+    PF_GATES_OPEN = 1u << 5,
+    PF_LOW_TIDE = 1u << 6,
+    PF_DOME = 1u << 7,          // rope tied to the railing
+    PF_GRATE_UNLOCKED = 1u << 8,
+    PF_GRATE_REVEALED = 1u << 9,
+    PF_RAINBOW = 1u << 10,      // rainbow is solid
+    PF_DEAD = 1u << 11,         // wandering as a spirit
+    PF_WON = 1u << 12
+};
+
+// Observation layout: these fields, then the inventory bitset, then the
+// visited-room bitset (32 bits per int32, bit i = entry i of
+// VecEnv::objectIds() / VecEnv::roomIds())
+enum ObservationField : size_t {
+    OBS_ROOM,          // ObjectId of the current room
+    OBS_SCORE,
+    OBS_MOVES,
+    OBS_LAMP_BATTERY,
+    OBS_MATCHES,
+    OBS_WATER_LEVEL,
+    OBS_DEATHS,
+    OBS_FLAGS,         // PuzzleFlag bits
+    OBS_FIELD_COUNT
+};
+
+class VecEnv {
+public:
+    struct Options {
+        size_t sessions = 1;
+
+        // Template: new game with this seed, then the start function
+        uint32_t seed = 1;
+        std::function<void()> start;
+
+        // Give each episode its own random seed (derived from seed, the
+        // session index and the episode number). When false every episode
+        // replays the template's random sequence.
+        bool varySeed = true;
+
+        // End an episode after this many steps (0 = never)
+        int maxEpisodeSteps = 0;
+
+        // Collect the text printed by each step; skipping it is faster
+        bool captureOutput = true;
+    };
+
+    // One step() or reset() of the whole batch; entry i is session i
+    struct Batch {
+        std::vector<std::string> output;
+        std::vector<int> reward;           // score change
+        std::vector<uint8_t> done;         // died, won, or step limit
+        std::vector<int32_t> observations; // sessions() rows of observationSize()
+    };
+
+    // Starts the session threads and builds the template in each; the
+    // sessions start out reset
+    explicit VecEnv(const Options& options);
+    ~VecEnv();
+
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    // Return every session to the template state. output[i] is whatever
+    // the template printed (nothing unless the start function prints).
+    const Batch& reset();
+
+    // Return one session to the template state
+    const Batch& reset(size_t session);
+
+    // Play actions[i] in session i (actions.size() must equal sessions())
+    // A session whose episode is done ignores its action until reset.
+    const Batch& step(const std::vector<std::string>& actions);
+
+    // Result of the last call
+    const Batch& last() const { return batch_; }
+
+    size_t sessions() const { return options_.sessions; }
+
+    // Number of int32 values in one observation
+    size_t observationSize() const {
+        return OBS_FIELD_COUNT + (objectIds_.size() + 31) / 32 + (roomIds_.size() + 31) / 32;
+    }
+
+    // Meaning of the inventory and visited-room bits
+    const std::vector<ObjectId>& objectIds() const { return objectIds_; }
+    const std::vector<ObjectId>& roomIds() const { return roomIds_; }
+
+private:
+    enum class Op : uint8_t { NONE, STEP, RESET };
+
+    void work(size_t index);
+    void run();
+
+    Options options_;
+    Batch batch_;
+    std::vector<Op> ops_;
+    const std::vector<std::string>* actions_ = nullptr;
+    std::vector<int> steps_;         // steps taken in the current episode
+    std::vector<uint32_t> episodes_; // episodes started per session
+    std::vector<ObjectId> objectIds_;
+    std::vector<ObjectId> roomIds_;
+    std::barrier<> barrier_;
+    bool done_ = false; // written between barriers
+    std::vector<std::thread> threads_;
+};
@@ -0,0 +1,735 @@
+/**
+ * @file zmachine.cpp
+ * @brief Minimal version 3 Z-machine interpreter
+ *
+ * Follows the Z-Machine Standards Document 1.1 for version 3 only. The
+ * dictionary is indexed once per instance, which keeps tokenizing cheap
+ * when thousands of command sequences are replayed.
+ */
+
+#include "zmachine.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+// Header fields
+constexpr uint32_t H_VERSION = 0x00;
+constexpr uint32_t H_INITIAL_PC = 0x06;
+constexpr uint32_t H_DICTIONARY = 0x08;
+constexpr uint32_t H_OBJECTS = 0x0A;
+constexpr uint32_t H_GLOBALS = 0x0C;
+constexpr uint32_t H_STATIC_BASE = 0x0E;
+constexpr uint32_t H_FLAGS2 = 0x10;
+constexpr uint32_t H_SERIAL = 0x12;
+constexpr uint32_t H_ABBREVIATIONS = 0x18;
+
+constexpr int DEFAULT_PROPERTIES = 31;
+constexpr int OBJECT_SIZE = 9;
+
+// Alphabet rows A0-A2 for Z-characters 6-31 (A2's first two are the ZSCII
+// escape and newline)
+const char* const ALPHABETS[3] = {
+    "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+    " \n0123456789.,!?_#'\"/\\-:()"
+};
+
+std::runtime_error fault(const char* what, uint32_t pc) {
+    char where[16];
+    std::snprintf(where, sizeof(where), "%05x", pc);
+    return std::runtime_error(std::string("Z-machine: ") + what + " at " + where);
+}
+
+} // namespace
+
+ZMachine::Story ZMachine::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open story file " + path);
+    }
+    auto bytes = std::make_shared<std::vector<uint8_t>>(std::istreambuf_iterator<char>(in),
+                                                        std::istreambuf_iterator<char>());
+    if (bytes->size() < 64 || (*bytes)[H_VERSION] != 3) {
+        throw std::runtime_error(path + " is not a version 3 story file");
+    }
+    return bytes;
+}
+
+ZMachine::ZMachine(Story story) : story_(std::move(story)) {
+    mem_ = *story_;
+
+    // Index the dictionary: separators, entry length, count, entries
+    uint32_t dict = word(H_DICTIONARY);
+    uint8_t count = byte(dict);
+    for (uint8_t i = 0; i < count; ++i) {
+        separators_ += static_cast<char>(byte(dict + 1 + i));
+    }
+    uint32_t entries = dict + 1 + count;
+    uint8_t entryLength = byte(entries);
+    int16_t entryCount = static_cast<int16_t>(word(entries + 1));
+    uint32_t addr = entries + 3;
+    for (int i = 0; i < std::abs(entryCount); ++i, addr += entryLength) {
+        uint32_t key = static_cast<uint32_t>(word(addr)) << 16 | word(addr + 2);
+        dictionary_.emplace_back(key, static_cast<uint16_t>(addr));
+    }
+    std::sort(dictionary_.begin(), dictionary_.end());
+
+    restart();
+}
+
+void ZMachine::restart() {
+    // Dynamic memory comes back from the story; the transcript bit survives
+    uint32_t staticBase = word(H_STATIC_BASE);
+    uint16_t flags2 = word(H_FLAGS2);
+    std::copy(story_->begin(), story_->begin() + staticBase, mem_.begin());
+    setWord(H_FLAGS2, static_cast<uint16_t>((word(H_FLAGS2) & ~1u) | (flags2 & 1u)));
+
+    // Interpreter capabilities: no status line, screen splitting or
+    // variable-pitch font
+    mem_[0x01] = static_cast<uint8_t>((mem_[0x01] & 0x07) | 0x10);
+
+    stack_.clear();
+    frames_.assign(1, Frame{});
+    memoryStreams_.clear();
+    pc_ = word(H_INITIAL_PC);
+    status_ = Status::RUNNING;
+    randomDraws_ = 0;
+}
+
+void ZMachine::seed(uint32_t value) {
+    rng_ = value ? value : 1;
+}
+
+std::string ZMachine::serial() const {
+    return std::string(reinterpret_cast<const char*>(&mem_[H_SERIAL]), 6);
+}
+
+std::string ZMachine::run() {
+    uint64_t limit = instructions_ + instructionLimit;
+    status_ = Status::RUNNING;
+    while (status_ == Status::RUNNING) {
+        if (instructions_ >= limit) {
+            throw fault("instruction limit reached", pc_);
+        }
+        step();
+        ++instructions_;
+    }
+    return std::move(output_);
+}
+
+void ZMachine::input(std::string_view line) {
+    if (status_ != Status::INPUT) {
+        return;
+    }
+
+    // Lowercased, truncated to the buffer, zero-terminated from byte 1
+    size_t capacity = byte(textBuffer_) > 0 ? byte(textBuffer_) - 1 : 0;
+    size_t length = std::min(line.size(), capacity);
+    for (size_t i = 0; i < length; ++i) {
+        setByte(textBuffer_ + 1 + i,
+                static_cast<uint8_t>(std::tolower(static_cast<unsigned char>(line[i]))));
+    }
+    setByte(textBuffer_ + 1 + length, 0);
+    tokenize(textBuffer_, parseBuffer_);
+
+    randomDraws_ = 0;
+    status_ = Status::RUNNING;
+}
+
+// -- Memory and variables ---------------------------------------------------
+
+void ZMachine::setByte(uint32_t addr, uint8_t value) {
+    if (addr >= word(H_STATIC_BASE)) {
+        throw fault("write to static memory", pc_);
+    }
+    mem_[addr] = value;
+}
+
+void ZMachine::setWord(uint32_t addr, uint16_t value) {
+    setByte(addr, static_cast<uint8_t>(value >> 8));
+    setByte(addr + 1, static_cast<uint8_t>(value));
+}
+
+void ZMachine::push(uint16_t value) {
+    stack_.push_back(value);
+}
+
+uint16_t ZMachine::pop() {
+    if (stack_.size() <= frames_.back().stackBase) {
+        throw fault("stack underflow", pc_);
+    }
+    uint16_t value = stack_.back();
+    stack_.pop_back();
+    return value;
+}
+
+uint16_t ZMachine::readVar(uint8_t var) {
+    return var == 0 ? pop() : peekVar(var);
+}
+
+void ZMachine::writeVar(uint8_t var, uint16_t value) {
+    if (var == 0) {
+        push(value);
+    } else {
+        pokeVar(var, value);
+    }
+}
+
+uint16_t ZMachine::peekVar(uint8_t var) {
+    if (var == 0) {
+        if (stack_.size() <= frames_.back().stackBase) {
+            throw fault("stack underflow", pc_);
+        }
+        return stack_.back();
+    }
+    if (var < 16) {
+        return frames_.back().locals[var - 1];
+    }
+    return word(word(H_GLOBALS) + 2u * (var - 16));
+}
+
+void ZMachine::pokeVar(uint8_t var, uint16_t value) {
+    if (var == 0) {
+        if (stack_.size() <= frames_.back().stackBase) {
+            throw fault("stack underflow", pc_);
+        }
+        stack_.back() = value;
+    } else if (var < 16) {
+        frames_.back().locals[var - 1] = value;
+    } else {
+        setWord(word(H_GLOBALS) + 2u * (var - 16), value);
+    }
+}
+
+// -- Control flow -----------------------------------------------------------
+
+uint16_t ZMachine::fetchWord() {
+    uint16_t value = word(pc_);
+    pc_ += 2;
+    return value;
+}
+
+void ZMachine::store(uint16_t value) {
+    writeVar(fetchByte(), value);
+}
+
+void ZMachine::branch(bool condition) {
+    uint8_t b = fetchByte();
+    bool onTrue = b & 0x80;
+    int offset = b & 0x3F;
+    if (!(b & 0x40)) {
+        offset = (offset << 8) | fetchByte();
+        if (offset & 0x2000) {
+            offset -= 0x4000; // 14-bit signed
+        }
+    }
+    if (condition != onTrue) {
+        return;
+    }
+    if (offset == 0 || offset == 1) {
+        ret(static_cast<uint16_t>(offset));
+    } else {
+        pc_ = static_cast<uint32_t>(static_cast<int32_t>(pc_) + offset - 2);
+    }
+}
+
+void ZMachine::call(uint16_t packed, const uint16_t* args, int argc, int storeVar) {
+    if (packed == 0) {
+        if (storeVar >= 0) {
+            writeVar(static_cast<uint8_t>(storeVar), 0);
+        }
+        return;
+    }
+
+    Frame frame;
+    frame.returnPc = pc_;
+    frame.storeVar = storeVar;
+    frame.stackBase = stack_.size();
+
+    // Routine header: local count, then their initial values
+    uint32_t addr = 2u * packed;
+    frame.localCount = byte(addr++);
+    if (frame.localCount > 15) {
+        throw fault("bad routine header", addr - 1);
+    }
+    for (int i = 0; i < frame.localCount; ++i, addr += 2) {
+        frame.locals[i] = i < argc ? args[i] : word(addr);
+    }
+    frames_.push_back(frame);
+    pc_ = addr;
+}
+
+void ZMachine::ret(uint16_t value) {
+    if (frames_.size() <= 1) {
+        throw fault("return from the main routine", pc_);
+    }
+    Frame frame = frames_.back();
+    frames_.pop_back();
+    stack_.resize(frame.stackBase);
+    pc_ = frame.returnPc;
+    if (frame.storeVar >= 0) {
+        writeVar(static_cast<uint8_t>(frame.storeVar), value);
+    }
+}
+
+// -- Objects ----------------------------------------------------------------
+
+uint32_t ZMachine::objectAddr(uint16_t obj) const {
+    if (obj == 0 || obj > 255) {
+        throw fault("bad object number", pc_);
+    }
+    return word(H_OBJECTS) + 2u * DEFAULT_PROPERTIES + OBJECT_SIZE * (obj - 1u);
+}
+
+void ZMachine::removeObject(uint16_t obj) {
+    uint16_t p = parent(obj);
+    if (p == 0) {
+        return;
+    }
+    uint32_t addr = objectAddr(obj);
+    if (child(p) == obj) {
+        setByte(objectAddr(p) + 6, static_cast<uint8_t>(sibling(obj)));
+    } else {
+        for (uint16_t o = child(p); o != 0; o = sibling(o)) {
+            if (sibling(o) == obj) {
+                setByte(objectAddr(o) + 5, static_cast<uint8_t>(sibling(obj)));
+                break;
+            }
+        }
+    }
+    setByte(addr + 4, 0);
+    setByte(addr + 5, 0);
+}
+
+void ZMachine::insertObject(uint16_t obj, uint16_t dest) {
+    removeObject(obj);
+    uint32_t addr = objectAddr(obj);
+    setByte(addr + 5, static_cast<uint8_t>(child(dest)));
+    setByte(addr + 4, static_cast<uint8_t>(dest));
+    setByte(objectAddr(dest) + 6, static_cast<uint8_t>(obj));
+}
+
+uint32_t ZMachine::firstProperty(uint16_t obj) const {
+    uint32_t table = propertyTable(obj);
+    return table + 1 + 2u * byte(table); // skip the short name
+}
+
+uint32_t ZMachine::findProperty(uint16_t obj, uint16_t prop) const {
+    // Properties are in descending number order, ended by a zero size byte
+    for (uint32_t addr = firstProperty(obj); byte(addr) != 0;
+         addr += 1 + propertySize(byte(addr))) {
+        int number = byte(addr) & 0x1F;
+        if (number == prop) {
+            return addr;
+        }
+        if (number < prop) {
+            break;
+        }
+    }
+    return 0;
+}
+
+// -- Text -------------------------------------------------------------------
+
+void ZMachine::printChar(uint16_t zscii) {
+    char c = zscii == 13 ? '\n' : static_cast<char>(zscii);
+    if (!memoryStreams_.empty()) {
+        // Stream 3 captures output into a table (length word, then bytes)
+        uint32_t table = memoryStreams_.back();
+        uint16_t length = word(table);
+        setByte(table + 2 + length, static_cast<uint8_t>(zscii));
+        setWord(table, static_cast<uint16_t>(length + 1));
+        return;
+    }
+    output_ += c;
+}
+
+void ZMachine::printNumber(int16_t value) {
+    for (char c : std::to_string(value)) {
+        printChar(static_cast<uint16_t>(c));
+    }
+}
+
+uint32_t ZMachine::decodeText(uint32_t addr) {
+    int alphabet = 0;      // shift for the next character only (version 3)
+    int abbreviation = 0;  // pending abbreviation bank (1-3)
+    int escape = 0;        // 10-bit ZSCII: 1 = want high bits, 2 = want low
+    uint16_t escaped = 0;
+
+    for (bool last = false; !last; addr += 2) {
+        uint16_t w = word(addr);
+        last = w & 0x8000;
+        for (int shift = 10; shift >= 0; shift -= 5) {
+            int z = (w >> shift) & 0x1F;
+            if (abbreviation) {
+                uint32_t entry = word(H_ABBREVIATIONS) + 2u * (32 * (abbreviation - 1) + z);
+                abbreviation = 0;
+                decodeText(2u * word(entry));
+            } else if (escape == 1) {
+                escaped = static_cast<uint16_t>(z << 5);
+                escape = 2;
+            } else if (escape == 2) {
+                printChar(escaped | static_cast<uint16_t>(z));
+                escape = 0;
+            } else if (z == 0) {
+                printChar(' ');
+            } else if (z <= 3) {
+                abbreviation = z;
+            } else if (z <= 5) {
+                alphabet = z - 3;
+                continue;
+            } else if (alphabet == 2 && z == 6) {
+                escape = 1;
+            } else {
+                printChar(static_cast<uint8_t>(ALPHABETS[alphabet][z - 6]));
+            }
+            alphabet = 0;
+        }
+    }
+    return addr;
+}
+
+uint32_t ZMachine::encodeWord(std::string_view text) const {
+    // Six Z-characters, padded with 5s; characters outside A0 use a shift
+    // to A2 or a ZSCII escape
+    uint8_t z[6];
+    int n = 0;
+    for (char c : text) {
+        if (n >= 6) {
+            break;
+        }
+        if (const char* p = std::strchr(ALPHABETS[0], c); c && p) {
+            z[n++] = static_cast<uint8_t>(6 + (p - ALPHABETS[0]));
+            continue;
+        }
+        const char* p = std::strchr(ALPHABETS[2] + 2, c);
+        z[n++] = 5;
+        if (c && p) {
+            if (n < 6) z[n++] = static_cast<uint8_t>(6 + (p - ALPHABETS[2]));
+        } else {
+            uint8_t zscii = static_cast<uint8_t>(c);
+            if (n < 6) z[n++] = 6;
+            if (n < 6) z[n++] = zscii >> 5;
+            if (n < 6) z[n++] = zscii & 0x1F;
+        }
+    }
+    while (n < 6) {
+        z[n++] = 5;
+    }
+    uint32_t high = static_cast<uint32_t>(z[0] << 10 | z[1] << 5 | z[2]);
+    uint32_t low = static_cast<uint32_t>(z[3] << 10 | z[4] << 5 | z[5]) | 0x8000;
+    return high << 16 | low;
+}
+
+void ZMachine::tokenize(uint32_t textBuffer, uint32_t parseBuffer) {
+    std::string text;
+    for (uint32_t addr = textBuffer + 1; byte(addr) != 0; ++addr) {
+        text += static_cast<char>(byte(addr));
+    }
+
+    uint8_t maxWords = byte(parseBuffer);
+    uint8_t words = 0;
+    size_t i = 0;
+    while (i < text.size() && words < maxWords) {
+        if (text[i] == ' ') {
+            ++i;
+            continue;
+        }
+        // A separator is a word of its own
+        size_t start = i;
+        if (separators_.find(text[i]) != std::string::npos) {
+            ++i;
+        } else {
+            while (i < text.size() && text[i] != ' ' &&
+                   separators_.find(text[i]) == std::string::npos) {
+                ++i;
+            }
+        }
+
+        uint32_t key = encodeWord(std::string_view(text).substr(start, i - start));
+        auto it = std::lower_bound(dictionary_.begin(), dictionary_.end(),
+                                   std::pair<uint32_t, uint16_t>(key, 0));
+        uint16_t entry = it != dictionary_.end() && it->first == key ? it->second : 0;
+
+        uint32_t slot = parseBuffer + 2 + 4u * words;
+        setWord(slot, entry);
+        setByte(slot + 2, static_cast<uint8_t>(i - start));
+        setByte(slot + 3, static_cast<uint8_t>(start + 1));
+        ++words;
+    }
+    setByte(parseBuffer + 1, words);
+}
+
+// -- Instructions -----------------------------------------------------------
+
+void ZMachine::step() {
+    uint32_t start = pc_;
+    uint8_t opcode = fetchByte();
+    uint16_t ops[8];
+    int count = 0;
+
+    auto operand = [&](int type) {
+        switch (type) {
+            case 0: ops[count++] = fetchWord(); break;
+            case 1: ops[count++] = fetchByte(); break;
+            case 2: ops[count++] = readVar(fetchByte()); break;
+        }
+    };
+    auto operandTypes = [&]() {
+        uint8_t types = fetchByte();
+        for (int shift = 6; shift >= 0; shift -= 2) {
+            int type = (types >> shift) & 3;
+            if (type == 3) {
+                break;
+            }
+            operand(type);
+        }
+    };
+
+    enum { OP2, OP1, OP0, VAR } kind;
+    int op;
+    if (opcode < 0x80) {
+        // Long form: two operands, small constants or variables
+        kind = OP2;
+        op = opcode & 0x1F;
+        operand(opcode & 0x40 ? 2 : 1);
+        operand(opcode & 0x20 ? 2 : 1);
+    } else if (opcode < 0xC0) {
+        int type = (opcode >> 4) & 3;
+        op = opcode & 0x0F;
+        if (type == 3) {
+            kind = OP0;
+        } else {
+            kind = OP1;
+            operand(type);
+        }
+    } else {
+        kind = opcode < 0xE0 ? OP2 : VAR;
+        op = opcode & 0x1F;
+        operandTypes();
+    }
+
+    auto a = [&](int i) { return static_cast<int16_t>(ops[i]); };
+
+    switch (kind) {
+    case OP2:
+        switch (op) {
+            case 0x01: { // je
+                bool equal = false;
+                for (int i = 1; i < count; ++i) {
+                    equal = equal || ops[0] == ops[i];
+                }
+                branch(equal);
+                return;
+            }
+            case 0x02: branch(a(0) < a(1)); return;  // jl
+            case 0x03: branch(a(0) > a(1)); return;  // jg
+            case 0x04: { // dec_chk
+                auto var = static_cast<uint8_t>(ops[0]);
+                auto value = static_cast<int16_t>(peekVar(var) - 1);
+                pokeVar(var, static_cast<uint16_t>(value));
+                branch(value < a(1));
+                return;
+            }
+            case 0x05: { // inc_chk
+                auto var = static_cast<uint8_t>(ops[0]);
+                auto value = static_cast<int16_t>(peekVar(var) + 1);
+                pokeVar(var, static_cast<uint16_t>(value));
+                branch(value > a(1));
+                return;
+            }
+            case 0x06: branch(ops[0] != 0 && parent(ops[0]) == ops[1]); return; // jin
+            case 0x07: branch((ops[0] & ops[1]) == ops[1]); return;             // test
+            case 0x08: store(ops[0] | ops[1]); return;                          // or
+            case 0x09: store(ops[0] & ops[1]); return;                          // and
+            case 0x0A: // test_attr
+                branch(byte(objectAddr(ops[0]) + ops[1] / 8) & (0x80 >> (ops[1] % 8)));
+                return;
+            case 0x0B: { // set_attr
+                uint32_t addr = objectAddr(ops[0]) + ops[1] / 8;
+                setByte(addr, static_cast<uint8_t>(byte(addr) | (0x80 >> (ops[1] % 8))));
+                return;
+            }
+            case 0x0C: { // clear_attr
+                uint32_t addr = objectAddr(ops[0]) + ops[1] / 8;
+                setByte(addr, static_cast<uint8_t>(byte(addr) & ~(0x80 >> (ops[1] % 8))));
+                return;
+            }
+            case 0x0D: pokeVar(static_cast<uint8_t>(ops[0]), ops[1]); return; // store
+            case 0x0E: insertObject(ops[0], ops[1]); return;                   // insert_obj
+            case 0x0F: store(word(static_cast<uint16_t>(ops[0] + 2 * ops[1]))); return; // loadw
+            case 0x10: store(byte(static_cast<uint16_t>(ops[0] + ops[1]))); return;     // loadb
+            case 0x11: { // get_prop
+                uint32_t addr = findProperty(ops[0], ops[1]);
+                if (addr == 0) {
+                    store(word(word(H_OBJECTS) + 2u * (ops[1] - 1)));
+                } else if (propertySize(byte(addr)) == 1) {
+                    store(byte(addr + 1));
+                } else {
+                    store(word(addr + 1));
+                }
+                return;
+            }
+            case 0x12: { // get_prop_addr
+                uint32_t addr = findProperty(ops[0], ops[1]);
+                store(static_cast<uint16_t>(addr ? addr + 1 : 0));
+                return;
+            }
+            case 0x13: { // get_next_prop
+                uint32_t addr = firstProperty(ops[0]);
+                if (ops[1] != 0) {
+                    addr = findProperty(ops[0], ops[1]);
+                    if (addr == 0) {
+                        throw fault("get_next_prop of a missing property", start);
+                    }
+                    addr += 1 + propertySize(byte(addr));
+                }
+                store(byte(addr) & 0x1F);
+                return;
+            }
+            case 0x14: store(static_cast<uint16_t>(a(0) + a(1))); return; // add
+            case 0x15: store(static_cast<uint16_t>(a(0) - a(1))); return; // sub
+            case 0x16: store(static_cast<uint16_t>(a(0) * a(1))); return; // mul
+            case 0x17: // div
+            case 0x18: // mod
+                if (a(1) == 0) {
+                    throw fault("division by zero", start);
+                }
+                store(static_cast<uint16_t>(op == 0x17 ? a(0) / a(1) : a(0) % a(1)));
+                return;
+        }
+        break;
+
+    case OP1:
+        switch (op) {
+            case 0x00: branch(ops[0] == 0); return; // jz
+            case 0x01: { // get_sibling
+                uint16_t o = sibling(ops[0]);
+                store(o);
+                branch(o != 0);
+                return;
+            }
+            case 0x02: { // get_child
+                uint16_t o = child(ops[0]);
+                store(o);
+                branch(o != 0);
+                return;
+            }
+            case 0x03: store(parent(ops[0])); return; // get_parent
+            case 0x04: // get_prop_len
+                store(static_cast<uint16_t>(ops[0] ? propertySize(byte(ops[0] - 1u)) : 0));
+                return;
+            case 0x05: { // inc
+                auto var = static_cast<uint8_t>(ops[0]);
+                pokeVar(var, static_cast<uint16_t>(peekVar(var) + 1));
+                return;
+            }
+            case 0x06: { // dec
+                auto var = static_cast<uint8_t>(ops[0]);
+                pokeVar(var, static_cast<uint16_t>(peekVar(var) - 1));
+                return;
+            }
+            case 0x07: decodeText(ops[0]); return;                   // print_addr
+            case 0x09: removeObject(ops[0]); return;                 // remove_obj
+            case 0x0A: decodeText(propertyTable(ops[0]) + 1); return; // print_obj
+            case 0x0B: ret(ops[0]); return;                          // ret
+            case 0x0C: pc_ = static_cast<uint32_t>(static_cast<int32_t>(pc_) + a(0) - 2); return; // jump
+            case 0x0D: decodeText(2u * ops[0]); return;              // print_paddr
+            case 0x0E: store(peekVar(static_cast<uint8_t>(ops[0]))); return; // load
+            case 0x0F: store(static_cast<uint16_t>(~ops[0])); return; // not
+        }
+        break;
+
+    case OP0:
+        switch (op) {
+            case 0x00: ret(1); return;            // rtrue
+            case 0x01: ret(0); return;            // rfalse
+            case 0x02: pc_ = decodeText(pc_); return; // print
+            case 0x03: // print_ret
+                pc_ = decodeText(pc_);
+                printChar(13);
+                ret(1);
+                return;
+            case 0x04: return;                    // nop
+            case 0x05:                            // save
+            case 0x06: branch(false); return;     // restore
+            case 0x07: restart(); return;         // restart
+            case 0x08: ret(pop()); return;        // ret_popped
+            case 0x09: pop(); return;             // pop
+            case 0x0A: status_ = Status::QUIT; return; // quit
+            case 0x0B: printChar(13); return;     // new_line
+            case 0x0C: return;                    // show_status
+            case 0x0D:                            // verify
+            case 0x0F: branch(true); return;      // piracy
+        }
+        break;
+
+    case VAR:
+        switch (op) {
+            case 0x00: { // call
+                int storeVar = fetchByte();
+                call(ops[0], ops + 1, count - 1, storeVar);
+                return;
+            }
+            case 0x01: setWord(static_cast<uint16_t>(ops[0] + 2 * ops[1]), ops[2]); return; // storew
+            case 0x02: setByte(static_cast<uint16_t>(ops[0] + ops[1]), static_cast<uint8_t>(ops[2])); return; // storeb
+            case 0x03: { // put_prop
+                uint32_t addr = findProperty(ops[0], ops[1]);
+                if (addr == 0) {
+                    throw fault("put_prop of a missing property", start);
+                }
+                if (propertySize(byte(addr)) == 1) {
+                    setByte(addr + 1, static_cast<uint8_t>(ops[2]));
+                } else {
+                    setWord(addr + 1, ops[2]);
+                }
+                return;
+            }
+            case 0x04: // sread
+                textBuffer_ = ops[0];
+                parseBuffer_ = ops[1];
+                status_ = Status::INPUT;
+                return;
+            case 0x05: printChar(ops[0]); return;     // print_char
+            case 0x06: printNumber(a(0)); return;     // print_num
+            case 0x07: { // random
+                uint16_t result = 0;
+                if (a(0) > 0) {
+                    // xorshift32
+                    rng_ ^= rng_ << 13;
+                    rng_ ^= rng_ >> 17;
+                    rng_ ^= rng_ << 5;
+                    result = static_cast<uint16_t>(rng_ % static_cast<uint32_t>(a(0)) + 1);
+                    ++randomDraws_;
+                } else {
+                    seed(static_cast<uint32_t>(-a(0)));
+                }
+                store(result);
+                return;
+            }
+            case 0x08: push(ops[0]); return;          // push
+            case 0x09: pokeVar(static_cast<uint8_t>(ops[0]), pop()); return; // pull
+            case 0x0A:                                // split_window
+            case 0x0B: return;                        // set_window
+            case 0x13: // output_stream
+                if (a(0) == 3) {
+                    setWord(ops[1], 0);
+                    memoryStreams_.push_back(ops[1]);
+                } else if (a(0) == -3 && !memoryStreams_.empty()) {
+                    memoryStreams_.pop_back();
+                }
+                return;
+            case 0x14:                                // input_stream
+            case 0x15: return;                        // sound_effect
+        }
+        break;
+    }
+    throw fault("illegal instruction", start);
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ZMachine - minimal version 3 Z-machine interpreter
+//
+// Runs the original story file (zil/COMPILED/zork1.z3) as a test oracle
+// for the port; see Fidelity. It implements exactly what a version 3 game
+// needs to be played through its text interface: no status line, no
+// windows, no sound, no transcript. SAVE and RESTORE always fail.
+//
+// The interpreter is driven a line at a time: run() executes until the
+// game asks for input (or ends) and returns what it printed; input()
+// supplies the next line. Output is not word-wrapped.
+//
+// RANDOM draws from a private engine seeded with seed(), so a session is
+// reproducible. An instance holds all of its own state, so sessions on
+// different threads are independent; the story image itself is shared.
+
+class ZMachine {
+public:
+    // Story file bytes, shared between instances
+    using Story = std::shared_ptr<const std::vector<uint8_t>>;
+
+    enum class Status {
+        RUNNING,  // before the first run()
+        INPUT,    // waiting for input()
+        QUIT      // the game executed QUIT
+    };
+
+    // Read a story file; throws std::runtime_error if it cannot be read
+    // or is not version 3
+    static Story load(const std::string& path);
+
+    explicit ZMachine(Story story);
+
+    // Start over from the story's initial state (as the RESTART opcode)
+    void restart();
+
+    // Seed the RANDOM opcode's engine
+    void seed(uint32_t value);
+
+    // Execute until the game asks for input or quits. Returns the text
+    // printed since the last call. Throws std::runtime_error on an illegal
+    // instruction or after instructionLimit instructions without input.
+    std::string run();
+
+    // Answer the pending read request; the next run() continues from it
+    void input(std::string_view line);
+
+    Status status() const { return status_; }
+
+    // Times the game used RANDOM since the last input (or restart)
+    uint32_t randomDraws() const { return randomDraws_; }
+
+    // Instructions executed since the story was loaded
+    uint64_t instructions() const { return instructions_; }
+
+    // Instructions allowed between two reads before run() gives up
+    uint64_t instructionLimit = 10000000;
+
+    // Story header fields
+    int release() const { return word(0x02); }
+    std::string serial() const;
+
+private:
+    struct Frame {
+        uint32_t returnPc = 0;
+        int storeVar = -1; // -1: discard the result
+        uint8_t localCount = 0;
+        uint16_t locals[15] = {};
+        size_t stackBase = 0;
+    };
+
+    // Memory
+    uint8_t byte(uint32_t addr) const { return mem_[addr]; }
+    uint16_t word(uint32_t addr) const { return static_cast<uint16_t>(mem_[addr] << 8 | mem_[addr + 1]); }
+    void setByte(uint32_t addr, uint8_t value);
+    void setWord(uint32_t addr, uint16_t value);
+
+    // Variables (0 = stack, 1-15 = locals, 16-255 = globals). The in-place
+    // forms leave the stack depth alone, as indirect references must.
+    uint16_t readVar(uint8_t var);
+    void writeVar(uint8_t var, uint16_t value);
+    uint16_t peekVar(uint8_t var);
+    void pokeVar(uint8_t var, uint16_t value);
+    void push(uint16_t value);
+    uint16_t pop();
+
+    // Instruction stream
+    uint8_t fetchByte() { return mem_[pc_++]; }
+    uint16_t fetchWord();
+    void store(uint16_t value);
+    void branch(bool condition);
+    void call(uint16_t packed, const uint16_t* args, int argc, int storeVar);
+    void ret(uint16_t value);
+    void step();
+
+    // Objects
+    uint32_t objectAddr(uint16_t obj) const;
+    uint16_t parent(uint16_t obj) const { return byte(objectAddr(obj) + 4); }
+    uint16_t sibling(uint16_t obj) const { return byte(objectAddr(obj) + 5); }
+    uint16_t child(uint16_t obj) const { return byte(objectAddr(obj) + 6); }
+    void removeObject(uint16_t obj);
+    void insertObject(uint16_t obj, uint16_t dest);
+    uint32_t propertyTable(uint16_t obj) const { return word(objectAddr(obj) + 7); }
+    uint32_t firstProperty(uint16_t obj) const;
+    uint32_t findProperty(uint16_t obj, uint16_t prop) const;
+    static int propertySize(uint8_t sizeByte) { return (sizeByte >> 5) + 1; }
+
+    // Text
+    uint32_t decodeText(uint32_t addr); // returns the address after the text
+    void printChar(uint16_t zscii);
+    void printNumber(int16_t value);
+    uint32_t encodeWord(std::string_view word) const;
+    void tokenize(uint32_t textBuffer, uint32_t parseBuffer);
+
+    Story story_;
+    std::vector<uint8_t> mem_;
+    std::vector<uint16_t> stack_;
+    std::vector<Frame> frames_;
+    uint32_t pc_ = 0;
+    Status status_ = Status::RUNNING;
+
+    // Pending read
+    uint32_t textBuffer_ = 0;
+    uint32_t parseBuffer_ = 0;
+
+    std::string output_;
+    std::vector<uint32_t> memoryStreams_; // output stream 3 tables, innermost last
+
+    uint32_t rng_ = 1;
+    uint32_t randomDraws_ = 0;
+    uint64_t instructions_ = 0;
+
+    // Dictionary: encoded word -> entry address
+    std::vector<std::pair<uint32_t, uint16_t>> dictionary_;
+    std::string separators_;
+};
@@ -7,6 +7,7 @@
 #include "core/io.h"
 #include "parser/parser.h"
 #include "systems/lamp.h"
+#include "systems/undo.h"
 #include "world/objects.h"
 #include "world/rooms.h"
 #include "world/world.h"
@@ -14,55 +15,19 @@
 #include <sstream>
 
 // External state from actions.cpp
-extern bool damGatesOpen;
+extern thread_local bool damGatesOpen;
 
 namespace Verbs {
 
-// Helper function to calculate total weight (size) of an object and all its
-// contents recursively This matches the WEIGHT function from ZIL
-// (Requirement 64.2)
-static int calculateWeight(const ZObject *obj) {
-  if (!obj)
-    return 0;
-
-  int weight = obj->getProperty(P_SIZE);
-
-  // Add weight of all contents recursively
-  for (const auto *content : obj->getContents()) {
-    weight += calculateWeight(content);
-  }
-
-  return weight;
-}
-
 // Helper function to check if an object is accessible to the player
-// An object is accessible if it's in the current room, player inventory,
-// or in an open container in either location
+// An object is accessible if it's in the current room or player inventory,
+// at any depth of open containers
 static bool isObjectAccessible(const ZObject *obj) {
   if (!obj)
     return false;
 
   auto &g = Globals::instance();
-  ZObject *location = obj->getLocation();
-
-  // In inventory
-  if (location == g.winner)
-    return true;
-
-  // In current room
-  if (location == g.here)
-    return true;
-
-  // In an open container in room or inventory
-  if (location && location->hasFlag(ObjectFlag::CONTBIT) &&
-      location->hasFlag(ObjectFlag::OPENBIT)) {
-    ZObject *containerLocation = location->getLocation();
-    if (containerLocation == g.here || containerLocation == g.winner) {
-      return true;
-    }
-  }
-
-  return false;
+  return obj->isReachableIn(g.here) || obj->isReachableIn(g.winner);
 }
 
 // Helper function to find and auto-select an implied object when verb has only
@@ -70,7 +35,7 @@ static bool isObjectAccessible(const ZObject *obj) {
 // otherwise Prints "(object name)" if an object is auto-selected
 static ZObject *tryImpliedObject(VerbId verb) {
   auto &g = Globals::instance();
-  std::vector<ZObject *> applicable;
+  std::pmr::vector<ZObject *> applicable(g.scratch());
 
   // Different verb types need different object pools
   if (verb == V_TAKE) {
@@ -295,7 +260,7 @@ bool vInventory() {
           }
 
           // Get description and add proper article
-          std::string desc = obj->getDesc();
+          std::string desc(obj->getDesc());
 
           // Capitalize first letter for display
           char firstChar = desc.empty() ? 'A' : desc[0];
@@ -445,14 +410,11 @@ bool vTake() {
   }
 
   // Check inventory weight limit (Requirement 63)
-  // Calculate current inventory weight
-  int currentWeight = 0;
-  for (const auto *obj : g.winner->getContents()) {
-    currentWeight += obj->getProperty(P_SIZE);
-  }
+  // Current inventory weight, including what containers hold (ZIL WEIGHT)
+  int currentWeight = g.winner->getContentsWeight();
 
-  // Get object size
-  int objectSize = g.prso->getProperty(P_SIZE);
+  // Get object weight, with its contents
+  int objectSize = g.prso->getWeight();
   if (objectSize == 0) {
     objectSize = 5; // Default size if not specified
   }
@@ -614,7 +576,7 @@ bool vOpen() {
       if (!first)
         print(", ");
       // Add proper article
-      std::string desc = obj->getDesc();
+      std::string desc(obj->getDesc());
       char firstChar = desc.empty() ? 'a' : desc[0];
       bool startsWithVowel =
           (firstChar == 'a' || firstChar == 'e' || firstChar == 'i' ||
@@ -894,7 +856,7 @@ bool vWalkDir(Direction dir) {
   // Move to new room
   ZObject *newRoom = g.getObject(exit->targetRoom);
   if (newRoom) {
-    g.here = newRoom;
+    g.setHere(newRoom);
     g.winner->moveTo(newRoom);
     vLook();
   }
@@ -953,7 +915,7 @@ bool trySpecialMovement(int verbId, Direction dir) {
   // Move to new room
   ZObject *newRoom = g.getObject(exit->targetRoom);
   if (newRoom) {
-    g.here = newRoom;
+    g.setHere(newRoom);
     g.winner->moveTo(newRoom);
   }
 
@@ -1093,7 +1055,7 @@ bool vRead() {
   // Check if object is specified
   if (!g.prso) {
     // Look for readable objects in scope
-    std::vector<ZObject *> readableObjects;
+    std::pmr::vector<ZObject *> readableObjects(g.scratch());
 
     // Check current room
     for (const auto *obj : g.here->getContents()) {
@@ -1168,31 +1130,15 @@ bool vRead() {
     }
 
     // Check if object is accessible
-    ZObject *objLocation = g.prso->getLocation();
-    bool accessible = false;
-
-    if (objLocation == g.here) {
-      accessible = true;
-    } else if (objLocation && objLocation->hasFlag(ObjectFlag::CONTBIT) &&
-               objLocation->hasFlag(ObjectFlag::OPENBIT)) {
-      ZObject *containerLocation = objLocation->getLocation();
-      if (containerLocation == g.here || containerLocation == g.winner) {
-        accessible = true;
-      }
-    }
-
-    if (!accessible) {
+    if (!isObjectAccessible(g.prso)) {
       printLine("You can't see any such thing.");
       return RTRUE;
     }
 
     // Check inventory weight limit
-    int currentWeight = 0;
-    for (const auto *obj : g.winner->getContents()) {
-      currentWeight += obj->getProperty(P_SIZE);
-    }
+    int currentWeight = g.winner->getContentsWeight();
 
-    int objectSize = g.prso->getProperty(P_SIZE);
+    int objectSize = g.prso->getWeight();
     if (objectSize == 0) {
       objectSize = 5;
     }
@@ -1361,23 +1307,7 @@ bool vPut() {
   }
 
   // Check if direct object is accessible
-  ZObject *objLocation = g.prso->getLocation();
-  bool accessible = false;
-
-  if (objLocation == g.here || objLocation == g.winner) {
-    accessible = true;
-  } else if (objLocation) {
-    // Check if object is in an open container
-    if (objLocation->hasFlag(ObjectFlag::CONTBIT) &&
-        objLocation->hasFlag(ObjectFlag::OPENBIT)) {
-      ZObject *containerLocation = objLocation->getLocation();
-      if (containerLocation == g.here || containerLocation == g.winner) {
-        accessible = true;
-      }
-    }
-  }
-
-  if (!accessible) {
+  if (!isObjectAccessible(g.prso)) {
     printLine("You can't see any such thing.");
     return RTRUE;
   }
@@ -1403,11 +1333,10 @@ bool vPut() {
     capacity = 100; // Default capacity if not specified
   }
 
-  // Calculate weight of container (including all nested contents)
-  int containerWeight = calculateWeight(g.prsi);
-
-  // Calculate weight of object to be added (including all nested contents)
-  int objectWeight = calculateWeight(g.prso);
+  // Weight of container and of object to be added, including all nested
+  // contents (kept by each object, see ZObject::getWeight)
+  int containerWeight = g.prsi->getWeight();
+  int objectWeight = g.prso->getWeight();
 
   // Get container's own size
   int containerSize = g.prsi->getProperty(P_SIZE);
@@ -2494,7 +2423,7 @@ bool vRestore() {
   // Restore player location
   ZObject *newLocation = g.getObject(playerLocation);
   if (newLocation) {
-    g.here = newLocation;
+    g.setHere(newLocation);
     if (g.winner) {
       g.winner->moveTo(newLocation);
     }
@@ -2646,6 +2575,17 @@ bool vUnscript() {
   return RTRUE;
 }
 
+bool vUndo() {
+  // Roll back the previous turn from the undo journal. UNDO is not a turn
+  // itself, so repeating it steps further back through the history.
+  if (UndoSystem::undo(1) == 0) {
+    printLine("[You can't \"undo\" what hasn't been done!]");
+    return RTRUE;
+  }
+  printLine("[Previous turn undone.]");
+  return RTRUE;
+}
+
 // Communication Verbs
 
 bool vTalk() {
@@ -2754,7 +2694,7 @@ bool vHello() {
   static const char *hellos[] = {"Hello.", "Good day.",
                                  "Nice weather we've been having lately.",
                                  "Goodbye."};
-  static int helloIdx = 0;
+  static thread_local int helloIdx = 0;
   printLine(hellos[helloIdx % 4]);
   helloIdx++;
   return RTRUE;
@@ -2807,7 +2747,7 @@ bool vJump() {
       "Very good. Now you can go to the second grade.",
       "Are you enjoying yourself?", "Wheeeeeeeeee!!!!!",
       "Do you expect me to applaud?"};
-  static int idx = 0;
+  static thread_local int idx = 0;
   printLine(responses[idx % 4]);
   idx++;
   return RTRUE;
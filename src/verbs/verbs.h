@@ -38,6 +38,7 @@ constexpr VerbId V_SCORE = 10;
 constexpr VerbId V_VERSION = 11;
 constexpr VerbId V_SCRIPT = 12;
 constexpr VerbId V_UNSCRIPT = 13;
+constexpr VerbId V_UNDO = 14;
 
 // Real verbs - manipulation
 constexpr VerbId V_TAKE = 20;
@@ -381,6 +382,7 @@ namespace Verbs {
     bool vVersion();
     bool vScript();
     bool vUnscript();
+    bool vUndo();
     
     // Communication verbs
     bool vTalk();
@@ -3,16 +3,17 @@
 #include "systems/candle.h"
 #include "systems/npc.h"
 #include "systems/score.h"
+#include "systems/undo.h"
 #include "verbs/verbs.h"
 #include "world.h"
 #include <memory>
 
 // Global flag for winning the game
-bool wonFlag = false;
+thread_local bool wonFlag = false;
 
 // Dam puzzle state (Requirement 70.2: Dam puzzle)
 // Yellow button opens the gates, brown button closes them
-bool damGatesOpen = false;
+thread_local bool damGatesOpen = false;
 
 // Room action functions
 void westHouseAction(int rarg) {
@@ -141,7 +142,7 @@ bool basketAction() {
     return RFALSE;
 
   // Static state for basket position (true = top, false = bottom)
-  static bool cageTop = true;
+  static thread_local bool cageTop = true;
 
   // RAISE
   if (g.prsa == V_RAISE) {
@@ -160,6 +161,9 @@ bool basketAction() {
       if (loweredBasket && lowerShaft)
         loweredBasket->moveTo(lowerShaft);
 
+      if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(cageTop);
+      }
       cageTop = true;
       printLine("The basket is raised to the top of the shaft.");
     }
@@ -182,6 +186,9 @@ bool basketAction() {
       if (loweredBasket && shaftRoom)
         loweredBasket->moveTo(shaftRoom);
 
+      if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(cageTop);
+      }
       cageTop = false;
       printLine("The basket is lowered to the bottom of the shaft.");
 
@@ -402,7 +409,7 @@ bool forestAction() {
       auto *target = g.getObject(nextRoom);
       if (target && g.winner) {
         g.winner->moveTo(target);
-        g.here = target;
+        g.setHere(target);
         return true;
       }
     }
@@ -483,7 +490,7 @@ bool groundAction() {
 }
 
 // Global flag to track if window has been opened (per ZIL KITCHEN-WINDOW-FLAG)
-static bool kitchenWindowOpened = false;
+static thread_local bool kitchenWindowOpened = false;
 
 bool kitchenWindowAction() {
   auto &g = Globals::instance();
@@ -495,6 +502,9 @@ bool kitchenWindowAction() {
     } else {
       if (window)
         window->setFlag(ObjectFlag::OPENBIT);
+      if (UndoSystem::isRecording()) {
+        UndoSystem::UndoJournal::instance().recordValue(kitchenWindowOpened);
+      }
       kitchenWindowOpened = true;
       printLine(
           "With great effort, you open the window far enough to allow entry.");
@@ -905,7 +915,7 @@ bool candlesAction() {
 // ============================================================================
 
 // Global flag to track if painting has been examined from back
-static bool paintingExaminedBack = false;
+static thread_local bool paintingExaminedBack = false;
 
 // Painting action - special treasure that can be taken from wall, has back side
 // Based on PAINTING-FCN from 1actions.zil
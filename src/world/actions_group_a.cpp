@@ -1,8 +1,10 @@
 #include "core/globals.h"
 #include "core/io.h"
 #include "core/object.h"
+#include "core/random.h"
 #include "systems/death.h"
 #include "systems/npc.h"
+#include "systems/undo.h"
 #include "verbs/verbs.h"
 #include "world/objects.h"
 #include "world/rooms.h"
@@ -22,7 +24,7 @@ static Direction getDirection(ZObject *obj) {
   // an object passed as PRSO? In ZIL: <EQUAL? ,PRSO ,P?WEST>. So PRSO is a
   // DIRECTION object. I'll assume standard naming or return Direction::WEST if
   // name is "west".
-  std::string name = obj->getDesc(); // or synonyms
+  std::string name(obj->getDesc()); // or synonyms
   // Fast path:
   if (name == "north" || name == "n")
     return Direction::NORTH;
@@ -778,7 +780,7 @@ void domeRoomAction(int rarg) {
       ZObject *torchRoom = g.getObject(RoomIds::TORCH_ROOM);
       if (torchRoom && g.winner) {
         g.winner->moveTo(torchRoom);
-        g.here = torchRoom;
+        g.setHere(torchRoom);
       }
       // RTRUE implies handled/stop?
       return;
@@ -1536,8 +1538,8 @@ bool leakAction() {
 // LIVING-ROOM-FCN - Living room handler with dynamic description
 // ZIL: M-LOOK shows door/trophy/rug/trap door state, M-END updates score
 // Source: 1actions.zil lines 449-485
-static bool rugMoved = false;  // RUG-MOVED flag
-static bool magicFlag = false; // MAGIC-FLAG (cyclops door opened)
+static thread_local bool rugMoved = false;  // RUG-MOVED flag
+static thread_local bool magicFlag = false; // MAGIC-FLAG (cyclops door opened)
 
 void livingRoomAction(int rarg) {
   auto &g = Globals::instance();
@@ -1584,8 +1586,8 @@ void livingRoomAction(int rarg) {
 // LOUD-ROOM-FCN - Loud room echo puzzle handler
 // ZIL: ECHO command sets LOUD-FLAG and clears BAR SACREDBIT, making bar
 // takeable Source: 1actions.zil lines 1660-1728
-static bool loudFlag = false; // LOUD-FLAG - room has been quieted
-extern bool damGatesOpen;     // From actions.cpp - dam gates state
+static thread_local bool loudFlag = false; // LOUD-FLAG - room has been quieted
+extern thread_local bool damGatesOpen;     // From actions.cpp - dam gates state
 
 void loudRoomAction(int rarg) {
   auto &g = Globals::instance();
@@ -1630,6 +1632,9 @@ bool handleEchoInLoudRoom() {
 
   if (!loudFlag && damGatesOpen) {
     // Saying ECHO quiets the room and makes platinum bar takeable
+    if (UndoSystem::isRecording()) {
+      UndoSystem::UndoJournal::instance().recordValue(loudFlag);
+    }
     loudFlag = true;
 
     // Clear SACREDBIT on platinum bar (makes it takeable by thief too)
@@ -1715,8 +1720,7 @@ bool machineSwitchAction() {
         }
       } else if (machine) {
         // Remove all contents and add GUNK
-        auto contents = machine->getContents();
-        for (ZObject *obj : contents) {
+        for (ZObject *obj : machine->getContents()) {
           obj->moveTo(nullptr);
         }
         ZObject *gunk = g.getObject(ObjectIds::GUNK);
@@ -1788,7 +1792,7 @@ bool rainbowAction() {
         ZObject *endOfRainbow = g.getObject(RoomIds::END_OF_RAINBOW);
         if (endOfRainbow) {
           g.player->moveTo(endOfRainbow);
-          g.here = endOfRainbow;
+          g.setHere(endOfRainbow);
         }
         return RTRUE;
       } else if (g.here && g.here->getId() == RoomIds::END_OF_RAINBOW) {
@@ -1796,7 +1800,7 @@ bool rainbowAction() {
         ZObject *aragainFalls = g.getObject(RoomIds::ARAGAIN_FALLS);
         if (aragainFalls) {
           g.player->moveTo(aragainFalls);
-          g.here = aragainFalls;
+          g.setHere(aragainFalls);
         }
         return RTRUE;
       } else {
@@ -2149,7 +2153,7 @@ static void flyMe() {
 
   // <GOTO <PICK-ONE ,BAT-DROPS> <>>
   if (!BAT_DROPS.empty()) {
-    int idx = std::rand() % BAT_DROPS.size();
+    int idx = Random::range(0, static_cast<int>(BAT_DROPS.size()) - 1);
     ObjectId targetId = BAT_DROPS[idx];
     ZObject *target = g.getObject(targetId);
     if (target) {
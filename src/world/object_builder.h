@@ -35,7 +35,7 @@ struct ObjectDef {
 inline ZObject* createObject(const ObjectDef& def) {
     auto& g = Globals::instance();
     
-    auto obj = std::make_unique<ZObject>(def.id, std::string(def.desc));
+    auto obj = g.makeObject<ZObject>(def.id, def.desc);
     
     for (auto syn : def.synonyms) {
         obj->addSynonym(std::string(syn));
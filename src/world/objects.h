@@ -229,7 +229,7 @@ constexpr ObjectId OBJ_FRONT_DOOR = ObjectIds::FRONT_DOOR;
 constexpr ObjectId OBJ_ADVENTURER = ObjectIds::ADVENTURER;
 constexpr ObjectId OBJ_KITCHEN_WINDOW = ObjectIds::KITCHEN_WINDOW;
 
-// Property IDs
+// Property IDs (each below PropertyTable::SLOTS in core/object.h)
 constexpr PropertyId P_SIZE = 1;
 constexpr PropertyId P_CAPACITY = 2;
 constexpr PropertyId P_VALUE = 3;
@@ -46,8 +46,7 @@ struct RoomDef {
 inline ZRoom* createRoom(const RoomDef& def) {
     auto& g = Globals::instance();
     
-    auto room = std::make_unique<ZRoom>(def.id, std::string(def.name), 
-                                         std::string(def.longDesc));
+    auto room = g.makeObject<ZRoom>(def.id, def.name, def.longDesc);
     
     // Normal exits
     for (const auto& [dir, target] : def.exits) {
@@ -1,11 +1,21 @@
 #include "rooms.h"
 #include "core/globals.h"
+#include "systems/footprint.h"
+#include "systems/metrics.h"
 
-ZRoom::ZRoom(ObjectId id, std::string_view desc, std::string_view longDesc)
-    : ZObject(id, desc), longDesc_(longDesc) {}
+ZRoom::ZRoom(ObjectId id, std::string_view desc, std::string_view longDesc,
+             std::pmr::memory_resource* memory)
+    : ZObject(id, desc, memory), longDesc_(longDesc, memory), exits_(memory) {}
+
+void ZRoom::performRoomAction(int arg) {
+    if (roomAction_) {
+        Metrics::roomAction(*this);
+        roomAction_(arg);
+    }
+}
 
 void ZRoom::setExit(Direction dir, const RoomExit& exit) {
-    exits_[dir] = exit;
+    exits_.insert_or_assign(dir, exit);
 }
 
 RoomExit* ZRoom::getExit(Direction dir) {
@@ -18,6 +28,25 @@ const RoomExit* ZRoom::getExit(Direction dir) const {
     return it != exits_.end() ? &it->second : nullptr;
 }
 
+void ZRoom::addFootprint(Footprint::Report& report) const {
+    using Footprint::Part;
+    using Footprint::heap;
+    ZObject::addFootprint(report);
+    report[Part::OBJECTS] += sizeof(ZRoom) - sizeof(ZObject) - sizeof(longDesc_) -
+                             sizeof(exits_) - sizeof(roomAction_);
+    report[Part::TEXT] += sizeof(longDesc_) + heap(longDesc_);
+    report[Part::CLOSURES] += sizeof(roomAction_);
+
+    // The exit table, less the messages and conditions inside its nodes
+    report[Part::EXITS] += sizeof(exits_) + heap(exits_);
+    for (const auto& [dir, exit] : exits_) {
+        size_t text = sizeof(exit.message) + sizeof(exit.specialMessage);
+        report[Part::EXITS] -= text + sizeof(exit.condition);
+        report[Part::TEXT] += text + heap(exit.message) + heap(exit.specialMessage);
+        report[Part::CLOSURES] += sizeof(exit.condition);
+    }
+}
+
 RoomExit RoomExit::createRequiresItem(ObjectId target, ObjectId requiredItem, std::string_view msg) {
     RoomExit exit;
     exit.targetRoom = target;
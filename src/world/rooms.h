@@ -4,6 +4,7 @@
 #include <string>
 #include <string_view>
 #include <map>
+#include <memory_resource>
 #include <functional>
 
 /**
@@ -186,9 +187,14 @@ enum class ExitType {
 };
 
 // Room exit structure
+//
+// Allocator-aware, so that an exit copied into a room's exit table keeps
+// its messages in the room's memory (see ZObject)
 struct RoomExit {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     ObjectId targetRoom = 0;
-    std::string message;  // For blocked exits
+    std::pmr::string message;  // For blocked exits
     std::function<bool()> condition;  // Optional condition
     ExitType type = ExitType::NORMAL;
     
@@ -197,11 +203,19 @@ struct RoomExit {
     
     // Special movement fields
     int requiredVerb = 0;  // Verb ID required for special exits (CLIMB, ENTER, etc.)
-    std::string specialMessage;  // Message when wrong verb is used
+    std::pmr::string specialMessage;  // Message when wrong verb is used
     
     RoomExit() = default;
     explicit RoomExit(ObjectId target) : targetRoom(target) {}
     explicit RoomExit(std::string_view msg) : message(msg) {}
+    RoomExit(const RoomExit& other) = default;
+    RoomExit(RoomExit&& other) = default;
+    RoomExit& operator=(const RoomExit& other) = default;
+    RoomExit& operator=(RoomExit&& other) = default;
+    RoomExit(const RoomExit& other, const allocator_type& memory)
+        : targetRoom(other.targetRoom), message(other.message, memory), condition(other.condition),
+          type(other.type), doorObject(other.doorObject), requiredVerb(other.requiredVerb),
+          specialMessage(other.specialMessage, memory) {}
     
     // Door exit constructor
     static RoomExit createDoor(ObjectId target, ObjectId door) {
@@ -271,7 +285,8 @@ struct RoomExit {
  */
 class ZRoom : public ZObject {
 public:
-    ZRoom(ObjectId id, std::string_view desc, std::string_view longDesc);
+    ZRoom(ObjectId id, std::string_view desc, std::string_view longDesc,
+          std::pmr::memory_resource* memory = std::pmr::get_default_resource());
     
     /// Set an exit in the specified direction
     void setExit(Direction dir, const RoomExit& exit);
@@ -281,7 +296,7 @@ public:
     const RoomExit* getExit(Direction dir) const;
     
     /// Get the long description for room display
-    const std::string& getLongDesc() const { return longDesc_; }
+    const std::pmr::string& getLongDesc() const { return longDesc_; }
     
     /// Room action handler type (receives action code like M_LOOK)
     using RoomActionFunc = std::function<void(int)>;
@@ -290,14 +305,17 @@ public:
     void setRoomAction(RoomActionFunc func) { roomAction_ = func; }
     
     /// Execute room action with given action code
-    void performRoomAction(int arg) { if (roomAction_) roomAction_(arg); }
+    void performRoomAction(int arg);
     
     /// Check if room has an action handler
     bool hasRoomAction() const { return roomAction_ != nullptr; }
     
+    /// Add the room's memory, exits included, to report
+    void addFootprint(Footprint::Report& report) const override;
+    
 private:
-    std::string longDesc_;                    ///< Full room description
-    std::map<Direction, RoomExit> exits_;     ///< Exits by direction
+    std::pmr::string longDesc_;                    ///< Full room description
+    std::pmr::map<Direction, RoomExit> exits_;     ///< Exits by direction
     RoomActionFunc roomAction_;               ///< Optional action handler
 };
 
@@ -11,7 +11,7 @@
 #include <memory>
 
 // Forward declarations for action handlers (defined in actions.cpp)
-extern bool wonFlag;
+extern thread_local bool wonFlag;
 void westHouseAction(int rarg);
 void northHouseAction(int rarg);
 void southHouseAction(int rarg);
@@ -66,7 +66,7 @@ void initializeWorld() {
     auto& g = Globals::instance();
     
     // Create West of House room
-    auto westOfHouse = std::make_unique<ZRoom>(
+    auto westOfHouse = g.makeObject<ZRoom>(
         ROOM_WEST_OF_HOUSE,
         "West of House",
         "You are standing in an open field west of a white house, with a boarded front door."
@@ -85,11 +85,11 @@ void initializeWorld() {
     westOfHouse->setExit(Direction::EAST, RoomExit("The door is boarded and you can't remove the boards."));
     // SW and IN to STONE_BARROW require WON-FLAG - will be handled by conditional exits later
     
-    g.here = westOfHouse.get();
+    g.setHere(westOfHouse.get());
     g.registerObject(ROOM_WEST_OF_HOUSE, std::move(westOfHouse));
     
     // Create North of House room
-    auto northOfHouse = std::make_unique<ZRoom>(
+    auto northOfHouse = g.makeObject<ZRoom>(
         ROOM_NORTH_OF_HOUSE,
         "North of House",
         "You are facing the north side of a white house. There is no door here, and all the windows are boarded up. To the north a narrow path winds through the trees."
@@ -110,7 +110,7 @@ void initializeWorld() {
     g.registerObject(ROOM_NORTH_OF_HOUSE, std::move(northOfHouse));
     
     // Create South of House room
-    auto southOfHouse = std::make_unique<ZRoom>(
+    auto southOfHouse = g.makeObject<ZRoom>(
         ROOM_SOUTH_OF_HOUSE,
         "South of House",
         "You are facing the south side of a white house. There is no door here, and all the windows are boarded."
@@ -131,7 +131,7 @@ void initializeWorld() {
     g.registerObject(ROOM_SOUTH_OF_HOUSE, std::move(southOfHouse));
     
     // Create Behind House room (EAST_OF_HOUSE in ZIL)
-    auto behindHouse = std::make_unique<ZRoom>(
+    auto behindHouse = g.makeObject<ZRoom>(
         ROOM_EAST_OF_HOUSE,
         "Behind House",
         "You are behind the white house. A path leads into the forest to the east. In one corner of the house there is a small window which is slightly ajar."
@@ -153,7 +153,7 @@ void initializeWorld() {
     g.registerObject(ROOM_EAST_OF_HOUSE, std::move(behindHouse));
     
     // Create Stone Barrow room
-    auto stoneBarrow = std::make_unique<ZRoom>(
+    auto stoneBarrow = g.makeObject<ZRoom>(
         ROOM_STONE_BARROW,
         "Stone Barrow",
         "You are standing in front of a massive barrow of stone. In the east face is a huge stone door which is open. You cannot see into the dark of the tomb."
@@ -170,7 +170,7 @@ void initializeWorld() {
     g.registerObject(ROOM_STONE_BARROW, std::move(stoneBarrow));
     
     // Create Forest-1
-    auto forest1 = std::make_unique<ZRoom>(
+    auto forest1 = g.makeObject<ZRoom>(
         ROOM_FOREST_1,
         "Forest",
         "This is a forest, with trees in all directions. To the east, there appears to be sunlight."
@@ -190,7 +190,7 @@ void initializeWorld() {
     g.registerObject(ROOM_FOREST_1, std::move(forest1));
     
     // Create Forest-2
-    auto forest2 = std::make_unique<ZRoom>(
+    auto forest2 = g.makeObject<ZRoom>(
         RoomIds::FOREST_2,
         "Forest",
         "This is a dimly lit forest, with large trees all around."
@@ -210,7 +210,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::FOREST_2, std::move(forest2));
     
     // Create Forest-3
-    auto forest3 = std::make_unique<ZRoom>(
+    auto forest3 = g.makeObject<ZRoom>(
         RoomIds::FOREST_3,
         "Forest",
         "This is a dimly lit forest, with large trees all around."
@@ -231,7 +231,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::FOREST_3, std::move(forest3));
     
     // Create Mountains room
-    auto mountains = std::make_unique<ZRoom>(
+    auto mountains = g.makeObject<ZRoom>(
         RoomIds::MOUNTAINS,
         "Forest",
         "The forest thins out, revealing impassable mountains."
@@ -254,7 +254,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MOUNTAINS, std::move(mountains));
     
     // Create Clearing room
-    auto clearing = std::make_unique<ZRoom>(
+    auto clearing = g.makeObject<ZRoom>(
         RoomIds::CLEARING,
         "Clearing",
         "You are in a small clearing in a well marked forest path that extends to the east and west."
@@ -277,7 +277,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::CLEARING, std::move(clearing));
     
     // Create Grating Clearing room
-    auto gratingClearing = std::make_unique<ZRoom>(
+    auto gratingClearing = g.makeObject<ZRoom>(
         RoomIds::GRATING_CLEARING,
         "Clearing",
         "You are in a clearing, with a forest surrounding you on all sides. A path leads south."
@@ -300,7 +300,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::GRATING_CLEARING, std::move(gratingClearing));
     
     // Create Forest Path room
-    auto forestPath = std::make_unique<ZRoom>(
+    auto forestPath = g.makeObject<ZRoom>(
         RoomIds::FOREST_PATH,
         "Forest Path",
         "This is a path winding through a dimly lit forest. The path heads north-south here. One particularly large tree with some low branches stands at the edge of the path."
@@ -323,7 +323,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::FOREST_PATH, std::move(forestPath));
     
     // Create Up a Tree room
-    auto upATree = std::make_unique<ZRoom>(
+    auto upATree = g.makeObject<ZRoom>(
         RoomIds::UP_A_TREE,
         "Up a Tree",
         "You are about 10 feet above the ground nestled among some large branches. The nearest branch above you is above your reach."
@@ -342,7 +342,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::UP_A_TREE, std::move(upATree));
     
     // Create Canyon View room
-    auto canyonView = std::make_unique<ZRoom>(
+    auto canyonView = g.makeObject<ZRoom>(
         RoomIds::CANYON_VIEW,
         "Canyon View",
         "You are at the top of the Great Canyon on its west wall. From here there is a marvelous view of the canyon and parts of the Frigid River upstream. Across the canyon, the walls of the White Cliffs join the mighty ramparts of the Flathead Mountains to the east. Following the Canyon upstream to the north, Aragain Falls may be seen, complete with rainbow. The mighty Frigid River flows out from a great dark cavern. To the west and south can be seen an immense forest, stretching for miles around. A path leads northwest."
@@ -367,7 +367,7 @@ void initializeWorld() {
     // ===== HOUSE INTERIOR ROOMS =====
     
     // Create Living Room
-    auto livingRoom = std::make_unique<ZRoom>(
+    auto livingRoom = g.makeObject<ZRoom>(
         RoomIds::LIVING_ROOM,
         "Living Room",
         "You are in the living room. There is a doorway to the east, a wooden door with strange gothic lettering to the west, which appears to be nailed shut, a trophy case, and a large oriental rug in the center of the room."
@@ -389,7 +389,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LIVING_ROOM, std::move(livingRoom));
     
     // Create Kitchen
-    auto kitchen = std::make_unique<ZRoom>(
+    auto kitchen = g.makeObject<ZRoom>(
         RoomIds::KITCHEN,
         "Kitchen",
         "You are in the kitchen of the white house. A table seems to have been used recently for the preparation of food. A passage leads to the west and a dark staircase can be seen leading upward. A dark chimney leads down and to the east is a small window which is open."
@@ -414,7 +414,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::KITCHEN, std::move(kitchen));
     
     // Create Attic
-    auto attic = std::make_unique<ZRoom>(
+    auto attic = g.makeObject<ZRoom>(
         RoomIds::ATTIC,
         "Attic",
         "This is the attic. The only exit is a stairway leading down."
@@ -434,7 +434,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::ATTIC, std::move(attic));
     
     // Create Cellar
-    auto cellar = std::make_unique<ZRoom>(
+    auto cellar = g.makeObject<ZRoom>(
         RoomIds::CELLAR,
         "Cellar",
         "You are in a dark and damp cellar with a narrow passageway leading north, and a crawlway to the south. On the west is the bottom of a steep metal ramp which is unclimbable."
@@ -458,7 +458,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::CELLAR, std::move(cellar));
     
     // Create Gallery
-    auto gallery = std::make_unique<ZRoom>(
+    auto gallery = g.makeObject<ZRoom>(
         RoomIds::GALLERY,
         "Gallery",
         "This is an art gallery. Most of the paintings which were here have been stolen by vandals with exceptional taste. The vandals left through either the north or west exits."
@@ -479,7 +479,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::GALLERY, std::move(gallery));
     
     // Create Studio
-    auto studio = std::make_unique<ZRoom>(
+    auto studio = g.makeObject<ZRoom>(
         RoomIds::STUDIO,
         "Studio",
         "This appears to have been an artist's studio. The walls and floors are splattered with paints of 69 different colors. Strangely enough, nothing of value is hanging here. At the south end of the room is an open door (also covered with paint). A dark and narrow chimney leads up from a fireplace; although you might be able to get up it, it seems unlikely you could get back down."
@@ -508,7 +508,7 @@ void initializeWorld() {
     // ===== UNDERGROUND PASSAGES =====
     
     // Create Troll Room
-    auto trollRoom = std::make_unique<ZRoom>(
+    auto trollRoom = g.makeObject<ZRoom>(
         RoomIds::TROLL_ROOM,
         "Troll Room",
         "This is a small room with passages to the east and south and a forbidding hole leading west. Bloodstains and deep scratches (perhaps made by an axe) mar the walls."
@@ -548,7 +548,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TROLL_ROOM, std::move(trollRoom));
     
     // Create East of Chasm room
-    auto eastOfChasm = std::make_unique<ZRoom>(
+    auto eastOfChasm = g.makeObject<ZRoom>(
         RoomIds::EAST_OF_CHASM,
         "East of Chasm",
         "You are on the east edge of a chasm, the bottom of which cannot be seen. A narrow passage goes north, and the path you are on continues to the east."
@@ -581,7 +581,7 @@ void initializeWorld() {
     }
     
     // Create East-West Passage
-    auto ewPassage = std::make_unique<ZRoom>(
+    auto ewPassage = g.makeObject<ZRoom>(
         RoomIds::EW_PASSAGE,
         "East-West Passage",
         "This is a narrow east-west passageway. There is a narrow stairway leading down at the north end of the room."
@@ -603,7 +603,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::EW_PASSAGE, std::move(ewPassage));
     
     // Create North-South Passage
-    auto nsPassage = std::make_unique<ZRoom>(
+    auto nsPassage = g.makeObject<ZRoom>(
         RoomIds::NS_PASSAGE,
         "North-South Passage",
         "This is a high north-south passage, which forks to the northeast."
@@ -624,7 +624,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::NS_PASSAGE, std::move(nsPassage));
     
     // Create Chasm Room
-    auto chasmRoom = std::make_unique<ZRoom>(
+    auto chasmRoom = g.makeObject<ZRoom>(
         RoomIds::CHASM_ROOM,
         "Chasm",
         "A chasm runs southwest to northeast and the path follows it. You are on the south side of the chasm, where a crack opens into a passage."
@@ -647,7 +647,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::CHASM_ROOM, std::move(chasmRoom));
     
     // Create Round Room
-    auto roundRoom = std::make_unique<ZRoom>(
+    auto roundRoom = g.makeObject<ZRoom>(
         RoomIds::ROUND_ROOM,
         "Round Room",
         "This is a circular stone room with passages in all directions. Several of them have unfortunately been blocked by cave-ins."
@@ -672,7 +672,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::ROUND_ROOM, std::move(roundRoom));
     
     // Create Loud Room
-    auto loudRoom = std::make_unique<ZRoom>(
+    auto loudRoom = g.makeObject<ZRoom>(
         RoomIds::LOUD_ROOM,
         "Loud Room",
         "This is a large room with a ceiling which cannot be detected from the ground. There is a narrow passage from east to west and a stone stairway leading upward. The room is extremely noisy. In fact, it is difficult to hear yourself think."
@@ -697,7 +697,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LOUD_ROOM, std::move(loudRoom));
     
     // Create Deep Canyon
-    auto deepCanyon = std::make_unique<ZRoom>(
+    auto deepCanyon = g.makeObject<ZRoom>(
         RoomIds::DEEP_CANYON,
         "Deep Canyon",
         "You are on the south edge of a deep canyon. Passages lead off to the east, northwest and southwest. You can hear the sound of flowing water from below."
@@ -715,7 +715,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DEEP_CANYON, std::move(deepCanyon));
     
     // Create Damp Cave
-    auto dampCave = std::make_unique<ZRoom>(
+    auto dampCave = g.makeObject<ZRoom>(
         RoomIds::DAMP_CAVE,
         "Damp Cave",
         "This cave has exits to the west and east, and narrows to a crack toward the south. The earth is particularly damp here."
@@ -736,7 +736,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DAMP_CAVE, std::move(dampCave));
     
     // Create Cold Passage
-    auto coldPassage = std::make_unique<ZRoom>(
+    auto coldPassage = g.makeObject<ZRoom>(
         RoomIds::COLD_PASSAGE,
         "Cold Passage",
         "This is a cold and damp corridor where a long east-west passageway turns into a southward path."
@@ -756,7 +756,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::COLD_PASSAGE, std::move(coldPassage));
     
     // Create Narrow Passage
-    auto narrowPassage = std::make_unique<ZRoom>(
+    auto narrowPassage = g.makeObject<ZRoom>(
         RoomIds::NARROW_PASSAGE,
         "Narrow Passage",
         "This is a long and narrow corridor where a long north-south passageway briefly narrows even further."
@@ -776,7 +776,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::NARROW_PASSAGE, std::move(narrowPassage));
     
     // Create Slide Room
-    auto slideRoom = std::make_unique<ZRoom>(
+    auto slideRoom = g.makeObject<ZRoom>(
         RoomIds::SLIDE_ROOM,
         "Slide Room",
         "This is a small chamber, which appears to have been part of a coal mine. On the south wall of the chamber the letters \"Granite Wall\" are etched in the rock. To the east is a long passage, and there is a steep metal slide twisting downward. To the north is a small opening."
@@ -797,7 +797,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SLIDE_ROOM, std::move(slideRoom));
     
     // Create Mine Entrance
-    auto mineEntrance = std::make_unique<ZRoom>(
+    auto mineEntrance = g.makeObject<ZRoom>(
         RoomIds::MINE_ENTRANCE,
         "Mine Entrance",
         "You are standing at the entrance of what might have been a coal mine. The shaft enters the west wall, and there is another exit on the south end of the room."
@@ -818,7 +818,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MINE_ENTRANCE, std::move(mineEntrance));
     
     // Create Squeaky Room
-    auto squeekyRoom = std::make_unique<ZRoom>(
+    auto squeekyRoom = g.makeObject<ZRoom>(
         RoomIds::SQUEEKY_ROOM,
         "Squeaky Room",
         "You are in a small room. Strange squeaky sounds may be heard coming from the passage at the north end. You may also escape to the east."
@@ -838,7 +838,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SQUEEKY_ROOM, std::move(squeekyRoom));
     
     // Create Bat Room
-    auto batRoom = std::make_unique<ZRoom>(
+    auto batRoom = g.makeObject<ZRoom>(
         RoomIds::BAT_ROOM,
         "Bat Room",
         "You are in a small room which has doors only to the east and south."
@@ -859,7 +859,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::BAT_ROOM, std::move(batRoom));
     
     // Create Shaft Room
-    auto shaftRoom = std::make_unique<ZRoom>(
+    auto shaftRoom = g.makeObject<ZRoom>(
         RoomIds::SHAFT_ROOM,
         "Shaft Room",
         "This is a large room, in the middle of which is a small shaft descending through the floor into darkness below. To the west and the north are exits from this room. Constructed over the top of the shaft is a metal framework to which a heavy iron chain is attached."
@@ -880,7 +880,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SHAFT_ROOM, std::move(shaftRoom));
     
     // Create Smelly Room
-    auto smellyRoom = std::make_unique<ZRoom>(
+    auto smellyRoom = g.makeObject<ZRoom>(
         RoomIds::SMELLY_ROOM,
         "Smelly Room",
         "This is a small nondescript room. However, from the direction of a small descending staircase a foul odor can be detected. To the south is a narrow tunnel."
@@ -900,7 +900,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SMELLY_ROOM, std::move(smellyRoom));
     
     // Create Gas Room
-    auto gasRoom = std::make_unique<ZRoom>(
+    auto gasRoom = g.makeObject<ZRoom>(
         RoomIds::GAS_ROOM,
         "Gas Room",
         "This is a small room which smells strongly of coal gas. There is a short climb up some stairs and a narrow tunnel leading east."
@@ -921,7 +921,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::GAS_ROOM, std::move(gasRoom));
     
     // Create Ladder Top
-    auto ladderTop = std::make_unique<ZRoom>(
+    auto ladderTop = g.makeObject<ZRoom>(
         RoomIds::LADDER_TOP,
         "Ladder Top",
         "This is a very small room. In the corner is a rickety wooden ladder, leading downward. It might be safe to descend. There is also a staircase leading upward."
@@ -941,7 +941,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LADDER_TOP, std::move(ladderTop));
     
     // Create Ladder Bottom
-    auto ladderBottom = std::make_unique<ZRoom>(
+    auto ladderBottom = g.makeObject<ZRoom>(
         RoomIds::LADDER_BOTTOM,
         "Ladder Bottom",
         "This is a rather wide room. On one side is the bottom of a narrow wooden ladder. To the west and the south are passages leaving the room."
@@ -962,7 +962,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LADDER_BOTTOM, std::move(ladderBottom));
     
     // Create Timber Room
-    auto timberRoom = std::make_unique<ZRoom>(
+    auto timberRoom = g.makeObject<ZRoom>(
         RoomIds::TIMBER_ROOM,
         "Timber Room",
         "This is a long and narrow passage, which is cluttered with broken timbers. A wide passage comes from the east and turns at the west end of the room into a very narrow passageway. From the west comes a strong draft."
@@ -983,7 +983,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TIMBER_ROOM, std::move(timberRoom));
     
     // Create Lower Shaft
-    auto lowerShaft = std::make_unique<ZRoom>(
+    auto lowerShaft = g.makeObject<ZRoom>(
         RoomIds::LOWER_SHAFT,
         "Drafty Room",
         "This is a small drafty room in which is the bottom of a long shaft. To the south is a passageway and to the east a very narrow passage. In the shaft can be seen a heavy iron chain."
@@ -1005,7 +1005,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LOWER_SHAFT, std::move(lowerShaft));
     
     // Create Machine Room
-    auto machineRoom = std::make_unique<ZRoom>(
+    auto machineRoom = g.makeObject<ZRoom>(
         RoomIds::MACHINE_ROOM,
         "Machine Room",
         "This is a large room full of assorted heavy machinery, whirring noisily. The room smells of burned resistors. Along one wall of the room are three buttons which are, respectively, round, triangular, and square. Naturally, above these buttons are instructions written in EBCDIC. A large sign above the buttons says \"DANGER: DEADLY RADIATION BEYOND THIS POINT!\" There are exits to the north and east."
@@ -1024,7 +1024,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MACHINE_ROOM, std::move(machineRoom));
     
     // Create Dead End 5 (coal mine dead end)
-    auto deadEnd5 = std::make_unique<ZRoom>(
+    auto deadEnd5 = g.makeObject<ZRoom>(
         RoomIds::DEAD_END_5,
         "Dead End",
         "You have come to a dead end in the mine."
@@ -1043,7 +1043,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DEAD_END_5, std::move(deadEnd5));
     
     // Create Coal Mine rooms (Mine 1-4)
-    auto mine1 = std::make_unique<ZRoom>(
+    auto mine1 = g.makeObject<ZRoom>(
         RoomIds::MINE_1,
         "Coal Mine",
         "This is a nondescript part of a coal mine."
@@ -1060,7 +1060,7 @@ void initializeWorld() {
     
     g.registerObject(RoomIds::MINE_1, std::move(mine1));
     
-    auto mine2 = std::make_unique<ZRoom>(
+    auto mine2 = g.makeObject<ZRoom>(
         RoomIds::MINE_2,
         "Coal Mine",
         "This is a nondescript part of a coal mine."
@@ -1077,7 +1077,7 @@ void initializeWorld() {
     
     g.registerObject(RoomIds::MINE_2, std::move(mine2));
     
-    auto mine3 = std::make_unique<ZRoom>(
+    auto mine3 = g.makeObject<ZRoom>(
         RoomIds::MINE_3,
         "Coal Mine",
         "This is a nondescript part of a coal mine."
@@ -1094,7 +1094,7 @@ void initializeWorld() {
     
     g.registerObject(RoomIds::MINE_3, std::move(mine3));
     
-    auto mine4 = std::make_unique<ZRoom>(
+    auto mine4 = g.makeObject<ZRoom>(
         RoomIds::MINE_4,
         "Coal Mine",
         "This is a nondescript part of a coal mine."
@@ -1114,7 +1114,7 @@ void initializeWorld() {
     // ===== RESERVOIR AND DAM AREA =====
     
     // Create Reservoir South
-    auto reservoirSouth = std::make_unique<ZRoom>(
+    auto reservoirSouth = g.makeObject<ZRoom>(
         RoomIds::RESERVOIR_SOUTH,
         "Reservoir South",
         "You are in a long room on the south shore of a large lake, far too deep and wide for crossing. There is a path along the stream to the east or west, and a steep pathway climbing southwest along the edge of a chasm."
@@ -1137,7 +1137,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::RESERVOIR_SOUTH, std::move(reservoirSouth));
     
     // Create Reservoir
-    auto reservoir = std::make_unique<ZRoom>(
+    auto reservoir = g.makeObject<ZRoom>(
         RoomIds::RESERVOIR,
         "Reservoir",
         "You are on the lake. The water is cold and the current is strong. It is difficult to stay afloat."
@@ -1159,7 +1159,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::RESERVOIR, std::move(reservoir));
     
     // Create Reservoir North
-    auto reservoirNorth = std::make_unique<ZRoom>(
+    auto reservoirNorth = g.makeObject<ZRoom>(
         RoomIds::RESERVOIR_NORTH,
         "Reservoir North",
         "You are in a long room on the north shore of a large lake, far too deep and wide for crossing."
@@ -1179,7 +1179,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::RESERVOIR_NORTH, std::move(reservoirNorth));
     
     // Create Stream View
-    auto streamView = std::make_unique<ZRoom>(
+    auto streamView = g.makeObject<ZRoom>(
         RoomIds::STREAM_VIEW,
         "Stream View",
         "You are standing on a path beside a gently flowing stream. The path follows the stream, which flows from west to east."
@@ -1199,7 +1199,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::STREAM_VIEW, std::move(streamView));
     
     // Create In Stream
-    auto inStream = std::make_unique<ZRoom>(
+    auto inStream = g.makeObject<ZRoom>(
         RoomIds::IN_STREAM,
         "Stream",
         "You are on the gently flowing stream. The upstream route is too narrow to navigate, and the downstream route is invisible due to twisting walls. There is a narrow beach to land on."
@@ -1220,7 +1220,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::IN_STREAM, std::move(inStream));
     
     // Create Dam Room
-    auto damRoom = std::make_unique<ZRoom>(
+    auto damRoom = g.makeObject<ZRoom>(
         RoomIds::DAM_ROOM,
         "Dam",
         "You are standing on the top of the Flood Control Dam #3, which was quite a tourist attraction in times far distant. There are paths to the north, south, and west, and a scramble down."
@@ -1243,7 +1243,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DAM_ROOM, std::move(damRoom));
     
     // Create Dam Lobby
-    auto damLobby = std::make_unique<ZRoom>(
+    auto damLobby = g.makeObject<ZRoom>(
         RoomIds::DAM_LOBBY,
         "Dam Lobby",
         "This room appears to have been the waiting room for groups touring the dam. There are open doorways here to the north and east marked \"Private\", and there is a path leading south over the top of the dam."
@@ -1264,7 +1264,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DAM_LOBBY, std::move(damLobby));
     
     // Create Maintenance Room
-    auto maintenanceRoom = std::make_unique<ZRoom>(
+    auto maintenanceRoom = g.makeObject<ZRoom>(
         RoomIds::MAINTENANCE_ROOM,
         "Maintenance Room",
         "This is what appears to have been the maintenance room for Flood Control Dam #3. Apparently, this room has been ransacked recently, for most of the valuable equipment is gone. On the wall in front of you is a group of buttons colored blue, yellow, brown, and red. There are doorways to the west and south."
@@ -1284,7 +1284,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAINTENANCE_ROOM, std::move(maintenanceRoom));
     
     // Create Dam Base
-    auto damBase = std::make_unique<ZRoom>(
+    auto damBase = g.makeObject<ZRoom>(
         RoomIds::DAM_BASE,
         "Dam Base",
         "You are at the base of Flood Control Dam #3, which looms above you and to the north. The river Frigid is flowing by here. Along the river are the White Cliffs which seem to form giant walls stretching from north to south along the shores of the river as it winds its way downstream."
@@ -1307,7 +1307,7 @@ void initializeWorld() {
     // ===== SPECIAL UNDERGROUND ROOMS =====
     
     // Create Engravings Cave
-    auto engravingsCave = std::make_unique<ZRoom>(
+    auto engravingsCave = g.makeObject<ZRoom>(
         RoomIds::ENGRAVINGS_CAVE,
         "Engravings Cave",
         "You have entered a low cave with passages leading northwest and east."
@@ -1331,7 +1331,7 @@ void initializeWorld() {
     // Rooms have similar descriptions to disorient the player
     
     // Create MAZE_1 (entrance from Troll Room)
-    auto maze1 = std::make_unique<ZRoom>(
+    auto maze1 = g.makeObject<ZRoom>(
         RoomIds::MAZE_1,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1341,7 +1341,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_1, std::move(maze1));
     
     // Create MAZE_2
-    auto maze2 = std::make_unique<ZRoom>(
+    auto maze2 = g.makeObject<ZRoom>(
         RoomIds::MAZE_2,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1351,7 +1351,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_2, std::move(maze2));
     
     // Create MAZE_3
-    auto maze3 = std::make_unique<ZRoom>(
+    auto maze3 = g.makeObject<ZRoom>(
         RoomIds::MAZE_3,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1361,7 +1361,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_3, std::move(maze3));
     
     // Create MAZE_4
-    auto maze4 = std::make_unique<ZRoom>(
+    auto maze4 = g.makeObject<ZRoom>(
         RoomIds::MAZE_4,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1371,7 +1371,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_4, std::move(maze4));
     
     // Create MAZE_5
-    auto maze5 = std::make_unique<ZRoom>(
+    auto maze5 = g.makeObject<ZRoom>(
         RoomIds::MAZE_5,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1381,7 +1381,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_5, std::move(maze5));
     
     // Create MAZE_6
-    auto maze6 = std::make_unique<ZRoom>(
+    auto maze6 = g.makeObject<ZRoom>(
         RoomIds::MAZE_6,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1391,7 +1391,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_6, std::move(maze6));
     
     // Create MAZE_7
-    auto maze7 = std::make_unique<ZRoom>(
+    auto maze7 = g.makeObject<ZRoom>(
         RoomIds::MAZE_7,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1401,7 +1401,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_7, std::move(maze7));
     
     // Create MAZE_8
-    auto maze8 = std::make_unique<ZRoom>(
+    auto maze8 = g.makeObject<ZRoom>(
         RoomIds::MAZE_8,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1411,7 +1411,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_8, std::move(maze8));
     
     // Create MAZE_9
-    auto maze9 = std::make_unique<ZRoom>(
+    auto maze9 = g.makeObject<ZRoom>(
         RoomIds::MAZE_9,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1421,7 +1421,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_9, std::move(maze9));
     
     // Create MAZE_10
-    auto maze10 = std::make_unique<ZRoom>(
+    auto maze10 = g.makeObject<ZRoom>(
         RoomIds::MAZE_10,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1431,7 +1431,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_10, std::move(maze10));
     
     // Create MAZE_11
-    auto maze11 = std::make_unique<ZRoom>(
+    auto maze11 = g.makeObject<ZRoom>(
         RoomIds::MAZE_11,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1441,7 +1441,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_11, std::move(maze11));
     
     // Create MAZE_12
-    auto maze12 = std::make_unique<ZRoom>(
+    auto maze12 = g.makeObject<ZRoom>(
         RoomIds::MAZE_12,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1451,7 +1451,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_12, std::move(maze12));
     
     // Create MAZE_13
-    auto maze13 = std::make_unique<ZRoom>(
+    auto maze13 = g.makeObject<ZRoom>(
         RoomIds::MAZE_13,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1461,7 +1461,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_13, std::move(maze13));
     
     // Create MAZE_14
-    auto maze14 = std::make_unique<ZRoom>(
+    auto maze14 = g.makeObject<ZRoom>(
         RoomIds::MAZE_14,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1471,7 +1471,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_14, std::move(maze14));
     
     // Create MAZE_15
-    auto maze15 = std::make_unique<ZRoom>(
+    auto maze15 = g.makeObject<ZRoom>(
         RoomIds::MAZE_15,
         "Maze",
         "This is part of a maze of twisty little passages, all alike."
@@ -1481,7 +1481,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MAZE_15, std::move(maze15));
     
     // Create Grating Room (exit from maze)
-    auto gratingRoom = std::make_unique<ZRoom>(
+    auto gratingRoom = g.makeObject<ZRoom>(
         RoomIds::GRATING_ROOM,
         "Grating Room",
         "You are in a small room near the maze. There are twisty passages in the immediate vicinity."
@@ -1495,7 +1495,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::GRATING_ROOM, std::move(gratingRoom));
     
     // Create Dead End rooms
-    auto deadEnd1 = std::make_unique<ZRoom>(
+    auto deadEnd1 = g.makeObject<ZRoom>(
         RoomIds::DEAD_END_1,
         "Dead End",
         "You have come to a dead end in the maze."
@@ -1508,7 +1508,7 @@ void initializeWorld() {
     });
     g.registerObject(RoomIds::DEAD_END_1, std::move(deadEnd1));
     
-    auto deadEnd2 = std::make_unique<ZRoom>(
+    auto deadEnd2 = g.makeObject<ZRoom>(
         RoomIds::DEAD_END_2,
         "Dead End",
         "You have come to a dead end in the maze."
@@ -1521,7 +1521,7 @@ void initializeWorld() {
     });
     g.registerObject(RoomIds::DEAD_END_2, std::move(deadEnd2));
     
-    auto deadEnd3 = std::make_unique<ZRoom>(
+    auto deadEnd3 = g.makeObject<ZRoom>(
         RoomIds::DEAD_END_3,
         "Dead End",
         "You have come to a dead end in the maze."
@@ -1534,7 +1534,7 @@ void initializeWorld() {
     });
     g.registerObject(RoomIds::DEAD_END_3, std::move(deadEnd3));
     
-    auto deadEnd4 = std::make_unique<ZRoom>(
+    auto deadEnd4 = g.makeObject<ZRoom>(
         RoomIds::DEAD_END_4,
         "Dead End",
         "You have come to a dead end in the maze."
@@ -1761,7 +1761,7 @@ void initializeWorld() {
     // ===== SPECIAL AREA ROOMS =====
     
     // Create Cyclops Room
-    auto cyclopsRoom = std::make_unique<ZRoom>(
+    auto cyclopsRoom = g.makeObject<ZRoom>(
         RoomIds::CYCLOPS_ROOM,
         "Cyclops Room",
         "This is a large room with a ceiling which cannot be detected from the ground. There is a narrow passage from east to west and a stone stairway leading upward. The room is eerie in its quietness."
@@ -1815,7 +1815,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::CYCLOPS_ROOM, std::move(cyclopsRoom));
     
     // Create Strange Passage
-    auto strangePassage = std::make_unique<ZRoom>(
+    auto strangePassage = g.makeObject<ZRoom>(
         RoomIds::STRANGE_PASSAGE,
         "Strange Passage",
         "This is a long passage. To the west is one entrance. On the east there is an old wooden door, with a large hole in it (about cyclops sized)."
@@ -1831,7 +1831,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::STRANGE_PASSAGE, std::move(strangePassage));
     
     // Create Treasure Room (Thief's Lair)
-    auto treasureRoom = std::make_unique<ZRoom>(
+    auto treasureRoom = g.makeObject<ZRoom>(
         RoomIds::TREASURE_ROOM,
         "Treasure Room",
         "This is a large room, whose east wall is solid granite. A number of discarded bags, which crumble at your touch, are scattered about on the floor. There is an exit down a staircase."
@@ -1854,7 +1854,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TREASURE_ROOM, std::move(treasureRoom));
     
     // Create Entrance to Hades
-    auto entranceToHades = std::make_unique<ZRoom>(
+    auto entranceToHades = g.makeObject<ZRoom>(
         RoomIds::ENTRANCE_TO_HADES,
         "Entrance to Hades",
         "You are outside a large gateway, on which is inscribed:\n\n  Abandon every hope all ye who enter here\n\nThe gate is open; through it you can see a desolation, with a pile of mangled bodies in one corner. Thousands of voices, lamenting some hideous fate, can be heard."
@@ -1884,7 +1884,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::ENTRANCE_TO_HADES, std::move(entranceToHades));
     
     // Create Land of the Living Dead
-    auto landOfLivingDead = std::make_unique<ZRoom>(
+    auto landOfLivingDead = g.makeObject<ZRoom>(
         RoomIds::LAND_OF_LIVING_DEAD,
         "Land of the Dead",
         "You have entered the Land of the Living Dead. Thousands of lost souls can be heard weeping and moaning. In the corner are stacked the remains of dozens of previous adventurers less fortunate than yourself. A passage exits to the north."
@@ -1901,7 +1901,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::LAND_OF_LIVING_DEAD, std::move(landOfLivingDead));
     
     // Create Dome Room
-    auto domeRoom = std::make_unique<ZRoom>(
+    auto domeRoom = g.makeObject<ZRoom>(
         RoomIds::DOME_ROOM,
         "Dome Room",
         "You are at the periphery of a large dome, which forms the ceiling of another room below. Protecting you from a precipitous drop is a wooden railing which circles the dome."
@@ -1918,7 +1918,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::DOME_ROOM, std::move(domeRoom));
     
     // Create Torch Room
-    auto torchRoom = std::make_unique<ZRoom>(
+    auto torchRoom = g.makeObject<ZRoom>(
         RoomIds::TORCH_ROOM,
         "Torch Room",
         "This is a large room with a prominent doorway leading to a down staircase. To the west is a narrow twisting tunnel, through which is coming a horrible stench. Above you is a large dome painted with scenes depicting elvish hacking rites. Up around the edge of the dome (20 feet up) is a wooden railing. In the center of the room there is a white marble pedestal."
@@ -1935,7 +1935,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TORCH_ROOM, std::move(torchRoom));
     
     // Create North Temple
-    auto northTemple = std::make_unique<ZRoom>(
+    auto northTemple = g.makeObject<ZRoom>(
         RoomIds::NORTH_TEMPLE,
         "Temple",
         "This is the north end of a large temple. On the east wall is an ancient inscription, probably a prayer in a long-forgotten language. Below the prayer is a staircase leading down. The west wall is solid granite. The exit to the north end of the room is through huge marble pillars."
@@ -1961,7 +1961,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::NORTH_TEMPLE, std::move(northTemple));
     
     // Create South Temple (Altar)
-    auto southTemple = std::make_unique<ZRoom>(
+    auto southTemple = g.makeObject<ZRoom>(
         RoomIds::SOUTH_TEMPLE,
         "Altar",
         "This is the south end of a large temple. In front of you is what appears to be an altar. In one corner is a small hole in the floor which leads into darkness. You probably could not get back up it."
@@ -1984,7 +1984,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SOUTH_TEMPLE, std::move(southTemple));
     
     // Create Egyptian Room
-    auto egyptRoom = std::make_unique<ZRoom>(
+    auto egyptRoom = g.makeObject<ZRoom>(
         RoomIds::EGYPT_ROOM,
         "Egyptian Room",
         "This is a room which looks like an Egyptian tomb. There is an ascending staircase to the west."
@@ -2004,7 +2004,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::EGYPT_ROOM, std::move(egyptRoom));
     
     // Create Mirror Room 1
-    auto mirrorRoom1 = std::make_unique<ZRoom>(
+    auto mirrorRoom1 = g.makeObject<ZRoom>(
         RoomIds::MIRROR_ROOM_1,
         "Mirror Room",
         "You are in a large square room with tall ceilings. On the south wall is an enormous mirror which fills the entire wall. There are exits on the other three sides of the room."
@@ -2021,7 +2021,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MIRROR_ROOM_1, std::move(mirrorRoom1));
     
     // Create Mirror Room 2
-    auto mirrorRoom2 = std::make_unique<ZRoom>(
+    auto mirrorRoom2 = g.makeObject<ZRoom>(
         RoomIds::MIRROR_ROOM_2,
         "Mirror Room",
         "You are in a large square room with tall ceilings. On the south wall is an enormous mirror which fills the entire wall. There are exits on the other three sides of the room."
@@ -2039,7 +2039,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::MIRROR_ROOM_2, std::move(mirrorRoom2));
     
     // Create Small Cave
-    auto smallCave = std::make_unique<ZRoom>(
+    auto smallCave = g.makeObject<ZRoom>(
         RoomIds::SMALL_CAVE,
         "Cave",
         "This is a tiny cave with entrances west and north, and a staircase leading down."
@@ -2057,7 +2057,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::SMALL_CAVE, std::move(smallCave));
     
     // Create Tiny Cave
-    auto tinyCave = std::make_unique<ZRoom>(
+    auto tinyCave = g.makeObject<ZRoom>(
         RoomIds::TINY_CAVE,
         "Cave",
         "This is a tiny cave with entrances west and north, and a dark, forbidding staircase leading down."
@@ -2074,7 +2074,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TINY_CAVE, std::move(tinyCave));
     
     // Create Winding Passage
-    auto windingPassage = std::make_unique<ZRoom>(
+    auto windingPassage = g.makeObject<ZRoom>(
         RoomIds::WINDING_PASSAGE,
         "Winding Passage",
         "This is a winding passage. It seems that there are only exits on the east and north."
@@ -2090,7 +2090,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::WINDING_PASSAGE, std::move(windingPassage));
     
     // Create Twisting Passage
-    auto twistingPassage = std::make_unique<ZRoom>(
+    auto twistingPassage = g.makeObject<ZRoom>(
         RoomIds::TWISTING_PASSAGE,
         "Twisting Passage",
         "This is a winding passage. It seems that there are only exits on the east and north."
@@ -2106,7 +2106,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::TWISTING_PASSAGE, std::move(twistingPassage));
     
     // Create Atlantis Room
-    auto atlantisRoom = std::make_unique<ZRoom>(
+    auto atlantisRoom = g.makeObject<ZRoom>(
         RoomIds::ATLANTIS_ROOM,
         "Atlantis Room",
         "This is an ancient room, long under water. There is an exit to the south and a staircase leading up."
@@ -2122,7 +2122,7 @@ void initializeWorld() {
     g.registerObject(RoomIds::ATLANTIS_ROOM, std::move(atlantisRoom));
     
     // Create Mailbox object
-    auto mailbox = std::make_unique<ZObject>(OBJ_MAILBOX, "small mailbox");
+    auto mailbox = g.makeObject<ZObject>(OBJ_MAILBOX, "small mailbox");
     mailbox->addSynonym("mailbox");
     mailbox->addSynonym("box");
     mailbox->addAdjective("small");
@@ -2135,7 +2135,7 @@ void initializeWorld() {
     g.registerObject(OBJ_MAILBOX, std::move(mailbox));
     
     // Create LEAFLET (Advertisement) - readable object
-    auto leaflet = std::make_unique<ZObject>(ObjectIds::ADVERTISEMENT, "leaflet");
+    auto leaflet = g.makeObject<ZObject>(ObjectIds::ADVERTISEMENT, "leaflet");
     leaflet->addSynonym("leaflet");
     leaflet->addSynonym("advertisement");
     leaflet->addSynonym("mail");
@@ -2157,7 +2157,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::ADVERTISEMENT, std::move(leaflet));
     
     // Create BOOK (Black book) - readable object
-    auto book = std::make_unique<ZObject>(ObjectIds::BOOK, "black book");
+    auto book = g.makeObject<ZObject>(ObjectIds::BOOK, "black book");
     book->addSynonym("book");
     book->addSynonym("tome");
     book->addAdjective("black");
@@ -2183,7 +2183,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOOK, std::move(book));
     
     // Create GUIDE (Tour guidebook) - readable object
-    auto guide = std::make_unique<ZObject>(ObjectIds::GUIDE, "tour guidebook");
+    auto guide = g.makeObject<ZObject>(ObjectIds::GUIDE, "tour guidebook");
     guide->addSynonym("guide");
     guide->addSynonym("guidebook");
     guide->addSynonym("book");
@@ -2204,7 +2204,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::GUIDE, std::move(guide));
     
     // Create OWNERS_MANUAL (Owner's manual) - readable object
-    auto ownersManual = std::make_unique<ZObject>(ObjectIds::OWNERS_MANUAL, "owner's manual");
+    auto ownersManual = g.makeObject<ZObject>(ObjectIds::OWNERS_MANUAL, "owner's manual");
     ownersManual->addSynonym("manual");
     ownersManual->addSynonym("book");
     ownersManual->addAdjective("owners");
@@ -2222,7 +2222,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::OWNERS_MANUAL, std::move(ownersManual));
     
     // Create MAP (Map) - readable object
-    auto map = std::make_unique<ZObject>(ObjectIds::MAP, "map");
+    auto map = g.makeObject<ZObject>(ObjectIds::MAP, "map");
     map->addSynonym("map");
     map->addSynonym("chart");
     map->setFlag(ObjectFlag::TAKEBIT);
@@ -2238,7 +2238,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::MAP, std::move(map));
     
     // Create BOAT_LABEL (Label on boat) - readable object
-    auto boatLabel = std::make_unique<ZObject>(ObjectIds::BOAT_LABEL, "label");
+    auto boatLabel = g.makeObject<ZObject>(ObjectIds::BOAT_LABEL, "label");
     boatLabel->addSynonym("label");
     boatLabel->addSynonym("tag");
     boatLabel->setFlag(ObjectFlag::READBIT);
@@ -2257,7 +2257,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOAT_LABEL, std::move(boatLabel));
     
     // Create Trophy Case container
-    auto trophyCase = std::make_unique<ZObject>(ObjectIds::TROPHY_CASE, "trophy case");
+    auto trophyCase = g.makeObject<ZObject>(ObjectIds::TROPHY_CASE, "trophy case");
     trophyCase->addSynonym("case");
     trophyCase->addAdjective("trophy");
     trophyCase->setFlag(ObjectFlag::CONTBIT);
@@ -2273,7 +2273,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TROPHY_CASE, std::move(trophyCase));
     
     // Create SACK (Brown sack/sandwich bag) - portable container
-    auto sack = std::make_unique<ZObject>(ObjectIds::SACK, "brown sack");
+    auto sack = g.makeObject<ZObject>(ObjectIds::SACK, "brown sack");
     sack->addSynonym("sack");
     sack->addSynonym("bag");
     sack->addAdjective("brown");
@@ -2292,7 +2292,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::SACK, std::move(sack));
     
     // Create LUNCH (Hot pepper sandwich) - food item inside sack
-    auto lunch = std::make_unique<ZObject>(ObjectIds::LUNCH, "lunch");
+    auto lunch = g.makeObject<ZObject>(ObjectIds::LUNCH, "lunch");
     lunch->addSynonym("lunch");
     lunch->addSynonym("sandwich");
     lunch->addSynonym("pepper");
@@ -2306,7 +2306,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::LUNCH, std::move(lunch));
     
     // Create GARLIC (Clove of garlic) - food item inside sack
-    auto garlic = std::make_unique<ZObject>(ObjectIds::GARLIC, "clove of garlic");
+    auto garlic = g.makeObject<ZObject>(ObjectIds::GARLIC, "clove of garlic");
     garlic->addSynonym("garlic");
     garlic->addSynonym("clove");
     garlic->setFlag(ObjectFlag::TAKEBIT);
@@ -2316,7 +2316,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::GARLIC, std::move(garlic));
     
     // Create BAG (Large bag - thief's bag) - portable container
-    auto bag = std::make_unique<ZObject>(ObjectIds::BAG, "large bag");
+    auto bag = g.makeObject<ZObject>(ObjectIds::BAG, "large bag");
     bag->addSynonym("bag");
     bag->addSynonym("sack");
     bag->addAdjective("large");
@@ -2328,7 +2328,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BAG, std::move(bag));
 
     // Create BAG_OF_COINS
-    auto bagOfCoins = std::make_unique<ZObject>(ObjectIds::BAG_OF_COINS, "bag of coins");
+    auto bagOfCoins = g.makeObject<ZObject>(ObjectIds::BAG_OF_COINS, "bag of coins");
     bagOfCoins->addSynonym("bag");
     bagOfCoins->addSynonym("coins");
     bagOfCoins->addAdjective("old");
@@ -2348,7 +2348,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BAG_OF_COINS, std::move(bagOfCoins));
     
     // Create RAISED_BASKET (Basket at top of shaft) - special container
-    auto raisedBasket = std::make_unique<ZObject>(ObjectIds::RAISED_BASKET, "basket");
+    auto raisedBasket = g.makeObject<ZObject>(ObjectIds::RAISED_BASKET, "basket");
     raisedBasket->addSynonym("basket");
     raisedBasket->addSynonym("cage");
     raisedBasket->addSynonym("dumbwaiter");
@@ -2363,7 +2363,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::RAISED_BASKET, std::move(raisedBasket));
     
     // Create LOWERED_BASKET (Basket at bottom of shaft) - special container
-    auto loweredBasket = std::make_unique<ZObject>(ObjectIds::BASKET, "basket");
+    auto loweredBasket = g.makeObject<ZObject>(ObjectIds::BASKET, "basket");
     loweredBasket->addSynonym("basket");
     loweredBasket->addSynonym("cage");
     loweredBasket->addSynonym("dumbwaiter");
@@ -2376,7 +2376,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BASKET, std::move(loweredBasket));
     
     // Create BUOY (Red buoy - portable container)
-    auto buoy = std::make_unique<ZObject>(ObjectIds::BUOY, "red buoy");
+    auto buoy = g.makeObject<ZObject>(ObjectIds::BUOY, "red buoy");
     buoy->addSynonym("buoy");
     buoy->addAdjective("red");
     buoy->setFlag(ObjectFlag::TAKEBIT);
@@ -2390,7 +2390,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BUOY, std::move(buoy));
     
     // Create NEST (Bird's nest - portable container)
-    auto nest = std::make_unique<ZObject>(ObjectIds::NEST, "bird's nest");
+    auto nest = g.makeObject<ZObject>(ObjectIds::NEST, "bird's nest");
     nest->addSynonym("nest");
     nest->addAdjective("birds");
     nest->setFlag(ObjectFlag::TAKEBIT);
@@ -2406,7 +2406,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::NEST, std::move(nest));
     
     // Create TOOL_CHEST (Group of tool chests - anchored container)
-    auto toolChest = std::make_unique<ZObject>(ObjectIds::TOOL_CHEST, "group of tool chests");
+    auto toolChest = g.makeObject<ZObject>(ObjectIds::TOOL_CHEST, "group of tool chests");
     toolChest->addSynonym("chest");
     toolChest->addSynonym("chests");
     toolChest->addSynonym("group");
@@ -2423,7 +2423,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TOOL_CHEST, std::move(toolChest));
     
     // Create ALTAR (Altar - surface container)
-    auto altar = std::make_unique<ZObject>(ObjectIds::ALTAR, "altar");
+    auto altar = g.makeObject<ZObject>(ObjectIds::ALTAR, "altar");
     altar->addSynonym("altar");
     altar->setFlag(ObjectFlag::CONTBIT);
     altar->setFlag(ObjectFlag::OPENBIT);
@@ -2436,7 +2436,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::ALTAR, std::move(altar));
     
     // Create PEDESTAL (White marble pedestal - surface container)
-    auto pedestal = std::make_unique<ZObject>(ObjectIds::PEDESTAL, "pedestal");
+    auto pedestal = g.makeObject<ZObject>(ObjectIds::PEDESTAL, "pedestal");
     pedestal->addSynonym("pedestal");
     pedestal->addAdjective("white");
     pedestal->addAdjective("marble");
@@ -2451,7 +2451,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::PEDESTAL, std::move(pedestal));
     
     // Create White House global object
-    auto whiteHouse = std::make_unique<ZObject>(OBJ_WHITE_HOUSE, "white house");
+    auto whiteHouse = g.makeObject<ZObject>(OBJ_WHITE_HOUSE, "white house");
     whiteHouse->addSynonym("house");
     whiteHouse->addAdjective("white");
     whiteHouse->addAdjective("beautiful");
@@ -2462,7 +2462,7 @@ void initializeWorld() {
     g.registerObject(OBJ_WHITE_HOUSE, std::move(whiteHouse));
     
     // Create Board global object
-    auto board = std::make_unique<ZObject>(OBJ_BOARD, "board");
+    auto board = g.makeObject<ZObject>(OBJ_BOARD, "board");
     board->addSynonym("boards");
     board->addSynonym("board");
     board->setFlag(ObjectFlag::NDESCBIT);
@@ -2471,7 +2471,7 @@ void initializeWorld() {
     g.registerObject(OBJ_BOARD, std::move(board));
     
     // Create Forest global object
-    auto forest = std::make_unique<ZObject>(OBJ_FOREST, "forest");
+    auto forest = g.makeObject<ZObject>(OBJ_FOREST, "forest");
     forest->addSynonym("forest");
     forest->addSynonym("trees");
     forest->addSynonym("pines");
@@ -2482,7 +2482,7 @@ void initializeWorld() {
     g.registerObject(OBJ_FOREST, std::move(forest));
     
     // Create Kitchen Window global object
-    auto kitchenWindow = std::make_unique<ZObject>(OBJ_KITCHEN_WINDOW, "kitchen window");
+    auto kitchenWindow = g.makeObject<ZObject>(OBJ_KITCHEN_WINDOW, "kitchen window");
     kitchenWindow->addSynonym("window");
     kitchenWindow->addAdjective("kitchen");
     kitchenWindow->addAdjective("small");
@@ -2494,7 +2494,7 @@ void initializeWorld() {
     
     // Create Ground global object (ZIL: GROUND in GLOBAL-OBJECTS)
     // Handles PUT X ON GROUND -> DROP X
-    auto ground = std::make_unique<ZObject>(ObjectIds::GROUND, "ground");
+    auto ground = g.makeObject<ZObject>(ObjectIds::GROUND, "ground");
     ground->addSynonym("ground");
     ground->addSynonym("floor");
     ground->addSynonym("dirt");
@@ -2505,7 +2505,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::GROUND, std::move(ground));
 
     // Create Hands global object (ZIL: HANDS in GLOBAL-OBJECTS)
-    auto hands = std::make_unique<ZObject>(ObjectIds::HANDS, "pair of hands");
+    auto hands = g.makeObject<ZObject>(ObjectIds::HANDS, "pair of hands");
     hands->addSynonym("pair");
     hands->addSynonym("hands");
     hands->addSynonym("hand");
@@ -2515,7 +2515,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::HANDS, std::move(hands));
     
     // Create Adventurer object (Task 24.1: Initialize player state)
-    auto adventurer = std::make_unique<ZObject>(OBJ_ADVENTURER, "adventurer");
+    auto adventurer = g.makeObject<ZObject>(OBJ_ADVENTURER, "adventurer");
     adventurer->addSynonym("adventurer");
     adventurer->addSynonym("me");
     adventurer->addSynonym("myself");
@@ -2535,7 +2535,7 @@ void initializeWorld() {
     // ===== TREASURE OBJECTS =====
     
     // Create TROPHY (Zorkmid trophy)
-    auto trophy = std::make_unique<ZObject>(ObjectIds::TROPHY, "trophy");
+    auto trophy = g.makeObject<ZObject>(ObjectIds::TROPHY, "trophy");
     trophy->addSynonym("trophy");
     trophy->addSynonym("cup");
     trophy->addAdjective("large");
@@ -2548,7 +2548,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TROPHY, std::move(trophy));
     
     // Create EGG (Jewel-encrusted egg) - starts CLOSED, contains canary
-    auto egg = std::make_unique<ZObject>(ObjectIds::EGG, "jewel-encrusted egg");
+    auto egg = g.makeObject<ZObject>(ObjectIds::EGG, "jewel-encrusted egg");
     egg->addSynonym("egg");
     egg->addSynonym("treasure");
     egg->addAdjective("jewel");
@@ -2569,7 +2569,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::EGG, std::move(egg));
     
     // Create BROKEN_EGG (Broken jewel-encrusted egg) - created when egg is damaged
-    auto brokenEgg = std::make_unique<ZObject>(ObjectIds::BROKEN_EGG, "broken jewel-encrusted egg");
+    auto brokenEgg = g.makeObject<ZObject>(ObjectIds::BROKEN_EGG, "broken jewel-encrusted egg");
     brokenEgg->addSynonym("egg");
     brokenEgg->addSynonym("treasure");
     brokenEgg->addAdjective("broken");
@@ -2588,7 +2588,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BROKEN_EGG, std::move(brokenEgg));
     
     // Create CANARY (Golden clockwork canary) - inside the egg
-    auto canary = std::make_unique<ZObject>(ObjectIds::CANARY, "golden clockwork canary");
+    auto canary = g.makeObject<ZObject>(ObjectIds::CANARY, "golden clockwork canary");
     canary->addSynonym("canary");
     canary->addSynonym("treasure");
     canary->addAdjective("clockwork");
@@ -2617,7 +2617,7 @@ void initializeWorld() {
     }
     
     // Create BROKEN_CANARY (Broken clockwork canary) - created when egg is damaged with canary inside
-    auto brokenCanary = std::make_unique<ZObject>(ObjectIds::BROKEN_CANARY, "broken clockwork canary");
+    auto brokenCanary = g.makeObject<ZObject>(ObjectIds::BROKEN_CANARY, "broken clockwork canary");
     brokenCanary->addSynonym("canary");
     brokenCanary->addSynonym("treasure");
     brokenCanary->addAdjective("broken");
@@ -2634,7 +2634,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BROKEN_CANARY, std::move(brokenCanary));
     
     // Create BAUBLE (Beautiful brass bauble) - produced by winding canary in forest
-    auto bauble = std::make_unique<ZObject>(ObjectIds::BAUBLE, "beautiful brass bauble");
+    auto bauble = g.makeObject<ZObject>(ObjectIds::BAUBLE, "beautiful brass bauble");
     bauble->addSynonym("bauble");
     bauble->addSynonym("treasure");
     bauble->addAdjective("brass");
@@ -2647,7 +2647,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BAUBLE, std::move(bauble));
     
     // Create CHALICE (Chalice)
-    auto chalice = std::make_unique<ZObject>(ObjectIds::CHALICE, "silver chalice");
+    auto chalice = g.makeObject<ZObject>(ObjectIds::CHALICE, "silver chalice");
     chalice->addSynonym("chalice");
     chalice->addSynonym("goblet");
     chalice->addSynonym("grail");
@@ -2661,7 +2661,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::CHALICE, std::move(chalice));
     
     // Create TRIDENT (Crystal trident)
-    auto trident = std::make_unique<ZObject>(ObjectIds::TRIDENT, "crystal trident");
+    auto trident = g.makeObject<ZObject>(ObjectIds::TRIDENT, "crystal trident");
     trident->addSynonym("trident");
     trident->addSynonym("fork");
     trident->addAdjective("crystal");
@@ -2675,7 +2675,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TRIDENT, std::move(trident));
     
     // Create JEWELS (Trunk of jewels)
-    auto jewels = std::make_unique<ZObject>(ObjectIds::JEWELS, "trunk of jewels");
+    auto jewels = g.makeObject<ZObject>(ObjectIds::JEWELS, "trunk of jewels");
     jewels->addSynonym("jewels");
     jewels->addSynonym("trunk");
     jewels->addSynonym("jewelry");
@@ -2690,7 +2690,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::JEWELS, std::move(jewels));
     
     // Create COINS (Bag of coins)
-    auto coins = std::make_unique<ZObject>(ObjectIds::COINS, "bag of coins");
+    auto coins = g.makeObject<ZObject>(ObjectIds::COINS, "bag of coins");
     coins->addSynonym("coins");
     coins->addSynonym("bag");
     coins->addSynonym("coin");
@@ -2706,7 +2706,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::COINS, std::move(coins));
     
     // Create DIAMOND (Huge diamond)
-    auto diamond = std::make_unique<ZObject>(ObjectIds::DIAMOND, "huge diamond");
+    auto diamond = g.makeObject<ZObject>(ObjectIds::DIAMOND, "huge diamond");
     diamond->addSynonym("diamond");
     diamond->addSynonym("gem");
     diamond->addAdjective("huge");
@@ -2720,7 +2720,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::DIAMOND, std::move(diamond));
     
     // Create EMERALD (Emerald bracelet)
-    auto emerald = std::make_unique<ZObject>(ObjectIds::EMERALD, "emerald bracelet");
+    auto emerald = g.makeObject<ZObject>(ObjectIds::EMERALD, "emerald bracelet");
     emerald->addSynonym("bracelet");
     emerald->addSynonym("emerald");
     emerald->addAdjective("emerald");
@@ -2733,7 +2733,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::EMERALD, std::move(emerald));
     
     // Create PAINTING (Painting - special treasure that can be taken from wall, has back side)
-    auto painting = std::make_unique<ZObject>(ObjectIds::PAINTING, "painting");
+    auto painting = g.makeObject<ZObject>(ObjectIds::PAINTING, "painting");
     painting->addSynonym("painting");
     painting->addSynonym("picture");
     painting->addSynonym("art");
@@ -2752,7 +2752,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::PAINTING, std::move(painting));
     
     // Create COFFIN (Gold coffin - both treasure and container)
-    auto coffin = std::make_unique<ZObject>(ObjectIds::COFFIN, "gold coffin");
+    auto coffin = g.makeObject<ZObject>(ObjectIds::COFFIN, "gold coffin");
     coffin->addSynonym("coffin");
     coffin->addSynonym("casket");
     coffin->addSynonym("treasure");
@@ -2772,7 +2772,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::COFFIN, std::move(coffin));
     
     // Create JADE (Jade figurine)
-    auto jade = std::make_unique<ZObject>(ObjectIds::JADE, "jade figurine");
+    auto jade = g.makeObject<ZObject>(ObjectIds::JADE, "jade figurine");
     jade->addSynonym("figurine");
     jade->addSynonym("jade");
     jade->addSynonym("statue");
@@ -2787,7 +2787,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::JADE, std::move(jade));
     
     // Create BRACELET (Sapphire bracelet)
-    auto bracelet = std::make_unique<ZObject>(ObjectIds::BRACELET, "sapphire bracelet");
+    auto bracelet = g.makeObject<ZObject>(ObjectIds::BRACELET, "sapphire bracelet");
     bracelet->addSynonym("bracelet");
     bracelet->addSynonym("sapphire");
     bracelet->addAdjective("sapphire");
@@ -2800,7 +2800,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BRACELET, std::move(bracelet));
     
     // Create BAR (Platinum bar)
-    auto bar = std::make_unique<ZObject>(ObjectIds::BAR, "platinum bar");
+    auto bar = g.makeObject<ZObject>(ObjectIds::BAR, "platinum bar");
     bar->addSynonym("bar");
     bar->addSynonym("platinum");
     bar->addAdjective("platinum");
@@ -2814,7 +2814,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BAR, std::move(bar));
     
     // Create POT_OF_GOLD (Pot of gold)
-    auto potOfGold = std::make_unique<ZObject>(ObjectIds::POT_OF_GOLD, "pot of gold");
+    auto potOfGold = g.makeObject<ZObject>(ObjectIds::POT_OF_GOLD, "pot of gold");
     potOfGold->addSynonym("pot");
     potOfGold->addSynonym("gold");
     potOfGold->addAdjective("gold");
@@ -2827,7 +2827,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::POT_OF_GOLD, std::move(potOfGold));
     
     // Create SCARAB (Scarab)
-    auto scarab = std::make_unique<ZObject>(ObjectIds::SCARAB, "scarab");
+    auto scarab = g.makeObject<ZObject>(ObjectIds::SCARAB, "scarab");
     scarab->addSynonym("scarab");
     scarab->addSynonym("beetle");
     scarab->addAdjective("beautiful");
@@ -2840,7 +2840,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::SCARAB, std::move(scarab));
     
     // Create TORCH (Ivory torch - also a light source)
-    auto torch = std::make_unique<ZObject>(ObjectIds::TORCH, "ivory torch");
+    auto torch = g.makeObject<ZObject>(ObjectIds::TORCH, "ivory torch");
     torch->addSynonym("torch");
     torch->addAdjective("ivory");
     torch->setFlag(ObjectFlag::TAKEBIT);
@@ -2855,7 +2855,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TORCH, std::move(torch));
     
     // Create SCEPTRE (Egyptian sceptre - also a weapon)
-    auto sceptre = std::make_unique<ZObject>(ObjectIds::SCEPTRE, "sceptre");
+    auto sceptre = g.makeObject<ZObject>(ObjectIds::SCEPTRE, "sceptre");
     sceptre->addSynonym("sceptre");
     sceptre->addSynonym("scepter");
     sceptre->addAdjective("egyptian");
@@ -2874,7 +2874,7 @@ void initializeWorld() {
     // ===== TOOL OBJECTS =====
     
     // Create SWORD (Elvish sword - weapon that glows near enemies)
-    auto sword = std::make_unique<ZObject>(ObjectIds::SWORD, "sword");
+    auto sword = g.makeObject<ZObject>(ObjectIds::SWORD, "sword");
     sword->addSynonym("sword");
     sword->addSynonym("blade");
     sword->addSynonym("orcrist");
@@ -2892,7 +2892,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::SWORD, std::move(sword));
     
     // Create KNIFE (Nasty knife - weapon, less effective than sword)
-    auto knife = std::make_unique<ZObject>(ObjectIds::KNIFE, "nasty knife");
+    auto knife = g.makeObject<ZObject>(ObjectIds::KNIFE, "nasty knife");
     knife->addSynonym("knife");
     knife->addSynonym("knives");
     knife->addSynonym("blade");
@@ -2906,7 +2906,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::KNIFE, std::move(knife));
     
     // Create LAMP (Battery-powered brass lantern - light source)
-    auto lamp = std::make_unique<ZObject>(ObjectIds::LAMP, "brass lantern");
+    auto lamp = g.makeObject<ZObject>(ObjectIds::LAMP, "brass lantern");
     lamp->addSynonym("lamp");
     lamp->addSynonym("lantern");
     lamp->addSynonym("light");
@@ -2924,7 +2924,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::LAMP, std::move(lamp));
     
     // Create CANDLES (Pair of candles - temporary light source)
-    auto candles = std::make_unique<ZObject>(ObjectIds::CANDLES, "pair of candles");
+    auto candles = g.makeObject<ZObject>(ObjectIds::CANDLES, "pair of candles");
     candles->addSynonym("candles");
     candles->addSynonym("candle");
     candles->addSynonym("pair");
@@ -2941,7 +2941,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::CANDLES, std::move(candles));
     
     // Create MATCH (Matchbook - one-time use light source)
-    auto match = std::make_unique<ZObject>(ObjectIds::MATCH, "matchbook");
+    auto match = g.makeObject<ZObject>(ObjectIds::MATCH, "matchbook");
     match->addSynonym("match");
     match->addSynonym("matches");
     match->addSynonym("matchbook");
@@ -2955,7 +2955,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::MATCH, std::move(match));
     
     // Create ROPE (Large coil of rope - for climbing and tying)
-    auto rope = std::make_unique<ZObject>(ObjectIds::ROPE, "rope");
+    auto rope = g.makeObject<ZObject>(ObjectIds::ROPE, "rope");
     rope->addSynonym("rope");
     rope->addSynonym("coil");
     rope->addSynonym("hemp");
@@ -2968,7 +2968,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::ROPE, std::move(rope));
     
     // Create WRENCH (Wrench - tool for bolts)
-    auto wrench = std::make_unique<ZObject>(ObjectIds::WRENCH, "wrench");
+    auto wrench = g.makeObject<ZObject>(ObjectIds::WRENCH, "wrench");
     wrench->addSynonym("wrench");
     wrench->addSynonym("tool");
     wrench->addAdjective("metal");
@@ -2980,7 +2980,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::WRENCH, std::move(wrench));
     
     // Create SCREWDRIVER (Screwdriver - tool for screws)
-    auto screwdriver = std::make_unique<ZObject>(ObjectIds::SCREWDRIVER, "screwdriver");
+    auto screwdriver = g.makeObject<ZObject>(ObjectIds::SCREWDRIVER, "screwdriver");
     screwdriver->addSynonym("screwdriver");
     screwdriver->addSynonym("driver");
     screwdriver->addSynonym("tool");
@@ -2993,7 +2993,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::SCREWDRIVER, std::move(screwdriver));
     
     // Create SHOVEL (Shovel - tool for digging)
-    auto shovel = std::make_unique<ZObject>(ObjectIds::SHOVEL, "shovel");
+    auto shovel = g.makeObject<ZObject>(ObjectIds::SHOVEL, "shovel");
     shovel->addSynonym("shovel");
     shovel->addSynonym("spade");
     shovel->addSynonym("tool");
@@ -3005,7 +3005,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::SHOVEL, std::move(shovel));
     
     // Create PUMP (Hand-held air pump - for inflating boat)
-    auto pump = std::make_unique<ZObject>(ObjectIds::PUMP, "hand-held air pump");
+    auto pump = g.makeObject<ZObject>(ObjectIds::PUMP, "hand-held air pump");
     pump->addSynonym("pump");
     pump->addSynonym("air-pump");
     pump->addSynonym("tool");
@@ -3020,7 +3020,7 @@ void initializeWorld() {
     
 
     // Create INFLATED_BOAT (Magic Boat)
-    auto boatInflated = std::make_unique<ZObject>(ObjectIds::INFLATED_BOAT, "magic boat");
+    auto boatInflated = g.makeObject<ZObject>(ObjectIds::INFLATED_BOAT, "magic boat");
     boatInflated->addSynonym("boat");
     boatInflated->addSynonym("raft");
     boatInflated->addAdjective("rubber");
@@ -3036,7 +3036,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOAT_INFLATED, std::move(boatInflated));
     
     // Create BOAT_PUNCTURED (Punctured rubber boat)
-    auto boatPunctured = std::make_unique<ZObject>(ObjectIds::BOAT_PUNCTURED, "punctured boat");
+    auto boatPunctured = g.makeObject<ZObject>(ObjectIds::BOAT_PUNCTURED, "punctured boat");
     boatPunctured->addSynonym("boat");
     boatPunctured->addSynonym("raft");
     boatPunctured->addAdjective("rubber");
@@ -3050,7 +3050,7 @@ void initializeWorld() {
 
     // Create BOAT_INFLATABLE (Pile of plastic / Deflated boat)
     // ZIL: INFLATABLE-BOAT in DAM-BASE
-    auto boatInflatable = std::make_unique<ZObject>(ObjectIds::BOAT_INFLATABLE, "pile of plastic");
+    auto boatInflatable = g.makeObject<ZObject>(ObjectIds::BOAT_INFLATABLE, "pile of plastic");
     boatInflatable->addSynonym("boat");
     boatInflatable->addSynonym("pile");
     boatInflatable->addSynonym("plastic");
@@ -3064,7 +3064,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOAT_INFLATABLE, std::move(boatInflatable));
     
     // Create BOTTLE (Glass bottle - container and tool)
-    auto bottle = std::make_unique<ZObject>(ObjectIds::BOTTLE, "glass bottle");
+    auto bottle = g.makeObject<ZObject>(ObjectIds::BOTTLE, "glass bottle");
     bottle->addSynonym("bottle");
     bottle->addSynonym("container");
     bottle->addAdjective("glass");
@@ -3080,7 +3080,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOTTLE, std::move(bottle));
     
     // Create WATER (Water in bottle)
-    auto water = std::make_unique<ZObject>(ObjectIds::WATER, "quantity of water");
+    auto water = g.makeObject<ZObject>(ObjectIds::WATER, "quantity of water");
     water->addSynonym("water");
     water->addSynonym("quantity");
     water->addAdjective("clear");
@@ -3092,7 +3092,7 @@ void initializeWorld() {
     // ===== PUZZLE OBJECTS (Task 45) =====
     
     // Create MACHINE (Control panel puzzle)
-    auto machine = std::make_unique<ZObject>(ObjectIds::MACHINE, "machine");
+    auto machine = g.makeObject<ZObject>(ObjectIds::MACHINE, "machine");
     machine->addSynonym("machine");
     machine->addSynonym("panel");
     machine->addSynonym("controls");
@@ -3109,7 +3109,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::MACHINE, std::move(machine));
     
     // Create MIRROR_1 (First mirror)
-    auto mirror1 = std::make_unique<ZObject>(ObjectIds::MIRROR_1, "mirror");
+    auto mirror1 = g.makeObject<ZObject>(ObjectIds::MIRROR_1, "mirror");
     mirror1->addSynonym("mirror");
     mirror1->addSynonym("glass");
     mirror1->addAdjective("large");
@@ -3120,7 +3120,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::MIRROR_1, std::move(mirror1));
     
     // Create MIRROR_2 (Second mirror)
-    auto mirror2 = std::make_unique<ZObject>(ObjectIds::MIRROR_2, "mirror");
+    auto mirror2 = g.makeObject<ZObject>(ObjectIds::MIRROR_2, "mirror");
     mirror2->addSynonym("mirror");
     mirror2->addSynonym("glass");
     mirror2->addAdjective("large");
@@ -3131,7 +3131,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::MIRROR_2, std::move(mirror2));
     
     // Create DAM (Dam structure)
-    auto dam = std::make_unique<ZObject>(ObjectIds::DAM, "dam");
+    auto dam = g.makeObject<ZObject>(ObjectIds::DAM, "dam");
     dam->addSynonym("dam");
     dam->addSynonym("structure");
     dam->addAdjective("concrete");
@@ -3143,7 +3143,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::DAM, std::move(dam));
     
     // Create BOLT (Metal bolt for dam puzzle)
-    auto bolt = std::make_unique<ZObject>(ObjectIds::BOLT, "bolt");
+    auto bolt = g.makeObject<ZObject>(ObjectIds::BOLT, "bolt");
     bolt->addSynonym("bolt");
     bolt->addSynonym("nut");
     bolt->addAdjective("metal");
@@ -3155,7 +3155,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BOLT, std::move(bolt));
     
     // Create BUBBLE (Green bubble)
-    auto bubble = std::make_unique<ZObject>(ObjectIds::BUBBLE, "bubble");
+    auto bubble = g.makeObject<ZObject>(ObjectIds::BUBBLE, "bubble");
     bubble->addSynonym("bubble");
     bubble->addAdjective("green");
     bubble->addAdjective("large");
@@ -3165,7 +3165,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BUBBLE, std::move(bubble));
     
     // Create YELLOW_BUTTON
-    auto yellowButton = std::make_unique<ZObject>(ObjectIds::YELLOW_BUTTON, "yellow button");
+    auto yellowButton = g.makeObject<ZObject>(ObjectIds::YELLOW_BUTTON, "yellow button");
     yellowButton->addSynonym("button");
     yellowButton->addAdjective("yellow");
     yellowButton->setFlag(ObjectFlag::TRYTAKEBIT);  // Can't be taken
@@ -3174,7 +3174,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::YELLOW_BUTTON, std::move(yellowButton));
     
     // Create BROWN_BUTTON
-    auto brownButton = std::make_unique<ZObject>(ObjectIds::BROWN_BUTTON, "brown button");
+    auto brownButton = g.makeObject<ZObject>(ObjectIds::BROWN_BUTTON, "brown button");
     brownButton->addSynonym("button");
     brownButton->addAdjective("brown");
     brownButton->setFlag(ObjectFlag::TRYTAKEBIT);  // Can't be taken
@@ -3183,7 +3183,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BROWN_BUTTON, std::move(brownButton));
     
     // Create RED_BUTTON
-    auto redButton = std::make_unique<ZObject>(ObjectIds::RED_BUTTON, "red button");
+    auto redButton = g.makeObject<ZObject>(ObjectIds::RED_BUTTON, "red button");
     redButton->addSynonym("button");
     redButton->addAdjective("red");
     redButton->setFlag(ObjectFlag::TRYTAKEBIT);  // Can't be taken
@@ -3192,7 +3192,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::RED_BUTTON, std::move(redButton));
     
     // Create BLUE_BUTTON
-    auto blueButton = std::make_unique<ZObject>(ObjectIds::BLUE_BUTTON, "blue button");
+    auto blueButton = g.makeObject<ZObject>(ObjectIds::BLUE_BUTTON, "blue button");
     blueButton->addSynonym("button");
     blueButton->addAdjective("blue");
     blueButton->setFlag(ObjectFlag::TRYTAKEBIT);  // Can't be taken
@@ -3201,7 +3201,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::BLUE_BUTTON, std::move(blueButton));
     
     // Create GUNK (Vitreous slag)
-    auto gunk = std::make_unique<ZObject>(ObjectIds::GUNK, "vitreous slag");
+    auto gunk = g.makeObject<ZObject>(ObjectIds::GUNK, "vitreous slag");
     gunk->addSynonym("gunk");
     gunk->addSynonym("slag");
     gunk->addSynonym("pile");
@@ -3220,7 +3220,7 @@ void initializeWorld() {
     // WHITE_HOUSE and BOARD already exist - verified
     
     // Create WINDOW (Generic window)
-    auto window = std::make_unique<ZObject>(ObjectIds::WINDOW, "window");
+    auto window = g.makeObject<ZObject>(ObjectIds::WINDOW, "window");
     window->addSynonym("window");
     window->addSynonym("windows");
     window->setFlag(ObjectFlag::TRYTAKEBIT);
@@ -3228,7 +3228,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::WINDOW, std::move(window));
     
     // Create FRONT_DOOR (Front door of house - boarded)
-    auto frontDoor = std::make_unique<ZObject>(ObjectIds::FRONT_DOOR, "front door");
+    auto frontDoor = g.makeObject<ZObject>(ObjectIds::FRONT_DOOR, "front door");
     frontDoor->addSynonym("door");
     frontDoor->addAdjective("front");
     frontDoor->addAdjective("boarded");
@@ -3238,7 +3238,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::FRONT_DOOR, std::move(frontDoor));
     
     // Create CHIMNEY (Chimney in kitchen)
-    auto chimney = std::make_unique<ZObject>(ObjectIds::CHIMNEY, "chimney");
+    auto chimney = g.makeObject<ZObject>(ObjectIds::CHIMNEY, "chimney");
     chimney->addSynonym("chimney");
     chimney->addAdjective("dark");
     chimney->setFlag(ObjectFlag::TRYTAKEBIT);
@@ -3251,7 +3251,7 @@ void initializeWorld() {
     // TREE and FOREST already exist - verified
     
     // Create RIVER (Frigid River)
-    auto river = std::make_unique<ZObject>(ObjectIds::RIVER, "river");
+    auto river = g.makeObject<ZObject>(ObjectIds::RIVER, "river");
     river->addSynonym("river");
     river->addSynonym("stream");
     river->addSynonym("water");
@@ -3261,7 +3261,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::RIVER, std::move(river));
     
     // Create RAINBOW (Rainbow at Aragain Falls)
-    auto rainbow = std::make_unique<ZObject>(ObjectIds::RAINBOW, "rainbow");
+    auto rainbow = g.makeObject<ZObject>(ObjectIds::RAINBOW, "rainbow");
     rainbow->addSynonym("rainbow");
     rainbow->addAdjective("beautiful");
     rainbow->setFlag(ObjectFlag::TRYTAKEBIT);
@@ -3270,7 +3270,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::RAINBOW, std::move(rainbow));
     
     // Create MOUNTAIN_RANGE (Mountains in distance)
-    auto mountainRange = std::make_unique<ZObject>(ObjectIds::MOUNTAIN_RANGE, "mountain range");
+    auto mountainRange = g.makeObject<ZObject>(ObjectIds::MOUNTAIN_RANGE, "mountain range");
     mountainRange->addSynonym("mountains");
     mountainRange->addSynonym("mountain");
     mountainRange->addSynonym("range");
@@ -3282,7 +3282,7 @@ void initializeWorld() {
     // Interior Scenery - Task 21.3
     
     // Create RUG (Oriental rug in living room)
-    auto rug = std::make_unique<ZObject>(ObjectIds::RUG, "oriental rug");
+    auto rug = g.makeObject<ZObject>(ObjectIds::RUG, "oriental rug");
     rug->addSynonym("rug");
     rug->addSynonym("carpet");
     rug->addAdjective("oriental");
@@ -3296,7 +3296,7 @@ void initializeWorld() {
     // ===== NPCs =====
     
     // Create THIEF NPC
-    auto thief = std::make_unique<ZObject>(ObjectIds::THIEF, "thief");
+    auto thief = g.makeObject<ZObject>(ObjectIds::THIEF, "thief");
     thief->addSynonym("thief");
     thief->addSynonym("robber");
     thief->addSynonym("burglar");
@@ -3345,7 +3345,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::THIEF, std::move(thief));
     
     // Create STILETTO (thief's weapon)
-    auto stiletto = std::make_unique<ZObject>(ObjectIds::STILETTO, "stiletto");
+    auto stiletto = g.makeObject<ZObject>(ObjectIds::STILETTO, "stiletto");
     stiletto->addSynonym("stiletto");
     stiletto->addSynonym("knife");
     stiletto->addAdjective("nasty");
@@ -3358,7 +3358,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::STILETTO, std::move(stiletto));
     
     // Create TROLL's AXE
-    auto axe = std::make_unique<ZObject>(ObjectIds::AXE, "bloody axe");
+    auto axe = g.makeObject<ZObject>(ObjectIds::AXE, "bloody axe");
     axe->addSynonym("axe");
     axe->addAdjective("bloody");
     axe->addAdjective("troll's");
@@ -3374,7 +3374,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::AXE, std::move(axe));
     
     // Create TROLL NPC
-    auto troll = std::make_unique<ZObject>(ObjectIds::TROLL, "troll");
+    auto troll = g.makeObject<ZObject>(ObjectIds::TROLL, "troll");
     troll->addSynonym("troll");
     troll->setFlag(ObjectFlag::FIGHTBIT);    // Hostile NPC
     troll->setFlag(ObjectFlag::ACTORBIT);    // Is an actor/NPC
@@ -3387,7 +3387,7 @@ void initializeWorld() {
     g.registerObject(ObjectIds::TROLL, std::move(troll));
     
     // Create CYCLOPS NPC
-    auto cyclops = std::make_unique<ZObject>(ObjectIds::CYCLOPS, "cyclops");
+    auto cyclops = g.makeObject<ZObject>(ObjectIds::CYCLOPS, "cyclops");
     cyclops->addSynonym("cyclops");
     cyclops->addSynonym("giant");
     cyclops->addSynonym("monster");
@@ -3402,7 +3402,7 @@ void initializeWorld() {
     
     // Create GRUE object (for darkness attacks)
     // The grue is never seen, only felt - it's not a physical object in the world
-    auto grue = std::make_unique<ZObject>(ObjectIds::GRUE, "grue");
+    auto grue = g.makeObject<ZObject>(ObjectIds::GRUE, "grue");
     grue->addSynonym("grue");
     grue->setFlag(ObjectFlag::INVISIBLE);      // Never visible
     // The grue doesn't have a location - it exists in darkness
@@ -3434,7 +3434,6 @@ void initializeWorld() {
     // - FIGHTBIT set for hostile NPCs
     
     // Initialize game state variables
-    g.lit = true;  // West of House is lit
     g.score = 0;
     g.moves = 0;
     
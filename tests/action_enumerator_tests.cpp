@@ -0,0 +1,123 @@
+// Action Enumerator Tests
+// Candidate commands from syntax patterns, scope and exits
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "parser/action_enumerator.h"
+#include "parser/parser.h"
+#include "systems/state_hash.h"
+#include "verbs/verbs.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+// Start a new game and play commands with output discarded
+static void replay(const std::vector<std::string>& commands) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    Engine::newGame(1);
+    for (const auto& c : commands) {
+        Engine::step(c);
+    }
+    std::cout.rdbuf(old);
+}
+
+static bool has(const std::vector<Action>& actions, const std::string& command) {
+    return std::any_of(actions.begin(), actions.end(),
+                       [&](const Action& a) { return a.command == command; });
+}
+
+TEST(ExitsOfCurrentRoom) {
+    replay({});
+    auto actions = ActionEnumerator::enumerate();
+    ASSERT_TRUE(has(actions, "north"));
+    ASSERT_TRUE(has(actions, "south"));
+    ASSERT_TRUE(has(actions, "west"));
+    ASSERT_FALSE(has(actions, "up"));
+
+    auto north = std::find_if(actions.begin(), actions.end(),
+                              [](const Action& a) { return a.command == "north"; });
+    ASSERT_TRUE(north->isDirection);
+    ASSERT_EQ(north->verb, V_WALK);
+}
+
+TEST(ObjectsInScopeOnly) {
+    replay({});
+    auto actions = ActionEnumerator::enumerate();
+    ASSERT_TRUE(has(actions, "open mailbox"));
+    ASSERT_FALSE(has(actions, "take leaflet")); // inside the closed mailbox
+
+    replay({"open mailbox"});
+    actions = ActionEnumerator::enumerate();
+    ASSERT_TRUE(has(actions, "take leaflet"));
+    ASSERT_TRUE(has(actions, "read leaflet"));
+}
+
+TEST(RequiredFlagPrunesSlots) {
+    // TAKE wants a takeable object; the mailbox is not
+    replay({});
+    ASSERT_FALSE(has(ActionEnumerator::enumerate(), "take mailbox"));
+    ASSERT_TRUE(has(ActionEnumerator::enumerate(false), "take mailbox"));
+    ASSERT_TRUE(ActionEnumerator::enumerate(false).size() >
+                ActionEnumerator::enumerate().size());
+}
+
+TEST(NoMetaVerbs) {
+    replay({});
+    for (const auto& a : ActionEnumerator::enumerate(false)) {
+        ASSERT_FALSE(ActionEnumerator::isMetaVerb(a.verb));
+    }
+    ASSERT_TRUE(ActionEnumerator::isMetaVerb(V_SAVE));
+    ASSERT_TRUE(ActionEnumerator::isMetaVerb(V_UNDO));
+    ASSERT_FALSE(ActionEnumerator::isMetaVerb(V_TAKE));
+}
+
+TEST(EveryValidActionParses) {
+    replay({"open mailbox"});
+    uint64_t before = StateHash::current();
+    auto actions = Engine::validActions();
+    ASSERT_TRUE(!actions.empty());
+    for (const auto& a : actions) {
+        StepResult result = Engine::tryStep(a.command);
+        ASSERT_TRUE(result.tookTurn);
+    }
+    ASSERT_EQ(StateHash::current(), before);
+}
+
+TEST(DropNoOpsKeepsStateChanges) {
+    replay({});
+    auto all = Engine::validActions();
+    auto changing = Engine::validActions(true);
+    ASSERT_TRUE(changing.size() < all.size());
+    ASSERT_TRUE(has(changing, "open mailbox"));
+    ASSERT_TRUE(has(changing, "north"));
+    ASSERT_FALSE(has(changing, "examine mailbox"));
+    for (const auto& a : changing) {
+        ASSERT_TRUE(has(all, a.command));
+    }
+}
+
+TEST(DryRunRestoresParserMemory) {
+    replay({"open mailbox"});
+    auto before = getGlobalParser().saveMemory();
+    Engine::tryStep("take leaflet");
+    auto after = getGlobalParser().saveMemory();
+    ASSERT_EQ(after.lastCommand, before.lastCommand);
+    ASSERT_EQ(after.lastObject, before.lastObject);
+}
+
+int main() {
+    std::cout << "Running Action Enumerator Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+// Allocation Tests
+// Attribution of heap allocations to subsystems, and allocation budgets of
+// warm turns
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "systems/allocation_hook.h"
+#include <iostream>
+#include <memory>
+
+using Allocations::Subsystem;
+
+namespace {
+
+// Output sink that keeps nothing (and so never allocates)
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+};
+
+NullBuffer nullBuffer;
+std::ostream nullStream(&nullBuffer);
+
+// Play commands with output discarded
+void play(std::initializer_list<const char*> commands) {
+    setOutputStream(&nullStream);
+    for (const char* command : commands) {
+        Engine::step(command);
+    }
+    setOutputStream(nullptr);
+}
+
+// Allocations made by one command, output discarded
+Allocations::Tally measure(const char* command) {
+    setOutputStream(&nullStream);
+    Allocations::Counter counter;
+    Engine::step(command);
+    Allocations::Tally tally = counter.elapsed();
+    setOutputStream(nullptr);
+    return tally;
+}
+
+} // namespace
+
+TEST(HookIsInstalled) {
+    ASSERT_TRUE(Allocations::hooked());
+    Allocations::Counter counter;
+    auto p = std::make_unique<int>(1);
+    ASSERT_EQ(counter.elapsed().total().allocations, 1u);
+    ASSERT_EQ(counter.elapsed().total().bytes, sizeof(int));
+}
+
+TEST(ScopesChargeInnermostSubsystem) {
+    Allocations::Counter counter;
+    std::unique_ptr<int> a, b, c;
+    {
+        Allocations::Scope parser(Subsystem::PARSER);
+        a = std::make_unique<int>(1);
+        {
+            Allocations::Scope npcs(Subsystem::NPCS);
+            b = std::make_unique<int>(2);
+        }
+        c = std::make_unique<int>(3);
+    }
+    auto d = std::make_unique<int>(4);
+
+    Allocations::Tally tally = counter.elapsed();
+    ASSERT_EQ(tally[Subsystem::PARSER].allocations, 2u);
+    ASSERT_EQ(tally[Subsystem::NPCS].allocations, 1u);
+    ASSERT_EQ(tally[Subsystem::OTHER].allocations, 1u);
+    ASSERT_EQ(tally.total().allocations, 4u);
+}
+
+TEST(WarmWalkAllocatesOnlyJournal) {
+    Engine::newGame(1);
+    play({"north", "south", "north", "south"});
+
+    Allocations::Tally tally = measure("north");
+    ASSERT_EQ(tally[Subsystem::PARSER].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::HANDLER].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::TIMERS].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::NPCS].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::OUTPUT].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::OTHER].allocations, 0u);
+    ASSERT_TRUE(tally[Subsystem::UNDO].allocations > 0);
+}
+
+TEST(WarmParsesDoNotAllocate) {
+    // Word lists, candidate lists and "all" lists live in the turn's scratch
+    auto session = {"north", "east", "open window", "enter window", "west", "take lamp",
+                    "take brass lantern", "put lamp in trophy case", "take all", "drop all",
+                    "take all except sword", "examine it", "look at rug"};
+    Engine::newGame(1);
+    play(session);
+
+    Engine::newGame(1);
+    setOutputStream(&nullStream);
+    Allocations::Counter counter;
+    for (const char* command : session) {
+        Engine::step(command);
+    }
+    Allocations::Tally tally = counter.elapsed();
+    setOutputStream(nullptr);
+    ASSERT_EQ(tally[Subsystem::PARSER].allocations, 0u);
+}
+
+TEST(ScratchIsReleasedEachTurn) {
+    auto& g = Globals::instance();
+    Engine::newGame(1);
+    play({"look"});
+    void* first = g.scratch()->allocate(64);
+    play({"take all", "drop all"});
+    void* again = g.scratch()->allocate(64);
+    ASSERT_EQ(again, first);
+}
+
+TEST(WarmTakeAllLabelsDoNotAllocate) {
+    // "jewel-encrusted egg: " is too long for the small-string buffer
+    Engine::newGame(1);
+    play({"north", "north", "up", "take all", "drop all"});
+
+    Allocations::Tally tally = measure("take all");
+    ASSERT_EQ(tally[Subsystem::OTHER].allocations, 0u);
+    ASSERT_EQ(tally[Subsystem::OUTPUT].allocations, 0u);
+}
+
+TEST(WarmOutputDoesNotAllocate) {
+    auto session = {"open mailbox", "take leaflet", "read leaflet", "drop leaflet",
+                    "north", "east", "open window", "enter window", "look"};
+    Engine::newGame(1);
+    play(session);
+
+    Engine::newGame(1);
+    setOutputStream(&nullStream);
+    Allocations::Counter counter;
+    for (const char* command : session) {
+        Engine::step(command);
+    }
+    Allocations::Tally tally = counter.elapsed();
+    setOutputStream(nullptr);
+    ASSERT_EQ(tally[Subsystem::OUTPUT].allocations, 0u);
+}
+
+int main() {
+    std::cout << "Running Allocation Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
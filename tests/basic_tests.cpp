@@ -65,7 +65,7 @@ TEST(ObjectContainment) {
     item.moveTo(&container);
     ASSERT_EQ(item.getLocation(), &container);
     ASSERT_EQ(container.getContents().size(), 1);
-    ASSERT_EQ(container.getContents()[0], &item);
+    ASSERT_EQ(container.getContents().front(), &item);
 }
 
 // Test room system
@@ -90,8 +90,8 @@ bool testEggPuzzle() {
          return true;
     } else {
          printLine("✗ Egg failed to break with axe");
-         printLine("  Egg Loc: " + (egg->getLocation() ? egg->getLocation()->getDesc() : "null"));
-         printLine("  Broken Egg Loc: " + (brokenEgg->getLocation() ? brokenEgg->getLocation()->getDesc() : "null"));
+         printLine("  Egg Loc: " + (egg->getLocation() ? std::string(egg->getLocation()->getDesc()) : "null"));
+         printLine("  Broken Egg Loc: " + (brokenEgg->getLocation() ? std::string(brokenEgg->getLocation()->getDesc()) : "null"));
          return false;
     }
 }
@@ -126,7 +126,7 @@ bool testCanaryPuzzle() {
          return true;
     } else {
          printLine("✗ Canary failed to drop bauble");
-         printLine("  Bauble Loc: " + (bauble->getLocation() ? bauble->getLocation()->getDesc() : "null"));
+         printLine("  Bauble Loc: " + (bauble->getLocation() ? std::string(bauble->getLocation()->getDesc()) : "null"));
          return false;
     }
 }
@@ -176,8 +176,8 @@ bool testBasketPuzzle() {
     } else {
         printLine("✗ Basket not found in Lower Shaft");
         // Debug
-        printLine("  RaisedBasket Loc: " + (raisedBasket->getLocation() ? raisedBasket->getLocation()->getDesc() : "null"));
-        printLine("  Basket Loc: " + (basket->getLocation() ? basket->getLocation()->getDesc() : "null"));
+        printLine("  RaisedBasket Loc: " + (raisedBasket->getLocation() ? std::string(raisedBasket->getLocation()->getDesc()) : "null"));
+        printLine("  Basket Loc: " + (basket->getLocation() ? std::string(basket->getLocation()->getDesc()) : "null"));
         return false;
     }
     
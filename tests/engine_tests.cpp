@@ -0,0 +1,202 @@
+// Engine Tests
+// Turn loop, dry-run commands and rollback
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "core/random.h"
+#include "parser/parser.h"
+#include "systems/death.h"
+#include "systems/npc.h"
+#include "systems/score.h"
+#include "systems/timer.h"
+#include "systems/undo.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <iostream>
+#include <sstream>
+
+// Fresh game with a fixed seed
+static void setupGame() {
+    Engine::newGame(1);
+}
+
+// Play a command for real with output discarded
+static StepResult play(const std::string& command) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    StepResult result = Engine::step(command);
+    std::cout.rdbuf(old);
+    return result;
+}
+
+TEST(TryStepReportsAndRollsBackMove) {
+    setupGame();
+    auto& g = Globals::instance();
+    ZObject* start = g.here;
+    int moves = g.moves;
+
+    StepResult result = Engine::tryStep("north");
+    ASSERT_TRUE(result.tookTurn);
+    ASSERT_TRUE(result.roomChanged());
+    ASSERT_EQ(result.roomBefore, RoomIds::WEST_OF_HOUSE);
+    ASSERT_EQ(result.roomAfter, RoomIds::NORTH_OF_HOUSE);
+    ASSERT_CONTAINS(result.output, "North of House");
+    ASSERT_FALSE(result.died);
+
+    ASSERT_EQ(g.here, start);
+    ASSERT_EQ(g.winner->getLocation(), start);
+    ASSERT_EQ(g.moves, moves);
+    ASSERT_FALSE(Engine::isDryRun());
+}
+
+TEST(TryStepAgainstSameBaseState) {
+    setupGame();
+    auto& g = Globals::instance();
+    ZObject* mailbox = g.getObject(ObjectIds::MAILBOX);
+    ASSERT_TRUE(mailbox != nullptr);
+
+    StepResult north = Engine::tryStep("north");
+    StepResult south = Engine::tryStep("south");
+    StepResult open = Engine::tryStep("open mailbox");
+    StepResult again = Engine::tryStep("open mailbox");
+
+    ASSERT_EQ(north.roomAfter, RoomIds::NORTH_OF_HOUSE);
+    ASSERT_EQ(south.roomAfter, RoomIds::SOUTH_OF_HOUSE);
+    ASSERT_EQ(south.roomBefore, RoomIds::WEST_OF_HOUSE);
+    ASSERT_FALSE(open.roomChanged());
+    ASSERT_EQ(open.output, again.output);
+    ASSERT_FALSE(mailbox->hasFlag(ObjectFlag::OPENBIT));
+}
+
+TEST(TrySequenceChainsThenRollsBack) {
+    setupGame();
+    auto& g = Globals::instance();
+    ZObject* start = g.here;
+
+    auto results = Engine::trySequence({"north", "east", "open window"});
+    ASSERT_EQ(results.size(), 3u);
+    ASSERT_EQ(results[1].roomBefore, RoomIds::NORTH_OF_HOUSE);
+    ASSERT_EQ(results[1].roomAfter, RoomIds::BEHIND_HOUSE);
+    ASSERT_CONTAINS(results[2].output, "open the window");
+
+    ASSERT_EQ(g.here, start);
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_FALSE(g.getObject(ObjectIds::KITCHEN_WINDOW)->hasFlag(ObjectFlag::OPENBIT));
+}
+
+TEST(TryStepReportsScoreDelta) {
+    setupGame();
+    auto& g = Globals::instance();
+    ZObject* livingRoom = g.getObject(RoomIds::LIVING_ROOM);
+    ZObject* egg = g.getObject(ObjectIds::EGG);
+    g.winner->moveTo(livingRoom);
+    g.here = livingRoom;
+    egg->moveTo(g.winner);
+    g.getObject(ObjectIds::TROPHY_CASE)->setFlag(ObjectFlag::OPENBIT);
+
+    StepResult result = Engine::tryStep("put egg in case");
+    ASSERT_EQ(result.scoreDelta, egg->getProperty(P_TVALUE));
+    ASSERT_TRUE(result.scoreDelta > 0);
+    ASSERT_EQ(ScoreSystem::instance().getScore(), 0);
+    ASSERT_FALSE(ScoreSystem::instance().isTreasureScored(ObjectIds::EGG));
+    ASSERT_EQ(egg->getLocation(), g.winner);
+}
+
+TEST(TryStepReportsDeath) {
+    setupGame();
+    TimerSystem::registerTimer("TEST-DEATH", 1, []() {
+        DeathSystem::jigsUp("A falling rock hits you on the head.");
+    });
+
+    StepResult result = Engine::tryStep("wait");
+    ASSERT_TRUE(result.died);
+    ASSERT_CONTAINS(result.output, "You have died");
+    ASSERT_EQ(result.scoreDelta, -10);
+
+    ASSERT_EQ(DeathSystem::getDeathCount(), 0);
+    ASSERT_EQ(ScoreSystem::instance().getScore(), 0);
+}
+
+TEST(TryStepLeavesRandomEngineAndHistory) {
+    setupGame();
+    auto& g = Globals::instance();
+
+    play("north");
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 1u);
+
+    Random::Engine before = Random::engine();
+    NPCSystem::ThiefState thief = NPCSystem::getThiefState();
+    for (int i = 0; i < 20; ++i) {
+        Engine::tryStep("wait");
+    }
+    ASSERT_TRUE(Random::engine() == before);
+    ASSERT_EQ(NPCSystem::getThiefState().turnsUntilMove, thief.turnsUntilMove);
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 1u);
+
+    // UNDO inside a dry run cannot reach the real history
+    auto results = Engine::trySequence({"undo", "east", "undo"});
+    ASSERT_CONTAINS(results[0].output, "can't");
+    ASSERT_CONTAINS(results[2].output, "Previous turn undone.");
+    ASSERT_EQ(g.here->getId(), RoomIds::NORTH_OF_HOUSE);
+
+    ASSERT_EQ(UndoSystem::undo(1), 1u);
+    ASSERT_EQ(g.here->getId(), RoomIds::WEST_OF_HOUSE);
+}
+
+TEST(StepPlaysForReal) {
+    setupGame();
+    auto& g = Globals::instance();
+
+    StepResult empty = play("   ");
+    ASSERT_FALSE(empty.tookTurn);
+
+    StepResult result = play("north");
+    ASSERT_TRUE(result.tookTurn);
+    ASSERT_TRUE(result.output.empty());
+    ASSERT_EQ(g.here->getId(), RoomIds::NORTH_OF_HOUSE);
+    ASSERT_EQ(g.moves, 1);
+}
+
+TEST(SameSeedReplaysSameGame) {
+    const std::vector<std::string> commands = {
+        "north", "east", "open window", "enter window", "west", "take all",
+        "wait", "wait", "wait", "wait"};
+
+    setupGame();
+    auto first = Engine::trySequence(commands);
+    setupGame();
+    auto second = Engine::trySequence(commands);
+
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        ASSERT_EQ(first[i].output, second[i].output);
+    }
+}
+
+TEST(NewGameForgetsParserMemory) {
+    setupGame();
+    play("open mailbox");
+    ASSERT_TRUE(getGlobalParser().saveMemory().lastObject != nullptr); // "it"
+
+    setupGame();
+    auto memory = getGlobalParser().saveMemory();
+    ASSERT_TRUE(memory.lastObject == nullptr);
+    ASSERT_TRUE(memory.lastCommand.empty());
+}
+
+int main() {
+    std::cout << "Running Engine Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
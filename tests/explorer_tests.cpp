@@ -0,0 +1,131 @@
+// Explorer Tests
+// Invariant checks, failure minimization and coverage-guided exploration
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "systems/explorer.h"
+#include "systems/timer.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+static void newGame() {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    Engine::newGame(1);
+    std::cout.rdbuf(old);
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+TEST(NewGameSatisfiesInvariants) {
+    newGame();
+    auto violation = Explorer::checkInvariants();
+    ASSERT_FALSE(violation.has_value());
+}
+
+TEST(DetectsContainmentCycle) {
+    newGame();
+    auto& g = Globals::instance();
+    ZObject* mailbox = g.getObject(ObjectIds::MAILBOX);
+    ZObject* leaflet = g.getObject(ObjectIds::ADVERTISEMENT);
+    mailbox->moveTo(leaflet); // the leaflet is inside the mailbox
+
+    auto violation = Explorer::checkInvariants();
+    ASSERT_TRUE(violation.has_value());
+    ASSERT_TRUE(contains(*violation, "cycle"));
+    newGame();
+}
+
+TEST(DetectsPlayerOutsideHere) {
+    newGame();
+    auto& g = Globals::instance();
+    g.here = g.getObject(RoomIds::KITCHEN);
+
+    auto violation = Explorer::checkInvariants();
+    ASSERT_TRUE(violation.has_value());
+    ASSERT_TRUE(contains(*violation, "player"));
+    newGame();
+}
+
+TEST(ReplayOfCleanLog) {
+    auto failure = Explorer::replay({"open mailbox", "take leaflet", "north", "east"}, 1);
+    ASSERT_FALSE(failure.has_value());
+}
+
+TEST(MinimizeKeepsOnlyNeededCommands) {
+    std::vector<std::string> log = {"a", "b", "c", "d", "e", "f", "g", "h", "i"};
+    int calls = 0;
+    auto fails = [&calls](const std::vector<std::string>& l) {
+        calls++;
+        bool hasC = std::find(l.begin(), l.end(), "c") != l.end();
+        bool hasG = std::find(l.begin(), l.end(), "g") != l.end();
+        return hasC && hasG;
+    };
+    auto minimal = Explorer::minimize(log, fails);
+    ASSERT_EQ(minimal.size(), 2u);
+    ASSERT_EQ(minimal[0], std::string("c"));
+    ASSERT_EQ(minimal[1], std::string("g"));
+    ASSERT_TRUE(calls < 40);
+}
+
+TEST(TimerFiringsRecorded) {
+    newGame();
+    auto& timers = TimerSystem::TimerManager::instance();
+    timers.registerTimer("TEST-TIMER", 1, []() {}, false);
+    timers.enableTimer("TEST-TIMER");
+    timers.tick();
+    const auto& fired = timers.getFiredLastTick();
+    ASSERT_TRUE(std::find(fired.begin(), fired.end(), "TEST-TIMER") != fired.end());
+    timers.tick();
+    ASSERT_TRUE(std::find(timers.getFiredLastTick().begin(), timers.getFiredLastTick().end(),
+                          "TEST-TIMER") == timers.getFiredLastTick().end());
+    newGame();
+}
+
+TEST(ExploreGrowsCorpus) {
+    Explorer::Options options;
+    options.threads = 2;
+    options.seconds = 0;
+    options.maxCommands = 3000;
+    Explorer::Stats stats = Explorer::explore(options);
+
+    ASSERT_TRUE(stats.commands >= 3000);
+    ASSERT_TRUE(stats.runs > 0);
+    ASSERT_TRUE(stats.corpus > 10);
+    ASSERT_TRUE(stats.features > stats.corpus);
+    ASSERT_EQ(stats.threads, 2u);
+
+    // Every reported failure comes with a log that reproduces it
+    for (const auto& failure : stats.failures) {
+        std::cout << "  " << Explorer::kindName(failure.kind) << ": " << failure.message
+                  << " (" << failure.commands.size() << " commands)\n";
+        if (contains(failure.message, "does not reproduce")) {
+            continue;
+        }
+        auto again = Explorer::replay(failure.commands, options.seed);
+        ASSERT_TRUE(again.has_value());
+        ASSERT_EQ(again->message, failure.message);
+    }
+}
+
+int main() {
+    std::cout << "Running Explorer Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,161 @@
+// Fidelity Tests
+// Z-machine interpreter and lockstep comparison with the original game
+
+#include "test_framework.h"
+#include "systems/fidelity.h"
+#include "systems/zmachine.h"
+#include <iostream>
+
+#ifndef ZORK_STORY_FILE
+#define ZORK_STORY_FILE "zil/COMPILED/zork1.z3"
+#endif
+
+static ZMachine::Story story() {
+    static ZMachine::Story loaded = ZMachine::load(ZORK_STORY_FILE);
+    return loaded;
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+static std::string play(ZMachine& zm, const std::string& command) {
+    zm.input(command);
+    return zm.run();
+}
+
+TEST(InterpreterPlaysOpening) {
+    ZMachine zm(story());
+    ASSERT_EQ(zm.release(), 119);
+    ASSERT_EQ(zm.serial(), "880429");
+
+    std::string opening = zm.run();
+    ASSERT_TRUE(contains(opening, "ZORK I: The Great Underground Empire"));
+    ASSERT_TRUE(contains(opening, "West of House"));
+    ASSERT_TRUE(contains(opening, "There is a small mailbox here."));
+    ASSERT_TRUE(zm.status() == ZMachine::Status::INPUT);
+}
+
+TEST(InterpreterPlaysCommands) {
+    ZMachine zm(story());
+    zm.run();
+    ASSERT_TRUE(contains(play(zm, "open mailbox"), "Opening the small mailbox reveals a leaflet."));
+    ASSERT_TRUE(contains(play(zm, "TAKE LEAFLET"), "Taken."));
+    ASSERT_TRUE(contains(play(zm, "north"), "North of House"));
+    ASSERT_TRUE(contains(play(zm, "inventory"), "A leaflet"));
+
+    // Words missing from the dictionary reach the game's parser
+    ASSERT_TRUE(contains(play(zm, "frobnicate"), "I don't know the word \"frobnicate\"."));
+}
+
+TEST(InterpreterRestart) {
+    ZMachine zm(story());
+    zm.run();
+    play(zm, "open mailbox");
+    play(zm, "take leaflet");
+
+    zm.restart();
+    ASSERT_TRUE(contains(zm.run(), "West of House"));
+    ASSERT_TRUE(contains(play(zm, "inventory"), "You are empty-handed."));
+}
+
+TEST(InterpreterQuit) {
+    ZMachine zm(story());
+    zm.run();
+    ASSERT_TRUE(contains(play(zm, "quit"), "Do you wish to leave the game?"));
+    play(zm, "y");
+    ASSERT_TRUE(zm.status() == ZMachine::Status::QUIT);
+}
+
+TEST(InterpreterSeedRepeatsRandomChoices) {
+    // RUB picks its reply at random
+    auto transcript = [](uint32_t seed, uint32_t& draws) {
+        ZMachine zm(story());
+        zm.seed(seed);
+        zm.run();
+        std::string text;
+        draws = 0;
+        for (int i = 0; i < 8; ++i) {
+            text += play(zm, "rub mailbox");
+            draws += zm.randomDraws();
+        }
+        return text;
+    };
+    uint32_t draws1 = 0, draws2 = 0;
+    ASSERT_EQ(transcript(7, draws1), transcript(7, draws2));
+    ASSERT_TRUE(draws1 >= 8);
+    ASSERT_EQ(draws1, draws2);
+}
+
+TEST(ParagraphsIgnoreWrapping) {
+    auto p = Fidelity::paragraphs("West of House\n You are standing in an\nopen   field.\n\n\n  There\tis a\n mailbox.\n");
+    ASSERT_EQ(p.size(), 2u);
+    ASSERT_EQ(p[0], "West of House You are standing in an open field.");
+    ASSERT_EQ(p[1], "There is a mailbox.");
+    ASSERT_TRUE(Fidelity::paragraphs("\n \n").empty());
+}
+
+TEST(CompareOpeningMoves) {
+    ZMachine original(story());
+    auto divergence = Fidelity::compare(original, {"open mailbox", "take leaflet", "north"}, 1);
+    ASSERT_FALSE(divergence.has_value());
+}
+
+TEST(DivergencesReproduce) {
+    Fidelity::Options options;
+    options.storyPath = ZORK_STORY_FILE;
+    options.threads = 2;
+    options.walks = 60;
+    options.walkLength = 20;
+    options.scripts = {{"open mailbox", "take leaflet", "read leaflet"}};
+    Fidelity::Report report = Fidelity::run(options);
+
+    ASSERT_EQ(report.runs, 61u);
+    ASSERT_TRUE(report.commands >= report.runs);
+    size_t diverged = 0;
+    for (const auto& d : report.divergences) {
+        diverged += d.count;
+    }
+    ASSERT_EQ(report.matched + diverged, report.runs);
+
+    // Each reported sequence leads to the same difference from a new game
+    ZMachine original(story());
+    for (const auto& d : report.divergences) {
+        ASSERT_FALSE(d.commands.empty());
+        ASSERT_TRUE(d.expected != d.actual);
+        auto again = Fidelity::compare(original, d.commands, options.seed);
+        ASSERT_TRUE(again.has_value());
+        ASSERT_EQ(again->commands.size(), d.commands.size());
+        ASSERT_EQ(again->expected, d.expected);
+        ASSERT_EQ(again->actual, d.actual);
+    }
+}
+
+TEST(ThousandWalksInSeconds) {
+    Fidelity::Options options;
+    options.storyPath = ZORK_STORY_FILE;
+    options.threads = 2;
+    options.walks = 1000;
+    Fidelity::Report report = Fidelity::run(options);
+
+    std::cout << "  " << report.runs << " walks, " << report.commands << " commands in "
+              << report.seconds << " s, " << report.divergences.size()
+              << " distinct divergences\n";
+    ASSERT_EQ(report.runs, 1000u);
+    ASSERT_TRUE(report.seconds < 30);
+}
+
+int main() {
+    std::cout << "Running Fidelity Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,112 @@
+// Footprint Tests
+// Per-session memory report: parts, attribution and agreement with malloc
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "parser/parser.h"
+#include "systems/footprint.h"
+#include "world/rooms.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using Footprint::Part;
+
+// Play commands with output discarded
+static void play(std::initializer_list<const char*> commands) {
+    std::ostringstream discard;
+    setOutputStream(&discard);
+    for (const char* command : commands) {
+        Engine::step(command);
+    }
+    setOutputStream(nullptr);
+}
+
+TEST(NewGameHasEveryWorldPart) {
+    Engine::newGame(1);
+    Footprint::Report report = Footprint::current();
+    for (Part part : {Part::OBJECTS, Part::VOCABULARY, Part::TEXT, Part::EXITS, Part::CLOSURES,
+                      Part::TIMERS, Part::PARSER_HISTORY, Part::UNDO}) {
+        ASSERT_TRUE(report[part] > 0);
+    }
+    ASSERT_EQ(report[Part::OUTPUT], 0u);
+
+    size_t sum = 0;
+    for (size_t bytes : report.bytes) {
+        sum += bytes;
+    }
+    ASSERT_EQ(report.total(), sum);
+}
+
+TEST(MembersCountToTheirParts) {
+    std::string longText(100, 'x');
+    ZRoom room(9999, "a room with a long name", "");
+    room.addSynonym("room");
+    room.setExit(Direction::NORTH, RoomExit(longText));
+
+    Footprint::Report report;
+    room.addFootprint(report);
+    ASSERT_TRUE(report[Part::TEXT] > 2 * longText.size()); // short description + exit message
+    ASSERT_TRUE(report[Part::VOCABULARY] > 0);
+    ASSERT_TRUE(report[Part::EXITS] > 0);
+    ASSERT_TRUE(report[Part::CLOSURES] > 0); // the action slots, empty or not
+    ASSERT_EQ(report[Part::TIMERS], 0u);
+}
+
+TEST(UndoHistoryGrows) {
+    Engine::newGame(1);
+    size_t before = Footprint::current()[Part::UNDO];
+    play({"open mailbox", "take leaflet", "north", "east"});
+    ASSERT_TRUE(Footprint::current()[Part::UNDO] > before);
+}
+
+TEST(CapturedOutputIsCounted) {
+    Engine::newGame(1);
+    std::ostringstream captured;
+    setOutputStream(&captured);
+    Engine::step("look");
+    Footprint::Report report = Footprint::current();
+    setOutputStream(nullptr);
+    ASSERT_TRUE(report[Part::OUTPUT] > captured.str().size());
+}
+
+#ifdef __GLIBC__
+TEST(AgreesWithMalloc) {
+    // A session on a fresh thread, its world on the heap: the heap it
+    // grows by is (nearly) all the session's, so the estimate should be
+    // within a tenth of it
+    std::thread([] {
+        std::ostringstream discard;
+        setOutputStream(&discard);
+        getGlobalParser(); // process-wide statics (verb registry) first
+        Globals::instance().setWorldArena(false);
+        size_t before = mallinfo2().uordblks;
+        Engine::newGame(1);
+        double grown = static_cast<double>(mallinfo2().uordblks - before);
+        double estimate = static_cast<double>(Footprint::current().total());
+        setOutputStream(nullptr);
+        ASSERT_TRUE(estimate > 0.9 * grown);
+        ASSERT_TRUE(estimate < 1.1 * grown);
+    }).join();
+}
+#endif
+
+int main() {
+    std::cout << "Running Footprint Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -155,6 +155,52 @@ TEST(lamp_in_open_container) {
     ASSERT_TRUE(LightSystem::isRoomLit(roomPtr));
 }
 
+// Test: Lamp in an open sack in the player's boat lights the room (Requirement 50)
+TEST(lamp_in_nested_containers) {
+    auto& g = Globals::instance();
+    g.reset();
+    
+    // Create a dark room with the player in an open boat
+    auto room = std::make_unique<ZObject>(1, "dark room");
+    auto* roomPtr = room.get();
+    g.registerObject(1, std::move(room));
+    
+    auto boat = std::make_unique<ZObject>(2, "boat");
+    boat->setFlag(ObjectFlag::CONTBIT);
+    boat->setFlag(ObjectFlag::OPENBIT);
+    boat->setFlag(ObjectFlag::VEHBIT);
+    auto* boatPtr = boat.get();
+    boat->moveTo(roomPtr);
+    g.registerObject(2, std::move(boat));
+    
+    auto player = std::make_unique<ZObject>(3, "player");
+    g.winner = player.get();
+    player->moveTo(boatPtr);
+    g.registerObject(3, std::move(player));
+    
+    // A lit lamp in a closed sack the player holds
+    auto sack = std::make_unique<ZObject>(4, "sack");
+    sack->setFlag(ObjectFlag::CONTBIT);
+    auto* sackPtr = sack.get();
+    sack->moveTo(g.winner);
+    g.registerObject(4, std::move(sack));
+    
+    auto lamp = std::make_unique<ZObject>(5, "lamp");
+    lamp->setFlag(ObjectFlag::LIGHTBIT);
+    lamp->setFlag(ObjectFlag::ONBIT);
+    lamp->moveTo(sackPtr);
+    g.registerObject(5, std::move(lamp));
+    
+    ASSERT_FALSE(LightSystem::isRoomLit(roomPtr));
+    sackPtr->setFlag(ObjectFlag::OPENBIT);
+    ASSERT_TRUE(LightSystem::isRoomLit(roomPtr));
+    
+    // And from the bottom of the boat
+    sackPtr->moveTo(boatPtr);
+    ASSERT_TRUE(LightSystem::isRoomLit(roomPtr));
+    g.winner = nullptr;
+}
+
 // Test: updateLighting sets global lit flag (Requirement 50)
 TEST(update_lighting) {
     auto& g = Globals::instance();
@@ -190,6 +236,41 @@ TEST(update_lighting_dark) {
     ASSERT_FALSE(g.lit);
 }
 
+// Test: lit follows moves and lamp changes without updateLighting (Requirement 50)
+TEST(lit_follows_the_world) {
+    auto& g = Globals::instance();
+    g.reset();
+    
+    auto room = std::make_unique<ZObject>(1, "dark room");
+    auto* roomPtr = room.get();
+    g.registerObject(1, std::move(room));
+    auto other = std::make_unique<ZObject>(2, "other room");
+    auto* otherPtr = other.get();
+    g.registerObject(2, std::move(other));
+    g.setHere(roomPtr);
+    ASSERT_FALSE(g.lit);
+    
+    auto lamp = std::make_unique<ZObject>(3, "lamp");
+    auto* lampPtr = lamp.get();
+    lamp->setFlag(ObjectFlag::LIGHTBIT);
+    lamp->moveTo(roomPtr);
+    g.registerObject(3, std::move(lamp));
+    ASSERT_FALSE(g.lit);
+    
+    lampPtr->setFlag(ObjectFlag::ONBIT);
+    ASSERT_TRUE(g.lit);
+    ASSERT_EQ(roomPtr->getLightSources(), 1);
+    
+    lampPtr->moveTo(otherPtr);
+    ASSERT_FALSE(g.lit);
+    g.setHere(otherPtr);
+    ASSERT_TRUE(g.lit);
+    
+    lampPtr->clearFlag(ObjectFlag::ONBIT);
+    ASSERT_FALSE(g.lit);
+    ASSERT_EQ(otherPtr->getLightSources(), 0);
+}
+
 // Test: First turn in darkness gives grue warning (Requirement 51)
 TEST(grue_first_warning) {
     auto& g = Globals::instance();
@@ -0,0 +1,168 @@
+// Metrics Tests
+// Latency histograms, per-thread recorders and the periodic dump
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "systems/metrics.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// Play a command with output discarded
+static StepResult play(const std::string& command) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    StepResult result = Engine::step(command);
+    std::cout.rdbuf(old);
+    return result;
+}
+
+TEST(HistogramBucketsCoverEveryValue) {
+    using Metrics::Histogram;
+    for (uint64_t ns : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 1000ull, 123456789ull}) {
+        int bucket = Histogram::bucketOf(ns);
+        ASSERT_TRUE(Histogram::bucketLow(bucket) <= ns);
+        ASSERT_TRUE(ns <= Histogram::bucketHigh(bucket));
+    }
+    for (int bucket = 0; bucket + 1 < Histogram::BUCKETS; ++bucket) {
+        ASSERT_EQ(Histogram::bucketHigh(bucket) + 1, Histogram::bucketLow(bucket + 1));
+    }
+    ASSERT_EQ(Histogram::bucketOf(~0ull), Histogram::BUCKETS - 1);
+}
+
+TEST(HistogramPercentiles) {
+    Metrics::Histogram h;
+    for (uint64_t ns = 1; ns <= 1000; ++ns) {
+        h.record(ns);
+    }
+    ASSERT_EQ(h.count, 1000u);
+    ASSERT_EQ(h.min, 1u);
+    ASSERT_EQ(h.max, 1000u);
+    ASSERT_TRUE(h.mean() == 500.5);
+
+    // Within one bucket (12.5%) of the exact value
+    uint64_t p50 = h.percentile(0.50);
+    ASSERT_TRUE(p50 >= 500 && p50 <= 563);
+    uint64_t p99 = h.percentile(0.99);
+    ASSERT_TRUE(p99 >= 990 && p99 <= 1000);
+    ASSERT_EQ(h.percentile(1.0), 1000u);
+
+    Metrics::Histogram other;
+    other.record(5000);
+    h.merge(other);
+    ASSERT_EQ(h.count, 1001u);
+    ASSERT_EQ(h.max, 5000u);
+    ASSERT_EQ(h.percentile(1.0), 5000u);
+}
+
+TEST(DisabledRecordsNothing) {
+    Metrics::setEnabled(false);
+    Metrics::reset();
+    Engine::newGame(1);
+    play("open mailbox");
+    ASSERT_EQ(Metrics::start(), 0u);
+    Metrics::Snapshot s = Metrics::snapshot();
+    ASSERT_EQ(s.parse.calls, 0u);
+    ASSERT_TRUE(s.verbs.empty());
+}
+
+TEST(CountsVerbsAndTimers) {
+    Metrics::setEnabled(true);
+    Metrics::setSampleEvery(1);
+    Metrics::reset();
+    Engine::newGame(1);
+    play("open mailbox");
+    play("take leaflet");
+    play("north");
+    play("north");
+    Metrics::setEnabled(false);
+
+    Metrics::Snapshot s = Metrics::snapshot();
+    ASSERT_EQ(s.parse.calls, 4u);
+    ASSERT_EQ(s.parse.latency.count, 4u); // every call timed
+    ASSERT_EQ(s.verbs["open"].calls, 1u);
+    ASSERT_EQ(s.verbs["take"].calls, 1u);
+    ASSERT_EQ(s.verbs["walk"].calls, 2u);
+    ASSERT_EQ(s.verbs["walk"].latency.count, 2u);
+    ASSERT_FALSE(s.timers.empty());
+    ASSERT_FALSE(s.roomActions.empty());
+    Metrics::setSampleEvery(64);
+}
+
+TEST(SamplingTimesFewerCalls) {
+    Metrics::setEnabled(true);
+    Metrics::setSampleEvery(5);
+    ASSERT_EQ(Metrics::sampleEvery(), 8u);
+    Metrics::reset();
+    for (int i = 0; i < 8000; ++i) {
+        Metrics::parsed(Metrics::start());
+    }
+    Metrics::setEnabled(false);
+    Metrics::setSampleEvery(64);
+
+    Metrics::Snapshot s = Metrics::snapshot();
+    ASSERT_EQ(s.parse.calls, 8000u);
+    ASSERT_TRUE(s.parse.latency.count > 500 && s.parse.latency.count < 1500);
+}
+
+TEST(SnapshotMergesThreads) {
+    Metrics::setEnabled(true);
+    Metrics::reset();
+    std::thread first([]() {
+        for (int i = 0; i < 100; ++i) {
+            Metrics::timerFired("I-TEST", Metrics::start());
+        }
+    });
+    first.join(); // retired: its recorder is gone
+    std::thread second([]() {
+        for (int i = 0; i < 50; ++i) {
+            Metrics::timerFired("I-TEST", Metrics::start());
+        }
+    });
+    second.join();
+    Metrics::timerFired("I-TEST", Metrics::start());
+    Metrics::setEnabled(false);
+
+    ASSERT_EQ(Metrics::snapshot().timers["I-TEST"].calls, 151u);
+    Metrics::reset();
+    ASSERT_EQ(Metrics::snapshot().timers["I-TEST"].calls, 0u);
+}
+
+TEST(PeriodicDumpWritesJson) {
+    std::string path = "metrics_tests_dump.json";
+    std::remove(path.c_str());
+    Metrics::setEnabled(true);
+    Metrics::reset();
+    Engine::newGame(1);
+    {
+        Metrics::PeriodicDump dump(path, std::chrono::milliseconds(60000));
+        play("open mailbox");
+    } // final dump on destruction
+    Metrics::setEnabled(false);
+
+    std::ifstream in(path);
+    ASSERT_TRUE(static_cast<bool>(in));
+    std::stringstream text;
+    text << in.rdbuf();
+    ASSERT_CONTAINS(text.str(), "\"sample_every\": 64");
+    ASSERT_CONTAINS(text.str(), "\"open\": {\"calls\": 1");
+    ASSERT_CONTAINS(text.str(), "\"p999_ns\"");
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "Running Metrics Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
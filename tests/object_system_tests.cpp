@@ -199,11 +199,40 @@ TEST(ObjectPropertiesSerialization) {
     // Get all properties
     const auto& props = obj.getAllProperties();
     
-    // Verify properties are in the map
+    // Verify properties are in the table
     ASSERT_EQ(props.size(), 3);
-    ASSERT_EQ(props.at(P_SIZE), 10);
-    ASSERT_EQ(props.at(P_CAPACITY), 100);
-    ASSERT_EQ(props.at(P_VALUE), 50);
+    ASSERT_EQ(props.get(P_SIZE), 10);
+    ASSERT_EQ(props.get(P_CAPACITY), 100);
+    ASSERT_EQ(props.get(P_VALUE), 50);
+}
+
+// Test the property table: id order, removal, ids without a slot
+TEST(ObjectPropertySlots) {
+    ZObject obj(1, "test");
+    obj.setProperty(P_VALUE, 50);
+    obj.setProperty(P_SIZE, 0);
+    obj.setProperty(P_TVALUE, -3);
+
+    std::vector<std::pair<PropertyId, int>> seen;
+    for (const auto& [prop, value] : obj.getAllProperties()) {
+        seen.emplace_back(prop, value);
+    }
+    ASSERT_EQ(seen.size(), 3);
+    ASSERT_EQ(seen[0].first, P_SIZE);
+    ASSERT_EQ(seen[1].first, P_VALUE);
+    ASSERT_EQ(seen[2].second, -3);
+
+    // A property set to 0 is still set
+    ASSERT_TRUE(obj.getAllProperties().contains(P_SIZE));
+    obj.removeProperty(P_SIZE);
+    ASSERT_FALSE(obj.getAllProperties().contains(P_SIZE));
+    ASSERT_EQ(obj.getAllProperties().size(), 2);
+
+    obj.setProperty(PropertyTable::SLOTS, 7);
+    obj.setProperty(-1, 7);
+    ASSERT_EQ(obj.getProperty(PropertyTable::SLOTS), 0);
+    ASSERT_EQ(obj.getProperty(-1), 0);
+    ASSERT_EQ(obj.getAllProperties().size(), 2);
 }
 
 // Test text property operations
@@ -246,7 +275,7 @@ TEST(ObjectTextPropertyLong) {
     std::string longText(1000, 'a');
     obj.setText(longText);
     ASSERT_TRUE(obj.hasText());
-    ASSERT_EQ(obj.getText(), longText);
+    ASSERT_EQ(obj.getText(), std::string_view(longText));
 }
 
 // Test containment operations
@@ -259,7 +288,7 @@ TEST(ObjectContainmentBasic) {
     
     ASSERT_EQ(item.getLocation(), &container);
     ASSERT_EQ(container.getContents().size(), 1);
-    ASSERT_EQ(container.getContents()[0], &item);
+    ASSERT_EQ(container.getContents().front(), &item);
 }
 
 TEST(ObjectContainmentMultipleItems) {
@@ -348,10 +377,138 @@ TEST(ObjectContainmentOrder) {
     item3.moveTo(&container);
     
     // Verify order is preserved
-    const auto& contents = container.getContents();
-    ASSERT_EQ(contents[0], &item1);
-    ASSERT_EQ(contents[1], &item2);
-    ASSERT_EQ(contents[2], &item3);
+    auto it = container.getContents().begin();
+    ASSERT_EQ(*it, &item1);
+    ASSERT_EQ(*++it, &item2);
+    ASSERT_EQ(*++it, &item3);
+    ASSERT_TRUE(++it == container.getContents().end());
+}
+
+TEST(ObjectContainmentDestroyedObjectDetaches) {
+    ZObject container(1, "container");
+    ZObject kept(2, "kept");
+    ZObject child(4, "child");
+    kept.moveTo(&container);
+    {
+        ZObject doomed(3, "doomed");
+        doomed.moveTo(&container);
+        child.moveTo(&doomed);
+    }
+    
+    // No dangling pointers either way
+    ASSERT_EQ(container.getContents().size(), 1);
+    ASSERT_EQ(container.getContents().front(), &kept);
+    ASSERT_EQ(child.getLocation(), nullptr);
+}
+
+TEST(ObjectContainmentRelinks) {
+    ZObject container(1, "container");
+    ZObject other(2, "other");
+    ZObject a(3, "a"), b(4, "b"), c(5, "c");
+    auto names = [&container]() {
+        std::string s;
+        for (const ZObject* child : container.getContents()) {
+            s += child->getDesc();
+        }
+        return s;
+    };
+    a.moveTo(&container);
+    b.moveTo(&container);
+    c.moveTo(&container);
+
+    // Out of the middle, then back at the end
+    b.moveTo(&other);
+    ASSERT_EQ(names(), "ac");
+    b.moveTo(&container);
+    ASSERT_EQ(names(), "acb");
+
+    // Reinserted at a position (UNDO), clamped to the end
+    a.restoreLocation(&container, 1);
+    ASSERT_EQ(names(), "cab");
+    c.restoreLocation(&container, 10);
+    ASSERT_EQ(names(), "abc");
+
+    // A loop may move the child it is on
+    for (ZObject* child : container.getContents()) {
+        child->moveTo(&other);
+    }
+    ASSERT_TRUE(container.getContents().empty());
+    ASSERT_EQ(other.getContents().size(), 3);
+}
+
+TEST(ObjectScopeFollowsContainers) {
+    ZObject room(1, "room");
+    ZObject boat(2, "boat"), sack(3, "sack"), lamp(4, "lamp");
+    boat.setFlag(ObjectFlag::CONTBIT);
+    boat.setFlag(ObjectFlag::OPENBIT);
+    sack.setFlag(ObjectFlag::CONTBIT);
+    lamp.moveTo(&sack);
+    sack.moveTo(&boat);
+    boat.moveTo(&room);
+
+    // Closed sack: the lamp is seen from the sack only
+    ASSERT_EQ(lamp.getSeenFrom(), &sack);
+    ASSERT_TRUE(lamp.isVisibleIn(&sack));
+    ASSERT_FALSE(lamp.isVisibleIn(&room));
+    ASSERT_TRUE(sack.isReachableIn(&room));
+
+    // Opening it exposes the lamp to the room, through both containers
+    sack.setFlag(ObjectFlag::OPENBIT);
+    ASSERT_EQ(lamp.getSeenFrom(), &room);
+    ASSERT_EQ(lamp.getReachedFrom(), &room);
+    ASSERT_TRUE(lamp.isVisibleIn(&boat));
+    ASSERT_TRUE(lamp.isReachableIn(&sack));
+
+    // Transparent but closed: seen, not reached
+    sack.clearFlag(ObjectFlag::OPENBIT);
+    sack.setFlag(ObjectFlag::TRANSBIT);
+    ASSERT_TRUE(lamp.isVisibleIn(&room));
+    ASSERT_FALSE(lamp.isReachableIn(&room));
+    ASSERT_EQ(lamp.getReachedFrom(), &sack);
+
+    // Moving the boat carries the scope of everything in it
+    ZObject river(5, "river");
+    boat.moveTo(&river);
+    ASSERT_EQ(lamp.getSeenFrom(), &river);
+    ASSERT_FALSE(lamp.isVisibleIn(&room));
+
+    // A sibling container is not on the way up
+    ZObject bag(6, "bag");
+    bag.setFlag(ObjectFlag::CONTBIT);
+    bag.setFlag(ObjectFlag::OPENBIT);
+    bag.moveTo(&boat);
+    ASSERT_FALSE(lamp.isVisibleIn(&bag));
+
+    // Moved inside itself (a broken state Explorer reports), it still settles
+    boat.moveTo(&sack);
+    ASSERT_EQ(boat.getSeenFrom(), &sack);
+    ASSERT_FALSE(lamp.isVisibleIn(&room));
+}
+
+TEST(ObjectWeightFollowsContents) {
+    ZObject player(1, "player"), sack(2, "sack"), lunch(3, "lunch"), garlic(4, "garlic");
+    sack.setProperty(P_SIZE, 9);
+    lunch.setProperty(P_SIZE, 5);
+    garlic.setProperty(P_SIZE, 4);
+    lunch.moveTo(&sack);
+    sack.moveTo(&player);
+    ASSERT_EQ(sack.getWeight(), 14);
+    ASSERT_EQ(player.getContentsWeight(), 14);
+
+    // Nested moves and size changes reach every container above
+    garlic.moveTo(&sack);
+    ASSERT_EQ(player.getContentsWeight(), 18);
+    lunch.setProperty(P_SIZE, 1);
+    ASSERT_EQ(sack.getContentsWeight(), 5);
+    ASSERT_EQ(player.getWeight(), 14);
+    garlic.removeProperty(P_SIZE);
+    ASSERT_EQ(player.getContentsWeight(), 10);
+
+    lunch.restoreLocation(&player, 0);
+    ASSERT_EQ(sack.getContentsWeight(), 0);
+    ASSERT_EQ(player.getContentsWeight(), 10);
+    sack.moveTo(nullptr);
+    ASSERT_EQ(player.getContentsWeight(), 1);
 }
 
 // Test object creation and destruction
@@ -373,7 +530,7 @@ TEST(ObjectCreationLongDescription) {
     std::string longDesc(1000, 'x');
     ZObject obj(1, longDesc);
     
-    ASSERT_EQ(obj.getDesc(), longDesc);
+    ASSERT_EQ(obj.getDesc(), std::string_view(longDesc));
 }
 
 TEST(ObjectCreationInitialState) {
@@ -80,7 +80,7 @@ TEST(PaintingFcn_MungChangesDescription) {
   paintingAction();
 
   // Verify LDESC changed to "worthless piece of canvas"
-  std::string ldesc = painting->getLongDesc();
+  std::string ldesc(painting->getLongDesc());
   ASSERT_TRUE(ldesc.find("worthless") != std::string::npos);
   ASSERT_TRUE(ldesc.find("canvas") != std::string::npos);
 }
@@ -3,6 +3,7 @@
 // Requirements: 86 - Command response time <10ms
 
 #include "test_framework.h"
+#include "core/engine.h"
 #include "core/globals.h"
 #include "core/io.h"
 #include "parser/parser.h"
@@ -11,10 +12,8 @@
 #include "world/rooms.h"
 #include "verbs/verbs.h"
 #include "systems/timer.h"
-#include "systems/npc.h"
-#include "systems/lamp.h"
-#include "systems/candle.h"
-#include "systems/sword.h"
+#include "systems/undo.h"
+#include "systems/vec_env.h"
 #include <chrono>
 #include <iostream>
 #include <sstream>
@@ -97,13 +96,7 @@ public:
 void initializeForPerformanceTest() {
     auto& g = Globals::instance();
     g.reset();
-    initializeWorld();
-    NPCSystem::initializeThief();
-    NPCSystem::initializeTroll();
-    NPCSystem::initializeCyclops();
-    LampSystem::initialize();
-    CandleSystem::initialize();
-    SwordSystem::initialize();
+    Engine::initialize();
 }
 
 // Test: Parser tokenization performance
@@ -502,6 +495,133 @@ TEST(PerformanceSummary) {
     std::cout << "========================================\n";
 }
 
+// Test: UNDO step performance (journal rollback of one turn)
+TEST(UndoStepPerformance) {
+    initializeForPerformanceTest();
+    auto& g = Globals::instance();
+    
+    std::cout << "\n=== Undo Step Performance ===\n";
+    
+    setSuppressOutput(true);
+    
+    // Journal a typical turn (move + timers) and time only its rollback
+    const int iterations = 1000;
+    std::vector<double> times;
+    times.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        UndoSystem::beginTurn();
+        Verbs::vWalkDir(Direction::NORTH);
+        g.moves++;
+        TimerSystem::tick();
+        UndoSystem::endTurn();
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        UndoSystem::undo(1);
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    
+    setSuppressOutput(false);
+    
+    double avg = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    PerformanceProfiler::Measurement m1{"UNDO one turn (walk + timers)", avg,
+        *std::min_element(times.begin(), times.end()),
+        *std::max_element(times.begin(), times.end()), iterations};
+    PerformanceProfiler::printMeasurement(m1);
+    
+    // The rollback must leave the world where it started
+    ASSERT_EQ(g.here, g.getObject(RoomIds::WEST_OF_HOUSE));
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_TRUE(m1.avgMicroseconds < 10000);
+}
+
+// Test: Dry-run command performance
+TEST(TryStepPerformance) {
+    initializeForPerformanceTest();
+    auto& g = Globals::instance();
+    
+    std::cout << "\n=== Dry-Run Performance ===\n";
+    
+    // Full turn (parse, verb, timers, NPCs) plus rollback
+    auto m1 = PerformanceProfiler::measure("tryStep (north)", [&]() {
+        Engine::tryStep("north");
+    }, 1000);
+    PerformanceProfiler::printMeasurement(m1);
+    
+    auto m2 = PerformanceProfiler::measure("trySequence (5 commands)", [&]() {
+        Engine::trySequence({"north", "east", "open window", "enter window", "west"});
+    }, 200);
+    PerformanceProfiler::printMeasurement(m2);
+    
+    ASSERT_EQ(g.here, g.getObject(RoomIds::WEST_OF_HOUSE));
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_TRUE(m1.avgMicroseconds < 10000);
+    ASSERT_TRUE(m2.avgMicroseconds < 10000);
+}
+
+// Test: Valid-action generation performance
+TEST(ValidActionsPerformance) {
+    initializeForPerformanceTest();
+    auto& g = Globals::instance();
+    
+    std::cout << "\n=== Valid-Action Generation ===\n";
+    
+    size_t candidates = 0;
+    auto m1 = PerformanceProfiler::measure("enumerate (candidates)", [&]() {
+        candidates = Engine::validActions().size();
+    }, 1000);
+    PerformanceProfiler::printMeasurement(m1);
+    
+    // One dry run per candidate
+    size_t kept = 0;
+    auto m2 = PerformanceProfiler::measure("validActions (no-ops dropped)", [&]() {
+        kept = Engine::validActions(true).size();
+    }, 20);
+    PerformanceProfiler::printMeasurement(m2);
+    std::cout << "  " << candidates << " candidates, " << kept << " change the state\n";
+    
+    ASSERT_EQ(g.here, g.getObject(RoomIds::WEST_OF_HOUSE));
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_TRUE(kept > 0 && kept < candidates);
+    ASSERT_TRUE(m1.avgMicroseconds < 10000);
+}
+
+// Test: Batched session throughput
+TEST(VecEnvThroughput) {
+    std::cout << "\n=== VecEnv Throughput ===\n";
+    
+    const std::vector<std::string> commands = {
+        "north", "east", "south", "west", "open mailbox", "take leaflet",
+        "drop leaflet", "up", "take egg", "down", "wait", "look"};
+    
+    for (size_t sessions : {1u, 4u}) {
+        VecEnv::Options options;
+        options.sessions = sessions;
+        options.maxEpisodeSteps = 100;
+        options.captureOutput = false;
+        VecEnv env(options);
+        
+        std::vector<std::string> actions(sessions);
+        const int batches = 2000;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int b = 0; b < batches; ++b) {
+            for (size_t i = 0; i < sessions; ++i) {
+                actions[i] = commands[(b * 7 + i * 5) % commands.size()];
+            }
+            const auto& batch = env.step(actions);
+            if (batch.done[0]) {
+                env.reset();
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double rate = static_cast<double>(batches * sessions) / seconds;
+        std::cout << "  " << sessions << " session(s): " << std::fixed << std::setprecision(0)
+                  << rate << " steps/s\n";
+        ASSERT_TRUE(rate > 1000);
+    }
+}
+
 int main() {
     std::cout << "========================================\n";
     std::cout << "  Zork I Performance Profiling Tests\n";
@@ -174,6 +174,7 @@ void testObjectSerialization() {
     // Modify object
     objPtr->clearFlag(ObjectFlag::TAKEBIT);
     objPtr->setProperty(1, 99);
+    objPtr->setProperty(3, 7);  // not in the save
     objPtr->setText("");
     
     // Restore
@@ -192,6 +193,8 @@ void testObjectSerialization() {
                 "Object VALUE property should be restored");
     TEST_ASSERT(objPtr->getText() == "Test text content",
                 "Object text should be restored");
+    TEST_ASSERT(!objPtr->getAllProperties().contains(3),
+                "Property set after the save should be removed");
     
     cleanupTestFile();
     std::cout << "✓ Object serialization test passed" << std::endl;
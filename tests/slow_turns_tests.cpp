@@ -0,0 +1,184 @@
+// Slow Turns Tests
+// Incident ring, incident files and reproducing the state of a slow turn
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/random.h"
+#include "systems/slow_turns.h"
+#include "systems/state_hash.h"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+// Play a command with output discarded
+static StepResult play(const std::string& command) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    StepResult result = Engine::step(command);
+    std::cout.rdbuf(old);
+    return result;
+}
+
+// An empty ring directory
+static std::string freshDirectory() {
+    auto dir = std::filesystem::temp_directory_path() / "slow_turns_tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+// Record every turn (threshold 0) into a ring of capacity slots
+static std::string recordEverything(size_t capacity) {
+    SlowTurns::Options options;
+    options.directory = freshDirectory();
+    options.thresholdNs = 0;
+    options.capacity = capacity;
+    SlowTurns::enable(options);
+    return options.directory;
+}
+
+TEST(IncidentRoundTrip) {
+    SlowTurns::Incident incident;
+    incident.sequence = 7;
+    incident.command = "kill troll with sword";
+    incident.turnNs = 123456789;
+    incident.phaseNs = {1, 2, 3, 4};
+    incident.seed = 42;
+    incident.openingLook = true;
+    incident.history = {"open mailbox", "take leaflet"};
+    incident.random = "16807";
+    incident.hashBefore = 0xdeadbeefcafef00dull;
+    incident.hashAfter = 0x0123456789abcdefull;
+    incident.moves = 2;
+    incident.room = 5;
+
+    std::stringstream file;
+    incident.write(file);
+    auto read = SlowTurns::Incident::read(file);
+    ASSERT_TRUE(read.has_value());
+    ASSERT_EQ(read->sequence, 7u);
+    ASSERT_EQ(read->command, incident.command);
+    ASSERT_EQ(read->turnNs, incident.turnNs);
+    ASSERT_TRUE(read->phaseNs == incident.phaseNs);
+    ASSERT_EQ(read->seed, 42u);
+    ASSERT_TRUE(read->openingLook);
+    ASSERT_TRUE(read->history == incident.history);
+    ASSERT_EQ(read->random, incident.random);
+    ASSERT_EQ(read->hashBefore, incident.hashBefore);
+    ASSERT_EQ(read->hashAfter, incident.hashAfter);
+    ASSERT_EQ(read->moves, 2);
+    ASSERT_EQ(read->room, 5);
+
+    std::stringstream garbage("not an incident\n");
+    ASSERT_FALSE(SlowTurns::Incident::read(garbage).has_value());
+}
+
+TEST(RingKeepsNewestIncidents) {
+    std::string dir = recordEverything(3);
+    Engine::newGame(1);
+    for (const char* command : {"open mailbox", "take leaflet", "north", "east", "wait"}) {
+        play(command);
+    }
+    SlowTurns::disable();
+
+    ASSERT_EQ(SlowTurns::written(), 5u);
+    auto incidents = SlowTurns::list(dir);
+    ASSERT_EQ(incidents.size(), 3u);
+    ASSERT_EQ(incidents[0].sequence, 2u);
+    ASSERT_EQ(incidents[0].command, std::string("north"));
+    ASSERT_EQ(incidents[2].command, std::string("wait"));
+    ASSERT_EQ(incidents[2].history.size(), 4u);
+    ASSERT_EQ(incidents[2].seed, 1u);
+    ASSERT_TRUE(incidents[2].phaseNs[static_cast<size_t>(SlowTurns::Phase::PARSE)] > 0);
+    ASSERT_TRUE(incidents[2].turnNs > 0);
+}
+
+TEST(NumberingContinuesAcrossEnables) {
+    std::string dir = recordEverything(4);
+    Engine::newGame(1);
+    play("wait");
+    play("wait");
+
+    SlowTurns::Options options;
+    options.directory = dir;
+    options.thresholdNs = 0;
+    options.capacity = 4;
+    SlowTurns::enable(options);
+    Engine::newGame(1);
+    play("look");
+    SlowTurns::disable();
+
+    auto incidents = SlowTurns::list(dir);
+    ASSERT_EQ(incidents.size(), 3u);
+    ASSERT_EQ(incidents.back().sequence, 2u);
+    ASSERT_EQ(incidents.back().command, std::string("look"));
+}
+
+TEST(NothingRecordedWithoutKnownHistory) {
+    std::string dir = recordEverything(8);
+    play("wait"); // game started before enable()
+    Engine::newGame(1);
+    Engine::tryStep("open mailbox"); // dry runs are not turns
+    play("open mailbox");
+    SlowTurns::disable();
+    play("wait");
+
+    auto incidents = SlowTurns::list(dir);
+    ASSERT_EQ(incidents.size(), 1u);
+    ASSERT_EQ(incidents[0].command, std::string("open mailbox"));
+    ASSERT_TRUE(incidents[0].history.empty());
+}
+
+TEST(SlowTurnsBelowThresholdAreNotWritten) {
+    SlowTurns::Options options;
+    options.directory = freshDirectory();
+    options.thresholdNs = 60'000'000'000ull; // a minute
+    SlowTurns::enable(options);
+    Engine::newGame(1);
+    play("open mailbox");
+    SlowTurns::disable();
+    ASSERT_EQ(SlowTurns::written(), 0u);
+    ASSERT_TRUE(SlowTurns::list(options.directory).empty());
+}
+
+TEST(IncidentReproducesState) {
+    std::string dir = recordEverything(16);
+    Engine::newGame(7);
+    for (const char* command : {"open mailbox", "north", "east", "open window",
+                                "enter window", "take all", "west", "move rug"}) {
+        play(command);
+    }
+    SlowTurns::disable();
+    auto incidents = SlowTurns::list(dir);
+    ASSERT_EQ(incidents.size(), 8u);
+    const auto& last = incidents.back();
+
+    // Another game in between, then back to the recorded state
+    Engine::newGame(99);
+    play("wait");
+    Engine::newGame(last.seed);
+    for (const auto& command : last.history) {
+        play(command);
+    }
+    std::ostringstream random;
+    random << Random::engine();
+    ASSERT_EQ(random.str(), last.random);
+    ASSERT_EQ(StateHash::current(), last.hashBefore);
+    ASSERT_EQ(play(last.command).stateHash, last.hashAfter);
+    std::filesystem::remove_all(dir);
+}
+
+int main() {
+    std::cout << "Running Slow Turns Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
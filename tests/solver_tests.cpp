@@ -0,0 +1,162 @@
+// Solver Tests
+// Parallel breadth-first search over game states
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "systems/score.h"
+#include "systems/solver.h"
+#include "systems/state_hash.h"
+#include "systems/timer.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+static bool inRoom(ObjectId room) {
+    ZObject* here = Globals::instance().here;
+    return here && here->getId() == room;
+}
+
+// Play commands from a new game with output discarded
+static void replay(const std::vector<std::string>& commands, uint32_t seed = 1) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    Engine::newGame(seed);
+    for (const auto& c : commands) {
+        Engine::step(c);
+    }
+    std::cout.rdbuf(old);
+}
+
+static bool carrying(ObjectId obj) {
+    auto& g = Globals::instance();
+    ZObject* o = g.getObject(obj);
+    return o && o->getLocation() == g.winner;
+}
+
+TEST(FindsShortestRouteToGoal) {
+    Solver::Options options;
+    options.goal = []() { return carrying(ObjectIds::EGG); };
+    options.threads = 2;
+
+    Solver::Result result = Solver::solve(options);
+    ASSERT_TRUE(result.outcome == Solver::Outcome::FOUND);
+    // Into the forest, up the tree, take the egg
+    ASSERT_EQ(result.route.size(), 4u);
+    ASSERT_EQ(result.route.back(), std::string("take egg"));
+    ASSERT_EQ(result.depth, 4);
+
+    replay(result.route);
+    ASSERT_TRUE(carrying(ObjectIds::EGG));
+}
+
+TEST(RouteLengthIndependentOfThreadCount) {
+    Solver::Options options;
+    options.goal = []() { return carrying(ObjectIds::ADVERTISEMENT); };
+
+    options.threads = 1;
+    Solver::Result one = Solver::solve(options);
+    options.threads = 4;
+    Solver::Result four = Solver::solve(options);
+
+    ASSERT_TRUE(one.outcome == Solver::Outcome::FOUND);
+    ASSERT_TRUE(four.outcome == Solver::Outcome::FOUND);
+    ASSERT_EQ(one.route.size(), 2u); // open mailbox, take leaflet
+    ASSERT_EQ(four.route.size(), one.route.size());
+}
+
+TEST(StartStateAndScoreGoal) {
+    // From the top of the tree, the first points come from putting the
+    // egg in the trophy case
+    const std::vector<std::string> start = {"north", "north", "up"};
+    Solver::Options options;
+    options.start = Solver::startAfter(start);
+    options.targetScore = 1;
+    options.threads = 2;
+
+    Solver::Result result = Solver::solve(options);
+    ASSERT_TRUE(result.outcome == Solver::Outcome::FOUND);
+    ASSERT_EQ(result.route.front(), std::string("take egg"));
+
+    std::vector<std::string> full = start;
+    full.insert(full.end(), result.route.begin(), result.route.end());
+    replay(full);
+    ASSERT_TRUE(ScoreSystem::instance().getScore() >= 1);
+}
+
+TEST(ProvesGoalUnreachable) {
+    // With no timers running and only NORTH and SOUTH, the kitchen is out
+    // of reach: the search runs out of states
+    Solver::Options options;
+    options.start = []() { TimerSystem::TimerManager::instance().clear(); };
+    options.actions = []() { return std::vector<std::string>{"north", "south"}; };
+    options.goal = []() { return inRoom(RoomIds::KITCHEN); };
+    options.threads = 3;
+
+    Solver::Result result = Solver::solve(options);
+    ASSERT_TRUE(result.outcome == Solver::Outcome::UNWINNABLE);
+    ASSERT_TRUE(result.route.empty());
+    ASSERT_TRUE(result.statesSeen > 2);
+    ASSERT_EQ(result.statesSeen, result.statesExpanded);
+
+    // With the thief wandering the state space is far larger
+    options.start = nullptr;
+    options.maxDepth = 10;
+    result = Solver::solve(options);
+    ASSERT_TRUE(result.outcome == Solver::Outcome::LIMIT);
+    ASSERT_EQ(result.depth, 10);
+}
+
+TEST(StopsAtStateLimit) {
+    Solver::Options options;
+    options.threads = 2;
+    options.maxStates = 50;
+
+    Solver::Result result = Solver::solve(options);
+    ASSERT_TRUE(result.outcome == Solver::Outcome::LIMIT);
+    ASSERT_TRUE(result.statesSeen >= 50);
+}
+
+TEST(CallerGameUntouched) {
+    replay({"north", "east"});
+    uint64_t before = StateHash::current();
+
+    Solver::Options options;
+    options.goal = []() { return inRoom(RoomIds::LIVING_ROOM); };
+    options.threads = 2;
+    Solver::Result result = Solver::solve(options);
+
+    ASSERT_TRUE(result.outcome == Solver::Outcome::FOUND);
+    ASSERT_EQ(StateHash::current(), before);
+    ASSERT_TRUE(inRoom(RoomIds::BEHIND_HOUSE));
+}
+
+TEST(BasicActionsCoverExitsAndObjects) {
+    replay({});
+    auto actions = Solver::basicActions();
+    auto has = [&](const std::string& a) {
+        return std::find(actions.begin(), actions.end(), a) != actions.end();
+    };
+    ASSERT_TRUE(has("north"));
+    ASSERT_TRUE(has("south"));
+    ASSERT_TRUE(has("open mailbox"));
+    ASSERT_FALSE(has("take leaflet")); // inside the closed mailbox
+}
+
+int main() {
+    std::cout << "Running Solver Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
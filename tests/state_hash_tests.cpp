@@ -0,0 +1,165 @@
+// State Hash Tests
+// Incremental Zobrist hash and divergence bisect
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "systems/score.h"
+#include "systems/state_hash.h"
+#include "systems/timer.h"
+#include "systems/undo.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <iostream>
+#include <sstream>
+
+// Play a command with output discarded
+static StepResult play(const std::string& command) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    StepResult result = Engine::step(command);
+    std::cout.rdbuf(old);
+    return result;
+}
+
+TEST(IncrementalHashMatchesFullScan) {
+    Engine::newGame(1);
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+
+    for (const char* command : {"open mailbox", "take leaflet", "north", "east",
+                                "open window", "enter window", "take all",
+                                "west", "move rug", "open trap door", "wait"}) {
+        play(command);
+        ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+    }
+}
+
+TEST(MutationAndReverseRestoreHash) {
+    Engine::newGame(1);
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+    ZObject* home = lamp->getLocation();
+    uint64_t start = StateHash::current();
+
+    lamp->setFlag(ObjectFlag::ONBIT);
+    ASSERT_TRUE(StateHash::current() != start);
+    lamp->clearFlag(ObjectFlag::ONBIT);
+    ASSERT_EQ(StateHash::current(), start);
+
+    lamp->moveTo(g.winner);
+    ASSERT_TRUE(StateHash::current() != start);
+    lamp->moveTo(home);
+    ASSERT_EQ(StateHash::current(), start);
+
+    int size = lamp->getProperty(P_SIZE);
+    lamp->setProperty(P_SIZE, size + 1);
+    ASSERT_TRUE(StateHash::current() != start);
+    lamp->setProperty(P_SIZE, size);
+    ASSERT_EQ(StateHash::current(), start);
+
+    lamp->setProperty(P_TVALUE, 3);
+    lamp->removeProperty(P_TVALUE);
+    ASSERT_EQ(StateHash::current(), start);
+}
+
+TEST(TimerAndScoreChangesAreHashed) {
+    Engine::newGame(1);
+    uint64_t start = StateHash::incremental();
+
+    TimerSystem::queueTimer("I-THIEF", 9);
+    ASSERT_TRUE(StateHash::incremental() != start);
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+
+    ScoreSystem::instance().addScore(5);
+    ScoreSystem::instance().markTreasureScored(ObjectIds::EGG);
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+
+    TimerSystem::registerTimer("HASH-TEST", 3, []() {});
+    TimerSystem::tick();
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+}
+
+TEST(ClockIsExcludedFromCycleHash) {
+    Engine::newGame(1);
+    auto& g = Globals::instance();
+    uint64_t full = StateHash::current();
+    uint64_t cycle = StateHash::currentIgnoringClock();
+
+    g.moves++;
+    ASSERT_TRUE(StateHash::current() != full);
+    ASSERT_EQ(StateHash::currentIgnoringClock(), cycle);
+}
+
+TEST(UndoAndDryRunRestoreHash) {
+    Engine::newGame(1);
+    play("north");
+    uint64_t before = StateHash::current();
+
+    play("east");
+    play("open window");
+    ASSERT_TRUE(StateHash::current() != before);
+    UndoSystem::undo(2);
+    ASSERT_EQ(StateHash::current(), before);
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+
+    StepResult result = Engine::tryStep("east");
+    ASSERT_TRUE(result.stateHash != before);
+    ASSERT_EQ(StateHash::current(), before);
+}
+
+TEST(SameLogGivesSameTrace) {
+    const std::vector<std::string> commands = {
+        "north", "east", "open window", "enter window", "west", "take all",
+        "wait", "wait", "wait", "east", "up", "wait"};
+
+    std::vector<uint64_t> first, second;
+    Engine::newGame(7);
+    for (const auto& c : commands) first.push_back(play(c).stateHash);
+    Engine::newGame(7);
+    for (const auto& c : commands) second.push_back(play(c).stateHash);
+
+    ASSERT_TRUE(first == second);
+    ASSERT_EQ(StateHash::firstDivergence(first, second), commands.size());
+}
+
+TEST(BisectFindsFirstDivergence) {
+    std::vector<uint64_t> a = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<uint64_t> b = {1, 2, 3, 4, 9, 9, 9, 9};
+    ASSERT_EQ(StateHash::firstDivergence(a, b), 4u);
+    ASSERT_EQ(StateHash::firstDivergence(a, a), 8u);
+    ASSERT_EQ(StateHash::firstDivergence({}, a), 0u);
+    ASSERT_EQ(StateHash::firstDivergence(a, {0, 0, 0}), 0u);
+
+    size_t probes = 0;
+    size_t found = StateHash::bisect(1000, [&](size_t i) {
+        probes++;
+        return i >= 617;
+    });
+    ASSERT_EQ(found, 617u);
+    ASSERT_TRUE(probes <= 11);
+}
+
+TEST(ResetClearsObjectKeys) {
+    Engine::newGame(1);
+    play("north");
+    Globals::instance().reset();
+    ScoreSystem::instance().reset();
+    ASSERT_EQ(StateHash::incremental(), StateHash::scanIncremental());
+    ASSERT_EQ(StateHash::incremental(), 0u);
+}
+
+int main() {
+    std::cout << "Running State Hash Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
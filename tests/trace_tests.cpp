@@ -0,0 +1,131 @@
+// Trace Tests
+// Chrome trace-event export of turn phases (built with ZORK_TRACE)
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "systems/trace.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// Play a command with output discarded
+static StepResult play(const std::string& command) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    StepResult result = Engine::step(command);
+    std::cout.rdbuf(old);
+    return result;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static size_t countOf(const std::string& text, const std::string& what) {
+    size_t n = 0;
+    for (size_t at = text.find(what); at != std::string::npos; at = text.find(what, at + 1)) {
+        n++;
+    }
+    return n;
+}
+
+TEST(TraceHasOneSlicePerPhase) {
+    std::string path = "trace_tests.json";
+    Engine::newGame(1);
+    ASSERT_TRUE(Trace::start(path));
+    ASSERT_TRUE(Trace::active());
+    play("open mailbox");
+    play("take leaflet");
+    {
+        ZORK_TRACE_SCOPE("quoted", "say \"hello\"");
+    }
+    Trace::stop();
+    ASSERT_FALSE(Trace::active());
+
+    std::string text = readFile(path);
+    ASSERT_EQ(text.substr(0, 2), std::string("[\n"));
+    ASSERT_EQ(text.substr(text.size() - 3), std::string("\n]\n"));
+    ASSERT_EQ(countOf(text, "{\"name\":\"turn\""), 2u);
+    ASSERT_CONTAINS(text, "\"args\":{\"arg\":\"open mailbox\"}");
+    ASSERT_CONTAINS(text, "\"args\":{\"arg\":\"say \\\"hello\\\"\"}"); // escaped
+    for (const char* phase : {"tokenize", "verb lookup", "resolve objects", "verb handler",
+                              "timers", "troll turn", "cyclops turn"}) {
+        ASSERT_TRUE(countOf(text, std::string("{\"name\":\"") + phase + "\"") >= 2);
+    }
+    ASSERT_CONTAINS(text, "{\"name\":\"I-CANDLES\""); // fires every turn
+    ASSERT_CONTAINS(text, "\"ph\":\"X\"");
+    std::remove(path.c_str());
+}
+
+TEST(NothingRecordedWhenStopped) {
+    std::string path = "trace_tests_stopped.json";
+    Engine::newGame(1);
+    ASSERT_TRUE(Trace::start(path));
+    Trace::stop();
+    play("open mailbox"); // not traced
+
+    std::string text = readFile(path);
+    ASSERT_NOT_CONTAINS(text, "\"name\"");
+
+    // Restarting does not pick up anything from before
+    ASSERT_TRUE(Trace::start(path));
+    Trace::stop();
+    ASSERT_NOT_CONTAINS(readFile(path), "\"name\"");
+    std::remove(path.c_str());
+}
+
+TEST(ThreadsGetTheirOwnTrack) {
+    std::string path = "trace_tests_threads.json";
+    ASSERT_TRUE(Trace::start(path));
+    {
+        ZORK_TRACE_SCOPE("main thread");
+    }
+    std::thread worker([]() {
+        ZORK_TRACE_SCOPE("worker thread");
+    });
+    worker.join(); // its events are written when it exits
+    Trace::stop();
+
+    std::string text = readFile(path);
+    ASSERT_CONTAINS(text, "\"main thread\"");
+    ASSERT_CONTAINS(text, "\"worker thread\"");
+    size_t mainTid = text.find("\"tid\":", text.find("\"main thread\""));
+    size_t workerTid = text.find("\"tid\":", text.find("\"worker thread\""));
+    ASSERT_TRUE(text.substr(mainTid, 8) != text.substr(workerTid, 8));
+    std::remove(path.c_str());
+}
+
+TEST(LargeTraceFlushesInBlocks) {
+    std::string path = "trace_tests_large.json";
+    Engine::newGame(1);
+    ASSERT_TRUE(Trace::start(path));
+    for (int i = 0; i < 200; ++i) {
+        play(i % 2 ? "open mailbox" : "close mailbox");
+    }
+    Trace::stop();
+
+    std::string text = readFile(path);
+    ASSERT_EQ(countOf(text, "{\"name\":\"turn\""), 200u);
+    ASSERT_EQ(countOf(text, "},\n{"), countOf(text, "\"ph\":\"X\"") - 1);
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "Running Trace Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,210 @@
+// Undo System Tests
+// Per-turn undo journal and the UNDO verb
+
+#include "test_framework.h"
+#include "core/globals.h"
+#include "core/object.h"
+#include "world/world.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include "verbs/verbs.h"
+#include "systems/npc.h"
+#include "systems/score.h"
+#include "systems/timer.h"
+#include "systems/undo.h"
+#include <iostream>
+#include <sstream>
+
+// Fresh world with an empty journal
+static void setupWorld() {
+    auto& g = Globals::instance();
+    g.reset();
+    ScoreSystem::instance().reset();
+    initializeWorld();
+    UndoSystem::UndoJournal::instance().setMemoryLimit(
+        UndoSystem::UndoJournal::DEFAULT_MEMORY_LIMIT);
+}
+
+// Run a verb handler with output captured
+static std::string runVerb(bool (*handler)()) {
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    handler();
+    std::cout.rdbuf(old);
+    return buffer.str();
+}
+
+TEST(UndoRestoresObjectLocationAndOrder) {
+    setupWorld();
+    auto& g = Globals::instance();
+    ZObject* kitchen = g.getObject(RoomIds::KITCHEN);
+    ZObject* sack = g.getObject(ObjectIds::SACK);
+    ASSERT_TRUE(kitchen != nullptr && sack != nullptr);
+
+    auto contentsOf = [](ZObject* obj) {
+        return std::vector<ZObject*>(obj->getContents().begin(), obj->getContents().end());
+    };
+    auto before = contentsOf(kitchen);
+    ZObject* oldLocation = sack->getLocation();
+
+    UndoSystem::beginTurn();
+    sack->moveTo(g.winner);
+    UndoSystem::endTurn();
+    ASSERT_EQ(sack->getLocation(), g.winner);
+
+    ASSERT_EQ(UndoSystem::undo(1), 1u);
+    ASSERT_EQ(sack->getLocation(), oldLocation);
+    if (oldLocation == kitchen) {
+        ASSERT_TRUE(contentsOf(kitchen) == before);
+    }
+}
+
+TEST(UndoRestoresFlagsAndProperties) {
+    setupWorld();
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+    ASSERT_TRUE(lamp != nullptr);
+
+    bool wasOn = lamp->hasFlag(ObjectFlag::ONBIT);
+    int size = lamp->getProperty(P_SIZE);
+    size_t propertyCount = lamp->getAllProperties().size();
+
+    UndoSystem::beginTurn();
+    lamp->setFlag(ObjectFlag::ONBIT);
+    lamp->setProperty(P_SIZE, size + 10);
+    lamp->setProperty(P_TVALUE, 7);
+    UndoSystem::endTurn();
+
+    UndoSystem::undo(1);
+    ASSERT_EQ(lamp->hasFlag(ObjectFlag::ONBIT), wasOn);
+    ASSERT_EQ(lamp->getProperty(P_SIZE), size);
+    ASSERT_EQ(lamp->getAllProperties().size(), propertyCount);
+}
+
+TEST(UndoRestoresGlobalsScoreAndTimers) {
+    setupWorld();
+    auto& g = Globals::instance();
+    auto& score = ScoreSystem::instance();
+
+    int fires = 0;
+    TimerSystem::registerTimer("UNDO-TEST", 2, [&fires]() { fires++; });
+    auto* timer = TimerSystem::TimerManager::instance().findTimer("UNDO-TEST");
+    ASSERT_TRUE(timer != nullptr);
+
+    ZObject* start = g.here;
+    UndoSystem::beginTurn();
+    g.here = g.getObject(RoomIds::KITCHEN);
+    g.lampBattery -= 5;
+    g.moves++;
+    score.addScore(10);
+    score.markTreasureScored(ObjectIds::EGG);
+    NPCSystem::getTrollState().health = 1;
+    TimerSystem::tick();
+    TimerSystem::registerTimer("UNDO-NEW", 4, []() {});
+    UndoSystem::endTurn();
+
+    UndoSystem::undo(1);
+    ASSERT_EQ(g.here, start);
+    ASSERT_EQ(g.lampBattery, 330);
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_EQ(score.getScore(), 0);
+    ASSERT_FALSE(score.isTreasureScored(ObjectIds::EGG));
+    ASSERT_EQ(NPCSystem::getTrollState().health, 3);
+    ASSERT_EQ(timer->counter, 2);
+    ASSERT_TRUE(TimerSystem::TimerManager::instance().findTimer("UNDO-NEW") == nullptr);
+    ASSERT_EQ(fires, 0);
+}
+
+TEST(UndoMultipleTurns) {
+    setupWorld();
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+    ZObject* home = lamp->getLocation();
+
+    for (int i = 0; i < 3; ++i) {
+        UndoSystem::beginTurn();
+        lamp->moveTo(i % 2 == 0 ? g.winner : g.here);
+        g.moves++;
+        UndoSystem::endTurn();
+    }
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 3u);
+
+    ASSERT_EQ(UndoSystem::undo(2), 2u);
+    ASSERT_EQ(lamp->getLocation(), g.winner);
+    ASSERT_EQ(g.moves, 1);
+
+    ASSERT_EQ(UndoSystem::undo(5), 1u);
+    ASSERT_EQ(lamp->getLocation(), home);
+    ASSERT_EQ(g.moves, 0);
+    ASSERT_EQ(UndoSystem::undo(1), 0u);
+}
+
+TEST(UndoJournalRespectsMemoryLimit) {
+    setupWorld();
+    auto& journal = UndoSystem::UndoJournal::instance();
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+
+    journal.setMemoryLimit(4096);
+    for (int i = 0; i < 200; ++i) {
+        UndoSystem::beginTurn();
+        lamp->moveTo(i % 2 == 0 ? g.winner : g.here);
+        TimerSystem::tick();
+        UndoSystem::endTurn();
+    }
+    ASSERT_TRUE(journal.getMemoryUsage() <= 4096);
+    ASSERT_TRUE(journal.getTurnCount() > 0);
+    ASSERT_TRUE(journal.getTurnCount() < 200);
+}
+
+TEST(MutationsOutsideTurnAreNotJournaled) {
+    setupWorld();
+    auto& g = Globals::instance();
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+
+    lamp->moveTo(g.winner);
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 0u);
+    ASSERT_EQ(UndoSystem::undo(1), 0u);
+    ASSERT_EQ(lamp->getLocation(), g.winner);
+}
+
+TEST(UndoVerbMessages) {
+    setupWorld();
+    auto& g = Globals::instance();
+
+    std::string output = runVerb(Verbs::vUndo);
+    ASSERT_CONTAINS(output, "can't \"undo\"");
+
+    UndoSystem::beginTurn();
+    g.moves++;
+    UndoSystem::endTurn();
+    output = runVerb(Verbs::vUndo);
+    ASSERT_CONTAINS(output, "Previous turn undone.");
+    ASSERT_EQ(g.moves, 0);
+}
+
+TEST(ResetClearsJournal) {
+    setupWorld();
+    UndoSystem::beginTurn();
+    Globals::instance().moves++;
+    UndoSystem::endTurn();
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 1u);
+
+    Globals::instance().reset();
+    ASSERT_EQ(UndoSystem::UndoJournal::instance().getTurnCount(), 0u);
+}
+
+int main() {
+    std::cout << "Running Undo System Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+// VecEnv Tests
+// Batched sessions: observations, rewards, episode ends and resets
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "systems/solver.h"
+#include "systems/vec_env.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+static const int32_t* row(const VecEnv& env, size_t session) {
+    return env.last().observations.data() + session * env.observationSize();
+}
+
+static bool bitSet(const int32_t* words, size_t bit) {
+    return (static_cast<uint32_t>(words[bit / 32]) >> (bit % 32)) & 1u;
+}
+
+static bool carrying(const VecEnv& env, size_t session, ObjectId obj) {
+    const auto& ids = env.objectIds();
+    auto it = std::find(ids.begin(), ids.end(), obj);
+    return it != ids.end() && bitSet(row(env, session) + OBS_FIELD_COUNT, it - ids.begin());
+}
+
+static bool visited(const VecEnv& env, size_t session, ObjectId room) {
+    const auto& ids = env.roomIds();
+    auto it = std::find(ids.begin(), ids.end(), room);
+    const int32_t* rooms = row(env, session) + OBS_FIELD_COUNT + (env.objectIds().size() + 31) / 32;
+    return it != ids.end() && bitSet(rooms, it - ids.begin());
+}
+
+TEST(InitialObservation) {
+    VecEnv::Options options;
+    options.sessions = 3;
+    VecEnv env(options);
+
+    ASSERT_EQ(env.last().observations.size(), 3 * env.observationSize());
+    ASSERT_TRUE(!env.objectIds().empty());
+    ASSERT_TRUE(!env.roomIds().empty());
+    for (size_t i = 0; i < env.sessions(); ++i) {
+        ASSERT_EQ(row(env, i)[OBS_ROOM], static_cast<int32_t>(RoomIds::WEST_OF_HOUSE));
+        ASSERT_EQ(row(env, i)[OBS_SCORE], 0);
+        ASSERT_EQ(row(env, i)[OBS_MOVES], 0);
+        ASSERT_EQ(row(env, i)[OBS_LAMP_BATTERY], 330);
+        ASSERT_EQ(static_cast<int>(env.last().done[i]), 0);
+    }
+}
+
+TEST(SessionsAreIndependent) {
+    VecEnv::Options options;
+    options.sessions = 3;
+    VecEnv env(options);
+
+    const auto& batch = env.step({"north", "south", "open mailbox"});
+    ASSERT_EQ(row(env, 0)[OBS_ROOM], static_cast<int32_t>(RoomIds::NORTH_OF_HOUSE));
+    ASSERT_EQ(row(env, 1)[OBS_ROOM], static_cast<int32_t>(RoomIds::SOUTH_OF_HOUSE));
+    ASSERT_EQ(row(env, 2)[OBS_ROOM], static_cast<int32_t>(RoomIds::WEST_OF_HOUSE));
+    ASSERT_TRUE(batch.output[0].find("North of House") != std::string::npos);
+    ASSERT_TRUE(batch.output[2].find("leaflet") != std::string::npos);
+    ASSERT_TRUE(visited(env, 0, RoomIds::NORTH_OF_HOUSE));
+    ASSERT_FALSE(visited(env, 1, RoomIds::NORTH_OF_HOUSE));
+
+    env.step({"wait", "wait", "take leaflet"});
+    ASSERT_TRUE(carrying(env, 2, ObjectIds::ADVERTISEMENT));
+    ASSERT_FALSE(carrying(env, 0, ObjectIds::ADVERTISEMENT));
+    ASSERT_EQ(row(env, 2)[OBS_MOVES], 2);
+}
+
+TEST(RewardIsScoreChange) {
+    VecEnv::Options options;
+    options.sessions = 2;
+    VecEnv env(options);
+
+    const std::vector<std::string> route = {
+        "north", "north", "up", "take egg", "down", "south", "east",
+        "open window", "west", "west", "open case", "put egg in case"};
+    int total = 0;
+    for (const auto& command : route) {
+        const auto& batch = env.step({command, "wait"});
+        total += batch.reward[0];
+        ASSERT_EQ(batch.reward[1], 0);
+    }
+    ASSERT_EQ(env.last().reward[0], 5);
+    ASSERT_EQ(total, row(env, 0)[OBS_SCORE]);
+}
+
+TEST(ResetReturnsToTemplate) {
+    VecEnv::Options options;
+    options.sessions = 2;
+    options.start = Solver::startAfter({"open mailbox"});
+    VecEnv env(options);
+    std::vector<int32_t> initial = env.last().observations;
+
+    env.step({"take leaflet", "north"});
+    env.step({"south", "east"});
+    ASSERT_TRUE(env.last().observations != initial);
+
+    env.reset(1);
+    ASSERT_TRUE(carrying(env, 0, ObjectIds::ADVERTISEMENT));
+    ASSERT_TRUE(std::equal(initial.begin() + env.observationSize(), initial.end(),
+                           env.last().observations.begin() + env.observationSize()));
+
+    env.reset();
+    ASSERT_TRUE(env.last().observations == initial);
+    env.step({"take leaflet", "take leaflet"});
+    ASSERT_TRUE(carrying(env, 0, ObjectIds::ADVERTISEMENT));
+    ASSERT_TRUE(carrying(env, 1, ObjectIds::ADVERTISEMENT));
+}
+
+TEST(EpisodeStepLimit) {
+    VecEnv::Options options;
+    options.sessions = 2;
+    options.maxEpisodeSteps = 2;
+    VecEnv env(options);
+
+    env.step({"north", "north"});
+    ASSERT_EQ(static_cast<int>(env.last().done[0]), 0);
+    env.step({"east", "wait"});
+    ASSERT_EQ(static_cast<int>(env.last().done[0]), 1);
+    ASSERT_EQ(static_cast<int>(env.last().done[1]), 1);
+
+    // A finished session ignores its action until reset
+    env.step({"south", "south"});
+    ASSERT_EQ(row(env, 0)[OBS_MOVES], 2);
+    ASSERT_EQ(env.last().output[0], std::string());
+
+    env.reset(0);
+    ASSERT_EQ(static_cast<int>(env.last().done[0]), 0);
+    ASSERT_EQ(static_cast<int>(env.last().done[1]), 1);
+    env.step({"south", "south"});
+    ASSERT_EQ(row(env, 0)[OBS_ROOM], static_cast<int32_t>(RoomIds::SOUTH_OF_HOUSE));
+    ASSERT_EQ(row(env, 1)[OBS_MOVES], 2);
+}
+
+TEST(FixedSeedMatchesSingleGame) {
+    // With varySeed off every episode replays the template's random
+    // sequence, so a session plays exactly like Engine::newGame(seed)
+    const std::vector<std::string> commands = {
+        "north", "north", "up", "take egg", "down", "south", "east",
+        "open window", "west", "west", "take lamp", "turn on lamp", "open trap door", "down"};
+
+    VecEnv::Options options;
+    options.sessions = 2;
+    options.seed = 7;
+    options.varySeed = false;
+    VecEnv env(options);
+    for (int episode = 0; episode < 2; ++episode) {
+        for (const auto& command : commands) {
+            env.step({command, command});
+        }
+        ASSERT_TRUE(std::equal(row(env, 0), row(env, 1), row(env, 1)));
+        ASSERT_EQ(row(env, 0)[OBS_MOVES], static_cast<int32_t>(commands.size()));
+        env.reset();
+    }
+
+    std::stringstream buffer;
+    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    Engine::newGame(7);
+    for (const auto& command : commands) {
+        Engine::step(command);
+    }
+    std::cout.rdbuf(old);
+
+    for (const auto& command : commands) {
+        env.step({command, command});
+    }
+    auto& g = Globals::instance();
+    ASSERT_EQ(row(env, 0)[OBS_ROOM], static_cast<int32_t>(g.here->getId()));
+    ASSERT_EQ(row(env, 0)[OBS_LAMP_BATTERY], g.lampBattery);
+    ASSERT_TRUE(carrying(env, 0, ObjectIds::EGG));
+}
+
+TEST(OutputCaptureCanBeSkipped) {
+    VecEnv::Options options;
+    options.sessions = 1;
+    options.captureOutput = false;
+    VecEnv env(options);
+    const auto& batch = env.step({"north"});
+    ASSERT_EQ(batch.output[0], std::string());
+    ASSERT_EQ(row(env, 0)[OBS_ROOM], static_cast<int32_t>(RoomIds::NORTH_OF_HOUSE));
+}
+
+int main() {
+    std::cout << "Running VecEnv Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+// World Arena Tests
+// Session-owned arena for world objects: placement, teardown, heap parity
+
+#include "test_framework.h"
+#include "core/engine.h"
+#include "core/globals.h"
+#include "core/io.h"
+#include "world/objects.h"
+#include "world/rooms.h"
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+const char* const OPENING[] = {
+    "open mailbox", "take leaflet", "read leaflet", "drop leaflet", "north", "east",
+    "open window", "enter", "take sack", "open sack", "west", "take lamp", "turn on lamp",
+    "move rug", "open trap door", "down", "south", "inventory", "score",
+};
+
+// Transcript and final state hash of the opening
+std::pair<std::string, uint64_t> playOpening() {
+    std::ostringstream out;
+    setOutputStream(&out);
+    Engine::newGame(1);
+    uint64_t hash = 0;
+    for (const char* command : OPENING) {
+        hash = Engine::step(command).stateHash;
+    }
+    setOutputStream(nullptr);
+    return {out.str(), hash};
+}
+
+std::pmr::memory_resource* memoryOf(const std::pmr::string& s) {
+    return s.get_allocator().resource();
+}
+
+} // namespace
+
+TEST(WorldIsBuiltInTheArena) {
+    auto& g = Globals::instance();
+    g.setWorldArena(true);
+    Engine::newGame(1);
+
+    ZObject* lamp = g.getObject(ObjectIds::LAMP);
+    auto* livingRoom = dynamic_cast<ZRoom*>(g.getObject(RoomIds::LIVING_ROOM));
+    ASSERT_TRUE(lamp != nullptr && livingRoom != nullptr);
+
+    std::pmr::memory_resource* arena = memoryOf(lamp->getDesc());
+    ASSERT_TRUE(arena != std::pmr::get_default_resource());
+    ASSERT_TRUE(memoryOf(livingRoom->getLongDesc()) == arena);
+    ASSERT_TRUE(memoryOf(lamp->getSynonyms().front()) == arena);
+
+    // Exits copied into the table take the room's memory
+    const RoomExit* west = livingRoom->getExit(Direction::WEST);
+    ASSERT_TRUE(west != nullptr);
+    ASSERT_TRUE(memoryOf(west->message) == arena);
+}
+
+TEST(NewGameFitsInOneChunk) {
+    auto& g = Globals::instance();
+    g.setWorldArena(true);
+    Engine::newGame(1);
+    size_t bytes = g.worldArenaBytes();
+    ASSERT_TRUE(bytes >= Globals::WORLD_ARENA_BYTES); // the chunk and its bookkeeping
+    ASSERT_TRUE(bytes < 2 * Globals::WORLD_ARENA_BYTES);
+
+    // Released and taken again, not kept growing
+    Engine::newGame(2);
+    ASSERT_EQ(g.worldArenaBytes(), bytes);
+}
+
+TEST(ResetReleasesTheArena) {
+    auto& g = Globals::instance();
+    g.setWorldArena(true);
+    Engine::newGame(1);
+    ASSERT_TRUE(g.worldArenaBytes() > 0);
+    g.reset();
+    ASSERT_EQ(g.worldArenaBytes(), 0u);
+    ASSERT_TRUE(g.getAllObjects().empty());
+}
+
+TEST(HeapWorldIsOffTheArena) {
+    auto& g = Globals::instance();
+    g.setWorldArena(false);
+    Engine::newGame(1);
+    ASSERT_EQ(g.worldArenaBytes(), 0u);
+    ASSERT_TRUE(memoryOf(g.getObject(ObjectIds::LAMP)->getDesc()) ==
+                std::pmr::new_delete_resource());
+    g.setWorldArena(true);
+}
+
+TEST(ArenaAndHeapPlayTheSame) {
+    auto& g = Globals::instance();
+    g.setWorldArena(true);
+    auto arena = playOpening();
+    g.setWorldArena(false);
+    auto heap = playOpening();
+    g.setWorldArena(true);
+    ASSERT_TRUE(arena.first == heap.first);
+    ASSERT_EQ(arena.second, heap.second);
+}
+
+TEST(HeapObjectsMixWithArenaObjects) {
+    // Objects registered from make_unique are deleted, arena ones only destroyed
+    auto& g = Globals::instance();
+    g.setWorldArena(true);
+    Engine::newGame(1);
+    auto box = std::make_unique<ZObject>(9999, "test box");
+    ZObject* raw = box.get();
+    g.registerObject(9999, std::move(box));
+    raw->moveTo(g.here);
+    ASSERT_EQ(raw->getLocation(), g.here);
+    g.reset();
+    ASSERT_EQ(g.getObject(9999), nullptr);
+}
+
+int main() {
+    std::cout << "Running World Arena Tests..." << std::endl;
+
+    auto results = TestFramework::instance().runAll();
+
+    int passed = 0, failed = 0;
+    for (const auto& r : results) {
+        if (r.passed) passed++;
+        else failed++;
+    }
+
+    std::cout << "\nResults: " << passed << " passed, " << failed << " failed\n";
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+// State Bisect - find where two runs of the same command log diverge
+//
+// Usage:
+//   state_bisect trace <commands> [seed]
+//       Play the log from a new game and print one line per turn:
+//       <turn> <state hash> <command>
+//       Run this with two builds and compare the outputs.
+//
+//   state_bisect compare <traceA> <traceB>
+//       Report the first turn at which two traces disagree.
+//
+//   state_bisect roundtrip <commands> [seed]
+//       Bisect for the first turn after which a save/restore round trip
+//       changes the rest of the game. Each probe plays the log from a new
+//       game, saves and restores after turn k, plays the remaining turns
+//       and compares the final state hash with an uninterrupted run.
+//
+// The command log is a text file with one command per line; blank lines
+// and lines starting with '#' are skipped.
+
+#include "core/engine.h"
+#include "systems/save.h"
+#include "systems/state_hash.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t DEFAULT_SEED = 1;
+constexpr const char* ROUNDTRIP_FILE = "state_bisect.sav";
+
+struct TraceLine {
+    uint64_t hash = 0;
+    std::string command;
+};
+
+std::vector<std::string> readCommands(const std::string& path) {
+    std::vector<std::string> commands;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        commands.push_back(line);
+    }
+    return commands;
+}
+
+std::vector<TraceLine> readTrace(const std::string& path) {
+    std::vector<TraceLine> trace;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream ss(line);
+        size_t turn = 0;
+        std::string hex;
+        TraceLine entry;
+        if (!(ss >> turn >> hex)) {
+            continue;
+        }
+        entry.hash = std::stoull(hex, nullptr, 16);
+        std::getline(ss >> std::ws, entry.command);
+        trace.push_back(std::move(entry));
+    }
+    return trace;
+}
+
+// Play commands [first, last) with game output discarded; returns the
+// state hash after each one
+std::vector<uint64_t> play(const std::vector<std::string>& commands,
+                           size_t first, size_t last) {
+    std::ostringstream discard;
+    std::streambuf* old = std::cout.rdbuf(discard.rdbuf());
+
+    std::vector<uint64_t> hashes;
+    hashes.reserve(last - first);
+    for (size_t i = first; i < last; ++i) {
+        hashes.push_back(Engine::step(commands[i]).stateHash);
+        discard.str("");
+    }
+
+    std::cout.rdbuf(old);
+    return hashes;
+}
+
+int runTrace(const std::string& path, uint32_t seed) {
+    auto commands = readCommands(path);
+    Engine::newGame(seed);
+    auto hashes = play(commands, 0, commands.size());
+
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        std::printf("%zu %016" PRIx64 " %s\n", i + 1, hashes[i], commands[i].c_str());
+    }
+    return 0;
+}
+
+int runCompare(const std::string& pathA, const std::string& pathB) {
+    auto a = readTrace(pathA);
+    auto b = readTrace(pathB);
+
+    std::vector<uint64_t> hashesA, hashesB;
+    for (const auto& line : a) hashesA.push_back(line.hash);
+    for (const auto& line : b) hashesB.push_back(line.hash);
+
+    size_t turn = StateHash::firstDivergence(hashesA, hashesB);
+    if (turn == std::min(a.size(), b.size())) {
+        if (a.size() == b.size()) {
+            std::printf("Traces agree for all %zu turns.\n", a.size());
+            return 0;
+        }
+        std::printf("Traces agree for %zu turns, then one ends (%zu vs %zu turns).\n",
+                    turn, a.size(), b.size());
+        return 1;
+    }
+
+    std::printf("First divergence at turn %zu: %s\n", turn + 1, a[turn].command.c_str());
+    std::printf("  A: %016" PRIx64 "\n  B: %016" PRIx64 "\n", a[turn].hash, b[turn].hash);
+    return 1;
+}
+
+int runRoundtrip(const std::string& path, uint32_t seed) {
+    auto commands = readCommands(path);
+    if (commands.empty()) {
+        std::printf("No commands.\n");
+        return 0;
+    }
+
+    Engine::newGame(seed);
+    uint64_t reference = play(commands, 0, commands.size()).back();
+
+    // Does a save/restore after turn k (1-based: k + 1) change the end state?
+    size_t probes = 0;
+    auto diverges = [&](size_t k) {
+        probes++;
+        Engine::newGame(seed);
+        play(commands, 0, k + 1);
+        if (SaveSystem::save(ROUNDTRIP_FILE) != SaveSystem::SaveError::SUCCESS ||
+            SaveSystem::restore(ROUNDTRIP_FILE) != SaveSystem::SaveError::SUCCESS) {
+            return true;
+        }
+        auto rest = play(commands, k + 1, commands.size());
+        uint64_t endHash = rest.empty() ? StateHash::current() : rest.back();
+        return endHash != reference;
+    };
+
+    size_t turn = StateHash::bisect(commands.size(), diverges);
+    std::remove(ROUNDTRIP_FILE);
+
+    if (turn == commands.size()) {
+        std::printf("Save/restore after the last turn preserves the game (%zu probes).\n",
+                    probes);
+        return 0;
+    }
+    std::printf("Save/restore first loses state after turn %zu: %s (%zu probes)\n",
+                turn + 1, commands[turn].c_str(), probes);
+    return 1;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: state_bisect trace <commands> [seed]\n"
+                 "       state_bisect compare <traceA> <traceB>\n"
+                 "       state_bisect roundtrip <commands> [seed]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return usage();
+    }
+
+    std::string mode = argv[1];
+    if (mode == "compare") {
+        return argc > 3 ? runCompare(argv[2], argv[3]) : usage();
+    }
+
+    uint32_t seed = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : DEFAULT_SEED;
+    if (mode == "trace") {
+        return runTrace(argv[2], seed);
+    }
+    if (mode == "roundtrip") {
+        return runRoundtrip(argv[2], seed);
+    }
+    return usage();
+}
@@ -0,0 +1,496 @@
+// Zork A/B - check that two engine builds play the same game
+//
+// Usage:
+//   zork_ab [options] <buildA> <buildB> [log...]
+//   zork_ab --serve
+//
+//   buildA and buildB are zork_ab executables from the two trees being
+//   compared (e.g. before and after a performance change). Each is started
+//   with --serve and fed the same commands from a new game with the same
+//   seed. Turn by turn the tool compares the text printed and the state
+//   hash, and measures how long each build took and how many heap
+//   allocations it made.
+//
+//   A log is a command log (one command per line, blank lines and lines
+//   starting with '#' skipped) or a session transcript, in which case only
+//   the lines starting with '>' are played. Without logs, the sequences in
+//   tests/transcript_data.h are played.
+//
+// Options:
+//   --seed N          random seed of every new game (default 1)
+//   --repeat N        play every sequence N times; latency is the median
+//                     (default 6; the builds take turns going first, so
+//                     an even count is fairest)
+//   --turns           print every turn's latency and allocations
+//   --transcripts     also play tests/transcript_data.h with logs
+//
+// --serve speaks a line protocol on stdin/stdout:
+//   new <seed>        -> "ok"
+//   step <command>    -> "<hash> <ns> <allocations> <bytes> <length>" and
+//                        then <length> bytes of game output
+// The first line a server prints is "zork_ab 1".
+//
+// Exit status: 0 if the builds behaved the same, 1 if they did not, 2 on
+// usage errors or if a build could not be started.
+
+#include "core/engine.h"
+#include "core/io.h"
+#include "systems/allocation_hook.h"
+#include "../tests/transcript_data.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr const char* PROTOCOL = "zork_ab 1";
+
+// -- Server -------------------------------------------------------------------
+
+int serve() {
+    // Game text goes to the capture buffer whichever stream it is printed
+    // to; stdout carries only the protocol
+    std::ostringstream output;
+    std::istringstream noInput;
+    setOutputStream(&output);
+    setInputStream(&noInput);
+    std::cout.rdbuf(output.rdbuf());
+    std::cin.rdbuf(noInput.rdbuf());
+
+    std::printf("%s\n", PROTOCOL);
+    std::fflush(stdout);
+
+    char* line = nullptr;
+    size_t capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &capacity, stdin)) > 0) {
+        std::string request(line, static_cast<size_t>(length));
+        if (!request.empty() && request.back() == '\n') {
+            request.pop_back();
+        }
+
+        if (request.rfind("new ", 0) == 0) {
+            Engine::newGame(static_cast<uint32_t>(std::stoul(request.substr(4))));
+            setOutputColumn(0);
+            output.str("");
+            std::printf("ok\n");
+        } else if (request.rfind("step ", 0) == 0) {
+            Allocations::Counter counter;
+            auto start = std::chrono::steady_clock::now();
+            StepResult result = Engine::step(std::string_view(request).substr(5));
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            Allocations::Counts allocated = counter.elapsed().total();
+
+            std::string text = output.str();
+            output.str("");
+            std::printf("%016" PRIx64 " %" PRIu64 " %" PRIu64 " %" PRIu64 " %zu\n",
+                        result.stateHash,
+                        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                        allocated.allocations, allocated.bytes, text.size());
+            std::fwrite(text.data(), 1, text.size(), stdout);
+        } else {
+            break;
+        }
+        std::fflush(stdout);
+    }
+    std::free(line);
+    return 0;
+}
+
+// -- Driver -------------------------------------------------------------------
+
+struct Turn {
+    uint64_t hash = 0;
+    uint64_t nanoseconds = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    std::string output;
+};
+
+// A build running as a --serve subprocess
+class Build {
+public:
+    explicit Build(std::string path) : path_(std::move(path)) {}
+
+    ~Build() {
+        if (to_) {
+            std::fclose(to_);
+        }
+        if (from_) {
+            std::fclose(from_);
+        }
+        if (pid_ > 0) {
+            waitpid(pid_, nullptr, 0);
+        }
+    }
+
+    Build(const Build&) = delete;
+    Build& operator=(const Build&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    bool start() {
+        int in[2], out[2];
+        if (pipe(in) != 0 || pipe(out) != 0) {
+            return false;
+        }
+        pid_ = fork();
+        if (pid_ < 0) {
+            return false;
+        }
+        if (pid_ == 0) {
+            dup2(in[0], STDIN_FILENO);
+            dup2(out[1], STDOUT_FILENO);
+            close(in[0]);
+            close(in[1]);
+            close(out[0]);
+            close(out[1]);
+            execl(path_.c_str(), path_.c_str(), "--serve", static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        close(in[0]);
+        close(out[1]);
+        to_ = fdopen(in[1], "w");
+        from_ = fdopen(out[0], "r");
+        std::string hello;
+        return readLine(hello) && hello == PROTOCOL;
+    }
+
+    bool newGame(uint32_t seed) {
+        std::fprintf(to_, "new %" PRIu32 "\n", seed);
+        std::fflush(to_);
+        std::string reply;
+        return readLine(reply) && reply == "ok";
+    }
+
+    bool step(const std::string& command, Turn& turn) {
+        std::fprintf(to_, "step %s\n", command.c_str());
+        std::fflush(to_);
+        std::string header;
+        size_t length = 0;
+        if (!readLine(header) ||
+            std::sscanf(header.c_str(), "%" SCNx64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %zu",
+                        &turn.hash, &turn.nanoseconds, &turn.allocations, &turn.bytes,
+                        &length) != 5) {
+            return false;
+        }
+        turn.output.resize(length);
+        return std::fread(turn.output.data(), 1, length, from_) == length;
+    }
+
+private:
+    bool readLine(std::string& line) {
+        line.clear();
+        int c;
+        while ((c = std::fgetc(from_)) != EOF && c != '\n') {
+            line += static_cast<char>(c);
+        }
+        return c == '\n';
+    }
+
+    std::string path_;
+    pid_t pid_ = -1;
+    FILE* to_ = nullptr;
+    FILE* from_ = nullptr;
+};
+
+struct Sequence {
+    std::string name;
+    std::vector<std::string> commands;
+};
+
+std::vector<Sequence> transcripts() {
+    using namespace TranscriptData;
+    const std::pair<const char*, const std::vector<TranscriptStep>*> all[] = {
+        {"opening", &OPENING_SEQUENCE},
+        {"initial exploration", &INITIAL_EXPLORATION},
+        {"house exterior", &HOUSE_EXTERIOR},
+        {"enter house", &ENTER_HOUSE},
+        {"object manipulation", &OBJECT_MANIPULATION},
+        {"trophy case", &TROPHY_CASE},
+        {"forest navigation", &FOREST_NAVIGATION},
+        {"underground start", &UNDERGROUND_START},
+        {"lamp battery", &LAMP_BATTERY},
+        {"troll combat", &TROLL_COMBAT},
+        {"treasure collection", &TREASURE_COLLECTION},
+        {"score treasures", &SCORE_TREASURES},
+        {"parser features", &PARSER_FEATURES},
+        {"error handling", &ERROR_HANDLING},
+        {"disambiguation", &DISAMBIGUATION},
+        {"death sequence", &DEATH_SEQUENCE},
+        {"save restore", &SAVE_RESTORE},
+        {"winning sequence", &WINNING_SEQUENCE},
+        {"full walkthrough", &FULL_WALKTHROUGH},
+        {"troll puzzle", &TROLL_PUZZLE_SOLUTION},
+        {"cyclops puzzle", &CYCLOPS_PUZZLE_SOLUTION},
+        {"maze", &MAZE_SOLUTION},
+        {"boat puzzle", &BOAT_PUZZLE_SOLUTION},
+    };
+    std::vector<Sequence> sequences;
+    for (const auto& [name, steps] : all) {
+        Sequence sequence{name, {}};
+        for (const auto& step : *steps) {
+            sequence.commands.push_back(step.command);
+        }
+        sequences.push_back(std::move(sequence));
+    }
+    return sequences;
+}
+
+// Command log, or the "> command" lines of a transcript
+bool readLog(const std::string& path, Sequence& sequence) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::vector<std::string> lines;
+    std::vector<std::string> prompted;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] == '>') {
+            size_t start = line.find_first_not_of(" >");
+            prompted.push_back(start == std::string::npos ? "" : line.substr(start));
+        } else if (!line.empty() && line[0] != '#') {
+            lines.push_back(line);
+        }
+    }
+    sequence.name = path;
+    sequence.commands = prompted.empty() ? std::move(lines) : std::move(prompted);
+    return true;
+}
+
+uint64_t median(std::vector<uint64_t> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+double percent(double a, double b) {
+    return a > 0 ? 100.0 * (b - a) / a : 0.0;
+}
+
+// First line where two outputs differ
+void printOutputDiff(const std::string& a, const std::string& b) {
+    std::istringstream sa(a), sb(b);
+    std::string la, lb;
+    while (true) {
+        bool moreA = static_cast<bool>(std::getline(sa, la));
+        bool moreB = static_cast<bool>(std::getline(sb, lb));
+        if (!moreA && !moreB) {
+            return;
+        }
+        if (!moreA || !moreB || la != lb) {
+            std::printf("    A: %s\n    B: %s\n", moreA ? la.c_str() : "(end of output)",
+                        moreB ? lb.c_str() : "(end of output)");
+            return;
+        }
+    }
+}
+
+struct Totals {
+    size_t turns = 0;
+    uint64_t nanosecondsA = 0, nanosecondsB = 0;
+    uint64_t allocationsA = 0, allocationsB = 0;
+    size_t mismatched = 0;
+};
+
+// Play one sequence `repeat` times in both builds; false if a build died
+bool compareSequence(Build& a, Build& b, const Sequence& sequence, uint32_t seed, int repeat,
+                     bool showTurns, Totals& totals) {
+    size_t n = sequence.commands.size();
+    std::vector<std::vector<uint64_t>> timesA(n), timesB(n);
+    std::vector<Turn> firstA(n), firstB(n);
+    size_t outputDiff = n, hashDiff = n;
+
+    for (int r = 0; r < repeat; ++r) {
+        if (!a.newGame(seed) || !b.newGame(seed)) {
+            std::printf("%s: a build stopped responding\n", sequence.name.c_str());
+            return false;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            // Alternate which build goes first so neither always runs warm
+            Turn ta, tb;
+            for (int k = 0; k < 2; ++k) {
+                bool isA = (k == 0) == (r % 2 == 0);
+                if (!(isA ? a.step(sequence.commands[i], ta) : b.step(sequence.commands[i], tb))) {
+                    std::printf("%s: build %s stopped responding at turn %zu (%s)\n",
+                                sequence.name.c_str(), isA ? "A" : "B", i + 1,
+                                sequence.commands[i].c_str());
+                    return false;
+                }
+            }
+            timesA[i].push_back(ta.nanoseconds);
+            timesB[i].push_back(tb.nanoseconds);
+            if (r == 0) {
+                if (outputDiff == n && ta.output != tb.output) {
+                    outputDiff = i;
+                }
+                if (hashDiff == n && ta.hash != tb.hash) {
+                    hashDiff = i;
+                }
+                firstA[i] = std::move(ta);
+                firstB[i] = std::move(tb);
+            }
+        }
+    }
+
+    uint64_t sumA = 0, sumB = 0, allocA = 0, allocB = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sumA += median(timesA[i]);
+        sumB += median(timesB[i]);
+        allocA += firstA[i].allocations;
+        allocB += firstB[i].allocations;
+    }
+    totals.turns += n;
+    totals.nanosecondsA += sumA;
+    totals.nanosecondsB += sumB;
+    totals.allocationsA += allocA;
+    totals.allocationsB += allocB;
+
+    bool same = outputDiff == n && hashDiff == n;
+    if (!same) {
+        totals.mismatched++;
+    }
+    double turns = n ? static_cast<double>(n) : 1.0;
+    std::printf("\n== %s (%zu commands): %s\n", sequence.name.c_str(), n,
+                same ? "same output and state" : "BEHAVIOR DIFFERS");
+    if (outputDiff < n) {
+        std::printf("  output differs at turn %zu (%s):\n", outputDiff + 1,
+                    sequence.commands[outputDiff].c_str());
+        printOutputDiff(firstA[outputDiff].output, firstB[outputDiff].output);
+    }
+    if (hashDiff < n) {
+        std::printf("  state differs after turn %zu (%s): A %016" PRIx64 ", B %016" PRIx64 "\n",
+                    hashDiff + 1, sequence.commands[hashDiff].c_str(), firstA[hashDiff].hash,
+                    firstB[hashDiff].hash);
+    }
+    std::printf("  latency/turn      A %9.1f us  B %9.1f us  %+6.1f%%\n",
+                static_cast<double>(sumA) / turns / 1000.0, static_cast<double>(sumB) / turns / 1000.0,
+                percent(static_cast<double>(sumA), static_cast<double>(sumB)));
+    std::printf("  allocations/turn  A %9.1f     B %9.1f     %+6.1f%%\n",
+                static_cast<double>(allocA) / turns, static_cast<double>(allocB) / turns,
+                percent(static_cast<double>(allocA), static_cast<double>(allocB)));
+
+    if (showTurns) {
+        std::printf("  %4s %10s %10s %8s %8s %8s  %s\n", "turn", "A us", "B us", "delta",
+                    "A alloc", "B alloc", "command");
+        for (size_t i = 0; i < n; ++i) {
+            double ta = static_cast<double>(median(timesA[i])) / 1000.0;
+            double tb = static_cast<double>(median(timesB[i])) / 1000.0;
+            std::printf("  %4zu %10.1f %10.1f %+7.1f%% %8" PRIu64 " %8" PRIu64 "  %s%s\n", i + 1,
+                        ta, tb, percent(ta, tb), firstA[i].allocations, firstB[i].allocations,
+                        sequence.commands[i].c_str(),
+                        firstA[i].output != firstB[i].output || firstA[i].hash != firstB[i].hash
+                            ? "  [differs]" : "");
+        }
+    }
+    return true;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_ab [--seed N] [--repeat N] [--turns] [--transcripts]\n"
+                 "               <buildA> <buildB> [log...]\n"
+                 "       zork_ab --serve\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && std::strcmp(argv[1], "--serve") == 0) {
+        return serve();
+    }
+
+    uint32_t seed = 1;
+    int repeat = 6;
+    bool showTurns = false;
+    bool withTranscripts = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--repeat") == 0 && hasValue) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (std::strcmp(arg, "--turns") == 0) {
+            showTurns = true;
+        } else if (std::strcmp(arg, "--transcripts") == 0) {
+            withTranscripts = true;
+        } else if (arg[0] == '-') {
+            return usage();
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() < 2) {
+        return usage();
+    }
+
+    std::vector<Sequence> sequences;
+    if (paths.size() == 2 || withTranscripts) {
+        sequences = transcripts();
+    }
+    for (size_t i = 2; i < paths.size(); ++i) {
+        Sequence sequence;
+        if (!readLog(paths[i], sequence)) {
+            std::fprintf(stderr, "Cannot open %s\n", paths[i].c_str());
+            return 2;
+        }
+        sequences.push_back(std::move(sequence));
+    }
+
+    std::signal(SIGPIPE, SIG_IGN); // a build that dies shows up as a failed read
+    Build a(paths[0]), b(paths[1]);
+    for (Build* build : {&a, &b}) {
+        if (!build->start()) {
+            std::fprintf(stderr, "%s did not start as a zork_ab server\n", build->path().c_str());
+            return 2;
+        }
+    }
+
+    std::printf("A: %s\nB: %s\nseed %" PRIu32 ", median of %d runs\n", a.path().c_str(),
+                b.path().c_str(), seed, repeat);
+    Totals totals;
+    bool alive = true;
+    for (const auto& sequence : sequences) {
+        alive = compareSequence(a, b, sequence, seed, repeat, showTurns, totals);
+        if (!alive) {
+            totals.mismatched++;
+            break;
+        }
+    }
+
+    double turns = totals.turns ? static_cast<double>(totals.turns) : 1.0;
+    std::printf("\n%zu sequences, %zu turns, %zu differ\n", sequences.size(), totals.turns,
+                totals.mismatched);
+    std::printf("latency/turn      A %9.1f us  B %9.1f us  %+6.1f%%\n",
+                static_cast<double>(totals.nanosecondsA) / turns / 1000.0,
+                static_cast<double>(totals.nanosecondsB) / turns / 1000.0,
+                percent(static_cast<double>(totals.nanosecondsA),
+                        static_cast<double>(totals.nanosecondsB)));
+    std::printf("allocations/turn  A %9.1f     B %9.1f     %+6.1f%%\n",
+                static_cast<double>(totals.allocationsA) / turns,
+                static_cast<double>(totals.allocationsB) / turns,
+                percent(static_cast<double>(totals.allocationsA),
+                        static_cast<double>(totals.allocationsB)));
+    return totals.mismatched == 0 ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+// Zork Explore - coverage-guided random play to find bugs
+//
+// Usage:
+//   zork_explore [options]
+//   zork_explore --replay commands
+//
+//   Plays random commands from a growing corpus of interesting states
+//   until the time or command limit, printing each distinct failure with
+//   a minimal command log that reproduces it from a new game. Progress is
+//   printed every ten seconds. --replay plays a command log (one command
+//   per line) from a new game and reports the first failure.
+//
+// Options:
+//   --seconds N       stop after N seconds (default 60, 0 = no limit)
+//   --commands N      stop after N commands (default: no limit)
+//   --threads N       worker threads (default: one per hardware thread)
+//   --seed N          random seed of every new game (default 1)
+//   --stop            stop at the first failure
+//   --no-minimize     report failing logs as found
+//
+// Exit status: 0 if nothing failed, 1 otherwise.
+
+#include "systems/explorer.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printFailure(const Explorer::Failure& failure) {
+    std::printf("\n%s: %s\n", Explorer::kindName(failure.kind), failure.message.c_str());
+    for (const auto& command : failure.commands) {
+        std::printf("  %s\n", command.c_str());
+    }
+    std::fflush(stdout);
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_explore [--seconds N] [--commands N] [--threads N] [--seed N]\n"
+                 "                    [--stop] [--no-minimize]\n"
+                 "       zork_explore [--seed N] --replay commands\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Explorer::Options options;
+    options.handleCrashes = true;
+    options.onFailure = printFailure;
+    std::string replayPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--seconds") == 0 && hasValue) {
+            options.seconds = std::stod(argv[++i]);
+        } else if (std::strcmp(arg, "--commands") == 0 && hasValue) {
+            options.maxCommands = std::stoull(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--replay") == 0 && hasValue) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(arg, "--stop") == 0) {
+            options.stopOnFailure = true;
+        } else if (std::strcmp(arg, "--no-minimize") == 0) {
+            options.minimize = false;
+        } else {
+            return usage();
+        }
+    }
+
+    if (!replayPath.empty()) {
+        std::vector<std::string> commands;
+        std::ifstream in(replayPath);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) {
+                commands.push_back(line);
+            }
+        }
+        auto failure = Explorer::replay(commands, options.seed);
+        if (!failure) {
+            std::printf("No failure in %zu commands.\n", commands.size());
+            return 0;
+        }
+        printFailure(*failure);
+        return 1;
+    }
+
+    options.onProgress = [](const Explorer::Stats& s) {
+        std::printf("[%6.0f s] %llu commands (%.0f/s), corpus %zu, %zu features\n", s.seconds,
+                    static_cast<unsigned long long>(s.commands), s.commandsPerSecond(),
+                    s.corpus, s.features);
+        std::fflush(stdout);
+    };
+    Explorer::Stats stats = Explorer::explore(options);
+
+    unsigned threads = stats.threads ? stats.threads : 1;
+    std::printf("\n%llu commands in %.1f s on %u threads: %.0f commands/s (%.0f per thread)\n",
+                static_cast<unsigned long long>(stats.commands), stats.seconds, threads,
+                stats.commandsPerSecond(), stats.commandsPerSecond() / threads);
+    std::printf("%llu runs, corpus %zu, %zu coverage features, %zu failures\n",
+                static_cast<unsigned long long>(stats.runs), stats.corpus, stats.features,
+                stats.failures.size());
+    return stats.failures.empty() ? 0 : 1;
+}
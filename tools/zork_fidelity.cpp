@@ -0,0 +1,127 @@
+// Zork Fidelity - compare the port's output with the original game
+//
+// Usage:
+//   zork_fidelity [options] [script...]
+//
+//   Plays each script (one command per line) and a number of random walks
+//   in both the port and the original story file, and prints every
+//   distinct first divergence with the commands that reach it. Divergences
+//   during which the original used RANDOM are marked "(random)".
+//
+// Options:
+//   --story FILE      original story file (default zil/COMPILED/zork1.z3)
+//   --walks N         random walks to play (default 1000 without scripts)
+//   --length N        commands per walk (default 40)
+//   --threads N       worker threads (default: one per hardware thread)
+//   --seed N          random seed of every new game (default 1)
+//   --show N          divergences to print (default 20, 0 = all)
+//   --no-random       leave out divergences marked (random)
+//
+// Exit status: 0 if every run matched, 1 otherwise, 2 on usage errors.
+
+#include "systems/fidelity.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_fidelity [--story FILE] [--walks N] [--length N] [--threads N]\n"
+                 "                     [--seed N] [--show N] [--no-random] [script...]\n");
+    return 2;
+}
+
+void printDivergence(const Fidelity::Divergence& d) {
+    std::printf("\n%zu run%s%s:\n", d.count, d.count == 1 ? "" : "s", d.random ? " (random)" : "");
+    for (const auto& command : d.commands) {
+        std::printf("  > %s\n", command.c_str());
+    }
+    std::printf("  paragraph %zu\n", d.paragraph);
+    std::printf("  original: %s\n", d.expected.empty() ? "(nothing)" : d.expected.c_str());
+    std::printf("  port:     %s\n", d.actual.empty() ? "(nothing)" : d.actual.c_str());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Fidelity::Options options;
+    size_t show = 20;
+    bool showRandom = true;
+    bool walksGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--story") == 0 && hasValue) {
+            options.storyPath = argv[++i];
+        } else if (std::strcmp(arg, "--walks") == 0 && hasValue) {
+            options.walks = std::stoul(argv[++i]);
+            walksGiven = true;
+        } else if (std::strcmp(arg, "--length") == 0 && hasValue) {
+            options.walkLength = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--show") == 0 && hasValue) {
+            show = std::stoul(argv[++i]);
+        } else if (std::strcmp(arg, "--no-random") == 0) {
+            showRandom = false;
+        } else if (arg[0] == '-') {
+            return usage();
+        } else {
+            std::ifstream in(arg);
+            if (!in) {
+                std::fprintf(stderr, "Cannot open %s\n", arg);
+                return 2;
+            }
+            std::vector<std::string> script;
+            std::string line;
+            while (std::getline(in, line)) {
+                if (!line.empty()) {
+                    script.push_back(line);
+                }
+            }
+            options.scripts.push_back(std::move(script));
+        }
+    }
+    if (!walksGiven && options.scripts.empty()) {
+        options.walks = 1000;
+    }
+
+    Fidelity::Report report;
+    try {
+        report = Fidelity::run(options);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    size_t shown = 0;
+    size_t divergent = 0;
+    for (const auto& d : report.divergences) {
+        if (!showRandom && d.random) {
+            continue;
+        }
+        ++divergent;
+        if (show == 0 || shown < show) {
+            printDivergence(d);
+            ++shown;
+        }
+    }
+
+    std::printf("\n%zu runs, %zu matched, %zu commands in %.1f s (%.0f commands/s)\n",
+                report.runs, report.matched, report.commands, report.seconds,
+                report.seconds > 0 ? static_cast<double>(report.commands) / report.seconds : 0.0);
+    std::printf("%zu distinct divergences", divergent);
+    if (shown < divergent) {
+        std::printf(" (%zu shown)", shown);
+    }
+    std::printf("\n");
+    return report.matched == report.runs ? 0 : 1;
+}
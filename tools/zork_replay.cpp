@@ -0,0 +1,171 @@
+// Zork Replay - play back a slow turn recorded by SlowTurns
+//
+// Usage:
+//   zork_replay list <dir>
+//       One line per incident in a ring directory, oldest first: sequence,
+//       turn time, time per phase, move number and command.
+//
+//   zork_replay run <incident> [--repeat N]
+//       Rebuild the state the slow turn started from (a new game with the
+//       incident's seed, the opening LOOK if zork1 played it, then the
+//       command history, output discarded), check it against the random
+//       engine and state hash recorded, and play the turn N times (default 1000) as a dry run, which rolls
+//       the world back after each one, so every repetition does the same
+//       work. Then play it once for real and check the state hash after
+//       it. Run under a profiler to see where the turn spends its time:
+//
+//           perf record -g zork_replay run slow/slow-turn-3.txt --repeat 20000
+//
+//       A dry run captures the game's output instead of printing it, like
+//       the benchmarks' "capture" sink.
+//
+// Exit status: 0, 1 if the incident could not be reproduced (the state
+// before or after the turn differs from the recording), 2 on usage
+// errors or unreadable files.
+
+#include "core/engine.h"
+#include "core/io.h"
+#include "core/random.h"
+#include "systems/slow_turns.h"
+#include "systems/state_hash.h"
+#include "verbs/verbs.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+double ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_replay list <dir>\n"
+                 "       zork_replay run <incident> [--repeat N]\n");
+    return 2;
+}
+
+int runList(const std::string& directory) {
+    auto incidents = SlowTurns::list(directory);
+    if (incidents.empty()) {
+        std::printf("no incidents in %s\n", directory.c_str());
+        return 0;
+    }
+    std::printf("%8s %10s", "sequence", "turn ms");
+    for (size_t i = 0; i < static_cast<size_t>(SlowTurns::Phase::COUNT); ++i) {
+        std::printf(" %9s", std::string(SlowTurns::phaseName(static_cast<SlowTurns::Phase>(i))).c_str());
+    }
+    std::printf(" %6s  %s\n", "move", "command");
+    for (const auto& incident : incidents) {
+        std::printf("%8" PRIu64 " %10.3f", incident.sequence, ms(incident.turnNs));
+        for (uint64_t ns : incident.phaseNs) {
+            std::printf(" %9.3f", ms(ns));
+        }
+        std::printf(" %6d  %s\n", incident.moves, incident.command.c_str());
+    }
+    return 0;
+}
+
+int runIncident(const std::string& path, unsigned repeat) {
+    std::ifstream in(path);
+    auto incident = SlowTurns::Incident::read(in);
+    if (!incident) {
+        std::fprintf(stderr, "%s is not a slow-turn incident\n", path.c_str());
+        return 2;
+    }
+
+    std::ostringstream discard;
+    setOutputStream(&discard);
+    std::istringstream noInput;
+    setInputStream(&noInput);
+
+    // Back to the state the turn started from
+    Engine::newGame(incident->seed);
+    if (incident->openingLook) {
+        Verbs::vLook();
+    }
+    for (const auto& command : incident->history) {
+        Engine::step(command);
+        discard.str("");
+    }
+    std::ostringstream random;
+    random << Random::engine();
+    bool reproduced = random.str() == incident->random &&
+                      StateHash::current() == incident->hashBefore;
+
+    std::printf("incident %" PRIu64 ": \"%s\" took %.3f ms at move %d (%zu commands in)\n",
+                incident->sequence, incident->command.c_str(), ms(incident->turnNs),
+                incident->moves, incident->history.size());
+    for (size_t i = 0; i < incident->phaseNs.size(); ++i) {
+        std::printf("  %-8s %9.3f ms\n",
+                    std::string(SlowTurns::phaseName(static_cast<SlowTurns::Phase>(i))).c_str(),
+                    ms(incident->phaseNs[i]));
+    }
+    if (!reproduced) {
+        std::printf("state before the turn does not match the recording "
+                    "(hash %016" PRIx64 ", recorded %016" PRIx64 ")\n",
+                    StateHash::current(), incident->hashBefore);
+        setOutputStream(nullptr);
+        setInputStream(nullptr);
+        return 1;
+    }
+
+    // The turn, over and over
+    std::vector<uint64_t> samples;
+    samples.reserve(repeat);
+    for (unsigned i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        Engine::tryStep(incident->command);
+        samples.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+    std::sort(samples.begin(), samples.end());
+    if (!samples.empty()) {
+        std::printf("replayed %u times: min %.3f ms, median %.3f ms, max %.3f ms\n", repeat,
+                    ms(samples.front()), ms(samples[samples.size() / 2]), ms(samples.back()));
+    }
+
+    uint64_t after = Engine::step(incident->command).stateHash;
+    setOutputStream(nullptr);
+    setInputStream(nullptr);
+    if (after != incident->hashAfter) {
+        std::printf("state after the turn does not match the recording "
+                    "(hash %016" PRIx64 ", recorded %016" PRIx64 ")\n",
+                    after, incident->hashAfter);
+        return 1;
+    }
+    std::printf("state before and after the turn match the recording\n");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return usage();
+    }
+    std::string mode = argv[1];
+    if (mode == "list" && argc == 3) {
+        return runList(argv[2]);
+    }
+    if (mode != "run") {
+        return usage();
+    }
+
+    unsigned repeat = 1000;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else {
+            return usage();
+        }
+    }
+    return runIncident(argv[2], repeat);
+}
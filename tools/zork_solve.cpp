@@ -0,0 +1,104 @@
+// Zork Solve - search for a shortest route to a score
+//
+// Usage:
+//   zork_solve [options] [commands]
+//
+//   Plays the command log (if given) from a new game, then searches from
+//   that state for a shortest route to the target score. Prints the route,
+//   or reports that no reachable state gets there, or that a limit was hit.
+//
+// Options:
+//   --target N      score to reach (default 350)
+//   --threads N     worker threads (default: one per hardware thread)
+//   --max-states N  stop after N distinct states (default 1000000)
+//   --max-depth N   stop after N levels (default 1000)
+//   --seed N        random seed of the new game (default 1)
+//
+// The command log is a text file with one command per line; blank lines
+// and lines starting with '#' are skipped.
+
+#include "systems/solver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> readCommands(const std::string& path) {
+    std::vector<std::string> commands;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        commands.push_back(line);
+    }
+    return commands;
+}
+
+int usage() {
+    std::fprintf(stderr,
+                 "usage: zork_solve [--target N] [--threads N] [--max-states N]\n"
+                 "                  [--max-depth N] [--seed N] [commands]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Solver::Options options;
+    std::string startPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--target") == 0 && hasValue) {
+            options.targetScore = std::stoi(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (std::strcmp(arg, "--max-states") == 0 && hasValue) {
+            options.maxStates = std::stoull(argv[++i]);
+        } else if (std::strcmp(arg, "--max-depth") == 0 && hasValue) {
+            options.maxDepth = std::stoi(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg[0] != '-' && startPath.empty()) {
+            startPath = arg;
+        } else {
+            return usage();
+        }
+    }
+
+    if (!startPath.empty()) {
+        options.start = Solver::startAfter(readCommands(startPath));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    Solver::Result result = Solver::solve(options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    switch (result.outcome) {
+        case Solver::Outcome::FOUND:
+            std::printf("Route to %d points in %zu commands:\n", options.targetScore,
+                        result.route.size());
+            for (const auto& command : result.route) {
+                std::printf("%s\n", command.c_str());
+            }
+            break;
+        case Solver::Outcome::UNWINNABLE:
+            std::printf("No reachable state has %d points.\n", options.targetScore);
+            break;
+        case Solver::Outcome::LIMIT:
+            std::printf("Search limit reached at depth %d.\n", result.depth);
+            break;
+    }
+
+    std::printf("%zu states, %zu expanded, %.2f s (%.0f states/s)\n",
+                result.statesSeen, result.statesExpanded, seconds,
+                seconds > 0 ? static_cast<double>(result.statesExpanded) / seconds : 0.0);
+    return result.outcome == Solver::Outcome::FOUND ? 0 : 1;
+}